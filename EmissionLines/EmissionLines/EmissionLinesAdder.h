@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file EmissionLines/EmissionLinesAdder.h
+ * @date 10/19/26
+ */
+
+#ifndef _EMISSIONLINES_EMISSIONLINESADDER_H
+#define _EMISSIONLINES_EMISSIONLINESADDER_H
+
+#include "XYDataset/XYDataset.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace EmissionLines {
+
+/**
+ * @brief An emission line, its flux being given relatively to a reference line.
+ */
+struct EmissionLine {
+  std::string name;
+  /// Wavelength in Angstrom
+  double wavelength;
+  /// Flux ratio to the reference line
+  double ratio;
+};
+
+/**
+ * @brief Read an emission lines file: one line per row with its name, its
+ * wavelength and its flux ratio, '#' starting a comment.
+ * @throw Elements::Exception if the file cannot be read or is malformed
+ */
+std::vector<EmissionLine> readEmissionLines(const std::string& file_name);
+
+/**
+ * @class EmissionLinesAdder
+ *
+ * @brief Add emission lines to a SED.
+ *
+ * @details
+ * The flux of the reference line is derived from the flux of the SED
+ * integrated over a UV range and each line is added with either a Dirac-like
+ * (triangle of 2 Angstrom base) or a Gaussian profile. The knots of each
+ * profile are merged with the ones of the SED, which is linearly interpolated
+ * on the new knots.
+ *
+ * The adder is immutable and can be shared by several threads.
+ */
+class EmissionLinesAdder {
+
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param uv_range
+   * The wavelength range (Angstrom) over which the UV flux is integrated
+   * @param reference_factor
+   * The luminosity factor between the UV and the reference line
+   * @param lines
+   * The lines to add
+   * @param velocity
+   * The velocity (km/s) giving the FWHM of Gaussian profiles, if 0 the lines
+   * are Dirac-like
+   * @param no_sed
+   * If true the output contains only the lines
+   */
+  EmissionLinesAdder(std::pair<double, double> uv_range, double reference_factor, std::vector<EmissionLine> lines,
+                     double velocity = 0, bool no_sed = false);
+
+  /**
+   * @brief Get the SED with the emission lines added.
+   */
+  XYDataset::XYDataset operator()(const XYDataset::XYDataset& sed) const;
+
+private:
+  std::pair<double, double> m_uv_range;
+  double                    m_reference_factor;
+  std::vector<EmissionLine> m_lines;
+  double                    m_velocity;
+  bool                      m_no_sed;
+};
+
+}  // namespace EmissionLines
+}  // namespace Euclid
+
+#endif
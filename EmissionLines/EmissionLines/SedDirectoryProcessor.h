@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file EmissionLines/SedDirectoryProcessor.h
+ * @date 10/19/26
+ */
+
+#ifndef _EMISSIONLINES_SEDDIRECTORYPROCESSOR_H
+#define _EMISSIONLINES_SEDDIRECTORYPROCESSOR_H
+
+#include "EmissionLines/EmissionLinesAdder.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Euclid {
+namespace EmissionLines {
+
+/**
+ * @class SedDirectoryProcessor
+ *
+ * @brief Add emission lines to all the SEDs of a directory, writing the new
+ * SEDs (with the same file names) into an output directory.
+ *
+ * @details
+ * The SED files are read, processed and written by a pool of threads. The
+ * files which cannot be parsed as SEDs are skipped. The header keywords of
+ * the input SEDs (parameters, etc.), except their name, can be copied into
+ * the output files, before the "# Wave Flux" line which starts the data.
+ */
+class SedDirectoryProcessor {
+
+public:
+  /// Function called after each file with the number of SEDs written and the
+  /// number of SEDs to write, the files found not to be SEDs being removed from it
+  typedef std::function<void(std::size_t done, std::size_t total)> ProgressListener;
+
+  /**
+   * @brief Constructor
+   *
+   * @param adder
+   * The function adding the lines to each SED
+   * @param copy_parameters
+   * If true the header keywords of the input files are copied
+   * @param thread_number
+   * The number of threads, 0 meaning all the cores
+   */
+  SedDirectoryProcessor(EmissionLinesAdder adder, bool copy_parameters = true, std::size_t thread_number = 0);
+
+  /**
+   * @brief Process all the files of the input directory.
+   *
+   * @return the number of SEDs written
+   * @throw Elements::Exception if the output directory already exists or if
+   * a SED cannot be written
+   */
+  std::size_t process(const std::string& sed_dir, const std::string& out_dir, ProgressListener progress = {}) const;
+
+private:
+  bool processFile(const std::string& input_file, const std::string& output_file) const;
+
+  EmissionLinesAdder m_adder;
+  bool               m_copy_parameters;
+  std::size_t        m_thread_number;
+};
+
+}  // namespace EmissionLines
+}  // namespace Euclid
+
+#endif
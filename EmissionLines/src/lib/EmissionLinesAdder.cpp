@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/EmissionLinesAdder.cpp
+ * @date 10/19/26
+ */
+
+#include "EmissionLines/EmissionLinesAdder.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+
+namespace Euclid {
+namespace EmissionLines {
+
+namespace {
+
+constexpr double SPEED_OF_LIGHT_KM_S = 299792.458;
+constexpr double FWHM_TO_SIGMA       = 2.355;
+constexpr int    GAUSSIAN_KNOTS      = 31;
+
+// The wavelength range of a line profile, its knots and its values on a set of knots
+struct LineProfile {
+  double              a;
+  double              b;
+  std::vector<double> knots;
+
+  virtual ~LineProfile() = default;
+
+  virtual void addValues(const std::vector<double>& x, double flux, std::vector<double>& y) const = 0;
+};
+
+// Triangle of unit height and 2 Angstrom base, so that its area is the line flux
+struct DiracProfile : public LineProfile {
+  double wavelength;
+
+  explicit DiracProfile(double line_wavelength) : wavelength{line_wavelength} {
+    a     = wavelength - 1;
+    b     = wavelength + 1;
+    knots = {a, wavelength, b};
+  }
+
+  void addValues(const std::vector<double>& x, double flux, std::vector<double>& y) const override {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      y[i] += (x[i] <= wavelength ? x[i] - a : b - x[i]) * flux;
+    }
+  }
+};
+
+struct GaussianProfile : public LineProfile {
+  double mu;
+  double sigma;
+
+  GaussianProfile(double wavelength, double velocity) : mu{wavelength} {
+    double fwhm = wavelength * velocity / SPEED_OF_LIGHT_KM_S;
+    a           = wavelength - 2 * fwhm;
+    b           = wavelength + 2 * fwhm;
+    sigma       = fwhm / FWHM_TO_SIGMA;
+    knots.resize(GAUSSIAN_KNOTS);
+    for (int i = 0; i < GAUSSIAN_KNOTS; ++i) {
+      knots[i] = a + (b - a) * i / (GAUSSIAN_KNOTS - 1);
+    }
+  }
+
+  void addValues(const std::vector<double>& x, double flux, std::vector<double>& y) const override {
+    double norm        = flux / (sigma * std::sqrt(2 * M_PI));
+    double inv_two_var = 1. / (2 * sigma * sigma);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      double delta = x[i] - mu;
+      y[i] += norm * std::exp(-delta * delta * inv_two_var);
+    }
+  }
+};
+
+// Linear interpolation on sorted knots, constant outside the data range (as numpy.interp)
+std::vector<double> interpolate(const std::vector<double>& x, const std::vector<double>& y,
+                                const std::vector<double>& knots) {
+  std::vector<double> result(knots.size());
+  std::size_t         j = std::lower_bound(x.begin(), x.end(), knots.front()) - x.begin();
+  for (std::size_t i = 0; i < knots.size(); ++i) {
+    while (j < x.size() && x[j] < knots[i]) {
+      ++j;
+    }
+    if (j == 0) {
+      result[i] = y.front();
+    } else if (j == x.size()) {
+      result[i] = y.back();
+    } else {
+      double t  = (knots[i] - x[j - 1]) / (x[j] - x[j - 1]);
+      result[i] = y[j - 1] + t * (y[j] - y[j - 1]);
+    }
+  }
+  return result;
+}
+
+double integrate(const std::vector<double>& x, const std::vector<double>& y, double min, double max) {
+  double result = 0;
+  auto   begin  = std::lower_bound(x.begin(), x.end(), min) - x.begin();
+  auto   end    = std::upper_bound(x.begin(), x.end(), max) - x.begin();
+  for (auto i = begin; i + 1 < end; ++i) {
+    result += (x[i + 1] - x[i]) * (y[i] + y[i + 1]) / 2;
+  }
+  return result;
+}
+
+}  // namespace
+
+std::vector<EmissionLine> readEmissionLines(const std::string& file_name) {
+  std::ifstream in{file_name};
+  if (!in) {
+    throw Elements::Exception() << "Unable to open the emission lines file " << file_name;
+  }
+  std::vector<EmissionLine> lines{};
+  std::string               row;
+  while (std::getline(in, row)) {
+    row = row.substr(0, row.find('#'));
+    if (row.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    std::istringstream stream{row};
+    EmissionLine       line{};
+    if (!(stream >> line.name >> line.wavelength >> line.ratio)) {
+      throw Elements::Exception() << "Malformed emission line \"" << row << "\" in " << file_name;
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+EmissionLinesAdder::EmissionLinesAdder(std::pair<double, double> uv_range, double reference_factor,
+                                       std::vector<EmissionLine> lines, double velocity, bool no_sed)
+    : m_uv_range{uv_range}
+    , m_reference_factor{reference_factor}
+    , m_lines{std::move(lines)}
+    , m_velocity{velocity}
+    , m_no_sed{no_sed} {
+  if (m_uv_range.second <= m_uv_range.first) {
+    throw Elements::Exception() << "Invalid UV range " << m_uv_range.first << "," << m_uv_range.second;
+  }
+  if (m_velocity < 0) {
+    throw Elements::Exception() << "Negative velocity " << m_velocity;
+  }
+}
+
+XYDataset::XYDataset EmissionLinesAdder::operator()(const XYDataset::XYDataset& sed) const {
+  std::vector<double> x{};
+  std::vector<double> y{};
+  x.reserve(sed.size());
+  y.reserve(sed.size());
+  for (auto& point : sed) {
+    x.push_back(point.first);
+    y.push_back(point.second);
+  }
+  if (x.empty()) {
+    return XYDataset::XYDataset::factory(x, y);
+  }
+
+  double ref_flux = m_reference_factor * m_uv_range.second * m_uv_range.first / (m_uv_range.second - m_uv_range.first);
+  ref_flux *= integrate(x, y, m_uv_range.first, m_uv_range.second);
+
+  if (m_no_sed) {
+    std::fill(y.begin(), y.end(), 0.);
+  }
+
+  std::vector<double> knots{};
+  for (auto& line : m_lines) {
+    std::unique_ptr<LineProfile> profile{};
+    if (m_velocity > 0) {
+      profile.reset(new GaussianProfile{line.wavelength, m_velocity});
+    } else {
+      profile.reset(new DiracProfile{line.wavelength});
+    }
+
+    // The SED knots in [a, b] are merged with the ones of the line
+    auto middle_begin = std::lower_bound(x.begin(), x.end(), profile->a) - x.begin();
+    auto middle_end   = std::upper_bound(x.begin(), x.end(), profile->b) - x.begin();
+    knots.clear();
+    std::merge(x.begin() + middle_begin, x.begin() + middle_end, profile->knots.begin(), profile->knots.end(),
+               std::back_inserter(knots));
+    knots.erase(std::unique(knots.begin(), knots.end()), knots.end());
+
+    auto middle_y = interpolate(x, y, knots);
+    profile->addValues(knots, ref_flux * line.ratio, middle_y);
+
+    std::vector<double> new_x{};
+    std::vector<double> new_y{};
+    new_x.reserve(x.size() - (middle_end - middle_begin) + knots.size());
+    new_y.reserve(new_x.capacity());
+    new_x.insert(new_x.end(), x.begin(), x.begin() + middle_begin);
+    new_y.insert(new_y.end(), y.begin(), y.begin() + middle_begin);
+    new_x.insert(new_x.end(), knots.begin(), knots.end());
+    new_y.insert(new_y.end(), middle_y.begin(), middle_y.end());
+    new_x.insert(new_x.end(), x.begin() + middle_end, x.end());
+    new_y.insert(new_y.end(), y.begin() + middle_end, y.end());
+    x.swap(new_x);
+    y.swap(new_y);
+  }
+
+  return XYDataset::XYDataset::factory(x, y);
+}
+
+}  // namespace EmissionLines
+}  // namespace Euclid
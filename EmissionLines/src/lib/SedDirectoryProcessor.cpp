@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/SedDirectoryProcessor.cpp
+ * @date 10/19/26
+ */
+
+#include "EmissionLines/SedDirectoryProcessor.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzUITools/ParallelFor.h"
+#include "PhzUITools/SedHeader.h"
+#include "XYDataset/AsciiParser.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace Euclid {
+namespace EmissionLines {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SedDirectoryProcessor");
+
+SedDirectoryProcessor::SedDirectoryProcessor(EmissionLinesAdder adder, bool copy_parameters, std::size_t thread_number)
+    : m_adder{std::move(adder)}, m_copy_parameters{copy_parameters}, m_thread_number{thread_number} {}
+
+bool SedDirectoryProcessor::processFile(const std::string& input_file, const std::string& output_file) const {
+  XYDataset::AsciiParser                parser{};
+  std::unique_ptr<XYDataset::XYDataset> sed{};
+  try {
+    if (parser.isParsable(input_file)) {
+      sed = parser.getDataset(input_file);
+    }
+  } catch (const std::exception& e) {
+    logger.debug() << "Unable to parse " << input_file << " : " << e.what();
+  }
+  if (!sed) {
+    logger.info() << "Not a SED, skipping " << input_file;
+    return false;
+  }
+
+  auto result = m_adder(*sed);
+
+  std::ofstream out{output_file};
+  if (m_copy_parameters) {
+    // The name is not copied, the new SED being named after its file
+    auto header = PhzUITools::parseSedHeader(input_file);
+    for (auto& key : header.keyword_order) {
+      if (key == "NAME") {
+        continue;
+      }
+      std::vector<std::string> values{};
+      for (auto& value : header.keywords.at(key)) {
+        if (std::find(values.begin(), values.end(), value) == values.end()) {
+          values.push_back(value);
+          out << "# " << key << " : " << value << '\n';
+        }
+      }
+    }
+  }
+  out << "# Wave Flux\n";
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (auto& point : result) {
+    out << point.first << ' ' << point.second << '\n';
+  }
+  out.close();
+  if (!out) {
+    throw Elements::Exception() << "Unable to write the SED " << output_file;
+  }
+  return true;
+}
+
+std::size_t SedDirectoryProcessor::process(const std::string& sed_dir, const std::string& out_dir,
+                                           ProgressListener progress) const {
+  if (!boost::filesystem::is_directory(sed_dir)) {
+    throw Elements::Exception() << sed_dir << " is not a directory";
+  }
+  if (boost::filesystem::exists(out_dir)) {
+    throw Elements::Exception() << "Output directory " << out_dir << " already exists";
+  }
+  boost::filesystem::create_directories(out_dir);
+
+  std::vector<boost::filesystem::path> files{};
+  for (auto& entry : boost::filesystem::directory_iterator(sed_dir)) {
+    if (boost::filesystem::is_regular_file(entry.path())) {
+      files.push_back(entry.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  // The files are handed out one by one, the first error stops all the threads.
+  // The files which are not SEDs are removed from the total of the progress
+  std::size_t written = 0;
+  std::size_t total   = files.size();
+  std::mutex  mutex{};
+  PhzUITools::forEachIndex(files.size(), m_thread_number, [&](std::size_t index) {
+    auto output_file = boost::filesystem::path{out_dir} / files[index].filename();
+    bool is_sed      = processFile(files[index].string(), output_file.string());
+
+    std::lock_guard<std::mutex> lock{mutex};
+    if (is_sed) {
+      ++written;
+    } else {
+      --total;
+    }
+    if (progress) {
+      progress(written, total);
+    }
+  });
+
+  logger.info() << "Added the emission lines to " << written << " SED(s) into " << out_dir;
+  return written;
+}
+
+}  // namespace EmissionLines
+}  // namespace Euclid
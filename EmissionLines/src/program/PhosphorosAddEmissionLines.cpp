@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/PhosphorosAddEmissionLines.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Auxiliary.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "EmissionLines/EmissionLinesAdder.h"
+#include "EmissionLines/SedDirectoryProcessor.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Euclid::EmissionLines;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+static Elements::Logging logger = Elements::Logging::getLogger("PhosphorosAddEmissionLines");
+
+static const std::string EMISSION_LINES{"emission-lines"};
+static const std::string UV_RANGE{"uv-range"};
+static const std::string REFERENCE_FACTOR{"reference-factor"};
+static const std::string SED_DIR{"sed-dir"};
+static const std::string VELOCITY{"velocity"};
+static const std::string NO_SED{"no-sed"};
+static const std::string SUFFIX{"suffix"};
+static const std::string COPY_PARAMETER{"copy-parameter"};
+static const std::string THREAD_NO{"thread-no"};
+
+class PhosphorosAddEmissionLines : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Phosphoros Add Emission Lines options"};
+    options.add_options()(
+        EMISSION_LINES.c_str(), po::value<std::string>()->default_value("Ha_lines.txt"),
+        "The emission lines file (default: Ha_lines.txt, use LePhare_lines.txt for LePhare like lines)")(
+        UV_RANGE.c_str(), po::value<std::string>()->default_value("1500.0,2800.0"),
+        "The UV range to integrate (default: 1500.0,2800.0 Angstrom, use 2100,2500 for LePhare like lines)")(
+        REFERENCE_FACTOR.c_str(), po::value<double>()->default_value(5.91e-6),
+        "The luminosity factor between UV and the reference line (default: 5.91e-6, use 1.0e13 for LePhare like "
+        "lines)")(SED_DIR.c_str(), po::value<std::string>()->required(),
+                  "The directory containing the SEDs to add the emission lines on")(
+        VELOCITY.c_str(), po::value<double>(),
+        "The velocity (in km/s) to compute the FWHM of the lines from (defaults to dirac)")(
+        NO_SED.c_str(), po::bool_switch()->default_value(false), "Output only the emission lines")(
+        SUFFIX.c_str(), po::value<std::string>()->default_value("_el"),
+        "Suffix to be added to the directory name to form the output directory")(
+        COPY_PARAMETER.c_str(), po::value<bool>()->default_value(true),
+        "Define if the header containing physical parameters has to be copied into the new SEDs")(
+        THREAD_NO.c_str(), po::value<int>()->default_value(0), "Number of threads (0 for all the cores)");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto sed_dir = getSedDir(args.at(SED_DIR).as<std::string>());
+    auto out_dir = boost::trim_right_copy_if(sed_dir, boost::is_any_of("/")) + args.at(SUFFIX).as<std::string>();
+    logger.info() << "SED directory: " << sed_dir;
+    logger.info() << "Output directory: " << out_dir;
+
+    auto lines_file = getEmissionLinesFile(args.at(EMISSION_LINES).as<std::string>());
+    logger.info() << "Reading emission lines from " << lines_file;
+    auto lines = readEmissionLines(lines_file);
+
+    double velocity = args.count(VELOCITY) ? args.at(VELOCITY).as<double>() : 0.;
+    if (velocity <= 0) {
+      logger.info() << "Using Dirac";
+    }
+    EmissionLinesAdder adder{parseRange(args.at(UV_RANGE).as<std::string>()), args.at(REFERENCE_FACTOR).as<double>(),
+                             lines, velocity, args.at(NO_SED).as<bool>()};
+
+    auto thread_no = args.at(THREAD_NO).as<int>();
+    if (thread_no < 0) {
+      throw Elements::Exception() << "Invalid " << THREAD_NO << " : " << thread_no;
+    }
+    SedDirectoryProcessor processor{adder, args.at(COPY_PARAMETER).as<bool>(), static_cast<std::size_t>(thread_no)};
+    processor.process(sed_dir, out_dir, [](std::size_t done, std::size_t total) {
+      logger.debug() << "Processed " << done << " / " << total << " files";
+    });
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static std::pair<double, double> parseRange(const std::string& range) {
+    std::vector<std::string> tokens{};
+    boost::split(tokens, range, boost::is_any_of(","));
+    try {
+      if (tokens.size() == 2) {
+        return {std::stod(tokens[0]), std::stod(tokens[1])};
+      }
+    } catch (const std::exception&) {
+    }
+    throw Elements::Exception() << "A range must be start,end (in Angstrom), got " << range;
+  }
+
+  // A relative directory which does not exist is looked for in the Phosphoros SEDs directory
+  static std::string getSedDir(const std::string& sed_dir) {
+    if (fs::exists(sed_dir)) {
+      if (!fs::is_directory(sed_dir)) {
+        throw Elements::Exception() << sed_dir << " is not a directory";
+      }
+      return sed_dir;
+    }
+    if (fs::path{sed_dir}.is_relative()) {
+      auto phos_root = std::getenv("PHOSPHOROS_ROOT");
+      auto home      = std::getenv("HOME");
+      auto root      = phos_root ? fs::path{phos_root} : fs::path{home ? home : ""} / "Phosphoros";
+      auto path      = root / "AuxiliaryData" / "SEDs" / sed_dir;
+      if (fs::is_directory(path)) {
+        return path.string();
+      }
+    }
+    throw Elements::Exception() << "Unknown SED directory " << sed_dir;
+  }
+
+  // A file name without directory is looked for in the EmissionLines auxiliary directory
+  static std::string getEmissionLinesFile(const std::string& file_name) {
+    if (file_name.find('/') != std::string::npos) {
+      return file_name;
+    }
+    try {
+      return Elements::getAuxiliaryPath("EmissionLines/" + file_name).string();
+    } catch (const Elements::Exception&) {
+      return file_name;
+    }
+  }
+};
+
+MAIN_FOR(PhosphorosAddEmissionLines)
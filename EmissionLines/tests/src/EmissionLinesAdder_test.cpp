@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/EmissionLinesAdder_test.cpp
+ * @date 10/19/26
+ */
+
+#include "EmissionLines/EmissionLinesAdder.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include "EmissionLines/SedDirectoryProcessor.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+
+using namespace Euclid::EmissionLines;
+using Euclid::XYDataset::XYDataset;
+
+namespace {
+
+// Flat SED of value 1 between 1000 and 8000 Angstrom, a knot every 100 Angstrom
+XYDataset flatSed() {
+  std::vector<double> x{};
+  std::vector<double> y{};
+  for (double wavelength = 1000; wavelength <= 8000; wavelength += 100) {
+    x.push_back(wavelength);
+    y.push_back(1.);
+  }
+  return XYDataset::factory(x, y);
+}
+
+double integrate(const XYDataset& sed, double min, double max) {
+  double result = 0;
+  auto   prev   = sed.begin();
+  for (auto it = std::next(sed.begin()); it != sed.end(); prev = it++) {
+    if (prev->first >= min && it->first <= max) {
+      result += (it->first - prev->first) * (it->second + prev->second) / 2;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(EmissionLinesAdder_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(dirac_test) {
+  // GIVEN
+  // The UV flux over [1500, 2500] is 1000, so the reference flux is 1000 * 1500 * 2500 / 1000 * factor
+  double             factor = 1e-6;
+  double             ref    = 1000. * 1500. * 2500. / 1000. * factor;
+  EmissionLinesAdder adder{{1500., 2500.}, factor, {{"H_alpha", 6562.1, 1.}, {"H_beta", 4860.7, 0.5}}};
+
+  // WHEN
+  auto result = adder(flatSed());
+
+  // THEN
+  // The SED knots are kept and the 3 knots of each line are inserted
+  BOOST_CHECK_EQUAL(result.size(), flatSed().size() + 6);
+  double previous = 0;
+  for (auto& point : result) {
+    BOOST_CHECK_GT(point.first, previous);
+    previous = point.first;
+  }
+  BOOST_CHECK_CLOSE(integrate(result, 6500, 6600) - 100, ref, 1e-6);
+  BOOST_CHECK_CLOSE(integrate(result, 4800, 4900) - 100, 0.5 * ref, 1e-6);
+  BOOST_CHECK_CLOSE(integrate(result, 2000, 3000), 1000, 1e-6);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(gaussian_no_sed_test) {
+  // GIVEN
+  double             factor = 1e-6;
+  double             ref    = 1000. * 1500. * 2500. / 1000. * factor;
+  EmissionLinesAdder adder{{1500., 2500.}, factor, {{"H_alpha", 6562.1, 1.}}, 300., true};
+
+  // WHEN
+  auto result = adder(flatSed());
+
+  // THEN
+  BOOST_CHECK_EQUAL(result.size(), flatSed().size() + 31);
+  BOOST_CHECK_EQUAL(integrate(result, 1000, 6500), 0.);
+  // The profile is truncated at 2 FWHM
+  BOOST_CHECK_CLOSE(integrate(result, 6500, 6600), ref, 0.5);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(invalid_range_test) {
+  BOOST_CHECK_THROW((EmissionLinesAdder{{2500., 1500.}, 1., {}}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(readEmissionLines_test) {
+  // GIVEN
+  Elements::TempDir temp_dir{};
+  auto              file = (temp_dir.path() / "lines.txt").string();
+  std::ofstream{file} << "#Line lambda ratio\n\nH_alpha   6562.10   1.0000\nH_beta 4860.70 0.3101 # comment\n";
+
+  // WHEN
+  auto lines = readEmissionLines(file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[1].name, "H_beta");
+  BOOST_CHECK_EQUAL(lines[1].wavelength, 4860.7);
+  BOOST_CHECK_EQUAL(lines[1].ratio, 0.3101);
+
+  std::ofstream{file} << "H_alpha not_a_number 1.0\n";
+  BOOST_CHECK_THROW(readEmissionLines(file), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(directory_test) {
+  // GIVEN
+  Elements::TempDir temp_dir{};
+  auto              sed_dir = temp_dir.path() / "SEDs";
+  auto              out_dir = temp_dir.path() / "SEDs_el";
+  boost::filesystem::create_directories(sed_dir);
+  for (auto name : {"sed_1.sed", "sed_2.sed"}) {
+    std::ofstream out{(sed_dir / name).string()};
+    out << "# " << name << "\n# PARAMETER : AGE=1\n# PARAMETER : AGE=1\n";
+    for (auto& point : flatSed()) {
+      out << point.first << " " << point.second << "\n";
+    }
+  }
+  std::ofstream{(sed_dir / "readme.txt").string()} << "Not a SED at all\n";
+  SedDirectoryProcessor processor{EmissionLinesAdder{{1500., 2500.}, 1e-6, {{"H_alpha", 6562.1, 1.}}}, true, 2};
+
+  // WHEN
+  std::vector<std::pair<std::size_t, std::size_t>> progress{};
+  auto written = processor.process(sed_dir.string(), out_dir.string(), [&progress](std::size_t done, std::size_t total) {
+    progress.emplace_back(done, total);
+  });
+
+  // THEN
+  BOOST_CHECK_EQUAL(written, 2);
+  BOOST_REQUIRE_EQUAL(progress.size(), 3);
+  BOOST_CHECK((progress.back() == std::pair<std::size_t, std::size_t>{2, 2}));
+  BOOST_CHECK(boost::filesystem::exists(out_dir / "sed_2.sed"));
+  BOOST_CHECK(!boost::filesystem::exists(out_dir / "readme.txt"));
+  std::ifstream in{(out_dir / "sed_1.sed").string()};
+  std::string   line;
+  std::getline(in, line);
+  BOOST_CHECK_EQUAL(line, "# PARAMETER : AGE=1");
+  std::getline(in, line);
+  BOOST_CHECK_EQUAL(line, "# Wave Flux");
+  std::getline(in, line);
+  BOOST_CHECK_EQUAL(line.substr(0, 4), "1000");
+
+  // An existing output directory is never overwritten
+  BOOST_CHECK_THROW(processor.process(sed_dir.string(), out_dir.string()), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GalacticDustMap/CatalogEbvAnnotator.h
+ * @date 10/19/26
+ */
+
+#ifndef _GALACTICDUSTMAP_CATALOGEBVANNOTATOR_H
+#define _GALACTICDUSTMAP_CATALOGEBVANNOTATOR_H
+
+#include "GalacticDustMap/PlanckDustMap.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Euclid {
+namespace GalacticDustMap {
+
+/**
+ * @class CatalogEbvAnnotator
+ *
+ * @brief Copy a catalog adding a column with the galactic E(B-V) of each
+ * source, looked up in a Planck dust map.
+ *
+ * @details
+ * The catalog is streamed by chunks, so that its size is not bounded by the
+ * memory, and the positions of each chunk are looked up by several threads.
+ * The input can be a FITS or an ASCII table, the output format is FITS if its
+ * name ends with ".fits" (or ".FITS") and ASCII otherwise. If the input
+ * already contains the E(B-V) column its values are replaced.
+ */
+class CatalogEbvAnnotator {
+
+public:
+  /// Function called after each chunk with the number of processed and total rows
+  typedef std::function<void(std::size_t done, std::size_t total)> ProgressListener;
+
+  /// Function polled between the chunks, returning true if the processing must stop
+  typedef std::function<bool()> CancellationCheck;
+
+  /**
+   * @brief Constructor
+   *
+   * @param dust_map
+   * The map to look the positions up in
+   * @param ra_column
+   * The name of the right ascension column (degrees)
+   * @param dec_column
+   * The name of the declination column (degrees)
+   * @param ebv_column
+   * The name of the column to add to the catalog
+   * @param chunk_size
+   * The number of rows read at once
+   * @param thread_number
+   * The number of threads looking the positions up, 0 meaning all the cores
+   */
+  CatalogEbvAnnotator(std::shared_ptr<const PlanckDustMap> dust_map, std::string ra_column, std::string dec_column,
+                      std::string ebv_column = "GAL_EBV", std::size_t chunk_size = 100000,
+                      std::size_t thread_number = 0);
+
+  /**
+   * @brief Write the input catalog with the E(B-V) column into the output file.
+   *
+   * @details
+   * An existing output file is replaced. If the processing is cancelled or
+   * fails the partial output file is removed.
+   *
+   * @throw Elements::Exception if the catalog cannot be read, lacks the
+   * position columns or if the processing has been cancelled
+   */
+  void annotate(const std::string& input_catalog, const std::string& output_catalog,
+                ProgressListener progress = {}, CancellationCheck is_cancelled = {}) const;
+
+private:
+  std::shared_ptr<const PlanckDustMap> m_dust_map;
+  std::string                          m_ra_column;
+  std::string                          m_dec_column;
+  std::string                          m_ebv_column;
+  std::size_t                          m_chunk_size;
+  std::size_t                          m_thread_number;
+};
+
+}  // namespace GalacticDustMap
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GalacticDustMap/PlanckDustMap.h
+ * @date 10/19/26
+ */
+
+#ifndef _GALACTICDUSTMAP_PLANCKDUSTMAP_H
+#define _GALACTICDUSTMAP_PLANCKDUSTMAP_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace GalacticDustMap {
+
+/**
+ * @brief Convert equatorial coordinates into galactic ones.
+ *
+ * @details
+ * Port of raDecToLB of the GalacticDustMap python module (itself ported from
+ * the IDL code), so that both give the same results.
+ *
+ * @param ra
+ * The right ascension in degrees
+ * @param dec
+ * The declination in degrees
+ * @return the galactic longitude and latitude (l, b) in degrees
+ */
+std::pair<double, double> raDecToLB(double ra, double dec);
+
+/**
+ * @brief Get the index of the HEALPix pixel containing the given position, in
+ * the NESTED scheme.
+ *
+ * @details
+ * Port of ang2pix_nest of the GalacticDustMap python module.
+ *
+ * @param nside
+ * The resolution of the map, in [1, 8192]
+ * @param theta
+ * The colatitude in radians, in [0, pi]
+ * @param phi
+ * The longitude in radians
+ * @throw Elements::Exception if nside or theta are out of range
+ */
+long ang2pixNest(long nside, double theta, double phi);
+
+/**
+ * @class PlanckDustMap
+ *
+ * @brief The Planck galactic E(B-V) HEALPix map (NESTED ordering).
+ *
+ * @details
+ * The pixels are either owned by the object or memory-mapped read-only from a
+ * raw copy of the map (see open()). In the second case all the processes
+ * using the map share the same pages of the system cache and only the pages
+ * holding the pixels actually looked up are read from the disk.
+ *
+ * The raw file is made of a 32 bytes header followed by the pixels as 32 bits
+ * little endian floats. The header contains the 8 characters "PHZHPX1" (NUL
+ * terminated), then the nside and the number of pixels as 64 bits little
+ * endian integers and 8 reserved bytes. The python module maps the same file.
+ */
+class PlanckDustMap {
+
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param values
+   * The value of the 12 * nside^2 pixels of the map
+   * @throw Elements::Exception if the number of values is not the one of a
+   * HEALPix map
+   */
+  explicit PlanckDustMap(std::vector<float> values);
+
+  /**
+   * @brief Read the map from the first column of the first extension of a
+   * FITS file, as distributed by Planck.
+   */
+  static PlanckDustMap load(const std::string& file_name);
+
+  /**
+   * @brief Memory-map a raw copy of the map.
+   * @throw Elements::Exception if the file is not a valid raw map
+   */
+  static PlanckDustMap map(const std::string& raw_file);
+
+  /**
+   * @brief Write the map as a raw file, which can then be memory-mapped. The
+   * file is written under a temporary name then renamed, so that concurrent
+   * readers never see a partial file.
+   */
+  void writeRaw(const std::string& raw_file) const;
+
+  /**
+   * @brief Get the raw copy associated with a FITS map, stored next to it.
+   */
+  static std::string getRawFile(const std::string& fits_file);
+
+  /**
+   * @brief Get the map of a FITS file through its raw copy.
+   *
+   * @details
+   * The raw copy is (re)built if it is missing or older than the FITS file.
+   * If it cannot be written (e.g. read-only directory) the FITS file is read
+   * in memory instead.
+   */
+  static PlanckDustMap open(const std::string& fits_file);
+
+  long getNside() const;
+
+  /// The number of pixels (12 * nside^2)
+  std::size_t size() const;
+
+  /// The pixel values, in NESTED ordering
+  const float* data() const;
+
+  /// True if the pixels are memory-mapped from a raw file
+  bool isMapped() const;
+
+  /**
+   * @brief Get the E(B-V) at the given equatorial position (degrees), NaN if
+   * the position is not valid.
+   */
+  double getEbv(double ra, double dec) const;
+
+  /**
+   * @brief Get the E(B-V) of a list of positions.
+   *
+   * @param ra
+   * The right ascensions in degrees
+   * @param dec
+   * The declinations in degrees, same size as ra
+   * @param thread_number
+   * The number of threads sharing the positions, if 0 use all the cores
+   * @return The E(B-V) of each position
+   */
+  std::vector<double> getEbv(const std::vector<double>& ra, const std::vector<double>& dec,
+                             std::size_t thread_number = 0) const;
+
+private:
+  class Mapping;
+
+  PlanckDustMap(std::shared_ptr<const Mapping> mapping, const float* values, std::size_t size);
+
+  void checkSize();
+
+  std::shared_ptr<const std::vector<float>> m_owned_values;
+  std::shared_ptr<const Mapping>            m_mapping;
+  const float*                              m_values;
+  std::size_t                               m_size;
+  long                                      m_nside;
+};
+
+}  // namespace GalacticDustMap
+}  // namespace Euclid
+
+#endif
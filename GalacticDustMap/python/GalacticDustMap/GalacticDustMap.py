@@ -30,6 +30,7 @@ from __future__ import division, print_function
 from astropy.io import fits
 import math as math
 import numpy as np
+import os
 import sys
 if sys.version_info[0] < 3:
     from future_builtins import *
@@ -180,11 +181,73 @@ def raDecToLB(ra,dec):
     l = (l + 360)*mask_l + l*np.logical_not(mask_l)
     return (l,b)
     
-def loadMap(dustmap_filename):
+# Raw copy of the map shared with the C++ PlanckDustMap: a 32 bytes header
+# (magic, nside and number of pixels as little endian uint64, reserved) then
+# the pixels as little endian float32
+_RAW_MAGIC = b'PHZHPX1\x00'
+_RAW_HEADER_SIZE = 32
+
+
+def getRawFile(dustmap_filename):
+    return os.path.splitext(dustmap_filename)[0] + '.raw'
+
+
+def loadRawMap(raw_filename):
+    header = np.fromfile(raw_filename, dtype=np.uint8, count=_RAW_HEADER_SIZE)
+    if len(header) != _RAW_HEADER_SIZE or header[:8].tobytes() != _RAW_MAGIC:
+        raise ValueError('%s is not a raw HEALPix map' % raw_filename)
+    nside, npix = header[8:24].view('<u8')
+    if npix != 12 * nside * nside or \
+            os.path.getsize(raw_filename) != _RAW_HEADER_SIZE + 4 * npix:
+        raise ValueError('%s is not a valid raw HEALPix map' % raw_filename)
+    return np.memmap(raw_filename, dtype='<f4', mode='r',
+                     offset=_RAW_HEADER_SIZE, shape=(int(npix),))
+
+
+def writeRawMap(data, raw_filename):
+    npix = len(data)
+    nside = int(round(math.sqrt(npix / 12)))
+    if 12 * nside * nside != npix:
+        raise ValueError('A HEALPix map must have 12 * nside^2 pixels')
+    header = np.zeros(_RAW_HEADER_SIZE, dtype=np.uint8)
+    header[:8] = np.frombuffer(_RAW_MAGIC, dtype=np.uint8)
+    header[8:24] = np.array([nside, npix], dtype='<u8').view(np.uint8)
+    # Write a temporary file then rename it, so that the concurrent readers
+    # never map a partial file
+    tmp_filename = '%s.%d.tmp' % (raw_filename, os.getpid())
+    with open(tmp_filename, 'wb') as out:
+        out.write(header.tobytes())
+        out.write(np.asarray(data, dtype='<f4').tobytes())
+    os.replace(tmp_filename, raw_filename)
+
+
+def loadFitsMap(dustmap_filename):
     with fits.open(dustmap_filename) as hdul:  # open a FITS file
         data = hdul[1].data[0][0]
         #data = hdul[0].data
     return data
+
+
+def loadMap(dustmap_filename):
+    """
+    Get the map memory-mapped from its raw copy, so that all the processes
+    share the same pages. The raw copy is (re)built next to the FITS file
+    when it is missing or outdated; if it cannot be written the FITS file
+    is read in memory.
+    """
+    raw_filename = getRawFile(dustmap_filename)
+    if os.path.exists(raw_filename) and \
+            os.path.getmtime(raw_filename) >= os.path.getmtime(dustmap_filename):
+        try:
+            return loadRawMap(raw_filename)
+        except ValueError:
+            pass
+    data = loadFitsMap(dustmap_filename)
+    try:
+        writeRawMap(data, raw_filename)
+        return loadRawMap(raw_filename)
+    except (OSError, IOError, ValueError):
+        return data
     
 def ebv_planck(data,ra,dec):
     (l,b)=raDecToLB(ra,dec)
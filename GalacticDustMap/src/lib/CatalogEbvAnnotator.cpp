@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/CatalogEbvAnnotator.cpp
+ * @date 10/19/26
+ */
+
+#include "GalacticDustMap/CatalogEbvAnnotator.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "Table/AsciiReader.h"
+#include "Table/AsciiWriter.h"
+#include "Table/FitsReader.h"
+#include "Table/FitsWriter.h"
+#include <array>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+namespace Euclid {
+namespace GalacticDustMap {
+
+static Elements::Logging logger = Elements::Logging::getLogger("CatalogEbvAnnotator");
+
+namespace {
+
+// Convert the numerical cells into double, anything else into NaN
+class ToDoubleVisitor : public boost::static_visitor<double> {
+public:
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, double>::type operator()(const T& value) const {
+    return static_cast<double>(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value, double>::type operator()(const T&) const {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+};
+
+bool isFitsFile(const std::string& file_name) {
+  std::ifstream        in{file_name};
+  std::array<char, 10> header{};
+  in.read(header.data(), 9);
+  return std::string{header.data()} == "SIMPLE  =";
+}
+
+std::unique_ptr<Table::TableReader> createReader(const std::string& file_name) {
+  if (isFitsFile(file_name)) {
+    return std::unique_ptr<Table::TableReader>{new Table::FitsReader{file_name, 1}};
+  }
+  logger.info() << "The catalog " << file_name << " is not a FITS file, read it as ASCII";
+  return std::unique_ptr<Table::TableReader>{new Table::AsciiReader{file_name}};
+}
+
+std::unique_ptr<Table::TableWriter> createWriter(const std::string& file_name) {
+  if (boost::ends_with(file_name, ".fits") || boost::ends_with(file_name, ".FITS")) {
+    return std::unique_ptr<Table::TableWriter>{new Table::FitsWriter{file_name, true}};
+  }
+  return std::unique_ptr<Table::TableWriter>{new Table::AsciiWriter{file_name}};
+}
+
+std::size_t getColumnIndex(const Table::ColumnInfo& column_info, const std::string& name) {
+  auto index = column_info.find(name);
+  if (index == nullptr) {
+    throw Elements::Exception() << "Column missing in the input catalog : " << name;
+  }
+  return *index;
+}
+
+}  // namespace
+
+CatalogEbvAnnotator::CatalogEbvAnnotator(std::shared_ptr<const PlanckDustMap> dust_map, std::string ra_column,
+                                         std::string dec_column, std::string ebv_column, std::size_t chunk_size,
+                                         std::size_t thread_number)
+    : m_dust_map{std::move(dust_map)}
+    , m_ra_column{std::move(ra_column)}
+    , m_dec_column{std::move(dec_column)}
+    , m_ebv_column{std::move(ebv_column)}
+    , m_chunk_size{std::max<std::size_t>(1, chunk_size)}
+    , m_thread_number{thread_number} {}
+
+void CatalogEbvAnnotator::annotate(const std::string& input_catalog, const std::string& output_catalog,
+                                   ProgressListener progress, CancellationCheck is_cancelled) const {
+  auto reader     = createReader(input_catalog);
+  auto input_info = reader->getInfo();
+  auto ra_index   = getColumnIndex(input_info, m_ra_column);
+  auto dec_index  = getColumnIndex(input_info, m_dec_column);
+
+  // The E(B-V) column replaces the existing one or is appended
+  std::vector<Table::ColumnInfo::info_type> output_descriptions{};
+  std::size_t                               ebv_index = input_info.size();
+  for (std::size_t index = 0; index < input_info.size(); ++index) {
+    output_descriptions.push_back(input_info.getDescription(index));
+    if (output_descriptions.back().name == m_ebv_column) {
+      ebv_index = index;
+    }
+  }
+  Table::ColumnInfo::info_type ebv_description{m_ebv_column, typeid(double), "mag", "Galactic E(B-V) from Planck"};
+  if (ebv_index == input_info.size()) {
+    output_descriptions.push_back(ebv_description);
+  } else {
+    output_descriptions[ebv_index] = ebv_description;
+  }
+  auto output_info = std::make_shared<Table::ColumnInfo>(output_descriptions);
+
+  if (boost::filesystem::exists(output_catalog)) {
+    logger.warn() << "Output file " << output_catalog << " was already present: deleting it.";
+    boost::filesystem::remove(output_catalog);
+  }
+
+  std::size_t     total = reader->rowsLeft();
+  std::size_t     done  = 0;
+  ToDoubleVisitor to_double{};
+  try {
+    auto writer = createWriter(output_catalog);
+    while (reader->hasMoreRows()) {
+      if (is_cancelled && is_cancelled()) {
+        throw Elements::Exception() << "The E(B-V) computation has been cancelled";
+      }
+      auto table = reader->read(m_chunk_size);
+
+      std::vector<double> ra(table.size());
+      std::vector<double> dec(table.size());
+      for (std::size_t row = 0; row < table.size(); ++row) {
+        ra[row]  = boost::apply_visitor(to_double, table[row][ra_index]);
+        dec[row] = boost::apply_visitor(to_double, table[row][dec_index]);
+      }
+      auto ebv = m_dust_map->getEbv(ra, dec, m_thread_number);
+
+      std::vector<Table::Row> rows{};
+      rows.reserve(table.size());
+      for (std::size_t row = 0; row < table.size(); ++row) {
+        std::vector<Table::Row::cell_type> cells(table[row].begin(), table[row].end());
+        if (ebv_index == cells.size()) {
+          cells.emplace_back(ebv[row]);
+        } else {
+          cells[ebv_index] = ebv[row];
+        }
+        rows.emplace_back(std::move(cells), output_info);
+      }
+      writer->addData(Table::Table{rows});
+
+      done += table.size();
+      if (progress) {
+        progress(done, total);
+      }
+    }
+  } catch (...) {
+    // Do not leave a truncated catalog behind
+    boost::system::error_code error{};
+    boost::filesystem::remove(output_catalog, error);
+    throw;
+  }
+  logger.info() << "Added the column " << m_ebv_column << " to " << done << " sources into " << output_catalog;
+}
+
+}  // namespace GalacticDustMap
+}  // namespace Euclid
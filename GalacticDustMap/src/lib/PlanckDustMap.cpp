@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PlanckDustMap.cpp
+ * @date 10/19/26
+ */
+
+#include "GalacticDustMap/PlanckDustMap.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzUITools/ParallelFor.h"
+#include <CCfits/CCfits>
+#include <algorithm>
+#include <array>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <valarray>
+
+namespace Euclid {
+namespace GalacticDustMap {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PlanckDustMap");
+
+namespace {
+
+constexpr double PI      = 3.14159265358979323846;
+constexpr double RADEG   = 180.0 / PI;
+constexpr long   NS_MAX  = 8192;
+constexpr double TWOPI   = 2. * PI;
+constexpr double PIOVER2 = 0.5 * PI;
+
+// Pole and center of the galactic frame, as in the IDL code
+const double RAPOL    = (12 + 51.4 / 60.0) * 15.0 / RADEG;
+const double DECPOL   = (27.0 + 77.0 / 600.0) / RADEG;
+const double SDECPOL  = std::sin(DECPOL);
+const double CDECPOL  = std::cos(DECPOL);
+const double RACEN    = (17 + 45.6 / 60.0) * 15.0 / RADEG;
+const double SDECCEN  = std::sin(std::atan(-std::cos(RACEN - RAPOL) / std::tan(DECPOL)));
+const double Q_OFFSET = std::acos(SDECCEN / CDECPOL) * RADEG;
+
+// Raw file layout, see the class documentation
+constexpr char        RAW_MAGIC[8]    = "PHZHPX1";
+constexpr std::size_t RAW_HEADER_SIZE = 32;
+
+double clamp(double value) {
+  return std::max(-1., std::min(1., value));
+}
+
+// The number of the pixel lying in (x, y) for x, y in [0, 128[ (see init_xy2pix)
+struct XY2Pix {
+  std::array<long, 128> x2pix{};
+  std::array<long, 128> y2pix{};
+
+  XY2Pix() {
+    for (long i = 0; i < 128; ++i) {
+      long j  = i;
+      long k  = 0;
+      long ip = 1;
+      while (j > 0) {
+        k += ip * (j % 2);
+        j /= 2;
+        ip *= 4;
+      }
+      x2pix[i] = k;
+      y2pix[i] = 2 * k;
+    }
+  }
+};
+
+const XY2Pix& xy2pix() {
+  static const XY2Pix instance{};
+  return instance;
+}
+
+}  // namespace
+
+std::pair<double, double> raDecToLB(double ra, double dec) {
+  double ras   = ra / RADEG;
+  double decs  = dec / RADEG;
+  double sdecs = std::sin(decs);
+  double cdecs = std::cos(decs);
+
+  double b  = std::asin(clamp(sdecs * SDECPOL + cdecs * CDECPOL * std::cos(ras - RAPOL))) * RADEG;
+  double cb = std::cos(b / RADEG);
+  double j  = (((sdecs * CDECPOL) - (cdecs * SDECPOL * std::cos(ras - RAPOL))) / cb) * RADEG;
+  double k  = std::asin(clamp((cdecs * std::sin(ras - RAPOL)) / cb)) * RADEG;
+  double l  = j < 0 ? Q_OFFSET + k - 180.0 : Q_OFFSET - k;
+  if (l < 0) {
+    l += 360;
+  }
+  return {l, b};
+}
+
+long ang2pixNest(long nside, double theta, double phi) {
+  if (nside < 1 || nside > NS_MAX) {
+    throw Elements::Exception() << "nside out of range : " << nside;
+  }
+  if (!(theta >= 0 && theta <= PI)) {
+    throw Elements::Exception() << "theta out of range : " << theta;
+  }
+
+  double z      = std::cos(theta);
+  double z0     = 2. / 3.;
+  double phi_in = std::fmod(phi, TWOPI);
+  if (phi_in < 0.) {
+    phi_in += TWOPI;
+  }
+  double tt = phi_in / PIOVER2;  // in [0,4[
+
+  long face_num = 0;
+  long ix       = 0;
+  long iy       = 0;
+  if (z <= z0 && z > -z0) {
+    // Equatorial strip: the index of edge lines increase when the longitude goes up
+    long jp  = static_cast<long>(NS_MAX * (0.5 + tt - z * 0.75));  // ascending edge line index
+    long jm  = static_cast<long>(NS_MAX * (0.5 + tt + z * 0.75));  // descending edge line index
+    long ifp = jp / NS_MAX;
+    long ifm = jm / NS_MAX;
+    if (ifp == ifm) {
+      face_num = ifp % 4 + 4;
+    } else if (ifp < ifm) {
+      face_num = ifp % 4;
+    } else {
+      face_num = ifm % 4 + 8;
+    }
+    ix = jm % NS_MAX;
+    iy = NS_MAX - (jp % NS_MAX) - 1;
+  } else {
+    // Polar caps: the index of edge lines increase when the distance from the closest pole goes up
+    long   ntt = std::min(static_cast<long>(tt), 3L);
+    double tp  = tt - ntt;
+    double tmp = std::sqrt(3. * (1. - std::abs(z)));
+    long   jp  = std::min(static_cast<long>(NS_MAX * tp * tmp), NS_MAX - 1);
+    long   jm  = std::min(static_cast<long>(NS_MAX * (1. - tp) * tmp), NS_MAX - 1);
+    if (z > 0.) {
+      face_num = ntt;
+      ix       = NS_MAX - jm - 1;
+      iy       = NS_MAX - jp - 1;
+    } else {
+      face_num = ntt + 8;
+      ix       = jp;
+      iy       = jm;
+    }
+  }
+
+  auto& table = xy2pix();
+  long  ipix  = (table.x2pix[ix / 128] + table.y2pix[iy / 128]) * 16384 +
+              (table.x2pix[ix % 128] + table.y2pix[iy % 128]);
+  ipix = ipix / ((NS_MAX / nside) * (NS_MAX / nside));
+  return ipix + face_num * nside * nside;
+}
+
+// Read-only mapping of a whole file, unmapped when the last map using it is destroyed
+class PlanckDustMap::Mapping {
+public:
+  explicit Mapping(const std::string& file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw Elements::Exception() << "Unable to open the dust map " << file_name;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(RAW_HEADER_SIZE)) {
+      ::close(fd);
+      throw Elements::Exception() << "The dust map " << file_name << " is not a raw HEALPix map";
+    }
+    m_size    = static_cast<std::size_t>(status.st_size);
+    m_address = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_address == MAP_FAILED) {
+      throw Elements::Exception() << "Unable to map the dust map " << file_name;
+    }
+    // The lookups of a catalog are spread all over the sky, read-ahead would be wasted
+    ::madvise(m_address, m_size, MADV_RANDOM);
+  }
+
+  ~Mapping() {
+    ::munmap(m_address, m_size);
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const char* data() const {
+    return static_cast<const char*>(m_address);
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+private:
+  void*       m_address = nullptr;
+  std::size_t m_size    = 0;
+};
+
+PlanckDustMap::PlanckDustMap(std::vector<float> values)
+    : m_owned_values{std::make_shared<const std::vector<float>>(std::move(values))}
+    , m_values{m_owned_values->data()}
+    , m_size{m_owned_values->size()} {
+  checkSize();
+}
+
+PlanckDustMap::PlanckDustMap(std::shared_ptr<const Mapping> mapping, const float* values, std::size_t size)
+    : m_mapping{std::move(mapping)}, m_values{values}, m_size{size} {
+  checkSize();
+}
+
+void PlanckDustMap::checkSize() {
+  m_nside = std::lround(std::sqrt(m_size / 12.));
+  if (m_nside < 1 || static_cast<std::size_t>(12 * m_nside * m_nside) != m_size) {
+    throw Elements::Exception() << "A HEALPix map must have 12 * nside^2 pixels, got " << m_size;
+  }
+}
+
+PlanckDustMap PlanckDustMap::load(const std::string& file_name) {
+  logger.info() << "Read the dust map " << file_name;
+  std::vector<float> values{};
+  try {
+    CCfits::FITS    fits{file_name, CCfits::RWmode::Read};
+    CCfits::ExtHDU& extension = fits.extension(1);
+    CCfits::Column& column    = extension.column(1);
+    if (column.repeat() > 1) {
+      // The map is stored as vectors in one or more rows
+      std::vector<std::valarray<float>> rows{};
+      column.readArrays(rows, 1, extension.rows());
+      values.reserve(rows.size() * column.repeat());
+      for (auto& row : rows) {
+        values.insert(values.end(), std::begin(row), std::end(row));
+      }
+    } else {
+      column.read(values, 1, extension.rows());
+    }
+  } catch (const CCfits::FitsException& e) {
+    throw Elements::Exception() << "Unable to read the dust map " << file_name << " : " << e.message();
+  }
+  return PlanckDustMap{std::move(values)};
+}
+
+PlanckDustMap PlanckDustMap::map(const std::string& raw_file) {
+  auto mapping = std::make_shared<const Mapping>(raw_file);
+
+  std::uint64_t nside = 0;
+  std::uint64_t npix  = 0;
+  std::memcpy(&nside, mapping->data() + 8, sizeof(nside));
+  std::memcpy(&npix, mapping->data() + 16, sizeof(npix));
+  if (std::memcmp(mapping->data(), RAW_MAGIC, sizeof(RAW_MAGIC)) != 0 || npix != 12 * nside * nside ||
+      mapping->size() != RAW_HEADER_SIZE + npix * sizeof(float)) {
+    throw Elements::Exception() << "The dust map " << raw_file << " is not a valid raw HEALPix map";
+  }
+
+  auto values = reinterpret_cast<const float*>(mapping->data() + RAW_HEADER_SIZE);
+  return PlanckDustMap{std::move(mapping), values, static_cast<std::size_t>(npix)};
+}
+
+void PlanckDustMap::writeRaw(const std::string& raw_file) const {
+  auto tmp_file =
+      boost::filesystem::path{raw_file + "." + boost::filesystem::unique_path().string() + ".tmp"}.string();
+  {
+    std::ofstream out{tmp_file, std::ios::binary};
+    std::array<char, RAW_HEADER_SIZE> header{};
+    std::uint64_t                     nside = static_cast<std::uint64_t>(m_nside);
+    std::uint64_t                     npix  = static_cast<std::uint64_t>(m_size);
+    std::memcpy(header.data(), RAW_MAGIC, sizeof(RAW_MAGIC));
+    std::memcpy(header.data() + 8, &nside, sizeof(nside));
+    std::memcpy(header.data() + 16, &npix, sizeof(npix));
+    out.write(header.data(), header.size());
+    out.write(reinterpret_cast<const char*>(m_values), static_cast<std::streamsize>(m_size * sizeof(float)));
+    out.close();
+    if (!out) {
+      boost::system::error_code error{};
+      boost::filesystem::remove(tmp_file, error);
+      throw Elements::Exception() << "Unable to write the dust map " << raw_file;
+    }
+  }
+  boost::filesystem::rename(tmp_file, raw_file);
+}
+
+std::string PlanckDustMap::getRawFile(const std::string& fits_file) {
+  return boost::filesystem::path{fits_file}.replace_extension(".raw").string();
+}
+
+PlanckDustMap PlanckDustMap::open(const std::string& fits_file) {
+  auto raw_file = getRawFile(fits_file);
+
+  boost::system::error_code error{};
+  auto                      raw_time = boost::filesystem::last_write_time(raw_file, error);
+  if (!error && raw_time >= boost::filesystem::last_write_time(fits_file)) {
+    try {
+      return map(raw_file);
+    } catch (const Elements::Exception& e) {
+      logger.warn() << e.what() << ", rebuilding it";
+    }
+  }
+
+  auto dust_map = load(fits_file);
+  try {
+    dust_map.writeRaw(raw_file);
+    logger.info() << "Wrote the raw dust map " << raw_file;
+    return map(raw_file);
+  } catch (const std::exception& e) {
+    logger.warn() << "Unable to use a raw copy of the dust map (" << e.what() << "), keep it in memory";
+  }
+  return dust_map;
+}
+
+long PlanckDustMap::getNside() const {
+  return m_nside;
+}
+
+std::size_t PlanckDustMap::size() const {
+  return m_size;
+}
+
+const float* PlanckDustMap::data() const {
+  return m_values;
+}
+
+bool PlanckDustMap::isMapped() const {
+  return m_mapping != nullptr;
+}
+
+double PlanckDustMap::getEbv(double ra, double dec) const {
+  if (!std::isfinite(ra) || !std::isfinite(dec) || std::abs(dec) > 90) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  auto   lb    = raDecToLB(ra, dec);
+  double phi   = lb.first / RADEG;
+  double theta = std::max(0., std::min(PI, (90 - lb.second) / RADEG));
+  return m_values[ang2pixNest(m_nside, theta, phi)];
+}
+
+std::vector<double> PlanckDustMap::getEbv(const std::vector<double>& ra, const std::vector<double>& dec,
+                                          std::size_t thread_number) const {
+  if (ra.size() != dec.size()) {
+    throw Elements::Exception() << "Inconsistent number of RA (" << ra.size() << ") and Dec (" << dec.size() << ")";
+  }
+  // Below a few thousands positions the threads cost more than they save
+  thread_number = PhzUITools::getThreadNumber(thread_number, ra.size(), 4096);
+
+  std::vector<double> ebv(ra.size());
+  auto                compute = [this, &ra, &dec, &ebv](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t index = begin; index < end; ++index) {
+      ebv[index] = getEbv(ra[index], dec[index]);
+    }
+  };
+  PhzUITools::forEachBlock(ra.size(), thread_number, compute);
+  return ebv;
+}
+
+}  // namespace GalacticDustMap
+}  // namespace Euclid
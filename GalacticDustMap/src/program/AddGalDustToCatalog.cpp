@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/AddGalDustToCatalog.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "GalacticDustMap/CatalogEbvAnnotator.h"
+#include "GalacticDustMap/PlanckDustMap.h"
+#include "PhzUITools/ProgressReporter.h"
+#include <boost/program_options.hpp>
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace Euclid;
+using namespace Euclid::GalacticDustMap;
+namespace po = boost::program_options;
+
+static Elements::Logging logger = Elements::Logging::getLogger("AddGalDustToCatalog");
+
+static const std::string PLANCK_DUST_MAP{"planck-dust-map"};
+static const std::string INPUT_CATALOG{"input-catalog"};
+static const std::string OUTPUT_CATALOG{"output-catalog"};
+static const std::string RA{"ra"};
+static const std::string DEC{"dec"};
+static const std::string GALACTIC_EBV_COL{"galatic-ebv-col"};
+static const std::string CHUNK_SIZE{"chunk-size"};
+static const std::string THREAD_NO{"thread-no"};
+static const std::string PROGRESS_FILE{"progress-file"};
+
+class AddGalDustToCatalog : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Add Galactic Dust To Catalog options"};
+    options.add_options()(PLANCK_DUST_MAP.c_str(), po::value<std::string>()->default_value(""),
+                          "Filename of the Planck dust map in HEALPIX format")(
+        INPUT_CATALOG.c_str(), po::value<std::string>()->default_value(""), "Input catalog filename")(
+        OUTPUT_CATALOG.c_str(), po::value<std::string>()->default_value(""), "Output catalog filename")(
+        RA.c_str(), po::value<std::string>()->default_value(""), "Right Ascension column in the catalog (Degrees)")(
+        DEC.c_str(), po::value<std::string>()->default_value(""), "Declination column in the catalog (Degrees)")(
+        GALACTIC_EBV_COL.c_str(), po::value<std::string>()->default_value("GAL_EBV"),
+        "Name of the column to be added to the output catalog")(
+        CHUNK_SIZE.c_str(), po::value<int>()->default_value(100000), "Number of rows processed at once")(
+        THREAD_NO.c_str(), po::value<int>()->default_value(0), "Number of threads (0 for all the cores)")(
+        PROGRESS_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(optional) JSON file into which the progress is written");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto map_file = getMandatory(args, PLANCK_DUST_MAP);
+    auto input    = getMandatory(args, INPUT_CATALOG);
+    auto output   = getMandatory(args, OUTPUT_CATALOG);
+    auto ra       = getMandatory(args, RA);
+    auto dec      = getMandatory(args, DEC);
+
+    auto chunk_size = args.at(CHUNK_SIZE).as<int>();
+    auto thread_no  = args.at(THREAD_NO).as<int>();
+    if (chunk_size <= 0 || thread_no < 0) {
+      throw Elements::Exception() << "Invalid " << CHUNK_SIZE << " or " << THREAD_NO;
+    }
+
+    auto dust_map = std::make_shared<const PlanckDustMap>(PlanckDustMap::open(map_file));
+
+    CatalogEbvAnnotator annotator{dust_map, ra, dec, args.at(GALACTIC_EBV_COL).as<std::string>(),
+                                  static_cast<std::size_t>(chunk_size), static_cast<std::size_t>(thread_no)};
+    PhzUITools::ProgressReporter progress{
+        [](const PhzUITools::ProgressReporter::Status& status) {
+          logger.info() << "Processed " << status.step << " / " << status.total << " sources, "
+                        << PhzUITools::ProgressReporter::describe(status);
+        },
+        "sources", args.at(PROGRESS_FILE).as<std::string>()};
+    try {
+      annotator.annotate(input, output, progress);
+    } catch (...) {
+      progress.markFailed();
+      throw;
+    }
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static std::string getMandatory(std::map<std::string, po::variable_value>& args, const std::string& name) {
+    auto value = args.at(name).as<std::string>();
+    if (value.empty()) {
+      throw Elements::Exception() << "Missing " << name;
+    }
+    return value;
+  }
+};
+
+MAIN_FOR(AddGalDustToCatalog)
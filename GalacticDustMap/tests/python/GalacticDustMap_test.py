@@ -114,6 +114,28 @@ class TestGalacticDustMap(object):
         for i in range(len(l_expected)):
             assert abs(abs(l_expected[i]-l[i])/l_expected[i])<0.001, 'Element number '+str(i)+ ' of l do not match' 
             assert abs(abs(b_expected[i]-b[i])/b_expected[i])<0.001, 'Element number '+str(i)+ ' of b do not match' 
+
+    def test_raw_map(self, tmpdir):
+        # GIVEN
+        data = np.arange(12*8*8, dtype=np.float32) * 0.5
+        raw_file = str(tmpdir.join('map.raw'))
+
+        # WHEN
+        GalacticDustMap.writeRawMap(data, raw_file)
+        mapped = GalacticDustMap.loadRawMap(raw_file)
+
+        # THEN
+        assert isinstance(mapped, np.memmap)
+        assert np.array_equal(mapped, data)
+
+    def test_raw_map_invalid(self, tmpdir):
+        # GIVEN
+        raw_file = tmpdir.join('map.raw')
+        raw_file.write('This is not a raw HEALPix map, only some text long enough for a header')
+
+        # THEN
+        with pytest.raises(ValueError):
+            GalacticDustMap.loadRawMap(str(raw_file))
         
  
         
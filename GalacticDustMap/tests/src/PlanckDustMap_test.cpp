@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PlanckDustMap_test.cpp
+ * @date 10/19/26
+ */
+
+#include "GalacticDustMap/PlanckDustMap.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include <CCfits/CCfits>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+using namespace Euclid::GalacticDustMap;
+
+namespace {
+
+// Write the map as Planck does: the first column of the first extension
+void writeFits(const std::string& file_name, const std::vector<float>& values) {
+  CCfits::FITS             fits{"!" + file_name, CCfits::RWmode::Write};
+  std::vector<std::string> names{"EBV"};
+  std::vector<std::string> formats{"E"};
+  std::vector<std::string> units{""};
+
+  auto table = fits.addTable("MAP", static_cast<int>(values.size()), names, formats, units);
+  table->column("EBV").write(values, 1);
+}
+
+std::vector<float> createValues(long nside, float factor) {
+  std::vector<float> values(12 * nside * nside);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = factor * i;
+  }
+  return values;
+}
+
+// A FITS map and a raw copy holding other values
+struct OpenMap_Fixture {
+  Elements::TempDir  m_temp_dir{};
+  std::string        m_fits_file   = (m_temp_dir.path() / "map.fits").string();
+  std::string        m_raw_file    = PlanckDustMap::getRawFile(m_fits_file);
+  std::vector<float> m_fits_values = createValues(4, 0.5f);
+  std::vector<float> m_raw_values  = createValues(4, 2.f);
+
+  OpenMap_Fixture() {
+    writeFits(m_fits_file, m_fits_values);
+    PlanckDustMap{m_raw_values}.writeRaw(m_raw_file);
+  }
+
+  // Make the raw copy older than the FITS file by the given number of seconds
+  void setRawAge(std::time_t seconds) {
+    boost::filesystem::last_write_time(m_raw_file, boost::filesystem::last_write_time(m_fits_file) - seconds);
+  }
+};
+
+void checkValues(const PlanckDustMap& dust_map, const std::vector<float>& values) {
+  BOOST_CHECK_EQUAL_COLLECTIONS(dust_map.data(), dust_map.data() + dust_map.size(), values.begin(), values.end());
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(PlanckDustMap_test)
+
+//-----------------------------------------------------------------------------
+// The expected values are the ones used for the python module, computed by
+// the IDL code both implementations have been ported from.
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ang2pixNest_test) {
+  // GIVEN
+  long                nside = 2048;
+  std::vector<double> theta{0,  180, 20, 40,  60,  80,  90,  110, 130, 150, 170, 20, 40, 60, 80,
+                            90, 110, 130, 150, 170, 20, 40, 60,  80,  90,  110, 130, 150, 170};
+  std::vector<double> phi{0,  0,  30, 30, 30, 30, 30,  30,  30,  30,  30,  90,  90,  90,  90,
+                          90, 90, 90, 90, 90, 360, 360, 360, 360, 360, 360, 360, 360, 360};
+  std::vector<long>   expected{4194303,  33554432, 16440540, 15431481, 33380969, 32600336, 31087209, 29773264,
+                             48920284, 48284168, 46302413, 7990252,  7147573,  6396249,  22912224, 22452569,
+                             41587488, 40296492, 38519304, 37898763, 8072512,  7135286,  6460821,  22987275,
+                             22648213, 21315275, 40487399, 39869553, 37894434};
+
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    // WHEN
+    auto ipix = ang2pixNest(nside, theta[i] * M_PI / 180, phi[i]);
+
+    // THEN
+    BOOST_CHECK_EQUAL(ipix, expected[i]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ang2pixNest_range_test) {
+  BOOST_CHECK_THROW(ang2pixNest(0, 0., 0.), Elements::Exception);
+  BOOST_CHECK_THROW(ang2pixNest(16384, 0., 0.), Elements::Exception);
+  BOOST_CHECK_THROW(ang2pixNest(2048, -0.1, 0.), Elements::Exception);
+  BOOST_CHECK_THROW(ang2pixNest(2048, 4., 0.), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(raDecToLB_test) {
+  // GIVEN
+  std::vector<double> ra{0, 90, 180, 30, 60, 90, 120, 150, 60, 192.84, 266.40};
+  std::vector<double> dec{-90, -60, -30, 0, 10, 20, 30, 60, 90, 27.1283, -28.929};
+  std::vector<double> l_expected{302.92431, 268.82596, 289.85989, 157.01316, 180.42564,        189.35432,
+                                 191.26976, 152.31915, 122.92431, 213.13837, 0.000560166339596};
+  std::vector<double> b_expected{-27.128333, -29.594671, 31.564374, -58.256844, -31.123705,     -1.7214120,
+                                 27.082141,  46.148339,  27.128333, 89.991096,  0.0003419167118};
+
+  for (std::size_t i = 0; i < ra.size(); ++i) {
+    // WHEN
+    auto lb = raDecToLB(ra[i], dec[i]);
+
+    // THEN
+    BOOST_CHECK_CLOSE(lb.first, l_expected[i], 0.1);
+    BOOST_CHECK_CLOSE(lb.second, b_expected[i], 0.1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(getEbv_test) {
+  // GIVEN
+  long               nside = 4;
+  std::vector<float> values(12 * nside * nside);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i);
+  }
+  PlanckDustMap       dust_map{values};
+  std::vector<double> ra{};
+  std::vector<double> dec{};
+  for (int i = 0; i < 10000; ++i) {
+    ra.push_back(i % 360);
+    dec.push_back(i % 180 - 89.5);
+  }
+  ra.push_back(NAN);
+  dec.push_back(0);
+
+  // WHEN
+  auto ebv = dust_map.getEbv(ra, dec, 4);
+
+  // THEN
+  BOOST_CHECK_EQUAL(dust_map.getNside(), nside);
+  BOOST_CHECK_EQUAL(ebv.size(), ra.size());
+  for (std::size_t i = 0; i + 1 < ra.size(); ++i) {
+    auto   lb       = raDecToLB(ra[i], dec[i]);
+    double expected = values[ang2pixNest(nside, (90 - lb.second) * M_PI / 180, lb.first * M_PI / 180)];
+    BOOST_CHECK_EQUAL(ebv[i], expected);
+  }
+  BOOST_CHECK(std::isnan(ebv.back()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(invalid_size_test) {
+  BOOST_CHECK_THROW(PlanckDustMap{std::vector<float>(100)}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(raw_file_test) {
+  // GIVEN
+  Elements::TempDir  temp_dir{};
+  auto               raw_file = (temp_dir.path() / "map.raw").string();
+  std::vector<float> values(12 * 8 * 8);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = 0.5f * i;
+  }
+  PlanckDustMap dust_map{values};
+
+  // WHEN
+  dust_map.writeRaw(raw_file);
+  auto mapped = PlanckDustMap::map(raw_file);
+
+  // THEN
+  BOOST_CHECK(!dust_map.isMapped());
+  BOOST_CHECK(mapped.isMapped());
+  BOOST_CHECK_EQUAL(mapped.getNside(), 8);
+  BOOST_CHECK_EQUAL_COLLECTIONS(mapped.data(), mapped.data() + mapped.size(), values.begin(), values.end());
+  BOOST_CHECK_EQUAL(mapped.getEbv(120., -30.), dust_map.getEbv(120., -30.));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(invalid_raw_file_test) {
+  // GIVEN
+  Elements::TempDir temp_dir{};
+  auto              raw_file = (temp_dir.path() / "map.raw").string();
+  std::ofstream{raw_file} << "This is not a raw HEALPix map, only some text long enough for a header";
+
+  // THEN
+  BOOST_CHECK_THROW(PlanckDustMap::map(raw_file), Elements::Exception);
+  BOOST_CHECK_EQUAL(PlanckDustMap::getRawFile("/aux/GalacticDustMap/PlanckEbv.fits"),
+                    "/aux/GalacticDustMap/PlanckEbv.raw");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(open_missing_raw_test, OpenMap_Fixture) {
+  // GIVEN
+  boost::filesystem::remove(m_raw_file);
+
+  // WHEN
+  auto dust_map = PlanckDustMap::open(m_fits_file);
+
+  // THEN
+  BOOST_CHECK(dust_map.isMapped());
+  checkValues(dust_map, m_fits_values);
+  checkValues(PlanckDustMap::map(m_raw_file), m_fits_values);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(open_up_to_date_raw_test, OpenMap_Fixture) {
+  // GIVEN
+  setRawAge(-10);
+
+  // WHEN
+  auto dust_map = PlanckDustMap::open(m_fits_file);
+
+  // THEN: the FITS file is not read
+  BOOST_CHECK(dust_map.isMapped());
+  checkValues(dust_map, m_raw_values);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(open_stale_raw_test, OpenMap_Fixture) {
+  // GIVEN
+  setRawAge(10);
+
+  // WHEN
+  auto dust_map = PlanckDustMap::open(m_fits_file);
+
+  // THEN: the raw copy is rebuilt from the FITS file
+  BOOST_CHECK(dust_map.isMapped());
+  checkValues(dust_map, m_fits_values);
+  checkValues(PlanckDustMap::map(m_raw_file), m_fits_values);
+  BOOST_CHECK(boost::filesystem::last_write_time(m_raw_file) >= boost::filesystem::last_write_time(m_fits_file));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(open_invalid_raw_test, OpenMap_Fixture) {
+  // GIVEN
+  std::ofstream{m_raw_file} << "This is not a raw HEALPix map, only some text long enough for a header";
+  setRawAge(-10);
+
+  // WHEN
+  auto dust_map = PlanckDustMap::open(m_fits_file);
+
+  // THEN
+  BOOST_CHECK(dust_map.isMapped());
+  checkValues(dust_map, m_fits_values);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
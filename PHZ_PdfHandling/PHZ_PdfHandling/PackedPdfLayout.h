@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PHZ_PdfHandling/PackedPdfLayout.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZ_PDFHANDLING_PACKEDPDFLAYOUT_H
+#define _PHZ_PDFHANDLING_PACKEDPDFLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+/**
+ * @struct PackedPdfLayout
+ *
+ * @brief The layout of a packed PDF file, storing the PDFs of all the sources
+ * of a catalog as fixed width rows, indexed by the source ID.
+ *
+ * @details
+ * All the values are little endian and all the sections are aligned on 8
+ * bytes, so that the file can be memory-mapped and read in place:
+ *  - the 64 bytes header: the 8 characters "PHZPDF1" (NUL terminated), the
+ *    number of sources and the number of PDF samples as 64 bits integers, and
+ *    the name of the PDF parameter (e.g. "Z"), NUL padded to 40 characters
+ *  - the PDF sampling as 64 bits floats
+ *  - the PDFs as 32 bits floats, one row per source in the order the sources
+ *    were written (padded to 8 bytes)
+ *  - the source IDs as 64 bits integers, in the same order
+ *  - the index: the source IDs sorted in increasing order, then the row of
+ *    each of them, as 64 bits integers
+ *
+ * The python module PHZ_PdfHandling.PackedPdf reads and writes the same files.
+ */
+struct PackedPdfLayout {
+  static constexpr char        MAGIC[8]       = {'P', 'H', 'Z', 'P', 'D', 'F', '1', '\0'};
+  static constexpr std::size_t HEADER_SIZE    = 64;
+  static constexpr std::size_t PARAMETER_SIZE = 40;
+
+  PackedPdfLayout(std::size_t source_no, std::size_t bin_no)
+      : sampling{HEADER_SIZE}
+      , pdfs{sampling + bin_no * sizeof(double)}
+      , ids{(pdfs + source_no * bin_no * sizeof(float) + 7) / 8 * 8}
+      , sorted_ids{ids + source_no * sizeof(std::int64_t)}
+      , sorted_rows{sorted_ids + source_no * sizeof(std::int64_t)}
+      , size{sorted_rows + source_no * sizeof(std::uint64_t)} {}
+
+  /// Offsets of the sections and size of the file, in bytes
+  std::size_t sampling, pdfs, ids, sorted_ids, sorted_rows, size;
+};
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
+
+#endif
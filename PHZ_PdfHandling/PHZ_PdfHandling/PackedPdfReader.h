@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PHZ_PdfHandling/PackedPdfReader.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZ_PDFHANDLING_PACKEDPDFREADER_H
+#define _PHZ_PDFHANDLING_PACKEDPDFREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+/**
+ * @class PackedPdfReader
+ *
+ * @brief Read-only access to a packed PDF file (see PackedPdfLayout).
+ *
+ * @details
+ * The file is memory-mapped: the PDF of a source is found by a binary search
+ * of its ID in the index and is read in place, and a sequential scan of all
+ * the rows reads the file in its order. The reader is cheap to copy, the
+ * copies share the mapping.
+ *
+ * The format pays off for the lookup of sources by ID, as done by
+ * PlotSpecZComparison. The tools scanning the whole catalog column in its
+ * order (ProcessPDF, behind DialogPOP, and ComputeStackedPdfPitAndCrps) gain
+ * nothing from it and keep reading the catalog, which is always produced,
+ * while the packed files are only written by PackPdfs.
+ */
+class PackedPdfReader {
+
+public:
+  /**
+   * @brief Map a packed PDF file
+   * @throws Elements::Exception if the file is not a valid packed PDF file
+   */
+  explicit PackedPdfReader(const std::string& file_name);
+
+  /// The name of the PDF parameter
+  const std::string& getParameter() const;
+
+  /// The sampling of the PDFs
+  const std::vector<double>& getSampling() const;
+
+  /// The number of sources
+  std::size_t size() const;
+
+  /// The ID of the source of the given row
+  std::int64_t getId(std::size_t row) const;
+
+  /// The sampling.size() values of the PDF of the given row
+  const float* getPdf(std::size_t row) const;
+
+  /// The row of a source, -1 if the ID is not in the file
+  std::ptrdiff_t findRow(std::int64_t id) const;
+
+  /// The PDF of a source, nullptr if the ID is not in the file
+  const float* findPdf(std::int64_t id) const;
+
+private:
+  class Mapping;
+
+  std::shared_ptr<const Mapping> m_mapping;
+  std::string                    m_parameter;
+  std::vector<double>            m_sampling;
+  std::size_t                    m_source_no;
+  const float*                   m_pdfs;
+  const std::int64_t*            m_ids;
+  const std::int64_t*            m_sorted_ids;
+  const std::uint64_t*           m_sorted_rows;
+};
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
+
+#endif
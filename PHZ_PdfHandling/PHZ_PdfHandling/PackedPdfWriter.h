@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PHZ_PdfHandling/PackedPdfWriter.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZ_PDFHANDLING_PACKEDPDFWRITER_H
+#define _PHZ_PDFHANDLING_PACKEDPDFWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+/**
+ * @class PackedPdfWriter
+ *
+ * @brief Write the PDFs of a catalog into a packed PDF file (see
+ * PackedPdfLayout).
+ *
+ * @details
+ * The PDFs are streamed to the disk as they are added, only their IDs are kept
+ * in memory to build the index when the file is closed. The file is written
+ * under a temporary name and renamed by close(), so that a reader never sees
+ * a partial file. If the writer is destroyed without being closed the
+ * temporary file is removed.
+ */
+class PackedPdfWriter {
+
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param file_name
+   * The packed PDF file, replaced if it exists
+   * @param sampling
+   * The sampling of the PDFs
+   * @param parameter
+   * The name of the PDF parameter (at most 39 characters)
+   */
+  PackedPdfWriter(std::string file_name, std::vector<double> sampling, const std::string& parameter = "");
+
+  ~PackedPdfWriter();
+
+  PackedPdfWriter(const PackedPdfWriter&) = delete;
+  PackedPdfWriter& operator=(const PackedPdfWriter&) = delete;
+
+  /**
+   * @brief Append the PDF of a source, stored as 32 bits floats
+   *
+   * @param id
+   * The source ID
+   * @param pdf
+   * The sampling.size() PDF values
+   */
+  void addPdf(std::int64_t id, const double* pdf);
+
+  /// @overload
+  void addPdf(std::int64_t id, const float* pdf);
+
+  /**
+   * @brief Write the index and publish the file
+   *
+   * @throws Elements::Exception
+   * If a source ID has been added twice or if the file cannot be written
+   */
+  void close();
+
+private:
+  std::string               m_file_name;
+  std::string               m_tmp_file_name;
+  std::size_t               m_bin_no;
+  std::ofstream             m_out;
+  std::vector<std::int64_t> m_ids{};
+  std::vector<float>        m_row{};
+  bool                      m_closed = false;
+};
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PHZ_PdfHandling/PdfKernels.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZ_PDFHANDLING_PDFKERNELS_H
+#define _PHZ_PDFHANDLING_PDFKERNELS_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+/**
+ * @brief Integrate the samples with the composite Simpson rule for irregular
+ * spacing. With an even number of samples the result is the average of the two
+ * possible Simpson + trapezoid combinations (like scipy.integrate.simps).
+ */
+double simpson(const double* x, const double* y, std::size_t size);
+
+/**
+ * @brief Compute the integrals of all the prefixes of the samples with the same
+ * rule as simpson, in linear time: out[i] is the integral from x[0] to x[i].
+ */
+void cumulativeSimpson(const double* x, const double* y, std::size_t size, double* out);
+
+/**
+ * @brief Compute the Probability Integral Transform (the value of the
+ * cumulative distribution at the reference value) and the Continuous Ranked
+ * Probability Score of a PDF.
+ *
+ * @param bins
+ * The sampling of the PDF
+ * @param pdf
+ * The PDF values (not necessarily normalized)
+ * @param reference
+ * The reference ("true") value
+ * @param workspace
+ * A buffer reused between calls to avoid allocations
+ *
+ * @return the PIT and the CRPS, NaN if the PDF cannot be normalized
+ */
+std::pair<double, double> computePitAndCrps(const std::vector<double>& bins, const double* pdf, double reference,
+                                            std::vector<double>& workspace);
+
+/// The point estimates of a PDF
+enum class PointEstimateType { MODE, MEAN, MEDIAN, FITTED_MODE };
+
+/**
+ * @brief Get the sample for which the PDF is the highest (the first one in
+ * case of ties)
+ */
+double computeMode(const std::vector<double>& bins, const double* pdf);
+
+/**
+ * @brief Get the mean of the PDF, integrated with the Simpson rule
+ */
+double computeMean(const std::vector<double>& bins, const double* pdf, std::vector<double>& workspace);
+
+/**
+ * @brief Get the median of the PDF, linearly interpolated on the cumulative
+ * sum of the samples
+ */
+double computeMedian(const std::vector<double>& bins, const double* pdf, std::vector<double>& workspace);
+
+/**
+ * @brief Get the top of the parabola fitted (least squares) around the mode of
+ * the PDF, or the mode if the parabola cannot be fitted or is not concave.
+ *
+ * @param threshold
+ * The parabola is fitted on the samples around the mode above this fraction of
+ * the mode value: 1 selects the mode only, 0 all the samples
+ */
+double computeFittedMode(const std::vector<double>& bins, const double* pdf, double threshold);
+
+/**
+ * @brief Compute a point estimate for a set of PDFs on a pool of threads
+ *
+ * @param pdfs
+ * The source_no x bins.size() PDF values, row major
+ * @param out
+ * The source_no point estimates
+ * @param thread_number
+ * The number of threads, 0 meaning all the cores
+ * @param threshold
+ * The threshold of computeFittedMode
+ */
+void computePointEstimates(PointEstimateType type, const std::vector<double>& bins, const double* pdfs,
+                           std::size_t source_no, double* out, std::size_t thread_number = 0,
+                           double threshold = 0.7);
+
+/**
+ * @brief Compute the PIT and the CRPS (see computePitAndCrps) of a set of PDFs
+ * on a pool of threads
+ *
+ * @param pdfs
+ * The source_no x bins.size() PDF values, row major
+ * @param references
+ * The source_no reference values
+ * @param pits, crps
+ * The source_no PIT and CRPS values
+ * @param thread_number
+ * The number of threads, 0 meaning all the cores
+ */
+void computePitsAndCrps(const std::vector<double>& bins, const double* pdfs, const double* references,
+                        std::size_t source_no, double* pits, double* crps, std::size_t thread_number = 0);
+
+/**
+ * @brief Get the index of the stacking bin of a value, the bin i covering
+ * (edges[i], edges[i+1]], or -1 if the value is outside the edges.
+ */
+int findStackBin(const std::vector<double>& edges, double value);
+
+/**
+ * @brief Get the sampling of the shifted PDFs (PDF sampling minus reference
+ * value): the symmetric of the PDF sampling, zero and the PDF sampling.
+ */
+std::vector<double> getShiftedBins(const std::vector<double>& bins);
+
+/**
+ * @brief Read the sampling of a PDF column from the comments of the first
+ * extension of a PHZ catalog, the likelihood sampling being used for the
+ * columns whose name contains LIKELIHOOD.
+ * @throw Elements::Exception if the sampling is not found
+ */
+std::vector<double> readPdfSampling(const std::string& catalog_file, const std::string& pdf_column);
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PHZ_PdfHandling/PdfValidationStatistics.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZ_PDFHANDLING_PDFVALIDATIONSTATISTICS_H
+#define _PHZ_PDFHANDLING_PDFVALIDATIONSTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+/**
+ * @class PdfValidationStatistics
+ *
+ * @brief Accumulate the statistics used for validating the PDFs of a catalog
+ * against reference values.
+ *
+ * @details
+ * The sources are added by chunks, so that a catalog of any size can be
+ * streamed. For each source are computed:
+ *  - its PDF normalized to a unit sum, stacked in the bin of its reference
+ *    value (the reference stack);
+ *  - its PDF shifted by the reference value, stacked in the bin of its point
+ *    estimate (the shifted stack);
+ *  - its PIT and CRPS.
+ *
+ * Only the stacks (of size PDF sampling x stack bins) and the PIT and CRPS
+ * values (as floats) are kept in memory.
+ */
+class PdfValidationStatistics {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param pdf_bins
+   * The sampling of the PDFs
+   * @param stack_edges
+   * The edges of the stacking bins, in increasing order
+   */
+  PdfValidationStatistics(std::vector<double> pdf_bins, std::vector<double> stack_edges);
+
+  /**
+   * @brief Get the edges of the stacking bins used by the validation plots:
+   * stack_bins + 1 regularly spaced edges from the first to the last PDF node.
+   * The Python implementation used (last + first) as the span, which only
+   * agrees for samplings starting at 0.
+   */
+  static std::vector<double> computeStackEdges(const std::vector<double>& pdf_bins, std::size_t stack_bins);
+
+  /**
+   * @brief Add a chunk of sources.
+   *
+   * @param pdfs
+   * The PDFs of the sources, one row of size getPdfBins().size() per source
+   * @param point_estimates
+   * The point estimates of the sources
+   * @param reference_values
+   * The reference values of the sources
+   * @param thread_number
+   * The number of threads to use, 0 for the number of cores
+   * @throw Elements::Exception if the sizes are inconsistent
+   */
+  void addSources(const std::vector<double>& pdfs, const std::vector<double>& point_estimates,
+                  const std::vector<double>& reference_values, std::size_t thread_number = 0);
+
+  const std::vector<double>& getPdfBins() const {
+    return m_pdf_bins;
+  }
+
+  const std::vector<double>& getStackEdges() const {
+    return m_stack_edges;
+  }
+
+  const std::vector<double>& getShiftedBins() const {
+    return m_shifted_bins;
+  }
+
+  /// The reference stack, row major [PDF node][stack bin]
+  const std::vector<double>& getReferenceStack() const {
+    return m_reference_stack;
+  }
+
+  /// The shifted stack, row major [shifted node][stack bin]
+  const std::vector<double>& getShiftedStack() const {
+    return m_shifted_stack;
+  }
+
+  /// The PIT of the sources, in the order they have been added (NaN if undefined)
+  const std::vector<float>& getPits() const {
+    return m_pits;
+  }
+
+  /// The CRPS of the sources, in the order they have been added (NaN if undefined)
+  const std::vector<float>& getCrps() const {
+    return m_crps;
+  }
+
+  std::size_t getSourceNumber() const {
+    return m_pits.size();
+  }
+
+  /**
+   * @brief Build the histogram of the finite values in [min, max], the max
+   * value being counted in the last bin.
+   */
+  static std::vector<std::int64_t> computeHistogram(const std::vector<float>& values, double min, double max,
+                                                    std::size_t bins);
+
+  /**
+   * @brief Write the summary FITS file read by the plotting script, made of
+   * the tables SAMPLING (the PDF and shifted sampling), STACKS (the two
+   * stacks, one row per stack bin), PIT_HIST and CRPS_HIST.
+   *
+   * @param file_name
+   * The output file, overwritten if it exists
+   * @param hist_bins
+   * The number of bins of the PIT and CRPS histograms
+   */
+  void writeSummary(const std::string& file_name, std::size_t hist_bins) const;
+
+private:
+  std::vector<double> m_pdf_bins;
+  std::vector<double> m_stack_edges;
+  std::vector<double> m_shifted_bins;
+  std::vector<double> m_reference_stack;
+  std::vector<double> m_shifted_stack;
+  std::vector<float>  m_pits{};
+  std::vector<float>  m_crps{};
+};
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,136 @@
+#
+# Copyright (C) 2012-2020 Euclid Science Ground Segment
+#
+# This library is free software; you can redistribute it and/or modify it under
+# the terms of the GNU Lesser General Public License as published by the Free
+# Software Foundation; either version 3.0 of the License, or (at your option)
+# any later version.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+# details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this library; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+#
+
+"""
+File: python/PHZ_PdfHandling/PackedPdf.py
+
+Created on: 10/19/26
+
+Reader and writer of the packed PDF files, which store the PDFs of all the
+sources of a catalog as fixed width rows indexed by the source ID. The layout
+is the one of the C++ PHZ_PdfHandling/PackedPdfLayout.h: a 64 bytes header
+(magic, number of sources and of samples as little endian uint64, parameter
+name), the sampling as float64, the PDFs as float32 (padded to 8 bytes), the
+IDs as int64, then the sorted IDs and their rows as int64 / uint64.
+"""
+
+import os
+
+import numpy as np
+
+_MAGIC = b'PHZPDF1\x00'
+_HEADER_SIZE = 64
+_PARAMETER_SIZE = 40
+
+
+def _layout(source_no, bin_no):
+    sampling = _HEADER_SIZE
+    pdfs = sampling + 8 * bin_no
+    ids = (pdfs + 4 * source_no * bin_no + 7) // 8 * 8
+    sorted_ids = ids + 8 * source_no
+    sorted_rows = sorted_ids + 8 * source_no
+    return sampling, pdfs, ids, sorted_ids, sorted_rows, sorted_rows + 8 * source_no
+
+
+class PackedPdfReader(object):
+    """
+    Memory-mapped read-only access to a packed PDF file. The pdfs attribute
+    is a (sources x samples) float32 matrix read in place, so that a
+    sequential scan or the lookup of a few sources only reads the pages they
+    need.
+    """
+
+    def __init__(self, filename):
+        header = np.fromfile(filename, dtype=np.uint8, count=_HEADER_SIZE)
+        if len(header) != _HEADER_SIZE or header[:8].tobytes() != _MAGIC:
+            raise ValueError('%s is not a packed PDF file' % filename)
+        source_no, bin_no = (int(v) for v in header[8:24].view('<u8'))
+        offsets = _layout(source_no, bin_no)
+        if bin_no == 0 or os.path.getsize(filename) != offsets[5]:
+            raise ValueError('%s is not a valid packed PDF file' % filename)
+
+        self.parameter = header[24:].tobytes().split(b'\x00')[0].decode('ascii')
+        self.sampling = np.fromfile(filename, dtype='<f8', count=bin_no, offset=offsets[0])
+        if source_no == 0:
+            self.pdfs = np.zeros((0, bin_no), dtype='<f4')
+            self.ids = self._sorted_ids = np.zeros(0, dtype='<i8')
+            self._sorted_rows = np.zeros(0, dtype='<u8')
+            return
+        self.pdfs = np.memmap(filename, dtype='<f4', mode='r', offset=offsets[1], shape=(source_no, bin_no))
+        self.ids = np.memmap(filename, dtype='<i8', mode='r', offset=offsets[2], shape=(source_no,))
+        self._sorted_ids = np.memmap(filename, dtype='<i8', mode='r', offset=offsets[3], shape=(source_no,))
+        self._sorted_rows = np.memmap(filename, dtype='<u8', mode='r', offset=offsets[4], shape=(source_no,))
+
+    def __len__(self):
+        return len(self.ids)
+
+    def findRows(self, ids):
+        """
+        Get the rows of the given source IDs, -1 for the IDs not in the file
+        """
+        ids = np.asarray(ids, dtype=np.int64)
+        rows = np.full(ids.shape, -1, dtype=np.int64)
+        if len(self) == 0:
+            return rows
+        positions = np.minimum(np.searchsorted(self._sorted_ids, ids), len(self) - 1)
+        found = self._sorted_ids[positions] == ids
+        rows[found] = self._sorted_rows[positions[found]]
+        return rows
+
+    def pdf(self, source_id):
+        """
+        Get the PDF of a source, None if its ID is not in the file
+        """
+        row = self.findRows([source_id])[0]
+        return None if row < 0 else self.pdfs[row]
+
+
+def writePackedPdf(filename, ids, sampling, pdfs, parameter=''):
+    """
+    Write a packed PDF file, pdfs being a (sources x samples) matrix
+    """
+    ids = np.asarray(ids, dtype='<i8')
+    sampling = np.asarray(sampling, dtype='<f8')
+    pdfs = np.asarray(pdfs, dtype='<f4').reshape(len(ids), len(sampling))
+    if len(sampling) == 0:
+        raise ValueError('The PDF sampling is empty')
+    parameter = parameter.encode('ascii')
+    if len(parameter) >= _PARAMETER_SIZE:
+        raise ValueError('The PDF parameter name %s is too long' % parameter)
+    sorted_rows = np.argsort(ids, kind='stable').astype('<u8')
+    sorted_ids = ids[sorted_rows]
+    if np.any(sorted_ids[1:] == sorted_ids[:-1]):
+        raise ValueError('The source IDs are not unique')
+
+    offsets = _layout(len(ids), len(sampling))
+    header = bytearray(_HEADER_SIZE)
+    header[:8] = _MAGIC
+    header[8:24] = np.array([len(ids), len(sampling)], dtype='<u8').tobytes()
+    header[24:24 + len(parameter)] = parameter
+    # Write a temporary file then rename it, so that the concurrent readers
+    # never map a partial file
+    tmp_filename = '%s.%d.tmp' % (filename, os.getpid())
+    with open(tmp_filename, 'wb') as out:
+        out.write(bytes(header))
+        out.write(sampling.tobytes())
+        out.write(pdfs.tobytes())
+        out.write(bytes(offsets[2] - offsets[1] - pdfs.nbytes))
+        out.write(ids.tobytes())
+        out.write(sorted_ids.tobytes())
+        out.write(sorted_rows.tobytes())
+    os.replace(tmp_filename, filename)
@@ -5,8 +5,8 @@ Guillaume Desprez - 2019 - (guillaume.desprez@unige.ch)
 Script to plot PDZ versus spec-z
 """
 import numpy as np
-import scipy.integrate as integrate
-from scipy.optimize import curve_fit
+
+import _PdfKernels
 
 
 import matplotlib.pyplot as plt
@@ -27,7 +27,7 @@ def getMaxSamplingPointEstimate(pdf_bins, pdf_data):
     array: list of value of the sampling for wich the object's 1D-PDF has the higgest value
     
     """
-    return np.array([pdf_bins[np.argmax(pdf)] for pdf in pdf_data])
+    return _PdfKernels.computeMode(pdf_bins, pdf_data)
     
 def getMeanPointEstimate(pdf_bins, pdf_data):
     """For each  object, return the mean value of the 1D-PDF
@@ -42,7 +42,7 @@ def getMeanPointEstimate(pdf_bins, pdf_data):
     array: list of mean value (in the sampling axis) of the object's 1D-PDF
     
     """
-    return integrate.simps(np.multiply(pdf_bins,pdf_data), pdf_bins)/integrate.simps(pdf_data,  pdf_bins)
+    return _PdfKernels.computeMean(pdf_bins, pdf_data)
     
 def getMedianPointEstimate(pdf_bins, pdf_data):
     """For each  object, return the median value of the 1D-PDF
@@ -57,13 +57,8 @@ def getMedianPointEstimate(pdf_bins, pdf_data):
     array: list of median value (in the sampling axis) of the object's 1D-PDF
     
     """
-    cumul = np.cumsum(pdf_data, axis=1)
-    half = np.sum(pdf_data, axis=1)*0.5
-    return np.array([np.interp(half[index],cumul[index,:],pdf_bins) for index in range(len(pdf_data))])  
+    return _PdfKernels.computeMedian(pdf_bins, pdf_data)
     
-def quad(x, a, b, c):
-    return a*x**2 + b*x + c
-
 def getFitModeEstimate(pdf_bins, pdf_data, threshold = 0.7):
     """For each  object, fit a parabola around the highest value of the 1D-PDF and retrun the hoggest point of the curve
     
@@ -78,23 +73,7 @@ def getFitModeEstimate(pdf_bins, pdf_data, threshold = 0.7):
     array: list of center of the fitted parabola 
     
     """
-    values = [pdf_bins[np.argmax(pdf)] for pdf in pdf_data]
-    for index in range(len(pdf_data)):
-        id_center = np.argwhere(pdf_bins==values[index])[0][0]
-        id_min = id_center
-        treshold_value = threshold*pdf_data[index][id_center]  
-        while id_min>0 and pdf_data[index][id_min]>treshold_value:
-            id_min = id_min - 1
-        id_max = id_center
-        while id_max<len(pdf_bins)-1 and pdf_data[index][id_max]>treshold_value:
-            id_max = id_max + 1
-
-        if id_max - id_min > 2:
-            fit = curve_fit(quad, pdf_bins[id_min:id_max], pdf_data[index][id_min:id_max])
-            if (fit[0][0]<0):
-                values[index] = -fit[0][1]/(2*fit[0][0])   
-
-    return np.array(values)
+    return _PdfKernels.computeFittedMode(pdf_bins, pdf_data, threshold)
         
 # Stacked PDF 
 
@@ -206,27 +185,14 @@ def computePitAndCrps(pdf_data, pdf_bins, reference_values, progress_callback=No
     total = len(reference_values)
     pits = np.zeros(total)
     crps = np.zeros(total)
-    for index, ref_value in enumerate(reference_values):
-        current_bin = np.array(pdf_bins)
-        current_data = np.array(pdf_data[index])
-        current_cumul_data =  [integrate.simps(pdf_data[index][:i], pdf_bins[:i]) if i>0 else 0 for i in range(len(pdf_bins))] / integrate.simps(pdf_data[index], pdf_bins)
-        if not ref_value in current_bin:
-            current_bin = np.concatenate((current_bin,[ref_value]))
-            current_bin.sort()
-            current_data = np.interp(current_bin, pdf_bins, current_data)
-            current_cumul_data = np.interp(current_bin, pdf_bins, current_cumul_data)
-        current_data = current_data / integrate.simps(current_data, current_bin)
-        index_cut = np.argwhere(current_bin==ref_value)[0][0]
-        if index_cut > 0:
-            pits[index] = integrate.simps(current_data[:index_cut], current_bin[:index_cut]) 
-            if index_cut < len(current_bin)-1:
-                crps[index] = integrate.simps(np.square(current_cumul_data[:index_cut]), current_bin[:index_cut]) + integrate.simps(np.square(current_cumul_data[index_cut:] -1), current_bin[index_cut:])
-            else:
-                crps[index] = integrate.simps(np.square(current_cumul_data), current_bin) 
-        else:
-            crps[index] =  integrate.simps(np.square(current_cumul_data -1), current_bin)
+    # Processed by chunks, only to report the progress
+    chunk = total if progress_callback is None else max(1, total // 100)
+    for first in range(0, total, chunk):
+        last = min(first + chunk, total)
+        pits[first:last], crps[first:last] = _PdfKernels.computePitAndCrps(
+            pdf_bins, pdf_data[first:last], reference_values[first:last])
         if progress_callback is not None:
-            progress_callback(index,total)
+            progress_callback(last - 1, total)
     return pits, crps    
     
 # Nuber of sources per bin
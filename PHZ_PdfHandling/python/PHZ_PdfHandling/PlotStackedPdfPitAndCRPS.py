@@ -5,9 +5,11 @@ from ElementsKernel.Program import str_to_bool
 from ElementsKernel import Exit
 
 import numpy as np
+import os
+import subprocess
+import tempfile
 
 from astropy.io import fits
-import re
 from astropy import table
 
 import matplotlib.pyplot as plt
@@ -54,46 +56,63 @@ def defineSpecificProgramOptions():
     
     parser.add_argument('--pit-plot', type=str, default='True', help='Display the pit plot (computation of PIT and CRPS may ) (default "True")')
     parser.add_argument('--crps-plot', type=str, default='True', help='Display the crps plot (computation of PIT and CRPS may ) (default "True")')
+
+    parser.add_argument('--summary-file', type=str, default='', help='Summary file computed by ComputeStackedPdfPitAndCrps. If the pdz-catalog-file is provided it is (re)computed and kept, otherwise it is only plotted')
+    parser.add_argument('--chunk-size', type=int, default=10000, help='Number of rows of the catalogs processed at once')
+    parser.add_argument('--thread-no', type=int, default=0, help='Number of threads used for the computation (0 for all the cores)')
     
     return parser
  
-def getFitsComment(file_path):
-    hdul = fits.open(file_path)    
-    comment =  str(hdul[1].header['COMMENT'])
+def computeSummary(args, summary_file):
+    """
+    @brief Stream the catalogs through the ComputeStackedPdfPitAndCrps program,
+    which writes the stacked PDFs and the PIT and CRPS histograms into the summary file
+    """
+    command = ['ComputeStackedPdfPitAndCrps',
+               '--pdz-catalog-file', args.pdz_catalog_file,
+               '--refz-catalog-file', args.refz_catalog_file,
+               '--pdz-col-pdf', args.pdz_col_pdf,
+               '--pdz-col-pe', args.pdz_col_pe,
+               '--pe-catalog-file', args.pe_catalog_file,
+               '--refz-col-ref', args.refz_col_ref,
+               '--stack-bins', str(args.stack_bins),
+               '--hist-bins', str(args.hist_bins),
+               '--summary-file', summary_file,
+               '--chunk-size', str(args.chunk_size),
+               '--thread-no', str(args.thread_no)]
+    if subprocess.call(command) != 0:
+        raise Exception('The computation of the stacked PDF, PIT and CRPS has failed.')
+
+
+def readSummary(summary_file):
+    """
+    @brief Read the summary file
+    @return the PDZ sampling, the shifted sampling, the stack bins, the reference and
+    shifted stacks ([sampling, stack bin] arrays) and the PIT and CRPS histograms tables
+    """
+    hdul = fits.open(summary_file)
+    sampling = table.Table(hdul['SAMPLING'].data)
+    stacks = table.Table(hdul['STACKS'].data)
+    pit_hist = table.Table(hdul['PIT_HIST'].data)
+    crps_hist = table.Table(hdul['CRPS_HIST'].data)
+    hdul.close()
+
+    stack_bins = np.append(stacks['BIN_MIN'], stacks['BIN_MAX'][-1])
+    ref_map = np.array(stacks['REF_STACK']).T
+    shift_map = np.array(stacks['SHIFT_STACK']).T
+    return (np.array(sampling['PDZ_BINS'][0]), np.array(sampling['SHIFT_BINS'][0]), stack_bins,
+            ref_map, shift_map, pit_hist, crps_hist)
+
+
+def plotHistogram(hist, title, **kwargs):
+    """
+    @brief Plot a normalized histogram precomputed by ComputeStackedPdfPitAndCrps
+    """
+    plt.title(title)
+    edges = np.append(hist['BIN_MIN'], hist['BIN_MAX'][-1])
+    centers = 0.5 * (hist['BIN_MIN'] + hist['BIN_MAX'])
+    plt.hist(centers, bins=edges, weights=hist['COUNT'], density=True, **kwargs)
 
-    hdul.close();
-    return comment
- 
-def readPdzSampling(comment):
-    reg = "Z-BINS:\{[\d,.Ee-]+"
-    if "LIKELIHOOD-Z-BINS" in comment:
-        reg = "LIKELIHOOD-"+reg
-    data = re.findall(reg,comment.replace('\n','').replace(' ',''))
-    if len(data)!=1:
-        raise Exception('Unable to find sampling in the file.')
-    nodes = data[0].replace('\n','').replace(' ','').split('{')[1].split(',')
-    pdz_bins = [float(z) for z in nodes]
-    return pdz_bins
-
-
-def readTable(file_path, columns, index =1):
-    hdul = fits.open(file_path) 
-    checkColumns(hdul[index], columns)
-    data = table.Table(hdul[index].data)
-    return data  
-  
-def checkColumns(hdu, columns):
-    for col in columns:
-        if col not in hdu.columns.names:
-           raise Exception('The Column '+col+' is missing in the fits file.') 
-
-def progressCallback(value,total):
-    ten = int(total/20)
-    if value%ten==0:
-        logger = Logging.getLogger('PlotStackedPdfPitAndCrps')
-        logger.info('Computing PIT & CRPS:'+str(int(100*value/total))+"%")
-        
-            
 
 def mainMethod(args):
     """
@@ -107,54 +126,22 @@ def mainMethod(args):
     logger = Logging.getLogger('PlotStackedPdfPitAndCrps')
     logger.info('Entering PlotStackedPdfPitAndCrps mainMethod()')
     
-    columns_in_pdz = [args.pdz_col_id, args.pdz_col_pdf]
-    # Get the PDZ sampling
-    pdz_bins = np.array(readPdzSampling(getFitsComment(args.pdz_catalog_file))) 
-    nb_bin = args.stack_bins
-    stack_bins= [ pdz_bins[0] + (pdz_bins[-1]+pdz_bins[0])/(1.0*nb_bin)*index for index in range(nb_bin+1)]
+    summary_file = args.summary_file
+    if len(args.pdz_catalog_file) > 0:
+        if len(summary_file) == 0:
+            handle, summary_file = tempfile.mkstemp(suffix='.fits')
+            os.close(handle)
+        logger.info('Computing the stacked PDF, PIT and CRPS of ' + args.pdz_catalog_file)
+        computeSummary(args, summary_file)
+    elif len(summary_file) == 0:
+        raise Exception('Either the pdz-catalog-file or the summary-file must be provided.')
+
+    logger.info('Read the summary file ' + summary_file)
+    pdz_bins, bins, stack_bins, ref_map, shift_map, pit_hist, crps_hist = readSummary(summary_file)
+    if summary_file != args.summary_file:
+        os.remove(summary_file)
     logger.info('Bins borders for the stacking of the PDF :' + str(stack_bins))
 
-    # get the pdf data
-    logger.info('Read PDZ from column:' + args.pdz_col_pdf + ' of file '+args.pdz_catalog_file)
-    data = readTable(args.pdz_catalog_file, columns_in_pdz)
-    pdf_data = data[:][args.pdz_col_pdf]
-    
-    # get the point estimate data
-    if len(args.pe_catalog_file) > 0 and args.pe_catalog_file != args.pdz_catalog_file:
-        logger.info('Read Point Estimate from column:' + args.pdz_col_pe + ' of file:'+args.pe_catalog_file)
-        data_pe = readTable(args.pe_catalog_file, [args.pe_catalog_id,args.pdz_col_pe])
-        point_estimates = data_pe[:][args.pdz_col_pe]
-    else:
-        logger.info('Read Point Estimate from column:' + args.pdz_col_pe + ' of file:'+args.pdz_catalog_file)
-        if  not args.pdz_col_pe in data.colnames:
-            raise Exception('The Column '+args.pdz_col_pe+' is missing in the fits file.') 
-        point_estimates = data[:][args.pdz_col_pe]
-    
-    if len(args.refz_catalog_file)==0 or args.refz_catalog_file == args.pdz_catalog_file:
-        logger.info('Read Reference Redshift from column:' + args.refz_col_ref + ' of file:'+args.pdz_catalog_file)
-        if  not args.refz_col_ref in data.colnames:
-            raise Exception('The Column '+args.refz_col_ref+' is missing in the fits file.') 
-        reference_values = data[:][args.refz_col_ref]
-    else:
-        logger.info('Read Reference Redshift from column:' + args.refz_col_ref + ' of file:'+args.refz_catalog_file)
-        column_in_refz = [args.refz_col_id, args.refz_col_ref]
-        data_ref = readTable(args.refz_catalog_file, column_in_refz)
-        reference_values = data_ref[:][args.refz_col_ref]
-    
-    
-        
-    if args.ref_plot.upper()=="TRUE" or args.ref_bin_plot.upper()=="TRUE" or args.ref_bias_plot.upper()=="TRUE" or args.ref_frac_plot.upper()=="TRUE":
-        logger.info('Computing the reference map')  
-        ref_map = PHZ_PdfHandling.PdfPlot.stackPdfFromBinInRef(pdf_data, reference_values, stack_bins)
-        
-    if args.shift_plot.upper()=="TRUE" or args.shift_bin_plot.upper()=="TRUE" or args.shift_bias_plot.upper()=="TRUE" or args.shift_frac_plot.upper()=="TRUE":
-        logger.info('Computing the shift map')  
-        shift_map,bins = PHZ_PdfHandling.PdfPlot.stackedShiftedPdf(pdf_data, pdz_bins, point_estimates, reference_values, stack_bins)
-        
-    if args.pit_plot.upper()=="TRUE" or args.crps_plot.upper()=="TRUE": 
-        pits, crps  = PHZ_PdfHandling.PdfPlot.computePitAndCrps(pdf_data, pdz_bins, point_estimates, progressCallback)
-      
-    
     stacked_pe_type = "mean" 
     if args.stacked_point_estimate.upper() in ["MAX", "FIT", "MEAN", "MED"]:
         stacked_pe_type = args.stacked_point_estimate.lower()
@@ -209,11 +196,12 @@ def mainMethod(args):
         
     if args.pit_plot.upper()=="TRUE":
         f = plt.figure(9)   
-        PHZ_PdfHandling.PdfPlot.plotPIT(pits, histo_bins=args.hist_bins)
+        plotHistogram(pit_hist, "PDF's PIT")
+        plt.plot([0, 1], [1, 1])
         f.show()
     if args.crps_plot.upper()=="TRUE":
         f = plt.figure(10)   
-        PHZ_PdfHandling.PdfPlot.plotCRPS(crps, histo_bins=args.hist_bins)
+        plotHistogram(crps_hist, "PDF's CRPS")
         f.show()
     plt.show()
     return Exit.Code["OK"]
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/_PdfKernels.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace Euclid::PHZ_PdfHandling;
+namespace py = pybind11;
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> DoubleArray;
+
+namespace {
+
+std::vector<double> toVector(const DoubleArray& array) {
+  if (array.ndim() != 1) {
+    throw Elements::Exception() << "The PDF sampling must be a 1D array";
+  }
+  return std::vector<double>(array.data(), array.data() + array.size());
+}
+
+// The number of PDFs, checking their sampling
+std::size_t checkPdfs(const std::vector<double>& bins, const DoubleArray& pdfs) {
+  if (bins.empty()) {
+    throw Elements::Exception() << "The PDF sampling is empty";
+  }
+  if (pdfs.ndim() != 2 || static_cast<std::size_t>(pdfs.shape(1)) != bins.size()) {
+    throw Elements::Exception() << "The PDFs must be a 2D array of " << bins.size() << " columns";
+  }
+  return static_cast<std::size_t>(pdfs.shape(0));
+}
+
+py::array_t<double> pointEstimates(PointEstimateType type, const DoubleArray& pdf_bins, const DoubleArray& pdfs,
+                                   std::size_t thread_no, double threshold) {
+  auto                bins      = toVector(pdf_bins);
+  auto                source_no = checkPdfs(bins, pdfs);
+  py::array_t<double> result(static_cast<py::ssize_t>(source_no));
+  const double*       in  = pdfs.data();
+  double*             out = result.mutable_data();
+  {
+    py::gil_scoped_release release{};
+    computePointEstimates(type, bins, in, source_no, out, thread_no, threshold);
+  }
+  return result;
+}
+
+py::array_t<double> mode(const DoubleArray& pdf_bins, const DoubleArray& pdfs, std::size_t thread_no) {
+  return pointEstimates(PointEstimateType::MODE, pdf_bins, pdfs, thread_no, 0.);
+}
+
+py::array_t<double> mean(const DoubleArray& pdf_bins, const DoubleArray& pdfs, std::size_t thread_no) {
+  return pointEstimates(PointEstimateType::MEAN, pdf_bins, pdfs, thread_no, 0.);
+}
+
+py::array_t<double> median(const DoubleArray& pdf_bins, const DoubleArray& pdfs, std::size_t thread_no) {
+  return pointEstimates(PointEstimateType::MEDIAN, pdf_bins, pdfs, thread_no, 0.);
+}
+
+py::array_t<double> fittedMode(const DoubleArray& pdf_bins, const DoubleArray& pdfs, double threshold,
+                               std::size_t thread_no) {
+  return pointEstimates(PointEstimateType::FITTED_MODE, pdf_bins, pdfs, thread_no, threshold);
+}
+
+std::tuple<py::array_t<double>, py::array_t<double>> pitAndCrps(const DoubleArray& pdf_bins, const DoubleArray& pdfs,
+                                                                const DoubleArray& references, std::size_t thread_no) {
+  auto bins      = toVector(pdf_bins);
+  auto source_no = checkPdfs(bins, pdfs);
+  if (references.ndim() != 1 || static_cast<std::size_t>(references.size()) != source_no) {
+    throw Elements::Exception() << "Expected " << source_no << " reference values";
+  }
+  py::array_t<double> pits(static_cast<py::ssize_t>(source_no));
+  py::array_t<double> crps(static_cast<py::ssize_t>(source_no));
+  const double*       in       = pdfs.data();
+  const double*       ref      = references.data();
+  double*             pits_out = pits.mutable_data();
+  double*             crps_out = crps.mutable_data();
+  {
+    py::gil_scoped_release release{};
+    computePitsAndCrps(bins, in, ref, source_no, pits_out, crps_out, thread_no);
+  }
+  return std::make_tuple(pits, crps);
+}
+
+}  // namespace
+
+PYBIND11_MODULE(_PdfKernels, m) {
+  m.doc() = "Point estimates, PIT and CRPS of a matrix of PDFs (one PDF per row), computed on a pool of threads";
+
+  m.def("computeMode", &mode, "The sample of the highest value of each PDF", py::arg("pdf_bins"), py::arg("pdfs"),
+        py::arg("thread_no") = 0);
+  m.def("computeMean", &mean, "The mean of each PDF", py::arg("pdf_bins"), py::arg("pdfs"), py::arg("thread_no") = 0);
+  m.def("computeMedian", &median, "The median of each PDF", py::arg("pdf_bins"), py::arg("pdfs"),
+        py::arg("thread_no") = 0);
+  m.def("computeFittedMode", &fittedMode, "The top of the parabola fitted around the mode of each PDF",
+        py::arg("pdf_bins"), py::arg("pdfs"), py::arg("threshold") = 0.7, py::arg("thread_no") = 0);
+  m.def("computePitAndCrps", &pitAndCrps, "The PIT and the CRPS of each PDF for its reference value",
+        py::arg("pdf_bins"), py::arg("pdfs"), py::arg("reference_values"), py::arg("thread_no") = 0);
+}
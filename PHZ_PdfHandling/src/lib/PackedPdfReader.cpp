@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PackedPdfReader.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PackedPdfReader.h"
+#include "ElementsKernel/Exception.h"
+#include "PHZ_PdfHandling/PackedPdfLayout.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+constexpr char        PackedPdfLayout::MAGIC[8];
+constexpr std::size_t PackedPdfLayout::HEADER_SIZE;
+constexpr std::size_t PackedPdfLayout::PARAMETER_SIZE;
+
+// Read-only mapping of a whole file, unmapped when the last reader using it is destroyed
+class PackedPdfReader::Mapping {
+public:
+  explicit Mapping(const std::string& file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw Elements::Exception() << "Unable to open the packed PDF file " << file_name;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(PackedPdfLayout::HEADER_SIZE)) {
+      ::close(fd);
+      throw Elements::Exception() << file_name << " is not a packed PDF file";
+    }
+    m_size    = static_cast<std::size_t>(status.st_size);
+    m_address = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_address == MAP_FAILED) {
+      throw Elements::Exception() << "Unable to map the packed PDF file " << file_name;
+    }
+  }
+
+  ~Mapping() {
+    ::munmap(m_address, m_size);
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const char* data() const {
+    return static_cast<const char*>(m_address);
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+private:
+  void*       m_address = nullptr;
+  std::size_t m_size    = 0;
+};
+
+namespace {
+
+// Check that the sections of the given counts fit in the file before the
+// layout is computed, so that damaged counts cannot overflow the offsets
+bool fitsIn(std::uint64_t source_no, std::uint64_t bin_no, std::size_t file_size) {
+  std::uint64_t available = file_size - PackedPdfLayout::HEADER_SIZE;
+  if (bin_no > available / sizeof(double)) {
+    return false;
+  }
+  available -= bin_no * sizeof(double);
+  // The IDs, the sorted IDs and their rows
+  if (source_no > available / (3 * sizeof(std::int64_t))) {
+    return false;
+  }
+  available -= source_no * 3 * sizeof(std::int64_t);
+  return source_no == 0 || bin_no <= available / sizeof(float) / source_no;
+}
+
+}  // namespace
+
+PackedPdfReader::PackedPdfReader(const std::string& file_name)
+    : m_mapping{std::make_shared<const Mapping>(file_name)} {
+  const char*   data      = m_mapping->data();
+  std::uint64_t source_no = 0;
+  std::uint64_t bin_no    = 0;
+  std::memcpy(&source_no, data + 8, sizeof(source_no));
+  std::memcpy(&bin_no, data + 16, sizeof(bin_no));
+  if (std::memcmp(data, PackedPdfLayout::MAGIC, sizeof(PackedPdfLayout::MAGIC)) != 0 || bin_no == 0 ||
+      !fitsIn(source_no, bin_no, m_mapping->size()) || PackedPdfLayout(source_no, bin_no).size != m_mapping->size()) {
+    throw Elements::Exception() << file_name << " is not a valid packed PDF file";
+  }
+  PackedPdfLayout layout{source_no, bin_no};
+
+  const char* parameter = data + 24;
+  m_parameter.assign(parameter, strnlen(parameter, PackedPdfLayout::PARAMETER_SIZE));
+  m_sampling.resize(bin_no);
+  std::memcpy(m_sampling.data(), data + layout.sampling, bin_no * sizeof(double));
+  m_source_no   = source_no;
+  m_pdfs        = reinterpret_cast<const float*>(data + layout.pdfs);
+  m_ids         = reinterpret_cast<const std::int64_t*>(data + layout.ids);
+  m_sorted_ids  = reinterpret_cast<const std::int64_t*>(data + layout.sorted_ids);
+  m_sorted_rows = reinterpret_cast<const std::uint64_t*>(data + layout.sorted_rows);
+}
+
+const std::string& PackedPdfReader::getParameter() const {
+  return m_parameter;
+}
+
+const std::vector<double>& PackedPdfReader::getSampling() const {
+  return m_sampling;
+}
+
+std::size_t PackedPdfReader::size() const {
+  return m_source_no;
+}
+
+std::int64_t PackedPdfReader::getId(std::size_t row) const {
+  return m_ids[row];
+}
+
+const float* PackedPdfReader::getPdf(std::size_t row) const {
+  return m_pdfs + row * m_sampling.size();
+}
+
+std::ptrdiff_t PackedPdfReader::findRow(std::int64_t id) const {
+  auto found = std::lower_bound(m_sorted_ids, m_sorted_ids + m_source_no, id);
+  if (found == m_sorted_ids + m_source_no || *found != id) {
+    return -1;
+  }
+  return static_cast<std::ptrdiff_t>(m_sorted_rows[found - m_sorted_ids]);
+}
+
+const float* PackedPdfReader::findPdf(std::int64_t id) const {
+  auto row = findRow(id);
+  return row < 0 ? nullptr : getPdf(static_cast<std::size_t>(row));
+}
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PackedPdfWriter.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PackedPdfWriter.h"
+#include "ElementsKernel/Exception.h"
+#include "PHZ_PdfHandling/PackedPdfLayout.h"
+#include <algorithm>
+#include <array>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <numeric>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+PackedPdfWriter::PackedPdfWriter(std::string file_name, std::vector<double> sampling, const std::string& parameter)
+    : m_file_name{std::move(file_name)}
+    , m_tmp_file_name{m_file_name + "." + boost::filesystem::unique_path().string() + ".tmp"}
+    , m_bin_no{sampling.size()} {
+  if (sampling.empty()) {
+    throw Elements::Exception() << "The PDF sampling is empty";
+  }
+  if (parameter.size() >= PackedPdfLayout::PARAMETER_SIZE) {
+    throw Elements::Exception() << "The PDF parameter name " << parameter << " is too long";
+  }
+  m_out.open(m_tmp_file_name, std::ios::binary | std::ios::trunc);
+  if (!m_out) {
+    throw Elements::Exception() << "Unable to create the file " << m_tmp_file_name;
+  }
+
+  // The counts of the header are written by close()
+  std::array<char, PackedPdfLayout::HEADER_SIZE> header{};
+  std::memcpy(header.data(), PackedPdfLayout::MAGIC, sizeof(PackedPdfLayout::MAGIC));
+  std::memcpy(header.data() + 24, parameter.data(), parameter.size());
+  m_out.write(header.data(), header.size());
+  m_out.write(reinterpret_cast<const char*>(sampling.data()),
+              static_cast<std::streamsize>(sampling.size() * sizeof(double)));
+  m_row.resize(m_bin_no);
+}
+
+PackedPdfWriter::~PackedPdfWriter() {
+  if (!m_closed) {
+    m_out.close();
+    boost::system::error_code error{};
+    boost::filesystem::remove(m_tmp_file_name, error);
+  }
+}
+
+void PackedPdfWriter::addPdf(std::int64_t id, const double* pdf) {
+  std::copy(pdf, pdf + m_bin_no, m_row.begin());
+  addPdf(id, m_row.data());
+}
+
+void PackedPdfWriter::addPdf(std::int64_t id, const float* pdf) {
+  if (m_closed) {
+    throw Elements::Exception() << "The packed PDF file " << m_file_name << " is closed";
+  }
+  m_out.write(reinterpret_cast<const char*>(pdf), static_cast<std::streamsize>(m_bin_no * sizeof(float)));
+  m_ids.push_back(id);
+}
+
+void PackedPdfWriter::close() {
+  if (m_closed) {
+    return;
+  }
+  std::size_t     source_no = m_ids.size();
+  PackedPdfLayout layout{source_no, m_bin_no};
+
+  std::vector<std::uint64_t> sorted_rows(source_no);
+  std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+  std::stable_sort(sorted_rows.begin(), sorted_rows.end(),
+                   [this](std::uint64_t a, std::uint64_t b) { return m_ids[a] < m_ids[b]; });
+  std::vector<std::int64_t> sorted_ids(source_no);
+  for (std::size_t i = 0; i < source_no; ++i) {
+    sorted_ids[i] = m_ids[sorted_rows[i]];
+    if (i > 0 && sorted_ids[i] == sorted_ids[i - 1]) {
+      throw Elements::Exception() << "The source ID " << sorted_ids[i] << " is duplicated in " << m_file_name;
+    }
+  }
+
+  std::size_t         pdfs_end = layout.pdfs + source_no * m_bin_no * sizeof(float);
+  std::array<char, 8> padding{};
+  m_out.write(padding.data(), static_cast<std::streamsize>(layout.ids - pdfs_end));
+  m_out.write(reinterpret_cast<const char*>(m_ids.data()),
+              static_cast<std::streamsize>(source_no * sizeof(std::int64_t)));
+  m_out.write(reinterpret_cast<const char*>(sorted_ids.data()),
+              static_cast<std::streamsize>(source_no * sizeof(std::int64_t)));
+  m_out.write(reinterpret_cast<const char*>(sorted_rows.data()),
+              static_cast<std::streamsize>(source_no * sizeof(std::uint64_t)));
+
+  std::uint64_t counts[2] = {source_no, m_bin_no};
+  m_out.seekp(sizeof(PackedPdfLayout::MAGIC));
+  m_out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+  m_out.close();
+  if (!m_out) {
+    throw Elements::Exception() << "Unable to write the packed PDF file " << m_file_name;
+  }
+  boost::filesystem::rename(m_tmp_file_name, m_file_name);
+  m_closed = true;
+}
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
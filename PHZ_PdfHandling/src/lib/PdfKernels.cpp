@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PdfKernels.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzUITools/ParallelFor.h"
+#include <CCfits/CCfits>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <regex>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+namespace {
+
+inline double trapezoid(const double* x, const double* y, std::size_t first) {
+  return 0.5 * (x[first + 1] - x[first]) * (y[first] + y[first + 1]);
+}
+
+// Simpson rule over the 3 samples starting at first
+inline double simpsonPiece(const double* x, const double* y, std::size_t first) {
+  double h0 = x[first + 1] - x[first];
+  double h1 = x[first + 2] - x[first + 1];
+  if (h0 == 0 || h1 == 0) {
+    return trapezoid(x, y, first) + trapezoid(x, y, first + 1);
+  }
+  double hsum = h0 + h1;
+  return hsum / 6. * (y[first] * (2. - h1 / h0) + y[first + 1] * hsum * hsum / (h0 * h1) + y[first + 2] * (2. - h0 / h1));
+}
+
+// Linear interpolation with the numpy.interp conventions, xp being sorted
+double interpolate(const double* xp, const double* fp, std::size_t size, double x) {
+  if (x < xp[0]) {
+    return fp[0];
+  }
+  if (x >= xp[size - 1]) {
+    return fp[size - 1];
+  }
+  std::size_t j     = std::upper_bound(xp, xp + size, x) - xp - 1;
+  double      slope = (fp[j + 1] - fp[j]) / (xp[j + 1] - xp[j]);
+  double      value = slope * (x - xp[j]) + fp[j];
+  if (std::isnan(value)) {
+    value = slope * (x - xp[j + 1]) + fp[j + 1];
+    if (std::isnan(value) && fp[j] == fp[j + 1]) {
+      value = fp[j];
+    }
+  }
+  return value;
+}
+
+// Index of the highest sample, the first NaN winning like for numpy.argmax
+std::size_t findMaximum(const double* pdf, std::size_t size) {
+  std::size_t best = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (std::isnan(pdf[i])) {
+      return i;
+    }
+    if (pdf[i] > pdf[best]) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+// Below a few hundreds PDFs the threads cost more than they save
+template <typename Compute>
+void forEachSourceBlock(std::size_t source_no, std::size_t thread_number, Compute compute) {
+  PhzUITools::forEachBlock(source_no, PhzUITools::getThreadNumber(thread_number, source_no, 256), compute);
+}
+
+}  // namespace
+
+double simpson(const double* x, const double* y, std::size_t size) {
+  if (size < 2) {
+    return 0.;
+  }
+  // Sum of the pieces starting at the even samples, up to the one ending at last
+  auto even_sum = [x, y](std::size_t last) {
+    double result = 0.;
+    for (std::size_t first = 0; first + 2 <= last; first += 2) {
+      result += simpsonPiece(x, y, first);
+    }
+    return result;
+  };
+  if (size % 2 == 1) {
+    return even_sum(size - 1);
+  }
+  double odd_sum = 0.;
+  for (std::size_t first = 1; first + 2 <= size - 1; first += 2) {
+    odd_sum += simpsonPiece(x, y, first);
+  }
+  return 0.5 * (even_sum(size - 2) + trapezoid(x, y, size - 2) + trapezoid(x, y, 0) + odd_sum);
+}
+
+void cumulativeSimpson(const double* x, const double* y, std::size_t size, double* out) {
+  if (size == 0) {
+    return;
+  }
+  out[0] = 0.;
+  // Running sums of the pieces starting at the even and at the odd samples
+  double      even_sum = 0.;
+  double      odd_sum  = 0.;
+  double      first    = size > 1 ? trapezoid(x, y, 0) : 0.;
+  std::size_t i        = 1;
+  for (; i < size; ++i) {
+    if (i % 2 == 0) {
+      even_sum += simpsonPiece(x, y, i - 2);
+      out[i] = even_sum;
+    } else {
+      if (i >= 3) {
+        odd_sum += simpsonPiece(x, y, i - 2);
+      }
+      out[i] = 0.5 * (even_sum + trapezoid(x, y, i - 1) + first + odd_sum);
+    }
+  }
+}
+
+std::pair<double, double> computePitAndCrps(const std::vector<double>& bins, const double* pdf, double reference,
+                                            std::vector<double>& workspace) {
+  static const double nan  = std::numeric_limits<double>::quiet_NaN();
+  std::size_t         size = bins.size();
+  if (size < 2 || !std::isfinite(reference)) {
+    return {nan, nan};
+  }
+
+  // Layout of the workspace: the sampling with the reference value inserted,
+  // the cumulative distribution on it and the integrand
+  workspace.resize(3 * (size + 1));
+  double* grid      = workspace.data();
+  double* cumul     = grid + size + 1;
+  double* integrand = cumul + size + 1;
+
+  cumulativeSimpson(bins.data(), pdf, size, cumul);
+  double total = cumul[size - 1];
+  if (!(total > 0) || !std::isfinite(total)) {
+    return {nan, nan};
+  }
+
+  std::size_t cut    = std::lower_bound(bins.begin(), bins.end(), reference) - bins.begin();
+  bool        insert = cut == size || bins[cut] != reference;
+  if (insert) {
+    // The cumulative at the reference value is interpolated (and clamped outside the sampling)
+    double value = cut == 0      ? 0.
+                   : cut == size ? total
+                                 : cumul[cut - 1] + (cumul[cut] - cumul[cut - 1]) * (reference - bins[cut - 1]) /
+                                                        (bins[cut] - bins[cut - 1]);
+    std::copy_backward(cumul + cut, cumul + size, cumul + size + 1);
+    cumul[cut] = value;
+  }
+  std::size_t grid_size = insert ? size + 1 : size;
+  std::copy(bins.begin(), bins.begin() + cut, grid);
+  grid[cut] = reference;
+  std::copy(bins.begin() + cut + (insert ? 0 : 1), bins.end(), grid + cut + 1);
+
+  for (std::size_t i = 0; i < grid_size; ++i) {
+    cumul[i] /= total;
+    integrand[i] = i <= cut ? cumul[i] * cumul[i] : (cumul[i] - 1.) * (cumul[i] - 1.);
+  }
+  double crps = simpson(grid, integrand, cut + 1);
+  // Both parts share the reference value, on which the integrand is (F-1)^2 for the upper part
+  integrand[cut] = (cumul[cut] - 1.) * (cumul[cut] - 1.);
+  crps += simpson(grid + cut, integrand + cut, grid_size - cut);
+  return {cumul[cut], crps};
+}
+
+double computeMode(const std::vector<double>& bins, const double* pdf) {
+  return bins[findMaximum(pdf, bins.size())];
+}
+
+double computeMean(const std::vector<double>& bins, const double* pdf, std::vector<double>& workspace) {
+  workspace.resize(bins.size());
+  for (std::size_t i = 0; i < bins.size(); ++i) {
+    workspace[i] = bins[i] * pdf[i];
+  }
+  return simpson(bins.data(), workspace.data(), bins.size()) / simpson(bins.data(), pdf, bins.size());
+}
+
+double computeMedian(const std::vector<double>& bins, const double* pdf, std::vector<double>& workspace) {
+  workspace.resize(bins.size());
+  double sum = 0.;
+  for (std::size_t i = 0; i < bins.size(); ++i) {
+    sum += pdf[i];
+    workspace[i] = sum;
+  }
+  return interpolate(workspace.data(), bins.data(), bins.size(), 0.5 * sum);
+}
+
+double computeFittedMode(const std::vector<double>& bins, const double* pdf, double threshold) {
+  std::size_t size   = bins.size();
+  std::size_t center = findMaximum(pdf, size);
+  double      limit  = threshold * pdf[center];
+  std::size_t first  = center;
+  while (first > 0 && pdf[first] > limit) {
+    --first;
+  }
+  std::size_t last = center;
+  while (last < size - 1 && pdf[last] > limit) {
+    ++last;
+  }
+  if (last - first <= 2) {
+    return bins[center];
+  }
+
+  // Least squares fit of A*t^2 + B*t + C on [first, last), t being the centered
+  // and reduced sampling for the conditioning of the normal equations
+  std::size_t count  = last - first;
+  double      offset = 0.;
+  for (std::size_t i = first; i < last; ++i) {
+    offset += bins[i];
+  }
+  offset /= count;
+  double scale = std::max(std::abs(bins[first] - offset), std::abs(bins[last - 1] - offset));
+  if (!(scale > 0)) {
+    return bins[center];
+  }
+  double s[5] = {0., 0., 0., 0., 0.};  // sums of t^k
+  double r[3] = {0., 0., 0.};          // sums of y*t^k
+  for (std::size_t i = first; i < last; ++i) {
+    double t     = (bins[i] - offset) / scale;
+    double power = 1.;
+    for (int k = 0; k < 5; ++k) {
+      if (k < 3) {
+        r[k] += pdf[i] * power;
+      }
+      s[k] += power;
+      power *= t;
+    }
+  }
+  // Cramer's rule on the system | s4 s3 s2 | |A|   |r2|
+  //                             | s3 s2 s1 | |B| = |r1|
+  //                             | s2 s1 s0 | |C|   |r0|
+  auto det = [](double a, double b, double c, double d, double e, double f, double g, double h, double i) {
+    return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+  };
+  double d = det(s[4], s[3], s[2], s[3], s[2], s[1], s[2], s[1], s[0]);
+  if (d == 0 || !std::isfinite(d)) {
+    return bins[center];
+  }
+  double a = det(r[2], s[3], s[2], r[1], s[2], s[1], r[0], s[1], s[0]) / d;
+  double b = det(s[4], r[2], s[2], s[3], r[1], s[1], s[2], r[0], s[0]) / d;
+  if (!(a < 0)) {
+    return bins[center];
+  }
+  return offset - scale * b / (2 * a);
+}
+
+void computePointEstimates(PointEstimateType type, const std::vector<double>& bins, const double* pdfs,
+                           std::size_t source_no, double* out, std::size_t thread_number, double threshold) {
+  std::size_t size = bins.size();
+  if (size == 0) {
+    throw Elements::Exception() << "The PDF sampling is empty";
+  }
+  forEachSourceBlock(source_no, thread_number, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::vector<double> workspace{};
+    for (std::size_t source = begin; source < end; ++source) {
+      const double* pdf = pdfs + source * size;
+      switch (type) {
+      case PointEstimateType::MODE:
+        out[source] = computeMode(bins, pdf);
+        break;
+      case PointEstimateType::MEAN:
+        out[source] = computeMean(bins, pdf, workspace);
+        break;
+      case PointEstimateType::MEDIAN:
+        out[source] = computeMedian(bins, pdf, workspace);
+        break;
+      case PointEstimateType::FITTED_MODE:
+        out[source] = computeFittedMode(bins, pdf, threshold);
+        break;
+      }
+    }
+  });
+}
+
+void computePitsAndCrps(const std::vector<double>& bins, const double* pdfs, const double* references,
+                        std::size_t source_no, double* pits, double* crps, std::size_t thread_number) {
+  forEachSourceBlock(source_no, thread_number, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::vector<double> workspace{};
+    for (std::size_t source = begin; source < end; ++source) {
+      auto pit_crps = computePitAndCrps(bins, pdfs + source * bins.size(), references[source], workspace);
+      pits[source]  = pit_crps.first;
+      crps[source]  = pit_crps.second;
+    }
+  });
+}
+
+int findStackBin(const std::vector<double>& edges, double value) {
+  // Number of edges strictly below the value
+  auto below = std::lower_bound(edges.begin(), edges.end(), value) - edges.begin();
+  if (below == 0 || below == static_cast<long>(edges.size()) || std::isnan(value)) {
+    return -1;
+  }
+  return static_cast<int>(below - 1);
+}
+
+std::vector<double> getShiftedBins(const std::vector<double>& bins) {
+  std::vector<double> result{};
+  result.reserve(2 * bins.size() + 1);
+  for (auto bin = bins.rbegin(); bin != bins.rend(); ++bin) {
+    result.push_back(-*bin);
+  }
+  if (std::find(bins.begin(), bins.end(), 0.) != bins.end()) {
+    result.pop_back();
+  } else {
+    result.push_back(0.);
+  }
+  result.insert(result.end(), bins.begin(), bins.end());
+  return result;
+}
+
+std::vector<double> readPdfSampling(const std::string& catalog_file, const std::string& pdf_column) {
+  std::string comments{};
+  try {
+    CCfits::FITS fits_file{catalog_file, CCfits::RWmode::Read};
+    comments = fits_file.extension(1).getComments();
+  } catch (const CCfits::FitsException& e) {
+    throw Elements::Exception() << "Unable to read the catalog " << catalog_file << " : " << e.message();
+  }
+
+  std::regex range_regex{"(^Z|[^-]Z)-BINS : \\{[0-9., \\r\\n]+\\}"};
+  if (pdf_column.find("LIKELIHOOD") != std::string::npos) {
+    range_regex = std::regex{"LIKELIHOOD-Z-BINS : \\{[0-9., \\r\\n]+\\}"};
+  }
+  std::smatch range_match;
+  if (!std::regex_search(comments, range_match, range_regex)) {
+    throw Elements::Exception() << "The Pdf sampling was not found in the comments";
+  }
+
+  std::string ranges = range_match[0];
+  ranges             = ranges.substr(ranges.find('{'));
+  std::vector<double> sampling{};
+  std::regex          number_regex{"[0-9.]+"};
+  for (std::sregex_iterator number{ranges.begin(), ranges.end(), number_regex}, end{}; number != end; ++number) {
+    sampling.push_back(std::atof(number->str().c_str()));
+  }
+  return sampling;
+}
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PdfValidationStatistics.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PdfValidationStatistics.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include "PhzUITools/ParallelFor.h"
+#include "Table/FitsWriter.h"
+#include "Table/Table.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace Euclid {
+namespace PHZ_PdfHandling {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PdfValidationStatistics");
+
+namespace {
+
+// Add the PDF (normalized to a unit sum) shifted by the reference value to the
+// stack column, with the linear interpolation of numpy.interp
+void addShifted(const std::vector<double>& shifted_bins, const std::vector<double>& extended_bins,
+                std::size_t added_nodes, const double* pdf, std::size_t pdf_size, double norm, double reference,
+                std::vector<double>& stack, std::size_t stack_bins, std::size_t column) {
+  // Value of the completed PDF: zeros on the added nodes and after the last node
+  auto value = [&](std::size_t index) {
+    return (index < added_nodes || index >= added_nodes + pdf_size) ? 0. : pdf[index - added_nodes] / norm;
+  };
+  std::size_t last = extended_bins.size() - 1;
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < shifted_bins.size(); ++i) {
+    double x = shifted_bins[i] + reference;
+    while (next <= last && extended_bins[next] < x) {
+      ++next;
+    }
+    double result;
+    if (next == 0) {
+      result = value(0);
+    } else if (next > last) {
+      result = value(last);
+    } else {
+      double x0 = extended_bins[next - 1];
+      double x1 = extended_bins[next];
+      result    = value(next - 1) + (value(next) - value(next - 1)) * (x - x0) / (x1 - x0);
+    }
+    if (std::isfinite(result)) {
+      stack[i * stack_bins + column] += result;
+    }
+  }
+}
+
+}  // namespace
+
+PdfValidationStatistics::PdfValidationStatistics(std::vector<double> pdf_bins, std::vector<double> stack_edges)
+    : m_pdf_bins{std::move(pdf_bins)}, m_stack_edges{std::move(stack_edges)} {
+  if (m_pdf_bins.size() < 2) {
+    throw Elements::Exception() << "The PDF sampling must have at least two nodes";
+  }
+  if (m_stack_edges.size() < 2) {
+    throw Elements::Exception() << "At least one stacking bin is required";
+  }
+  m_shifted_bins = PHZ_PdfHandling::getShiftedBins(m_pdf_bins);
+  m_reference_stack.assign(m_pdf_bins.size() * (m_stack_edges.size() - 1), 0.);
+  m_shifted_stack.assign(m_shifted_bins.size() * (m_stack_edges.size() - 1), 0.);
+}
+
+std::vector<double> PdfValidationStatistics::computeStackEdges(const std::vector<double>& pdf_bins,
+                                                               std::size_t stack_bins) {
+  if (pdf_bins.empty() || stack_bins == 0) {
+    throw Elements::Exception() << "Cannot compute the stacking bins of an empty sampling";
+  }
+  std::vector<double> edges(stack_bins + 1);
+  double              step = (pdf_bins.back() - pdf_bins.front()) / static_cast<double>(stack_bins);
+  for (std::size_t index = 0; index <= stack_bins; ++index) {
+    edges[index] = pdf_bins.front() + step * static_cast<double>(index);
+  }
+  return edges;
+}
+
+void PdfValidationStatistics::addSources(const std::vector<double>& pdfs, const std::vector<double>& point_estimates,
+                                         const std::vector<double>& reference_values, std::size_t thread_number) {
+  std::size_t size        = m_pdf_bins.size();
+  std::size_t source_no   = reference_values.size();
+  std::size_t stack_bins  = m_stack_edges.size() - 1;
+  std::size_t added_nodes = m_shifted_bins.size() - size;
+  if (pdfs.size() != source_no * size || point_estimates.size() != source_no) {
+    throw Elements::Exception() << "Inconsistent chunk: " << pdfs.size() << " PDF values, " << point_estimates.size()
+                                << " point estimates and " << source_no << " reference values";
+  }
+
+  std::vector<double> extended_bins{m_shifted_bins};
+  extended_bins.push_back(2 * m_shifted_bins.back() - m_shifted_bins[m_shifted_bins.size() - 2]);
+
+  std::size_t offset = m_pits.size();
+  m_pits.resize(offset + source_no);
+  m_crps.resize(offset + source_no);
+
+  // Each thread stacks into its own maps, small chunks are not worth the copies
+  thread_number = PhzUITools::getThreadNumber(thread_number, source_no, 256);
+
+  std::mutex merge_mutex{};
+  PhzUITools::forEachBlock(source_no, thread_number, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::vector<double> reference_stack(m_reference_stack.size(), 0.);
+    std::vector<double> shifted_stack(m_shifted_stack.size(), 0.);
+    std::vector<double> workspace{};
+    for (std::size_t source = begin; source < end; ++source) {
+      const double* pdf       = pdfs.data() + source * size;
+      double        reference = reference_values[source];
+
+      auto pit_crps           = computePitAndCrps(m_pdf_bins, pdf, reference, workspace);
+      m_pits[offset + source] = static_cast<float>(pit_crps.first);
+      m_crps[offset + source] = static_cast<float>(pit_crps.second);
+
+      double norm = 0.;
+      for (std::size_t node = 0; node < size; ++node) {
+        norm += pdf[node];
+      }
+      if (norm == 0 || !std::isfinite(norm)) {
+        continue;
+      }
+
+      int reference_bin = findStackBin(m_stack_edges, reference);
+      if (reference_bin >= 0) {
+        for (std::size_t node = 0; node < size; ++node) {
+          reference_stack[node * stack_bins + reference_bin] += pdf[node] / norm;
+        }
+      }
+
+      int estimate_bin = findStackBin(m_stack_edges, point_estimates[source]);
+      if (estimate_bin >= 0 && std::isfinite(reference)) {
+        addShifted(m_shifted_bins, extended_bins, added_nodes, pdf, size, norm, reference, shifted_stack,
+                   stack_bins, estimate_bin);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(merge_mutex);
+    for (std::size_t index = 0; index < reference_stack.size(); ++index) {
+      m_reference_stack[index] += reference_stack[index];
+    }
+    for (std::size_t index = 0; index < shifted_stack.size(); ++index) {
+      m_shifted_stack[index] += shifted_stack[index];
+    }
+  });
+}
+
+std::vector<std::int64_t> PdfValidationStatistics::computeHistogram(const std::vector<float>& values, double min,
+                                                                     double max, std::size_t bins) {
+  std::vector<std::int64_t> histogram(bins, 0);
+  if (bins == 0 || !(max > min)) {
+    return histogram;
+  }
+  double scale = static_cast<double>(bins) / (max - min);
+  for (float value : values) {
+    if (!std::isfinite(value) || value < min || value > max) {
+      continue;
+    }
+    auto bin = static_cast<std::size_t>((value - min) * scale);
+    ++histogram[std::min(bin, bins - 1)];
+  }
+  return histogram;
+}
+
+void PdfValidationStatistics::writeSummary(const std::string& file_name, std::size_t hist_bins) const {
+  if (boost::filesystem::exists(file_name)) {
+    boost::filesystem::remove(file_name);
+  }
+  std::size_t stack_bins = m_stack_edges.size() - 1;
+
+  {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("PDZ_BINS", typeid(std::vector<double>), "", "Sampling of the PDFs"),
+        Table::ColumnInfo::info_type("SHIFT_BINS", typeid(std::vector<double>), "",
+                                     "Sampling of the shifted PDFs")});
+    Table::FitsWriter writer{file_name, true};
+    writer.setHduName("SAMPLING");
+    writer.addComment("Number of sources: " + std::to_string(getSourceNumber()));
+    writer.addData(Table::Table{{Table::Row{{m_pdf_bins, m_shifted_bins}, info}}});
+  }
+
+  {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("BIN_MIN", typeid(double), "", "Lower edge of the stacking bin"),
+        Table::ColumnInfo::info_type("BIN_MAX", typeid(double), "", "Upper edge of the stacking bin"),
+        Table::ColumnInfo::info_type("REF_STACK", typeid(std::vector<double>), "",
+                                     "Normalized PDFs stacked by reference value"),
+        Table::ColumnInfo::info_type("SHIFT_STACK", typeid(std::vector<double>), "",
+                                     "Normalized PDFs shifted by the reference value, stacked by point estimate")});
+    std::vector<Table::Row> rows{};
+    for (std::size_t bin = 0; bin < stack_bins; ++bin) {
+      std::vector<double> reference(m_pdf_bins.size());
+      for (std::size_t node = 0; node < reference.size(); ++node) {
+        reference[node] = m_reference_stack[node * stack_bins + bin];
+      }
+      std::vector<double> shifted(m_shifted_bins.size());
+      for (std::size_t node = 0; node < shifted.size(); ++node) {
+        shifted[node] = m_shifted_stack[node * stack_bins + bin];
+      }
+      rows.emplace_back(std::vector<Table::Row::cell_type>{m_stack_edges[bin], m_stack_edges[bin + 1],
+                                                           std::move(reference), std::move(shifted)},
+                        info);
+    }
+    Table::FitsWriter writer{file_name};
+    writer.setHduName("STACKS");
+    writer.addData(Table::Table{rows});
+  }
+
+  double crps_max = 0.;
+  for (float value : m_crps) {
+    if (std::isfinite(value)) {
+      crps_max = std::max(crps_max, static_cast<double>(value));
+    }
+  }
+  if (crps_max == 0) {
+    crps_max = 1.;
+  }
+  auto write_histogram = [&file_name, hist_bins](const std::string& name, const std::vector<float>& values,
+                                                 double max) {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("BIN_MIN", typeid(double), "", "Lower edge of the histogram bin"),
+        Table::ColumnInfo::info_type("BIN_MAX", typeid(double), "", "Upper edge of the histogram bin"),
+        Table::ColumnInfo::info_type("COUNT", typeid(std::int64_t), "", "Number of sources in the bin")});
+    auto                    histogram = computeHistogram(values, 0., max, hist_bins);
+    std::vector<Table::Row> rows{};
+    for (std::size_t bin = 0; bin < hist_bins; ++bin) {
+      rows.emplace_back(std::vector<Table::Row::cell_type>{max * bin / hist_bins, max * (bin + 1) / hist_bins,
+                                                           histogram[bin]},
+                        info);
+    }
+    Table::FitsWriter writer{file_name};
+    writer.setHduName(name);
+    writer.addData(Table::Table{rows});
+  };
+  if (hist_bins > 0) {
+    write_histogram("PIT_HIST", m_pits, 1.);
+    write_histogram("CRPS_HIST", m_crps, crps_max);
+  }
+  logger.info() << "Written the validation summary of " << getSourceNumber() << " sources into " << file_name;
+}
+
+}  // namespace PHZ_PdfHandling
+}  // namespace Euclid
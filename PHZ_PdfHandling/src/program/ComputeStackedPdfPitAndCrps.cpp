@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/ComputeStackedPdfPitAndCrps.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include "PHZ_PdfHandling/PdfValidationStatistics.h"
+#include "Table/FitsReader.h"
+#include <boost/program_options.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PHZ_PdfHandling;
+namespace po = boost::program_options;
+
+static Elements::Logging logger = Elements::Logging::getLogger("ComputeStackedPdfPitAndCrps");
+
+static const std::string PDZ_CATALOG_FILE{"pdz-catalog-file"};
+static const std::string REFZ_CATALOG_FILE{"refz-catalog-file"};
+static const std::string PDZ_COL_PDF{"pdz-col-pdf"};
+static const std::string PDZ_COL_PE{"pdz-col-pe"};
+static const std::string PE_CATALOG_FILE{"pe-catalog-file"};
+static const std::string REFZ_COL_REF{"refz-col-ref"};
+static const std::string STACK_BINS{"stack-bins"};
+static const std::string HIST_BINS{"hist-bins"};
+static const std::string SUMMARY_FILE{"summary-file"};
+static const std::string CHUNK_SIZE{"chunk-size"};
+static const std::string THREAD_NO{"thread-no"};
+
+namespace {
+
+// Convert the numerical cells into double, anything else into NaN
+class ToDoubleVisitor : public boost::static_visitor<double> {
+public:
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, double>::type operator()(const T& value) const {
+    return static_cast<double>(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value, double>::type operator()(const T&) const {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+};
+
+// Append the numerical vector cells to a buffer of doubles
+class AppendVectorVisitor : public boost::static_visitor<std::size_t> {
+public:
+  explicit AppendVectorVisitor(std::vector<double>& buffer) : m_buffer(buffer) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, std::size_t>::type
+  operator()(const std::vector<T>& values) const {
+    m_buffer.insert(m_buffer.end(), values.begin(), values.end());
+    return values.size();
+  }
+
+  template <typename T>
+  std::size_t operator()(const T&) const {
+    throw Elements::Exception() << "The PDF column must contain numerical vectors";
+  }
+
+private:
+  std::vector<double>& m_buffer;
+};
+
+std::size_t getColumnIndex(const Table::ColumnInfo& column_info, const std::string& name, const std::string& file) {
+  auto index = column_info.find(name);
+  if (index == nullptr) {
+    throw Elements::Exception() << "The Column " << name << " is missing in the fits file " << file;
+  }
+  return *index;
+}
+
+// Reader of one numerical column, either of the PDZ catalog or of a catalog
+// read in step with it
+class ColumnStream {
+public:
+  ColumnStream(const Table::ColumnInfo& pdz_info, const std::string& column, const std::string& file,
+               std::unique_ptr<Table::FitsReader> reader)
+      : m_reader{std::move(reader)}
+      , m_index{getColumnIndex(m_reader ? m_reader->getInfo() : pdz_info, column, file)}
+      , m_file{file} {}
+
+  void read(const Table::Table& pdz_table, std::vector<double>& values) {
+    if (!m_reader) {
+      fill(pdz_table, values);
+      return;
+    }
+    auto table = m_reader->read(pdz_table.size());
+    if (table.size() != pdz_table.size()) {
+      throw Elements::Exception() << "The catalog " << m_file << " has less rows than the PDZ catalog";
+    }
+    fill(table, values);
+  }
+
+private:
+  void fill(const Table::Table& table, std::vector<double>& values) const {
+    values.clear();
+    for (const auto& row : table) {
+      values.push_back(boost::apply_visitor(m_to_double, row[m_index]));
+    }
+  }
+
+  std::unique_ptr<Table::FitsReader> m_reader;
+  std::size_t                        m_index;
+  std::string                        m_file;
+  ToDoubleVisitor                    m_to_double{};
+};
+
+}  // namespace
+
+class ComputeStackedPdfPitAndCrps : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Compute Stacked PDF, PIT and CRPS options"};
+    options.add_options()(PDZ_CATALOG_FILE.c_str(), po::value<std::string>()->default_value(""),
+                          "Path to the .fits file containing the PDZ and the point estimate")(
+        REFZ_CATALOG_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "Path to the .fits file containing the reference redshift (If not provided the program looks for the "
+        "refZ into pdz-catalog-file)")(PDZ_COL_PDF.c_str(), po::value<std::string>()->default_value("Z-1D-PDF"),
+                                       "Column containing the PDZ in the pdz-catalog-file")(
+        PDZ_COL_PE.c_str(), po::value<std::string>()->default_value("Z"),
+        "Column containing the point estimate of the redshift")(
+        PE_CATALOG_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(Optional) name of an external catalog for looking up the point estimate")(
+        REFZ_COL_REF.c_str(), po::value<std::string>()->default_value("Z-TRUE"),
+        "Column containing the reference Redshift of the source in the refz-catalog-file")(
+        STACK_BINS.c_str(), po::value<int>()->default_value(20), "Number of bin for the stacking of the pdf")(
+        HIST_BINS.c_str(), po::value<int>()->default_value(20), "Number of bin for the PIT and CRPS histograms")(
+        SUMMARY_FILE.c_str(), po::value<std::string>()->default_value(""), "The output summary FITS file")(
+        CHUNK_SIZE.c_str(), po::value<int>()->default_value(10000), "Number of rows processed at once")(
+        THREAD_NO.c_str(), po::value<int>()->default_value(0), "Number of threads (0 for all the cores)");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto pdz_file     = getMandatory(args, PDZ_CATALOG_FILE);
+    auto summary_file = getMandatory(args, SUMMARY_FILE);
+    auto pdf_column   = args.at(PDZ_COL_PDF).as<std::string>();
+    auto pe_file      = args.at(PE_CATALOG_FILE).as<std::string>();
+    auto refz_file    = args.at(REFZ_CATALOG_FILE).as<std::string>();
+
+    auto stack_bins = args.at(STACK_BINS).as<int>();
+    auto hist_bins  = args.at(HIST_BINS).as<int>();
+    auto chunk_size = args.at(CHUNK_SIZE).as<int>();
+    auto thread_no  = args.at(THREAD_NO).as<int>();
+    if (stack_bins <= 0 || hist_bins <= 0 || chunk_size <= 0 || thread_no < 0) {
+      throw Elements::Exception() << "Invalid " << STACK_BINS << ", " << HIST_BINS << ", " << CHUNK_SIZE << " or "
+                                  << THREAD_NO;
+    }
+
+    auto pdz_bins    = readPdfSampling(pdz_file, pdf_column);
+    auto stack_edges = PdfValidationStatistics::computeStackEdges(pdz_bins, stack_bins);
+    PdfValidationStatistics statistics{pdz_bins, stack_edges};
+
+    Table::FitsReader pdz_reader{pdz_file, 1};
+    auto              pdz_info  = pdz_reader.getInfo();
+    auto              pdf_index = getColumnIndex(pdz_info, pdf_column, pdz_file);
+
+    // The point estimates and the reference values are read in the same row
+    // order, either from the PDZ catalog or from their own catalog
+    bool own_pe   = !pe_file.empty() && pe_file != pdz_file;
+    bool own_refz = !refz_file.empty() && refz_file != pdz_file;
+    logger.info() << "Read Point Estimate from column " << args.at(PDZ_COL_PE).as<std::string>() << " of file "
+                  << (own_pe ? pe_file : pdz_file);
+    ColumnStream pe_stream{pdz_info, args.at(PDZ_COL_PE).as<std::string>(), own_pe ? pe_file : pdz_file,
+                           own_pe ? std::unique_ptr<Table::FitsReader>{new Table::FitsReader{pe_file, 1}} : nullptr};
+    logger.info() << "Read Reference Redshift from column " << args.at(REFZ_COL_REF).as<std::string>()
+                  << " of file " << (own_refz ? refz_file : pdz_file);
+    ColumnStream refz_stream{
+        pdz_info, args.at(REFZ_COL_REF).as<std::string>(), own_refz ? refz_file : pdz_file,
+        own_refz ? std::unique_ptr<Table::FitsReader>{new Table::FitsReader{refz_file, 1}} : nullptr};
+
+    std::size_t         total = pdz_reader.rowsLeft();
+    std::size_t         done  = 0;
+    std::vector<double> pdfs{};
+    std::vector<double> point_estimates{};
+    std::vector<double> reference_values{};
+    AppendVectorVisitor append_pdf{pdfs};
+    while (pdz_reader.hasMoreRows()) {
+      auto table = pdz_reader.read(chunk_size);
+
+      pdfs.clear();
+      for (const auto& row : table) {
+        if (boost::apply_visitor(append_pdf, row[pdf_index]) != pdz_bins.size()) {
+          throw Elements::Exception() << "The PDF of the column " << pdf_column
+                                      << " does not match the sampling given in the comments";
+        }
+      }
+      pe_stream.read(table, point_estimates);
+      refz_stream.read(table, reference_values);
+
+      statistics.addSources(pdfs, point_estimates, reference_values, static_cast<std::size_t>(thread_no));
+      done += table.size();
+      logger.info() << "Processed " << done << " / " << total << " sources";
+    }
+
+    statistics.writeSummary(summary_file, static_cast<std::size_t>(hist_bins));
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static std::string getMandatory(std::map<std::string, po::variable_value>& args, const std::string& name) {
+    auto value = args.at(name).as<std::string>();
+    if (value.empty()) {
+      throw Elements::Exception() << "Missing " << name;
+    }
+    return value;
+  }
+};
+
+MAIN_FOR(ComputeStackedPdfPitAndCrps)
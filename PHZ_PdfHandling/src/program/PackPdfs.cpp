@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/PackPdfs.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PHZ_PdfHandling/PackedPdfWriter.h"
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include "Table/FitsReader.h"
+#include <CCfits/CCfits>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PHZ_PdfHandling;
+namespace po = boost::program_options;
+
+static Elements::Logging logger = Elements::Logging::getLogger("PackPdfs");
+
+static const std::string PHZ_CATALOG{"phz-catalog"};
+static const std::string PDF_COLUMN{"pdf-column"};
+static const std::string PDF_FILE{"pdf-file"};
+static const std::string ID_COLUMN{"id-column"};
+static const std::string INDEX_COLUMN{"index-column"};
+static const std::string PARAMETER{"parameter"};
+static const std::string OUTPUT_FILE{"output-file"};
+static const std::string CHUNK_SIZE{"chunk-size"};
+
+namespace {
+
+// Convert the integer cells into a 64 bits integer
+class ToIntegerVisitor : public boost::static_visitor<std::int64_t> {
+public:
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, std::int64_t>::type operator()(const T& value) const {
+    return static_cast<std::int64_t>(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_integral<T>::value, std::int64_t>::type operator()(const T&) const {
+    throw Elements::Exception() << "The ID and index columns must contain integers";
+  }
+};
+
+// Copy the numerical vector cells into a buffer of doubles
+class ToVectorVisitor : public boost::static_visitor<void> {
+public:
+  explicit ToVectorVisitor(std::vector<double>& buffer) : m_buffer(buffer) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type operator()(const std::vector<T>& values) const {
+    m_buffer.assign(values.begin(), values.end());
+  }
+
+  template <typename T>
+  void operator()(const T&) const {
+    throw Elements::Exception() << "The PDF column must contain numerical vectors";
+  }
+
+private:
+  std::vector<double>& m_buffer;
+};
+
+std::size_t getColumnIndex(const Table::ColumnInfo& column_info, const std::string& name, const std::string& file) {
+  auto index = column_info.find(name);
+  if (index == nullptr) {
+    throw Elements::Exception() << "The Column " << name << " is missing in the fits file " << file;
+  }
+  return *index;
+}
+
+}  // namespace
+
+class PackPdfs : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Pack PDFs options"};
+    options.add_options()(PHZ_CATALOG.c_str(), po::value<std::string>()->default_value(""),
+                          "Path to the .fits PHZ catalog")(
+        PDF_COLUMN.c_str(), po::value<std::string>()->default_value("Z-1D-PDF"),
+        "Column of the PHZ catalog containing the PDFs (used when no pdf-file is given)")(
+        PDF_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(Optional) .fits file containing one PDF per HDU (like pdf_z.fits), indexed by the index-column")(
+        ID_COLUMN.c_str(), po::value<std::string>()->default_value("ID"), "Column containing the source IDs")(
+        INDEX_COLUMN.c_str(), po::value<std::string>()->default_value("Index"),
+        "Column containing the HDU index of the sources in the pdf-file")(
+        PARAMETER.c_str(), po::value<std::string>()->default_value("Z"), "Name of the PDF parameter")(
+        OUTPUT_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "The output packed PDF file (default: the pdf-file with the .pdfpack extension, e.g. pdf_z.pdfpack, the name "
+        "PlotSpecZComparison looks for next to pdf_z.fits)")(
+        CHUNK_SIZE.c_str(), po::value<int>()->default_value(10000), "Number of catalog rows read at once");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto catalog_file = getMandatory(args, PHZ_CATALOG);
+    auto pdf_file     = args.at(PDF_FILE).as<std::string>();
+    auto output_file  = args.at(OUTPUT_FILE).as<std::string>();
+    if (output_file.empty() && !pdf_file.empty()) {
+      output_file = boost::filesystem::path{pdf_file}.replace_extension(".pdfpack").string();
+    }
+    if (output_file.empty()) {
+      throw Elements::Exception() << "Missing " << OUTPUT_FILE;
+    }
+    auto pdf_column   = args.at(PDF_COLUMN).as<std::string>();
+    auto chunk_size   = args.at(CHUNK_SIZE).as<int>();
+    if (chunk_size <= 0) {
+      throw Elements::Exception() << "Invalid " << CHUNK_SIZE;
+    }
+
+    Table::FitsReader catalog_reader{catalog_file, 1};
+    auto              catalog_info = catalog_reader.getInfo();
+    auto              id_index     = getColumnIndex(catalog_info, args.at(ID_COLUMN).as<std::string>(), catalog_file);
+
+    std::unique_ptr<CCfits::FITS> pdf_fits{};
+    std::vector<double>           sampling{};
+    std::size_t                   pdf_index = 0;
+    if (pdf_file.empty()) {
+      logger.info() << "Read the PDFs from the column " << pdf_column << " of " << catalog_file;
+      sampling  = readPdfSampling(catalog_file, pdf_column);
+      pdf_index = getColumnIndex(catalog_info, pdf_column, catalog_file);
+    } else {
+      logger.info() << "Read the PDFs from " << pdf_file;
+      pdf_index = getColumnIndex(catalog_info, args.at(INDEX_COLUMN).as<std::string>(), catalog_file);
+      try {
+        pdf_fits.reset(new CCfits::FITS{pdf_file, CCfits::RWmode::Read});
+        auto& sampling_hdu = pdf_fits->extension(1);
+        sampling_hdu.column(1).read(sampling, 1, sampling_hdu.rows());
+      } catch (const CCfits::FitsException& e) {
+        throw Elements::Exception() << "Unable to read the PDF file " << pdf_file << " : " << e.message();
+      }
+    }
+
+    PackedPdfWriter     writer{output_file, sampling, args.at(PARAMETER).as<std::string>()};
+    std::size_t         total = catalog_reader.rowsLeft();
+    std::size_t         done  = 0;
+    std::vector<double> pdf{};
+    ToIntegerVisitor    to_integer{};
+    ToVectorVisitor     to_vector{pdf};
+    while (catalog_reader.hasMoreRows()) {
+      for (const auto& row : catalog_reader.read(chunk_size)) {
+        auto id = boost::apply_visitor(to_integer, row[id_index]);
+        if (pdf_fits) {
+          // The HDU 0 is the primary one and the HDU 1 holds the sampling
+          auto hdu = boost::apply_visitor(to_integer, row[pdf_index]) + 1;
+          try {
+            auto& pdf_hdu = pdf_fits->extension(static_cast<int>(hdu));
+            pdf_hdu.column("Probability").read(pdf, 1, pdf_hdu.rows());
+          } catch (const CCfits::FitsException& e) {
+            throw Elements::Exception() << "Unable to read the PDF of the source " << id << " : " << e.message();
+          }
+        } else {
+          boost::apply_visitor(to_vector, row[pdf_index]);
+        }
+        if (pdf.size() != sampling.size()) {
+          throw Elements::Exception() << "The PDF of the source " << id << " does not match the sampling";
+        }
+        writer.addPdf(id, pdf.data());
+      }
+      done = total - catalog_reader.rowsLeft();
+      logger.info() << "Packed " << done << " / " << total << " sources";
+    }
+    writer.close();
+    logger.info() << "Written " << output_file;
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static std::string getMandatory(std::map<std::string, po::variable_value>& args, const std::string& name) {
+    auto value = args.at(name).as<std::string>();
+    if (value.empty()) {
+      throw Elements::Exception() << "Missing " << name;
+    }
+    return value;
+  }
+};
+
+MAIN_FOR(PackPdfs)
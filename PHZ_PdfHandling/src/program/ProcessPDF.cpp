@@ -22,6 +22,7 @@
  * @author fdubath
  */
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
@@ -34,6 +35,7 @@
 #include "MathUtils/PDF/Cumulative.h"
 #include "MathUtils/PDF/PdfModeExtraction.h"
 #include "PHZ_PdfHandling/PdfHandlingConfiguration.h"
+#include "PHZ_PdfHandling/PdfKernels.h"
 #include "PhzConfiguration/RedshiftConfig.h"
 #include "Table/FitsReader.h"
 #include "Table/FitsWriter.h"
@@ -41,9 +43,7 @@
 #include <boost/program_options.hpp>
 #include <cmath>
 
-#include <CCfits/CCfits>
 #include <SourceCatalog/Source.h>
-#include <regex>
 
 using namespace Euclid;
 using namespace Euclid::Configuration;
@@ -77,42 +77,9 @@ public:
 
     std::string pdf_col_name = config_manager.getConfiguration<PdfHandlingConfiguration>().getPdfColName();
 
-    std::regex likelihood_regex("LIKELIHOOD");
-
     logger.info("# Get the redshift sampling");
-    CCfits::FITS    fits_file(config_manager.getConfiguration<PdfHandlingConfiguration>().getInputCatalogName());
-    CCfits::ExtHDU& extension = fits_file.extension(1);
-    std::string     comments  = extension.getComments();
-
-    std::regex range_regex("LIKELIHOOD-Z-BINS : \\{[0-9., \\r\\n]+\\}");
-    if (regex_search(pdf_col_name, likelihood_regex)) {
-      // Likelihood Case
-
-    } else {
-      // Posterior case
-      range_regex = std::regex("(^Z|[^-]Z)-BINS : \\{[0-9., \\r\\n]+\\}");
-    }
-
-    std::smatch         range_match;
-    std::vector<double> pdf_sampling{};
-
-    if (std::regex_search(comments, range_match, range_regex)) {
-      std::string ranges = range_match[0];
-      ranges.erase(std::remove(ranges.begin(), ranges.end(), '\n'), ranges.end());
-      ranges.erase(std::remove(ranges.begin(), ranges.end(), '\r'), ranges.end());
-      ranges.erase(std::remove(ranges.begin(), ranges.end(), ' '), ranges.end());
-      std::regex             number_regex = std::regex("[0-9.]+");
-      std::smatch            res;
-      string::const_iterator searchStart(ranges.cbegin());
-      while (regex_search(searchStart, ranges.cend(), res, number_regex)) {
-        pdf_sampling.push_back(atof(res[0].str().c_str()));
-        searchStart = res.suffix().first;
-      }
-    } else {
-      //=> no range found
-      logger.error("The Pdf sampling was not found in the comments");
-      throw Elements::Exception() << "The Pdf sampling was not found in the comments";
-    }
+    std::vector<double> pdf_sampling = readPdfSampling(
+        config_manager.getConfiguration<PdfHandlingConfiguration>().getInputCatalogName(), pdf_col_name);
 
     uint        chunk_size  = config_manager.getConfiguration<PdfHandlingConfiguration>().getChunkSize();
     std::string id_col_name = config_manager.getConfiguration<PdfHandlingConfiguration>().getIdColumnName();
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PackedPdf_test.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include "PHZ_PdfHandling/PackedPdfReader.h"
+#include "PHZ_PdfHandling/PackedPdfWriter.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <vector>
+
+using namespace Euclid::PHZ_PdfHandling;
+
+struct PackedPdf_Fixture {
+  Elements::TempDir   temp_dir{};
+  std::string         file_name = (temp_dir.path() / "pdf_z.pdfpack").string();
+  std::vector<double> sampling{0., 0.5, 1., 1.5, 2.};
+};
+
+BOOST_AUTO_TEST_SUITE(PackedPdf_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(roundTrip_test, PackedPdf_Fixture) {
+  // GIVEN
+  std::vector<std::int64_t>        ids{42, -3, 1000, 7};
+  std::vector<std::vector<double>> pdfs{};
+  for (std::size_t row = 0; row < ids.size(); ++row) {
+    pdfs.push_back({0.1 * row, 0.2, 0.3, 0.4, 0.5 + row});
+  }
+
+  // WHEN
+  PackedPdfWriter writer{file_name, sampling, "Z"};
+  for (std::size_t row = 0; row < ids.size(); ++row) {
+    writer.addPdf(ids[row], pdfs[row].data());
+  }
+  writer.close();
+  PackedPdfReader reader{file_name};
+
+  // THEN
+  BOOST_CHECK_EQUAL(reader.getParameter(), "Z");
+  BOOST_CHECK_EQUAL_COLLECTIONS(reader.getSampling().begin(), reader.getSampling().end(), sampling.begin(),
+                                sampling.end());
+  BOOST_CHECK_EQUAL(reader.size(), ids.size());
+  for (std::size_t row = 0; row < ids.size(); ++row) {
+    BOOST_CHECK_EQUAL(reader.getId(row), ids[row]);
+    BOOST_CHECK_EQUAL(reader.findRow(ids[row]), static_cast<std::ptrdiff_t>(row));
+    auto pdf = reader.findPdf(ids[row]);
+    BOOST_REQUIRE(pdf == reader.getPdf(row));
+    for (std::size_t bin = 0; bin < sampling.size(); ++bin) {
+      BOOST_CHECK_EQUAL(pdf[bin], static_cast<float>(pdfs[row][bin]));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(missingId_test, PackedPdf_Fixture) {
+  // GIVEN
+  std::vector<float> pdf(sampling.size(), 1.f);
+  PackedPdfWriter    writer{file_name, sampling};
+  writer.addPdf(1, pdf.data());
+  writer.addPdf(3, pdf.data());
+  writer.close();
+
+  // WHEN
+  PackedPdfReader reader{file_name};
+
+  // THEN
+  BOOST_CHECK_EQUAL(reader.getParameter(), "");
+  BOOST_CHECK_EQUAL(reader.findRow(0), -1);
+  BOOST_CHECK_EQUAL(reader.findRow(2), -1);
+  BOOST_CHECK_EQUAL(reader.findRow(4), -1);
+  BOOST_CHECK(reader.findPdf(2) == nullptr);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(emptyFile_test, PackedPdf_Fixture) {
+  // GIVEN
+  PackedPdfWriter writer{file_name, sampling};
+  writer.close();
+
+  // WHEN
+  PackedPdfReader reader{file_name};
+
+  // THEN
+  BOOST_CHECK_EQUAL(reader.size(), 0);
+  BOOST_CHECK_EQUAL(reader.findRow(1), -1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(duplicatedId_test, PackedPdf_Fixture) {
+  // GIVEN
+  std::vector<float> pdf(sampling.size(), 1.f);
+  {
+    PackedPdfWriter writer{file_name, sampling};
+    writer.addPdf(5, pdf.data());
+    writer.addPdf(5, pdf.data());
+
+    // THEN
+    BOOST_CHECK_THROW(writer.close(), Elements::Exception);
+  }
+  BOOST_CHECK(!boost::filesystem::exists(file_name));
+  BOOST_CHECK(boost::filesystem::is_empty(temp_dir.path()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalidFile_test, PackedPdf_Fixture) {
+  // GIVEN
+  {
+    std::ofstream out{file_name};
+    out << "This is not a packed PDF file, but it is longer than the header of one of them";
+  }
+
+  // THEN
+  BOOST_CHECK_THROW(PackedPdfReader{file_name}, Elements::Exception);
+  BOOST_CHECK_THROW(PackedPdfReader{file_name + ".missing"}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalidCounts_test, PackedPdf_Fixture) {
+  // GIVEN
+  std::vector<double> two_bins{0., 1.};
+  std::vector<float>  pdf(two_bins.size(), 1.f);
+  {
+    PackedPdfWriter writer{file_name, two_bins};
+    writer.addPdf(1, pdf.data());
+    writer.addPdf(2, pdf.data());
+    writer.close();
+  }
+
+  // WHEN
+  // With 2 bins a source takes 32 bytes, so adding 2^59 sources to the header
+  // overflows the offsets back to the same file size
+  std::uint64_t source_no = 2 + (std::uint64_t{1} << 59);
+  {
+    std::fstream file{file_name, std::ios::in | std::ios::out | std::ios::binary};
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(&source_no), sizeof(source_no));
+  }
+
+  // THEN
+  BOOST_CHECK_THROW(PackedPdfReader{file_name}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PdfKernels_test.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PdfKernels.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace Euclid::PHZ_PdfHandling;
+
+BOOST_AUTO_TEST_SUITE(PdfKernels_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(simpson_test) {
+  // Exact for a quadratic with an odd number of irregular samples
+  std::vector<double> x{0., 0.5, 2.};
+  std::vector<double> y{0., 0.25, 4.};
+  BOOST_CHECK_CLOSE(simpson(x.data(), y.data(), x.size()), 8. / 3., 1e-10);
+
+  // Exact for a linear function with an even number of samples
+  std::vector<double> x2{0., 1., 2., 3.};
+  std::vector<double> y2{1., 3., 5., 7.};
+  BOOST_CHECK_CLOSE(simpson(x2.data(), y2.data(), x2.size()), 12., 1e-10);
+
+  BOOST_CHECK_EQUAL(simpson(x.data(), y.data(), 1), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(cumulativeSimpson_test) {
+  std::vector<double> x{0., 0.1, 0.3, 0.4, 0.8, 1.0, 1.5, 1.6};
+  std::vector<double> y{};
+  for (auto value : x) {
+    y.push_back(std::sin(value) + 2.);
+  }
+  std::vector<double> cumul(x.size());
+  cumulativeSimpson(x.data(), y.data(), x.size(), cumul.data());
+
+  BOOST_CHECK_EQUAL(cumul[0], 0.);
+  for (std::size_t size = 2; size <= x.size(); ++size) {
+    BOOST_CHECK_CLOSE(cumul[size - 1], simpson(x.data(), y.data(), size), 1e-10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(pitAndCrps_uniform_test) {
+  // Uniform PDF on [0, 1]: F(x) = x
+  std::vector<double> bins{};
+  std::vector<double> pdf{};
+  for (int i = 0; i <= 8; ++i) {
+    bins.push_back(i / 8.);
+    pdf.push_back(2.);
+  }
+  std::vector<double> workspace{};
+
+  // The reference is a node
+  auto result = computePitAndCrps(bins, pdf.data(), 0.5, workspace);
+  BOOST_CHECK_CLOSE(result.first, 0.5, 1e-10);
+  BOOST_CHECK_CLOSE(result.second, 1. / 12., 1e-10);
+
+  // The reference is between two nodes
+  result = computePitAndCrps(bins, pdf.data(), 0.3, workspace);
+  BOOST_CHECK_CLOSE(result.first, 0.3, 1e-10);
+  BOOST_CHECK_CLOSE(result.second, (std::pow(0.3, 3) + std::pow(0.7, 3)) / 3., 1.);
+
+  // The reference is outside of the sampling
+  result = computePitAndCrps(bins, pdf.data(), 2., workspace);
+  BOOST_CHECK_EQUAL(result.first, 1.);
+  BOOST_CHECK_GT(result.second, 1.);
+  result = computePitAndCrps(bins, pdf.data(), -1., workspace);
+  BOOST_CHECK_EQUAL(result.first, 0.);
+  BOOST_CHECK_GT(result.second, 1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(pitAndCrps_undefined_test) {
+  std::vector<double> bins{0., 1., 2.};
+  std::vector<double> pdf{0., 0., 0.};
+  std::vector<double> workspace{};
+  auto                result = computePitAndCrps(bins, pdf.data(), 1., workspace);
+  BOOST_CHECK(std::isnan(result.first));
+  BOOST_CHECK(std::isnan(result.second));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(pointEstimates_test) {
+  std::vector<double> bins{};
+  std::vector<double> pdf{};
+  for (int i = 0; i <= 200; ++i) {
+    bins.push_back(0.01 * i);
+    pdf.push_back(std::exp(-0.5 * std::pow((bins.back() - 1.2) / 0.1, 2)));
+  }
+  std::vector<double> workspace{};
+
+  BOOST_CHECK_CLOSE(computeMode(bins, pdf.data()), 1.2, 1e-10);
+  BOOST_CHECK_CLOSE(computeMean(bins, pdf.data(), workspace), 1.2, 1e-6);
+  // Half way between the two samples around the center of the cumulative sum
+  BOOST_CHECK_CLOSE(computeMedian(bins, pdf.data(), workspace), 1.195, 1e-6);
+
+  // The first of the highest samples
+  std::vector<double> flat(bins.size(), 1.);
+  BOOST_CHECK_EQUAL(computeMode(bins, flat.data()), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(fittedMode_test) {
+  std::vector<double> bins{};
+  std::vector<double> pdf{};
+  for (int i = 0; i <= 20; ++i) {
+    bins.push_back(0.1 * i);
+    pdf.push_back(std::max(0., 1. - std::pow(bins.back() - 1.234, 2)));
+  }
+
+  BOOST_CHECK_CLOSE(computeFittedMode(bins, pdf.data(), 0.7), 1.234, 1e-8);
+  // With a threshold of 1 only the mode is selected
+  BOOST_CHECK_CLOSE(computeFittedMode(bins, pdf.data(), 1.), 1.2, 1e-10);
+
+  // A convex shape keeps the mode
+  std::vector<double> convex{};
+  for (auto bin : bins) {
+    convex.push_back(1. + std::pow(bin - 1., 2));
+  }
+  BOOST_CHECK_EQUAL(computeFittedMode(bins, convex.data(), 0.), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(batch_test) {
+  std::vector<double> bins{};
+  for (int i = 0; i < 50; ++i) {
+    bins.push_back(0.1 * i);
+  }
+  std::size_t         source_no = 1000;
+  std::vector<double> pdfs{};
+  std::vector<double> references{};
+  for (std::size_t source = 0; source < source_no; ++source) {
+    double center = 0.5 + 4. * static_cast<double>(source) / source_no;
+    for (auto bin : bins) {
+      pdfs.push_back(std::exp(-std::pow(bin - center, 2)) + 0.01 * std::sin(bin * source));
+    }
+    references.push_back(center + 0.1);
+  }
+
+  std::vector<double> workspace{};
+  for (auto type : {PointEstimateType::MODE, PointEstimateType::MEAN, PointEstimateType::MEDIAN,
+                    PointEstimateType::FITTED_MODE}) {
+    std::vector<double> single(source_no), multi(source_no);
+    computePointEstimates(type, bins, pdfs.data(), source_no, single.data(), 1);
+    computePointEstimates(type, bins, pdfs.data(), source_no, multi.data(), 4);
+    BOOST_CHECK(single == multi);
+  }
+  std::vector<double> means(source_no);
+  computePointEstimates(PointEstimateType::MEAN, bins, pdfs.data(), source_no, means.data(), 4);
+  BOOST_CHECK_EQUAL(means[10], computeMean(bins, pdfs.data() + 10 * bins.size(), workspace));
+
+  std::vector<double> pits(source_no), crps(source_no);
+  computePitsAndCrps(bins, pdfs.data(), references.data(), source_no, pits.data(), crps.data(), 4);
+  for (std::size_t source : {0, 500, 999}) {
+    auto expected = computePitAndCrps(bins, pdfs.data() + source * bins.size(), references[source], workspace);
+    BOOST_CHECK_EQUAL(pits[source], expected.first);
+    BOOST_CHECK_EQUAL(crps[source], expected.second);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(findStackBin_test) {
+  std::vector<double> edges{0., 1., 2.};
+  BOOST_CHECK_EQUAL(findStackBin(edges, -1.), -1);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 0.), -1);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 0.5), 0);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 1.), 0);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 1.5), 1);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 2.), 1);
+  BOOST_CHECK_EQUAL(findStackBin(edges, 2.5), -1);
+  BOOST_CHECK_EQUAL(findStackBin(edges, std::nan("")), -1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(getShiftedBins_test) {
+  std::vector<double> expected{-2., -1., 0., 1., 2.};
+  auto                with_zero = getShiftedBins({0., 1., 2.});
+  BOOST_CHECK_EQUAL_COLLECTIONS(with_zero.begin(), with_zero.end(), expected.begin(), expected.end());
+  auto without_zero = getShiftedBins({1., 2.});
+  BOOST_CHECK_EQUAL_COLLECTIONS(without_zero.begin(), without_zero.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PdfValidationStatistics_test.cpp
+ * @date 10/19/26
+ */
+
+#include "PHZ_PdfHandling/PdfValidationStatistics.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Euclid::PHZ_PdfHandling;
+
+BOOST_AUTO_TEST_SUITE(PdfValidationStatistics_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(computeStackEdges_test) {
+  auto                edges = PdfValidationStatistics::computeStackEdges({0., 1., 2., 3., 4.}, 2);
+  std::vector<double> expected{0., 2., 4.};
+  BOOST_CHECK_EQUAL_COLLECTIONS(edges.begin(), edges.end(), expected.begin(), expected.end());
+
+  // The edges span the sampling, whatever its first node
+  edges    = PdfValidationStatistics::computeStackEdges({1., 2., 3., 5.}, 2);
+  expected = {1., 3., 5.};
+  BOOST_CHECK_EQUAL_COLLECTIONS(edges.begin(), edges.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(stacks_test) {
+  // GIVEN
+  PdfValidationStatistics statistics{{0., 1., 2., 3., 4.}, {0., 2., 4.}};
+
+  // WHEN
+  statistics.addSources({0., 0., 2., 0., 0.}, {2.5}, {1.5}, 1);
+
+  // THEN
+  auto& reference = statistics.getReferenceStack();
+  BOOST_CHECK_EQUAL(reference.size(), 10);
+  BOOST_CHECK_EQUAL(reference[2 * 2 + 0], 1.);
+  BOOST_CHECK_EQUAL(reference[2 * 2 + 1], 0.);
+
+  // Shifted by the reference value 1.5, stacked in the bin of the point estimate 2.5
+  auto& shifted_bins = statistics.getShiftedBins();
+  auto& shifted      = statistics.getShiftedStack();
+  BOOST_CHECK_EQUAL(shifted_bins.size(), 9);
+  BOOST_CHECK_EQUAL(shifted.size(), 18);
+  double total = 0.;
+  for (std::size_t node = 0; node < shifted_bins.size(); ++node) {
+    BOOST_CHECK_EQUAL(shifted[node * 2], 0.);
+    total += shifted[node * 2 + 1];
+  }
+  BOOST_CHECK_CLOSE(shifted[4 * 2 + 1], 0.5, 1e-10);
+  BOOST_CHECK_CLOSE(shifted[5 * 2 + 1], 0.5, 1e-10);
+  BOOST_CHECK_CLOSE(total, 1., 1e-10);
+
+  BOOST_CHECK_EQUAL(statistics.getSourceNumber(), 1);
+  BOOST_CHECK_GT(statistics.getPits()[0], 0.);
+  BOOST_CHECK_LT(statistics.getPits()[0], 1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+  // GIVEN
+  std::vector<double> bins{};
+  for (int i = 0; i <= 50; ++i) {
+    bins.push_back(i * 0.1);
+  }
+  auto                             edges = PdfValidationStatistics::computeStackEdges(bins, 5);
+  std::mt19937                     generator{42};
+  std::uniform_real_distribution<> uniform{0., 5.};
+  std::vector<double>              pdfs{};
+  std::vector<double>              point_estimates{};
+  std::vector<double>              reference_values{};
+  for (int source = 0; source < 3000; ++source) {
+    double center = uniform(generator);
+    for (auto z : bins) {
+      pdfs.push_back(std::exp(-(z - center) * (z - center) / 0.1));
+    }
+    point_estimates.push_back(center);
+    reference_values.push_back(uniform(generator));
+  }
+
+  // WHEN
+  PdfValidationStatistics single{bins, edges};
+  single.addSources(pdfs, point_estimates, reference_values, 1);
+  PdfValidationStatistics multi{bins, edges};
+  multi.addSources(pdfs, point_estimates, reference_values, 4);
+  multi.addSources(pdfs, point_estimates, reference_values, 4);
+
+  // THEN
+  BOOST_CHECK_EQUAL(multi.getSourceNumber(), 6000);
+  for (std::size_t index = 0; index < single.getReferenceStack().size(); ++index) {
+    BOOST_CHECK_CLOSE(multi.getReferenceStack()[index], 2 * single.getReferenceStack()[index], 1e-8);
+  }
+  for (std::size_t index = 0; index < single.getShiftedStack().size(); ++index) {
+    BOOST_CHECK_CLOSE(multi.getShiftedStack()[index], 2 * single.getShiftedStack()[index], 1e-8);
+  }
+  for (std::size_t index = 0; index < single.getSourceNumber(); ++index) {
+    BOOST_CHECK_EQUAL(multi.getPits()[index], single.getPits()[index]);
+    BOOST_CHECK_EQUAL(multi.getCrps()[index + 3000], single.getCrps()[index]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(computeHistogram_test) {
+  auto histogram = PdfValidationStatistics::computeHistogram({0.f, 0.5f, 1.f, std::nanf(""), 2.f}, 0., 1., 2);
+  BOOST_CHECK_EQUAL(histogram.size(), 2);
+  BOOST_CHECK_EQUAL(histogram[0], 1);
+  BOOST_CHECK_EQUAL(histogram[1], 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzCLI/AuxDataIndex.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZCLI_AUXDATAINDEX_H
+#define _PHZCLI_AUXDATAINDEX_H
+
+#include "XYDataset/QualifiedName.h"
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzCLI {
+
+/**
+ * @class AuxDataIndex
+ *
+ * @brief Persistent index of the datasets of an auxiliary data directory.
+ *
+ * @details
+ * Listing the datasets with a FileSystemProvider parses every file of the
+ * directory tree. This index keeps, for each file, its qualified dataset name
+ * (built like the FileSystemProvider does, from the sub-directories and the
+ * name given by the AsciiParser), its size, its modification time, its number
+ * of samples and its wavelength range. It also keeps the modification time of
+ * each directory.
+ *
+ * When the index is loaded the directories are checked, together with the size
+ * and modification time of the files of the checked group: if none of them has
+ * changed, no file is read. Otherwise the tree is walked and only the files
+ * which are new or whose size or modification time differ are parsed, in
+ * parallel. The directories and files modified during the second of the
+ * previous scan are always checked again, as their modification time cannot
+ * tell if they have been modified after it. Editing in place a file outside of
+ * the checked group does not modify its directory, so it is detected only with
+ * the next walk of the tree, or immediately with the refresh flag which forces
+ * all the files to be parsed.
+ *
+ * The hidden files and directories (starting with '.') are ignored.
+ */
+class AuxDataIndex {
+
+public:
+  /// The indexed information of a dataset
+  struct Entry {
+    XYDataset::QualifiedName name;
+    /// The path of the file, relative to the root directory
+    std::string    path;
+    std::uintmax_t size;
+    std::time_t    modified;
+    std::size_t    samples;
+    double         min_wavelength;
+    double         max_wavelength;
+  };
+
+  /**
+   * @brief Get the default index file of a directory: a hidden file next to it
+   * (".Filters.phosphoros_index" for the directory "Filters"). It is kept out
+   * of the directory because creating it modifies the directory.
+   */
+  static boost::filesystem::path getDefaultIndexFile(const boost::filesystem::path& root);
+
+  /**
+   * @brief Constructor, loads the index and updates it to the current content
+   * of the directory, saving it back if it changed
+   *
+   * @param root
+   * The directory to index
+   *
+   * @param index_file
+   * The file into which the index is persisted. If empty the index is kept in
+   * memory only. If it cannot be written a warning is logged.
+   *
+   * @param thread_number
+   * The number of threads parsing the files, 0 for one per core
+   *
+   * @param refresh
+   * If true the persisted index is ignored and all the files are parsed
+   *
+   * @param checked_group
+   * The group whose files are compared with their size and modification time
+   * even if the directories are unchanged, empty for all the files
+   *
+   * @throws Elements::Exception
+   * If the root is not a directory
+   */
+  AuxDataIndex(boost::filesystem::path root, boost::filesystem::path index_file = "", std::size_t thread_number = 0,
+               bool refresh = false, const std::string& checked_group = "");
+
+  /// The indexed directory
+  const boost::filesystem::path& getRoot() const;
+
+  /// All the datasets, in the alphabetical order of their names
+  const std::vector<Entry>& getEntries() const;
+
+  /**
+   * @brief Get the datasets of a group matching the given patterns
+   *
+   * @param group
+   * The group the datasets must belong to, empty for all
+   *
+   * @param glob
+   * A shell wildcard pattern the qualified name must match ('*' also matches
+   * '/'), empty for any
+   *
+   * @param regex
+   * A regular expression the whole qualified name must match, empty for any
+   *
+   * @throws Elements::Exception
+   * If the regular expression is malformed
+   */
+  std::vector<const Entry*> list(const std::string& group, const std::string& glob = "",
+                                 const std::string& regex = "") const;
+
+  /// Get the dataset with the given qualified name, or nullptr if there is none
+  const Entry* find(const std::string& qualified_name) const;
+
+  /// The number of files which have been parsed to update the index
+  std::size_t getParsedFileNumber() const;
+
+private:
+  struct FileState {
+    std::uintmax_t size;
+    std::time_t    modified;
+    bool           parsable;
+    std::string    name;
+    std::size_t    samples;
+    double         min_wavelength;
+    double         max_wavelength;
+  };
+
+  bool load();
+
+  void save() const;
+
+  bool directoriesUnchanged() const;
+
+  bool filesUnchanged(const std::string& group) const;
+
+  void scan(std::size_t thread_number);
+
+  void buildEntries();
+
+  boost::filesystem::path            m_root;
+  boost::filesystem::path            m_index_file;
+  std::map<std::string, std::time_t> m_directories{};
+  std::map<std::string, FileState>   m_files{};
+  std::vector<Entry>                 m_entries{};
+  std::map<std::string, std::size_t> m_entry_indices{};
+  std::size_t                        m_parsed_file_number = 0;
+  std::time_t                        m_scan_time          = 0;
+
+}; /* End of AuxDataIndex class */
+
+} /* namespace PhzCLI */
+} /* namespace Euclid */
+
+#endif
@@ -26,7 +26,11 @@
 #define _PHZCLI_CREATEFLATGRIDPRIORCONFIG_H
 
 #include "Configuration/Configuration.h"
+#include "PhzDataModel/PhzModel.h"
 #include <boost/filesystem.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
 
 namespace Euclid {
 namespace PhzCLI {
@@ -52,8 +56,19 @@ public:
 
   const boost::filesystem::path& getGridPriorFilename() const;
 
+  /// The number of regions written in parallel, 0 for one per core
+  std::size_t getThreadNumber() const;
+
+  /**
+   * @brief The axes of the model grid regions. Only the grid info header of the
+   * model grid file is read, not the photometries.
+   */
+  const std::map<std::string, PhzDataModel::ModelAxesTuple>& getRegionAxes() const;
+
 private:
-  boost::filesystem::path m_filename;
+  boost::filesystem::path                             m_filename;
+  std::size_t                                         m_thread_number = 1;
+  std::map<std::string, PhzDataModel::ModelAxesTuple> m_region_axes{};
 
 }; /* End of CreateFlatGridPriorConfig class */
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzCLI/FlatGridPriorWriter.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZCLI_FLATGRIDPRIORWRITER_H
+#define _PHZCLI_FLATGRIDPRIORWRITER_H
+
+#include "PhzDataModel/PhzModel.h"
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace Euclid {
+namespace PhzCLI {
+
+/**
+ * @class FlatGridPriorWriter
+ *
+ * @brief Write a flat grid prior, with the same value in all the cells, in the
+ * format of GridContainer::gridFitsExport.
+ *
+ * @details
+ * The regions are exported independently, each one to its own temporary file
+ * in the directory of the output file, by a pool of threads. Only the grids of
+ * the regions being exported are in memory at any time, so the memory needed
+ * is bounded by the number of threads times the size of the largest region
+ * instead of the size of the whole parameter space. The extension HDUs of the
+ * temporary files are then concatenated, in the order of the regions map, into
+ * the output file, which is the same as the one created by calling
+ * gridFitsExport for each region in turn.
+ */
+class FlatGridPriorWriter {
+
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param regions
+   * The axes of the parameter space regions, as in the PhotometryGridInfo
+   *
+   * @param value
+   * The value of all the cells of the prior
+   */
+  FlatGridPriorWriter(std::map<std::string, PhzDataModel::ModelAxesTuple> regions, double value = 1.);
+
+  /**
+   * @brief Write the prior, replacing any existing file
+   *
+   * @param file
+   * The output file
+   *
+   * @param thread_number
+   * The number of regions exported in parallel, 0 for one per core
+   *
+   * @throws Elements::Exception
+   * If a region or the output file cannot be written
+   */
+  void write(const boost::filesystem::path& file, std::size_t thread_number = 1) const;
+
+private:
+  std::map<std::string, PhzDataModel::ModelAxesTuple> m_regions;
+  double                                              m_value;
+
+}; /* End of FlatGridPriorWriter class */
+
+} /* namespace PhzCLI */
+} /* namespace Euclid */
+
+#endif
@@ -28,7 +28,8 @@
 #include <string>
 
 #include "Configuration/Configuration.h"
-#include "XYDataset/XYDatasetProvider.h"
+#include "PhzCLI/AuxDataIndex.h"
+#include <memory>
 
 namespace Euclid {
 namespace PhzCLI {
@@ -64,8 +65,12 @@ public:
   /// Initializes
   void initialize(const UserValues& args) override;
 
-  std::shared_ptr<XYDataset::XYDatasetProvider> getDatasetProvider() {
-    return m_provider;
+  /// The machine readable formats supported by the output
+  enum class OutputFormat { TEXT, TSV, JSON };
+
+  /// The index of the listed directory
+  const AuxDataIndex& getIndex() const {
+    return *m_index;
   }
 
   const std::string& getGroup() const {
@@ -80,11 +85,28 @@ public:
     return m_show_data;
   }
 
+  /// The wildcard pattern the listed names must match, empty for any
+  const std::string& getGlob() const {
+    return m_glob;
+  }
+
+  /// The regular expression the listed names must match, empty for any
+  const std::string& getRegex() const {
+    return m_regex;
+  }
+
+  OutputFormat getFormat() const {
+    return m_format;
+  }
+
 private:
-  std::shared_ptr<XYDataset::XYDatasetProvider> m_provider;
-  std::string                                   m_group;
-  std::string                                   m_dataset_to_show;
-  bool                                          m_show_data{false};
+  std::shared_ptr<AuxDataIndex> m_index;
+  std::string                   m_group;
+  std::string                   m_dataset_to_show;
+  bool                          m_show_data{false};
+  std::string                   m_glob;
+  std::string                   m_regex;
+  OutputFormat                  m_format{OutputFormat::TEXT};
 
 }; /* End of LsAuxDirConfig class */
 
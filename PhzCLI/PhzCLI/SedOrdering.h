@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzCLI/SedOrdering.h
+ * @date 10/19/26
+ */
+
+#ifndef _PHZCLI_SEDORDERING_H
+#define _PHZCLI_SEDORDERING_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzCLI {
+
+/**
+ * @class SedOrdering
+ *
+ * @brief Order a set of SEDs so that each SED is followed by its most similar
+ * remaining one.
+ *
+ * @details
+ * The SEDs are resampled with a linear interpolation on a common grid, which
+ * spans the range covered by all of them with as many points as the densest
+ * SED has in this range, and are stored as the rows of a contiguous matrix.
+ * The distance between two SEDs is the chi square between the second one and
+ * the first one scaled to fit it. The ordering starts from a given SED (by
+ * default the brightest of the two most distant SEDs) and repeatedly appends
+ * the closest SED not already ordered.
+ *
+ * The result is the same as the one of the former Python implementation of
+ * PhosphorosOrderSeds: the sums are done in the same order and the ties are
+ * resolved in favor of the first SED of the input list.
+ */
+class SedOrdering {
+
+public:
+  /// The (wavelength, flux) values of a SED
+  typedef std::vector<std::pair<double, double>> SedData;
+
+  /**
+   * @brief Read all the SED files of a directory (not recursively), in the
+   * order they are listed by the file system. The hidden files and the files
+   * which cannot be parsed as SEDs are skipped.
+   *
+   * @return The (file name, data) pairs of the SEDs
+   */
+  static std::vector<std::pair<std::string, SedData>> readDirectory(const std::string& directory);
+
+  /**
+   * @brief Constructor, resamples the SEDs on their common grid
+   *
+   * @param seds
+   * The (name, data) pairs of the SEDs to order
+   *
+   * @throws Elements::Exception
+   * If there is no SED or if the SEDs do not overlap
+   */
+  explicit SedOrdering(const std::vector<std::pair<std::string, SedData>>& seds);
+
+  /// The names of the SEDs, in the input order
+  const std::vector<std::string>& getNames() const;
+
+  /// The common wavelength grid
+  const std::vector<double>& getWavelengths() const;
+
+  /// The resampled fluxes, one row of getWavelengths().size() values per SED
+  const std::vector<double>& getFluxes() const;
+
+  /**
+   * @brief Compute the symmetric matrix of the distances between all the SEDs
+   *
+   * @param thread_number
+   * The number of threads, 0 meaning all the cores
+   *
+   * @return The N x N distances, row major
+   */
+  std::vector<double> computeDistances(std::size_t thread_number = 0) const;
+
+  /**
+   * @brief Order the SEDs
+   *
+   * @param start
+   * The name of the first SED, if empty the brightest of the two most distant
+   * SEDs is used
+   * @param thread_number
+   * The number of threads used for the distances, 0 meaning all the cores
+   *
+   * @return The ordered SED names
+   *
+   * @throws Elements::Exception
+   * If the start SED is unknown
+   */
+  std::vector<std::string> order(const std::string& start = "", std::size_t thread_number = 0) const;
+
+private:
+  std::vector<std::string> m_names{};
+  std::vector<double>      m_wavelengths{};
+  std::vector<double>      m_fluxes{};
+};
+
+}  // namespace PhzCLI
+}  // namespace Euclid
+
+#endif  // _PHZCLI_SEDORDERING_H
@@ -30,6 +30,7 @@ import matplotlib.pyplot as plt
 import matplotlib.animation as animation
 
 import PhzCLI.TableUtils as tut
+from PHZ_PdfHandling.PackedPdf import PackedPdfReader
 
 from scipy.stats import gaussian_kde
 
@@ -173,7 +174,17 @@ def read_pdfs(catalog, out_dir):
             return parameter, get_pdf_bins_from_comment(catalog.meta[key_comment], parameter), \
                    catalog[parameter + '-1D-PDF']
 
-        elif out_dir and os.path.exists(out_dir + '/' + filename_map[parameter]):
+        packed_file = out_dir + '/' + os.path.splitext(filename_map[parameter])[0] + '.pdfpack' if out_dir else ''
+        if packed_file and os.path.exists(packed_file):
+            # Only the PDFs of the catalog sources are read from the mapped file
+            packed = PackedPdfReader(packed_file)
+            rows = packed.findRows(catalog['ID'])
+            if np.all(rows >= 0):
+                logger.info('    ' + parameter + ': Reading file ' + packed_file)
+                return parameter, packed.sampling, packed.pdfs[rows]
+            logger.warning('    ' + parameter + ': Some sources are missing in ' + packed_file)
+
+        if out_dir and os.path.exists(out_dir + '/' + filename_map[parameter]):
             logger.info(
                 '    ' + parameter + ': Reading file ' + out_dir + '/' + filename_map[parameter])
             hdus = fits.open(out_dir + '/' + filename_map[parameter])
@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/AuxDataIndex.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/AuxDataIndex.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzUITools/ParallelFor.h"
+#include "XYDataset/AsciiParser.h"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <boost/regex.hpp>
+#include <fnmatch.h>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+namespace fs = boost::filesystem;
+
+namespace Euclid {
+namespace PhzCLI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("AuxDataIndex");
+
+// Index file layout (tab separated), after the header line:
+//   T <time of the scan>
+//   D <directory path> <mtime>
+//   F <file path> <size> <mtime> <parsable> <dataset name> <samples> <min wavelength> <max wavelength>
+// The paths are relative to the root directory, which is part of the header
+static const std::string INDEX_HEADER = "# Phosphoros aux data index v1";
+
+namespace {
+
+bool isHidden(const fs::path& path) {
+  auto name = path.filename().string();
+  return name.empty() || name[0] == '.';
+}
+
+std::string relativePath(const fs::path& root, const fs::path& path) {
+  auto root_string = root.generic_string();
+  auto path_string = path.generic_string();
+  if (path_string.size() <= root_string.size()) {
+    return "";
+  }
+  return path_string.substr(root_string.back() == '/' ? root_string.size() : root_string.size() + 1);
+}
+
+}  // namespace
+
+fs::path AuxDataIndex::getDefaultIndexFile(const fs::path& root) {
+  auto directory = fs::absolute(root);
+  while (directory.filename() == "." || directory.filename() == "/") {
+    directory = directory.parent_path();
+  }
+  return directory.parent_path() / ("." + directory.filename().string() + ".phosphoros_index");
+}
+
+AuxDataIndex::AuxDataIndex(fs::path root, fs::path index_file, std::size_t thread_number, bool refresh,
+                           const std::string& checked_group)
+    : m_root{std::move(root)}, m_index_file{std::move(index_file)} {
+  if (!fs::is_directory(m_root)) {
+    throw Elements::Exception() << m_root.string() << " is not a directory";
+  }
+  if (!refresh && load() && directoriesUnchanged() && filesUnchanged(checked_group)) {
+    logger.debug() << "Using the index " << m_index_file.string();
+  } else {
+    if (refresh) {
+      m_files.clear();
+    }
+    scan(thread_number);
+    if (!m_index_file.empty()) {
+      save();
+    }
+  }
+  buildEntries();
+}
+
+const fs::path& AuxDataIndex::getRoot() const {
+  return m_root;
+}
+
+const std::vector<AuxDataIndex::Entry>& AuxDataIndex::getEntries() const {
+  return m_entries;
+}
+
+std::vector<const AuxDataIndex::Entry*> AuxDataIndex::list(const std::string& group, const std::string& glob,
+                                                           const std::string& regex) const {
+  std::string prefix = boost::algorithm::trim_right_copy_if(group, boost::algorithm::is_any_of("/"));
+  if (!prefix.empty()) {
+    prefix += '/';
+  }
+  boost::regex expression{};
+  if (!regex.empty()) {
+    try {
+      expression = boost::regex{regex};
+    } catch (const boost::regex_error& e) {
+      throw Elements::Exception() << "Malformed regular expression " << regex << " : " << e.what();
+    }
+  }
+
+  std::vector<const Entry*> result{};
+  for (auto& entry : m_entries) {
+    auto& name = entry.name.qualifiedName();
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    if (!glob.empty() && fnmatch(glob.c_str(), name.c_str(), 0) != 0) {
+      continue;
+    }
+    if (!regex.empty() && !boost::regex_match(name, expression)) {
+      continue;
+    }
+    result.push_back(&entry);
+  }
+  return result;
+}
+
+const AuxDataIndex::Entry* AuxDataIndex::find(const std::string& qualified_name) const {
+  auto index = m_entry_indices.find(qualified_name);
+  return index == m_entry_indices.end() ? nullptr : &m_entries[index->second];
+}
+
+std::size_t AuxDataIndex::getParsedFileNumber() const {
+  return m_parsed_file_number;
+}
+
+bool AuxDataIndex::load() {
+  if (m_index_file.empty()) {
+    return false;
+  }
+  std::ifstream in{m_index_file.string()};
+  std::string   line;
+  if (!std::getline(in, line) || line != INDEX_HEADER + '\t' + m_root.generic_string()) {
+    return false;
+  }
+  while (std::getline(in, line)) {
+    std::vector<std::string> tokens;
+    boost::split(tokens, line, boost::is_any_of("\t"));
+    try {
+      if (tokens.size() == 2 && tokens[0] == "T") {
+        m_scan_time = static_cast<std::time_t>(std::stoll(tokens[1]));
+      } else if (tokens.size() == 3 && tokens[0] == "D") {
+        m_directories[tokens[1]] = static_cast<std::time_t>(std::stoll(tokens[2]));
+      } else if (tokens.size() == 9 && tokens[0] == "F") {
+        FileState state{};
+        state.size           = std::stoull(tokens[2]);
+        state.modified       = static_cast<std::time_t>(std::stoll(tokens[3]));
+        state.parsable       = tokens[4] == "1";
+        state.name           = tokens[5];
+        state.samples        = std::stoull(tokens[6]);
+        state.min_wavelength = std::stod(tokens[7]);
+        state.max_wavelength = std::stod(tokens[8]);
+        m_files[tokens[1]]   = std::move(state);
+      }
+    } catch (const std::exception&) {
+      // A damaged line is ignored, the corresponding file is parsed again
+    }
+  }
+  return true;
+}
+
+void AuxDataIndex::save() const {
+  // A name of its own, so that concurrent savers never write the same file
+  auto          tmp_file = m_index_file.string() + fs::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+  std::ofstream out{tmp_file};
+  out.precision(std::numeric_limits<double>::max_digits10);
+  out << INDEX_HEADER << '\t' << m_root.generic_string() << '\n';
+  out << "T\t" << m_scan_time << '\n';
+  for (auto& directory : m_directories) {
+    out << "D\t" << directory.first << '\t' << directory.second << '\n';
+  }
+  for (auto& file : m_files) {
+    auto& state = file.second;
+    out << "F\t" << file.first << '\t' << state.size << '\t' << state.modified << '\t' << (state.parsable ? 1 : 0)
+        << '\t' << state.name << '\t' << state.samples << '\t' << state.min_wavelength << '\t'
+        << state.max_wavelength << '\n';
+  }
+  out.close();
+  boost::system::error_code error;
+  if (out) {
+    fs::rename(tmp_file, m_index_file, error);
+  }
+  if (!out || error) {
+    fs::remove(tmp_file, error);
+    logger.warn() << "Unable to write the index file " << m_index_file.string();
+  }
+}
+
+bool AuxDataIndex::directoriesUnchanged() const {
+  if (m_directories.empty()) {
+    return false;
+  }
+  boost::system::error_code error;
+  for (auto& directory : m_directories) {
+    auto path = directory.first.empty() ? m_root : m_root / directory.first;
+    // A directory modified during the second of the scan may have been modified again after it
+    auto modified = fs::last_write_time(path, error);
+    if (error || modified != directory.second || modified >= m_scan_time) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AuxDataIndex::filesUnchanged(const std::string& group) const {
+  std::string prefix = boost::algorithm::trim_right_copy_if(group, boost::algorithm::is_any_of("/"));
+  if (!prefix.empty()) {
+    prefix += '/';
+  }
+  boost::system::error_code error;
+  for (auto& file : m_files) {
+    if (file.first.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    auto path = m_root / file.first;
+    auto size = fs::file_size(path, error);
+    if (error || size != file.second.size) {
+      return false;
+    }
+    // A file modified during the second of the scan may have been modified again after it
+    auto modified = fs::last_write_time(path, error);
+    if (error || modified != file.second.modified || modified >= m_scan_time) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AuxDataIndex::scan(std::size_t thread_number) {
+  std::map<std::string, std::time_t> directories{};
+  std::map<std::string, FileState>   files{};
+  std::vector<std::string>           to_parse{};
+  auto                               scan_time = std::time(nullptr);
+
+  // Only the metadata of the files is read while walking the tree
+  std::function<void(const fs::path&)> walk = [&](const fs::path& directory) {
+    directories[relativePath(m_root, directory)] = fs::last_write_time(directory);
+    for (fs::directory_iterator it{directory}; it != fs::directory_iterator{}; ++it) {
+      auto& path = it->path();
+      if (isHidden(path)) {
+        continue;
+      }
+      if (fs::is_directory(path)) {
+        walk(path);
+      } else if (fs::is_regular_file(path)) {
+        auto      relative = relativePath(m_root, path);
+        FileState state{};
+        state.size     = fs::file_size(path);
+        state.modified = fs::last_write_time(path);
+        auto known     = m_files.find(relative);
+        if (known != m_files.end() && known->second.size == state.size && known->second.modified == state.modified &&
+            state.modified < m_scan_time) {
+          files[relative] = known->second;
+        } else {
+          files[relative] = state;
+          to_parse.push_back(relative);
+        }
+      }
+    }
+  };
+  walk(m_root);
+
+  // The parsing cost depends on the file size, so the files are handed out one at a time
+  PhzUITools::forEachIndex(to_parse.size(), thread_number, [&](std::size_t i) {
+    XYDataset::AsciiParser parser{};
+    auto                   file  = (m_root / to_parse[i]).string();
+    auto&                  state = files.at(to_parse[i]);
+    try {
+      state.parsable = parser.isParsable(file);
+      if (state.parsable) {
+        state.name           = parser.getName(file);
+        state.min_wavelength = std::numeric_limits<double>::infinity();
+        state.max_wavelength = -std::numeric_limits<double>::infinity();
+        auto dataset         = parser.getDataset(file);
+        state.samples        = dataset ? dataset->size() : 0;
+        state.parsable       = state.samples > 0;
+        if (dataset) {
+          for (auto& pair : *dataset) {
+            state.min_wavelength = std::min(state.min_wavelength, pair.first);
+            state.max_wavelength = std::max(state.max_wavelength, pair.first);
+          }
+        }
+      }
+    } catch (const std::exception& e) {
+      logger.debug() << "Unable to parse " << file << " : " << e.what();
+      state.parsable = false;
+    }
+  });
+
+  logger.info() << "Indexed " << files.size() << " files of " << m_root.string() << ", parsed " << to_parse.size();
+  m_parsed_file_number = to_parse.size();
+  m_scan_time          = scan_time;
+  m_directories        = std::move(directories);
+  m_files              = std::move(files);
+}
+
+void AuxDataIndex::buildEntries() {
+  m_entries.clear();
+  m_entry_indices.clear();
+  for (auto& file : m_files) {
+    auto& state = file.second;
+    if (!state.parsable) {
+      continue;
+    }
+    auto group = fs::path{file.first}.parent_path().generic_string();
+    m_entries.push_back(Entry{XYDataset::QualifiedName{group.empty() ? state.name : group + "/" + state.name},
+                              file.first, state.size, state.modified, state.samples, state.min_wavelength,
+                              state.max_wavelength});
+  }
+  XYDataset::QualifiedName::AlphabeticalComparator comparator{};
+  std::stable_sort(m_entries.begin(), m_entries.end(),
+                   [&comparator](const Entry& a, const Entry& b) { return comparator(a.name, b.name); });
+
+  // The files are in the order of their paths, so for duplicated names the
+  // first path is kept
+  std::vector<Entry> unique{};
+  for (auto& entry : m_entries) {
+    if (!unique.empty() && unique.back().name.qualifiedName() == entry.name.qualifiedName()) {
+      logger.warn() << "Dataset " << entry.name.qualifiedName() << " defined by both " << unique.back().path
+                    << " and " << entry.path << ", the second is ignored";
+      continue;
+    }
+    m_entry_indices[entry.name.qualifiedName()] = unique.size();
+    unique.push_back(std::move(entry));
+  }
+  m_entries = std::move(unique);
+}
+
+}  // namespace PhzCLI
+}  // namespace Euclid
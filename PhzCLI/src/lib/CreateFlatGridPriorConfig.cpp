@@ -23,7 +23,15 @@
  */
 
 #include "PhzCLI/CreateFlatGridPriorConfig.h"
+#include "ElementsKernel/Exception.h"
 #include "PhzConfiguration/AuxDataDirConfig.h"
+#include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/IntermediateDirConfig.h"
+#include "PhzDataModel/PhotometryGridInfo.h"
+#include "PhzDataModel/serialization/PhotometryGridInfo.h"
+#include <boost/archive/text_iarchive.hpp>
+#include <algorithm>
+#include <fstream>
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
@@ -33,11 +41,17 @@ namespace PhzCLI {
 
 CreateFlatGridPriorConfig::CreateFlatGridPriorConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<PhzConfiguration::AuxDataDirConfig>();
+  declareDependency<PhzConfiguration::CatalogTypeConfig>();
+  declareDependency<PhzConfiguration::IntermediateDirConfig>();
 }
 
 auto CreateFlatGridPriorConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return {{"Create Flat Grid Prior options",
-           {{"out-grid-name", po::value<std::string>()->required(), "The name of the prior grid to create"}}}};
+           {{"out-grid-name", po::value<std::string>()->required(), "The name of the prior grid to create"},
+            {"model-grid-file", po::value<std::string>(), "The path and filename of the model grid file"},
+            {"thread-no", po::value<int>()->default_value(1),
+             "The number of regions written in parallel (0 for one per core), each thread holding the grid of one "
+             "region in memory"}}}};
 }
 
 void CreateFlatGridPriorConfig::initialize(const UserValues& args) {
@@ -46,11 +60,45 @@ void CreateFlatGridPriorConfig::initialize(const UserValues& args) {
     auto& aux_dir = getDependency<PhzConfiguration::AuxDataDirConfig>().getAuxDataDir();
     m_filename    = aux_dir / "GenericPriors" / m_filename;
   }
+  m_thread_number = static_cast<std::size_t>(std::max(0, args.at("thread-no").as<int>()));
+
+  auto&    intermediate_dir = getDependency<PhzConfiguration::IntermediateDirConfig>().getIntermediateDir();
+  auto&    catalog_type     = getDependency<PhzConfiguration::CatalogTypeConfig>().getCatalogType();
+  fs::path grid_file        = intermediate_dir / catalog_type / "ModelGrids" / "model_grid.dat";
+  if (args.count("model-grid-file") > 0) {
+    grid_file = args.at("model-grid-file").as<std::string>();
+    if (!grid_file.is_absolute()) {
+      grid_file = intermediate_dir / catalog_type / "ModelGrids" / grid_file;
+    }
+  }
+  if (!fs::exists(grid_file)) {
+    throw Elements::Exception() << "Model grid file " << grid_file.string() << " does not exist";
+  }
+
+  // Only the grid info at the beginning of the file is needed, so the boost
+  // archive is read directly instead of loading the photometry grid
+  PhzDataModel::PhotometryGridInfo grid_info;
+  try {
+    std::ifstream                 in{grid_file.string()};
+    boost::archive::text_iarchive bia{in};
+    bia >> grid_info;
+  } catch (const std::exception& e) {
+    throw Elements::Exception() << "Unable to read the model grid file " << grid_file.string() << " : " << e.what();
+  }
+  m_region_axes = std::move(grid_info.region_axes_map);
 }
 
 const boost::filesystem::path& CreateFlatGridPriorConfig::getGridPriorFilename() const {
   return m_filename;
 }
 
+std::size_t CreateFlatGridPriorConfig::getThreadNumber() const {
+  return m_thread_number;
+}
+
+const std::map<std::string, PhzDataModel::ModelAxesTuple>& CreateFlatGridPriorConfig::getRegionAxes() const {
+  return m_region_axes;
+}
+
 }  // namespace PhzCLI
 }  // namespace Euclid
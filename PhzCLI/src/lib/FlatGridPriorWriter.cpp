@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/FlatGridPriorWriter.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/FlatGridPriorWriter.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "GridContainer/serialize.h"
+#include "PhzDataModel/DoubleGrid.h"
+#include "PhzUITools/ParallelFor.h"
+#include <fstream>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace Euclid {
+namespace PhzCLI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("FlatGridPriorWriter");
+
+namespace {
+
+constexpr std::size_t FITS_BLOCK_SIZE = 2880;
+constexpr std::size_t FITS_CARD_SIZE  = 80;
+
+// Returns the size in bytes of the primary HDU of a FITS file, which is
+// expected to have no data (as the ones created by CCfits for new files)
+std::size_t getPrimaryHduSize(std::istream& in, const fs::path& file) {
+  std::vector<char> block(FITS_BLOCK_SIZE);
+  std::size_t       size = 0;
+  while (in.read(block.data(), FITS_BLOCK_SIZE)) {
+    size += FITS_BLOCK_SIZE;
+    for (std::size_t card = 0; card < FITS_BLOCK_SIZE; card += FITS_CARD_SIZE) {
+      std::string keyword{block.data() + card, 8};
+      if (keyword == "NAXIS   ") {
+        std::string value{block.data() + card + 10, FITS_CARD_SIZE - 10};
+        if (std::stoi(value) != 0) {
+          throw Elements::Exception() << "Unexpected data in the primary HDU of " << file.string();
+        }
+      }
+      if (keyword == "END     ") {
+        return size;
+      }
+    }
+  }
+  throw Elements::Exception() << "Malformed FITS file " << file.string();
+}
+
+// Removes the temporary directory whatever the outcome of the export
+struct TemporaryDirectory {
+  explicit TemporaryDirectory(fs::path p) : path(std::move(p)) {
+    fs::create_directories(path);
+  }
+  ~TemporaryDirectory() {
+    boost::system::error_code ignored;
+    fs::remove_all(path, ignored);
+  }
+  fs::path path;
+};
+
+}  // namespace
+
+FlatGridPriorWriter::FlatGridPriorWriter(std::map<std::string, PhzDataModel::ModelAxesTuple> regions, double value)
+    : m_regions{std::move(regions)}, m_value{value} {}
+
+void FlatGridPriorWriter::write(const fs::path& file, std::size_t thread_number) const {
+  if (m_regions.empty()) {
+    throw Elements::Exception() << "The parameter space has no region";
+  }
+
+  auto               parent = file.has_parent_path() ? file.parent_path() : fs::current_path();
+  TemporaryDirectory temp_dir{parent / fs::unique_path(file.filename().string() + ".%%%%-%%%%-%%%%.tmp")};
+
+  std::vector<std::pair<const std::string*, const PhzDataModel::ModelAxesTuple*>> regions{};
+  std::vector<fs::path>                                                          parts{};
+  for (auto& pair : m_regions) {
+    regions.emplace_back(&pair.first, &pair.second);
+    parts.emplace_back(temp_dir.path / ("region_" + std::to_string(parts.size()) + ".fits"));
+  }
+
+  // Each thread exports one region at a time, so that only thread_number
+  // grids are in memory together
+  PhzUITools::forEachIndex(regions.size(), thread_number, [&](std::size_t i) {
+    PhzDataModel::DoubleGrid grid{*regions[i].second};
+    for (auto& cell : grid) {
+      cell = m_value;
+    }
+    GridContainer::gridFitsExport(parts[i], *regions[i].first, grid);
+    logger.debug() << "Exported region " << *regions[i].first;
+  });
+
+  // Concatenate the regions, keeping only the primary HDU of the first one
+  auto temp_file = temp_dir.path / "prior.fits";
+  {
+    std::ofstream out{temp_file.string(), std::ios::binary};
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+      std::ifstream in{parts[i].string(), std::ios::binary};
+      if (i > 0) {
+        in.seekg(getPrimaryHduSize(in, parts[i]));
+      }
+      out << in.rdbuf();
+      // The region file is not needed any more, release its disk space
+      in.close();
+      fs::remove(parts[i]);
+    }
+    if (!out) {
+      throw Elements::Exception() << "Unable to write the grid prior " << file.string();
+    }
+  }
+  fs::rename(temp_file, file);
+}
+
+}  // namespace PhzCLI
+}  // namespace Euclid
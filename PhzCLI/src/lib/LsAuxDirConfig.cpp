@@ -23,11 +23,10 @@
  */
 
 #include "PhzCLI/LsAuxDirConfig.h"
+#include "ElementsKernel/Exception.h"
 #include "PhzConfiguration/AuxDataDirConfig.h"
 #include "PhzConfiguration/ProgramOptionsHelper.h"
-#include "XYDataset/AsciiParser.h"
-#include "XYDataset/FileParser.h"
-#include "XYDataset/FileSystemProvider.h"
+#include <algorithm>
 #include <memory>
 
 namespace po = boost::program_options;
@@ -45,23 +44,53 @@ auto LsAuxDirConfig::getProgramOptions() -> std::map<std::string, OptionDescript
            {{"type", po::value<std::string>()->required(),
              "The type of the contents to list (one of SEDs, Filters or ReddeningCurves"},
             {"group", po::value<std::string>(), "List the contents of the given group"},
-            {"data", po::value<std::string>(), "Print the data of the given dataset"}}}};
+            {"data", po::value<std::string>(), "Print the data of the given dataset"},
+            {"glob", po::value<std::string>(),
+             "List only the datasets whose qualified name matches the wildcard pattern"},
+            {"regex", po::value<std::string>(),
+             "List only the datasets whose qualified name matches the regular expression"},
+            {"format", po::value<std::string>()->default_value("text"), "The output format (one of text, tsv or json)"},
+            {"index-file", po::value<std::string>(),
+             "The index file of the listed directory (default: .<directory>.phosphoros_index next to it)"},
+            {"refresh-index", po::bool_switch()->default_value(false),
+             "Parse all the files again instead of trusting the index (the files of the listed group are always "
+             "checked, the other files edited in place are only detected when a directory changes)"},
+            {"thread-no", po::value<int>()->default_value(0),
+             "The number of threads parsing the new files (0 for one per core)"}}}};
 }
 
 void LsAuxDirConfig::initialize(const UserValues& args) {
   m_group           = args.count("group") > 0 ? args.at("group").as<std::string>() : "";
   m_dataset_to_show = args.count("data") > 0 ? args.at("data").as<std::string>() : "";
   m_show_data       = args.count("data") > 0;
+  m_glob            = args.count("glob") > 0 ? args.at("glob").as<std::string>() : "";
+  m_regex           = args.count("regex") > 0 ? args.at("regex").as<std::string>() : "";
 
-  // Get the dataset provider to use. If the user didn't gave the data-root-path
-  // use the current directory
   std::string path = getDependency<AuxDataDirConfig>().getAuxDataDir().string();
   if ((args.count("type") > 0) && (args.at("type").as<std::string>().size() != 0)) {
     path += "/" + args.at("type").as<std::string>();
   }
-  std::unique_ptr<XYDataset::FileParser> file_parser{new XYDataset::AsciiParser{}};
-  m_provider =
-      std::shared_ptr<XYDataset::XYDatasetProvider>{new XYDataset::FileSystemProvider{path, std::move(file_parser)}};
+
+  std::string format = args.count("format") > 0 ? args.at("format").as<std::string>() : "text";
+  if (format == "text") {
+    m_format = OutputFormat::TEXT;
+  } else if (format == "tsv") {
+    m_format = OutputFormat::TSV;
+  } else if (format == "json") {
+    m_format = OutputFormat::JSON;
+  } else {
+    throw Elements::Exception() << "Unknown output format " << format << " (must be one of text, tsv or json)";
+  }
+
+  // Index the directory to list, reusing the index persisted by the previous calls
+  boost::filesystem::path index_file = AuxDataIndex::getDefaultIndexFile(path);
+  if (args.count("index-file") > 0) {
+    index_file = args.at("index-file").as<std::string>();
+  }
+  bool        refresh       = args.count("refresh-index") > 0 && args.at("refresh-index").as<bool>();
+  std::size_t thread_number = args.count("thread-no") > 0 ? std::max(0, args.at("thread-no").as<int>()) : 0;
+  // The files of the listed group are checked even if their directories are unchanged
+  m_index = std::make_shared<AuxDataIndex>(path, index_file, thread_number, refresh, m_group);
 }
 
 }  // namespace PhzCLI
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/SedOrdering.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/SedOrdering.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzUITools/ParallelFor.h"
+#include "XYDataset/AsciiParser.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cmath>
+
+namespace Euclid {
+namespace PhzCLI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SedOrdering");
+
+namespace {
+
+// Number of SEDs compared at once with a given SED
+constexpr std::size_t BLOCK_SIZE = 4;
+
+// Linear interpolation with the numpy.interp conventions, the SED being sorted
+double interpolate(const SedOrdering::SedData& sed, double x) {
+  if (x < sed.front().first) {
+    return sed.front().second;
+  }
+  if (x >= sed.back().first) {
+    return sed.back().second;
+  }
+  auto   upper = std::upper_bound(sed.begin(), sed.end(), x, [](double value, const std::pair<double, double>& point) {
+    return value < point.first;
+  });
+  auto&  hi    = *upper;
+  auto&  lo    = *(upper - 1);
+  double slope = (hi.second - lo.second) / (hi.first - lo.first);
+  double value = slope * (x - lo.first) + lo.second;
+  if (std::isnan(value)) {
+    value = slope * (x - hi.first) + hi.second;
+    if (std::isnan(value) && lo.second == hi.second) {
+      value = lo.second;
+    }
+  }
+  return value;
+}
+
+/*
+ * Compute the distances between the SED of the given row and all the following
+ * ones. Each block of SEDs is processed in a single pass over the samples with
+ * independent accumulators, each sum being done in the sample order.
+ */
+void computeRow(const std::vector<double>& fluxes, const std::vector<double>& norms, std::size_t sed_no,
+                std::size_t sample_no, std::size_t row, std::vector<double>& distances) {
+  const double* first = fluxes.data() + row * sample_no;
+  for (std::size_t column = row + 1; column < sed_no; column += BLOCK_SIZE) {
+    std::size_t   count = std::min(BLOCK_SIZE, sed_no - column);
+    const double* second[BLOCK_SIZE];
+    for (std::size_t b = 0; b < BLOCK_SIZE; ++b) {
+      // The unused slots of the last block repeat its last SED
+      second[b] = fluxes.data() + (column + std::min(b, count - 1)) * sample_no;
+    }
+
+    double up[BLOCK_SIZE] = {0.};
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      for (std::size_t b = 0; b < BLOCK_SIZE; ++b) {
+        up[b] += first[k] * second[b][k];
+      }
+    }
+    double alpha[BLOCK_SIZE];
+    for (std::size_t b = 0; b < BLOCK_SIZE; ++b) {
+      alpha[b] = up[b] / norms[row];
+    }
+    double chi2[BLOCK_SIZE] = {0.};
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      for (std::size_t b = 0; b < BLOCK_SIZE; ++b) {
+        double diff = alpha[b] * first[k] - second[b][k];
+        chi2[b] += diff * diff;
+      }
+    }
+
+    for (std::size_t b = 0; b < count; ++b) {
+      double distance = std::equal(first, first + sample_no, second[b]) ? 0. : chi2[b];
+      distances[row * sed_no + column + b]   = distance;
+      distances[(column + b) * sed_no + row] = distance;
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<std::pair<std::string, SedOrdering::SedData>> SedOrdering::readDirectory(const std::string& directory) {
+  if (!boost::filesystem::is_directory(directory)) {
+    throw Elements::Exception() << directory << " is not a directory";
+  }
+  logger.info() << "Reading directory : " << directory;
+
+  XYDataset::AsciiParser                      parser{};
+  std::vector<std::pair<std::string, SedData>> seds{};
+  for (boost::filesystem::directory_iterator it{directory}; it != boost::filesystem::directory_iterator{}; ++it) {
+    auto file = it->path();
+    auto name = file.filename().string();
+    if (name.empty() || name[0] == '.' || !boost::filesystem::is_regular_file(file) ||
+        boost::filesystem::file_size(file) == 0) {
+      continue;
+    }
+    try {
+      if (parser.isParsable(file.string())) {
+        auto dataset = parser.getDataset(file.string());
+        if (dataset && dataset->size() >= 2) {
+          seds.emplace_back(name, SedData(dataset->begin(), dataset->end()));
+          continue;
+        }
+      }
+    } catch (const std::exception& e) {
+      logger.debug() << "Unable to parse " << file.string() << " : " << e.what();
+    }
+    if (name != "order.txt") {
+      logger.warn() << "Not a SED file, file rejected : " << file.string();
+    }
+  }
+  return seds;
+}
+
+SedOrdering::SedOrdering(const std::vector<std::pair<std::string, SedData>>& seds) {
+  if (seds.empty()) {
+    throw Elements::Exception() << "No SED to order";
+  }
+  for (auto& sed : seds) {
+    if (sed.second.empty()) {
+      throw Elements::Exception() << "The SED " << sed.first << " has no data";
+    }
+  }
+
+  // The grid spans the range covered by all the SEDs, as densely as the densest SED
+  double xmin = seds.front().second.front().first;
+  double xmax = seds.front().second.back().first;
+  for (auto& sed : seds) {
+    xmin = std::max(xmin, sed.second.front().first);
+    xmax = std::min(xmax, sed.second.back().first);
+  }
+  if (!(xmin < xmax)) {
+    throw Elements::Exception() << "Non overlapping SED templates";
+  }
+  std::size_t sample_no = 0;
+  for (auto& sed : seds) {
+    auto in_range = std::count_if(sed.second.begin(), sed.second.end(), [&](const std::pair<double, double>& point) {
+      return point.first >= xmin && point.first <= xmax;
+    });
+    sample_no = std::max<std::size_t>(sample_no, in_range);
+  }
+  // Same values as numpy.linspace
+  m_wavelengths.assign(sample_no, xmin);
+  if (sample_no > 1) {
+    double step = (xmax - xmin) / static_cast<double>(sample_no - 1);
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      m_wavelengths[k] = static_cast<double>(k) * step + xmin;
+    }
+    m_wavelengths.back() = xmax;
+  }
+
+  m_names.reserve(seds.size());
+  m_fluxes.resize(seds.size() * sample_no);
+  for (std::size_t i = 0; i < seds.size(); ++i) {
+    m_names.push_back(seds[i].first);
+    const SedData* data = &seds[i].second;
+    SedData        sorted{};
+    auto           by_wavelength = [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+      return a.first < b.first;
+    };
+    if (!std::is_sorted(data->begin(), data->end(), by_wavelength)) {
+      sorted = *data;
+      std::stable_sort(sorted.begin(), sorted.end(), by_wavelength);
+      data = &sorted;
+    }
+    double* row = m_fluxes.data() + i * sample_no;
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      row[k] = interpolate(*data, m_wavelengths[k]);
+    }
+  }
+}
+
+const std::vector<std::string>& SedOrdering::getNames() const {
+  return m_names;
+}
+
+const std::vector<double>& SedOrdering::getWavelengths() const {
+  return m_wavelengths;
+}
+
+const std::vector<double>& SedOrdering::getFluxes() const {
+  return m_fluxes;
+}
+
+std::vector<double> SedOrdering::computeDistances(std::size_t thread_number) const {
+  std::size_t sed_no    = m_names.size();
+  std::size_t sample_no = m_wavelengths.size();
+
+  std::vector<double> norms(sed_no, 0.);
+  for (std::size_t i = 0; i < sed_no; ++i) {
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      norms[i] += m_fluxes[i * sample_no + k] * m_fluxes[i * sample_no + k];
+    }
+  }
+
+  // The rows get shorter and shorter, so they are handed out one at a time
+  std::vector<double> distances(sed_no * sed_no, 0.);
+  PhzUITools::forEachIndex(sed_no > 0 ? sed_no - 1 : 0, PhzUITools::getThreadNumber(thread_number, sed_no, 2),
+                           [&](std::size_t row) { computeRow(m_fluxes, norms, sed_no, sample_no, row, distances); });
+  return distances;
+}
+
+std::vector<std::string> SedOrdering::order(const std::string& start, std::size_t thread_number) const {
+  std::size_t sed_no    = m_names.size();
+  std::size_t sample_no = m_wavelengths.size();
+
+  std::size_t first = sed_no;
+  if (!start.empty()) {
+    first = std::find(m_names.begin(), m_names.end(), start) - m_names.begin();
+    if (first == sed_no) {
+      throw Elements::Exception() << "Unknown start SED " << start;
+    }
+  }
+  if (sed_no == 1) {
+    return m_names;
+  }
+
+  auto distances = computeDistances(thread_number);
+
+  if (first == sed_no) {
+    // Start from the brightest of the two most distant SEDs
+    double      biggest = 0.;
+    std::size_t s1 = sed_no, s2 = sed_no;
+    for (std::size_t i = 0; i + 1 < sed_no; ++i) {
+      for (std::size_t j = i + 1; j < sed_no; ++j) {
+        if (biggest < distances[i * sed_no + j]) {
+          biggest = distances[i * sed_no + j];
+          s1      = i;
+          s2      = j;
+        }
+      }
+    }
+    if (s1 == sed_no) {
+      throw Elements::Exception() << "Unable to find the two most different SEDs";
+    }
+    double s1_sum = 0., s2_sum = 0.;
+    for (std::size_t k = 0; k < sample_no; ++k) {
+      s1_sum += m_fluxes[s1 * sample_no + k];
+      s2_sum += m_fluxes[s2 * sample_no + k];
+    }
+    first = s1_sum > s2_sum ? s1 : s2;
+  }
+
+  // Nearest neighbour chain, the first of the equally close SEDs being selected
+  std::vector<bool> ordered(sed_no, false);
+  ordered[first] = true;
+
+  std::vector<std::string> result{m_names[first]};
+  std::size_t              last = first;
+  while (result.size() < sed_no) {
+    const double* row  = distances.data() + last * sed_no;
+    std::size_t   next = sed_no;
+    for (std::size_t s = 0; s < sed_no; ++s) {
+      if (!ordered[s] && (next == sed_no || row[s] < row[next])) {
+        next = s;
+      }
+    }
+    ordered[next] = true;
+    result.push_back(m_names[next]);
+    last = next;
+  }
+  return result;
+}
+
+}  // namespace PhzCLI
+}  // namespace Euclid
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/**
+ * @file src/program/ComputeSpecZStatistics.cpp
+ * @date 10/19/26
+ */
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PhzUITools/ProgressReporter.h"
+#include "PhzUITools/SpecZComparisonEngine.h"
+#include "Table/AsciiWriter.h"
+#include "Table/Table.h"
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Euclid;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+static Elements::Logging logger = Elements::Logging::getLogger("PhosphorosComputeSpecZStatistics");
+
+static const std::string SPECZ_CATALOG{"specz-catalog"};
+static const std::string SPECZ_CAT_ID{"specz-cat-id"};
+static const std::string SPECZ_COLUMN{"specz-column"};
+static const std::string PHOSPHOROS_OUTPUT_DIR{"phosphoros-output-dir"};
+static const std::string PHZ_CATALOG{"phz-catalog"};
+static const std::string PHZ_ID{"phz-id"};
+static const std::string PHZ_COLUMN{"phz-column"};
+static const std::string PE_CATALOG{"pe-catalog"};
+static const std::string BOX_BINS{"box-bins"};
+static const std::string BOX_FILE{"box-file"};
+static const std::string CHUNK_SIZE{"chunk-size"};
+static const std::string PROGRESS_FILE{"progress-file"};
+
+class ComputeSpecZStatistics : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Compute SpecZ Statistics options"};
+    options.add_options()(SPECZ_CATALOG.c_str(), po::value<std::string>()->default_value(""),
+                          "Catalog file containing the spec-z")(
+        SPECZ_CAT_ID.c_str(), po::value<std::string>()->default_value("ID"), "Spec-z catalog ID column")(
+        SPECZ_COLUMN.c_str(), po::value<std::string>()->default_value("ZSPEC"), "Spec-z column name")(
+        PHOSPHOROS_OUTPUT_DIR.c_str(), po::value<std::string>()->default_value(""),
+        "Directory to read Phosphoros outputs from")(PHZ_CATALOG.c_str(), po::value<std::string>()->default_value(""),
+                                                     "Photo-z catalog (default phz_cat.fits of the output directory)")(
+        PHZ_ID.c_str(), po::value<std::string>()->default_value("ID"), "Photo-z catalog ID column")(
+        PHZ_COLUMN.c_str(), po::value<std::string>()->default_value("Z"), "Photo-z column name")(
+        PE_CATALOG.c_str(), po::value<std::string>()->default_value(""),
+        "(optional) Catalog file containing the point estimate redshift")(
+        BOX_BINS.c_str(), po::value<int>()->default_value(10), "Number of spec-z bins of the box plot statistics")(
+        BOX_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(optional) ASCII file into which the box plot statistics are written")(
+        CHUNK_SIZE.c_str(), po::value<int>()->default_value(100000), "Number of rows processed at once")(
+        PROGRESS_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(optional) JSON file into which the progress is written");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto specz_catalog = args.at(SPECZ_CATALOG).as<std::string>();
+    auto phz_catalog   = args.at(PHZ_CATALOG).as<std::string>();
+    auto output_dir    = args.at(PHOSPHOROS_OUTPUT_DIR).as<std::string>();
+    if (specz_catalog.empty()) {
+      throw Elements::Exception() << "Missing " << SPECZ_CATALOG;
+    }
+    if (phz_catalog.empty()) {
+      if (output_dir.empty()) {
+        throw Elements::Exception() << "At least one of " << PHZ_CATALOG << " or " << PHOSPHOROS_OUTPUT_DIR
+                                    << " must be specified";
+      }
+      phz_catalog = (fs::path{output_dir} / "phz_cat.fits").string();
+      if (!fs::exists(phz_catalog)) {
+        phz_catalog = (fs::path{output_dir} / "phz_cat.txt").string();
+      }
+    }
+    auto box_bins   = args.at(BOX_BINS).as<int>();
+    auto chunk_size = args.at(CHUNK_SIZE).as<int>();
+    if (box_bins < 0 || chunk_size <= 0) {
+      throw Elements::Exception() << "Invalid " << BOX_BINS << " or " << CHUNK_SIZE;
+    }
+
+    PhzUITools::SpecZComparisonEngine engine{
+        args.at(SPECZ_CAT_ID).as<std::string>(), args.at(SPECZ_COLUMN).as<std::string>(),
+        args.at(PHZ_ID).as<std::string>(),       args.at(PHZ_COLUMN).as<std::string>(),
+        static_cast<std::size_t>(box_bins),      static_cast<std::size_t>(chunk_size)};
+    PhzUITools::ProgressReporter progress{
+        [](const PhzUITools::ProgressReporter::Status& status) {
+          logger.info() << "Processed " << status.step << " / " << status.total << " sources, "
+                        << PhzUITools::ProgressReporter::describe(status);
+        },
+        "sources", args.at(PROGRESS_FILE).as<std::string>()};
+    try {
+      auto metrics = engine.compute(specz_catalog, phz_catalog, args.at(PE_CATALOG).as<std::string>(), progress);
+      logSummary(metrics);
+
+      auto box_file = args.at(BOX_FILE).as<std::string>();
+      if (!box_file.empty() && box_bins > 0) {
+        writeBoxStatistics(box_file, metrics.getBoxStatistics());
+      }
+    } catch (...) {
+      progress.markFailed();
+      throw;
+    }
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static void logSummary(const PhzUITools::SpecZComparisonMetrics& metrics) {
+    auto summary = metrics.getSummary();
+    logger.info() << "--> Sources             : " << summary.count;
+    logger.info() << "--> Mean                : " << summary.mean;
+    logger.info() << "--> Median              : " << summary.median;
+    logger.info() << "--> Sigma               : " << summary.sigma;
+    logger.info() << "--> Mad                 : " << summary.mad;
+    logger.info() << "--> NMad                : " << summary.nmad;
+    logger.info() << "--> Outliers            : " << summary.outliers_percent << " %";
+    logger.info() << "--> Sigma (no outliers) : " << summary.sigma_no_outliers;
+    logger.info() << "--> Mean (no outliers)  : " << summary.mean_no_outliers;
+  }
+
+  static void writeBoxStatistics(const std::string& file_name,
+                                 const std::vector<PhzUITools::SpecZComparisonMetrics::BoxStatistics>& boxes) {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("BIN_MIN", typeid(double)),
+        Table::ColumnInfo::info_type("BIN_MAX", typeid(double)),
+        Table::ColumnInfo::info_type("COUNT", typeid(std::int64_t)),
+        Table::ColumnInfo::info_type("LOWER_WHISKER", typeid(double)),
+        Table::ColumnInfo::info_type("FIRST_QUARTILE", typeid(double)),
+        Table::ColumnInfo::info_type("MEDIAN", typeid(double)),
+        Table::ColumnInfo::info_type("THIRD_QUARTILE", typeid(double)),
+        Table::ColumnInfo::info_type("UPPER_WHISKER", typeid(double)),
+        Table::ColumnInfo::info_type("OUTLIERS_PERCENT", typeid(double))});
+    std::vector<Table::Row> rows{};
+    for (auto& box : boxes) {
+      rows.emplace_back(std::vector<Table::Row::cell_type>{box.bin_min, box.bin_max,
+                                                           static_cast<std::int64_t>(box.count), box.lower_whisker,
+                                                           box.first_quartile, box.median, box.third_quartile,
+                                                           box.upper_whisker, box.outliers_percent},
+                        info);
+    }
+    if (fs::exists(file_name)) {
+      fs::remove(file_name);
+    }
+    Table::AsciiWriter writer{file_name};
+    writer.addComment("(PhotoZ - SpecZ)/(1 + SpecZ) per SpecZ bin");
+    writer.addData(Table::Table{rows});
+    logger.info() << "Written the box plot statistics into " << file_name;
+  }
+};
+
+MAIN_FOR(ComputeSpecZStatistics)
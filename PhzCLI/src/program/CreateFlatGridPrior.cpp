@@ -23,10 +23,8 @@
 #include "Configuration/ConfigManager.h"
 #include "Configuration/Utils.h"
 #include "ElementsKernel/ProgramHeaders.h"
-#include "GridContainer/serialize.h"
 #include "PhzCLI/CreateFlatGridPriorConfig.h"
-#include "PhzConfiguration/PhotometryGridConfig.h"
-#include "PhzDataModel/DoubleGrid.h"
+#include "PhzCLI/FlatGridPriorWriter.h"
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <map>
@@ -42,7 +40,6 @@ public:
   po::options_description defineSpecificProgramOptions() override {
     auto& config_manager = Configuration::ConfigManager::getInstance(config_manager_id);
     config_manager.registerConfiguration<PhzCLI::CreateFlatGridPriorConfig>();
-    config_manager.registerConfiguration<PhzConfiguration::PhotometryGridConfig>();
     return config_manager.closeRegistration();
   }
   Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
@@ -50,20 +47,14 @@ public:
     auto& config_manager = Configuration::ConfigManager::getInstance(config_manager_id);
     config_manager.initialize(args);
 
-    fs::path out_file = config_manager.getConfiguration<PhzCLI::CreateFlatGridPriorConfig>().getGridPriorFilename();
+    auto&    prior_config = config_manager.getConfiguration<PhzCLI::CreateFlatGridPriorConfig>();
+    fs::path out_file     = prior_config.getGridPriorFilename();
     fs::remove(out_file);
     fs::create_directories(out_file.parent_path());
 
-    auto& regions = config_manager.getConfiguration<PhzConfiguration::PhotometryGridConfig>()
-                        .getPhotometryGridInfo()
-                        .region_axes_map;
-    for (auto& pair : regions) {
-      PhzDataModel::DoubleGrid grid{pair.second};
-      for (auto& cell : grid) {
-        cell = 1;
-      }
-      GridContainer::gridFitsExport(out_file, pair.first, grid);
-    }
+    auto& regions = prior_config.getRegionAxes();
+    PhzCLI::FlatGridPriorWriter writer{regions};
+    writer.write(out_file, prior_config.getThreadNumber());
 
     logger.info() << "Created file " << out_file.string();
 
@@ -6,14 +6,15 @@
 
 #include "Configuration/ConfigManager.h"
 #include "Configuration/Utils.h"
+#include "ElementsKernel/Exception.h"
 #include "ElementsKernel/ProgramHeaders.h"
 #include "PhzCLI/LsAuxDirConfig.h"
 #include "XYDataset/AsciiParser.h"
-#include "XYDataset/FileSystemProvider.h"
 #include <boost/program_options/options_description.hpp>
-#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
-#include <set>
+#include <string>
 
 using namespace std;
 using namespace Euclid;
@@ -25,6 +26,166 @@ static Elements::Logging logger = Elements::Logging::getLogger("PhosphorosLsAux"
 
 static long config_manager_id = getUniqueManagerId();
 
+namespace {
+
+// Accumulates the output and writes it to stdout by large blocks
+class BufferedWriter {
+public:
+  BufferedWriter() {
+    m_buffer.reserve(BUFFER_SIZE + 4096);
+  }
+
+  ~BufferedWriter() {
+    flush();
+  }
+
+  BufferedWriter& operator<<(const string& text) {
+    m_buffer += text;
+    return checkFlush();
+  }
+
+  BufferedWriter& operator<<(const char* text) {
+    m_buffer += text;
+    return checkFlush();
+  }
+
+  BufferedWriter& operator<<(char c) {
+    m_buffer += c;
+    return checkFlush();
+  }
+
+  BufferedWriter& operator<<(size_t value) {
+    m_buffer += to_string(value);
+    return checkFlush();
+  }
+
+  // Same format as the default of the streams, used for the human readable output
+  BufferedWriter& number(double value) {
+    return format("%g", value);
+  }
+
+  // Enough digits to read back the same value, used for the machine readable output
+  BufferedWriter& exactNumber(double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.15g", value);
+    if (strtod(text, nullptr) != value) {
+      snprintf(text, sizeof(text), "%.17g", value);
+    }
+    m_buffer += text;
+    return checkFlush();
+  }
+
+  BufferedWriter& jsonString(const string& text) {
+    m_buffer += '"';
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        m_buffer += '\\';
+        m_buffer += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        m_buffer += escaped;
+      } else {
+        m_buffer += c;
+      }
+    }
+    m_buffer += '"';
+    return checkFlush();
+  }
+
+  void flush() {
+    fwrite(m_buffer.data(), 1, m_buffer.size(), stdout);
+    fflush(stdout);
+    m_buffer.clear();
+  }
+
+private:
+  static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+  BufferedWriter& format(const char* format, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), format, value);
+    m_buffer += text;
+    return checkFlush();
+  }
+
+  BufferedWriter& checkFlush() {
+    if (m_buffer.size() >= BUFFER_SIZE) {
+      fwrite(m_buffer.data(), 1, m_buffer.size(), stdout);
+      m_buffer.clear();
+    }
+    return *this;
+  }
+
+  string m_buffer{};
+};
+
+void listDatasets(const vector<const AuxDataIndex::Entry*>& entries, LsAuxDirConfig::OutputFormat format) {
+  BufferedWriter out{};
+  switch (format) {
+  case LsAuxDirConfig::OutputFormat::TEXT:
+    for (auto entry : entries) {
+      out << entry->name.qualifiedName() << '\n';
+    }
+    break;
+  case LsAuxDirConfig::OutputFormat::TSV:
+    out << "name\tpath\tsize\tsamples\tmin_wavelength\tmax_wavelength\n";
+    for (auto entry : entries) {
+      out << entry->name.qualifiedName() << '\t' << entry->path << '\t' << static_cast<size_t>(entry->size) << '\t'
+          << entry->samples << '\t';
+      out.exactNumber(entry->min_wavelength) << '\t';
+      out.exactNumber(entry->max_wavelength) << '\n';
+    }
+    break;
+  case LsAuxDirConfig::OutputFormat::JSON:
+    out << '[';
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto entry = entries[i];
+      out << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+      out.jsonString(entry->name.qualifiedName()) << ", \"path\": ";
+      out.jsonString(entry->path) << ", \"size\": " << static_cast<size_t>(entry->size) << ", \"samples\": ";
+      out << entry->samples << ", \"min_wavelength\": ";
+      out.exactNumber(entry->min_wavelength) << ", \"max_wavelength\": ";
+      out.exactNumber(entry->max_wavelength) << '}';
+    }
+    out << "\n]\n";
+    break;
+  }
+}
+
+void showDataset(const string& name, const XYDataset::XYDataset& dataset, LsAuxDirConfig::OutputFormat format) {
+  BufferedWriter out{};
+  switch (format) {
+  case LsAuxDirConfig::OutputFormat::TEXT:
+    for (auto& pair : dataset) {
+      out.number(pair.first) << '\t';
+      out.number(pair.second) << '\n';
+    }
+    break;
+  case LsAuxDirConfig::OutputFormat::TSV:
+    out << "wavelength\tvalue\n";
+    for (auto& pair : dataset) {
+      out.exactNumber(pair.first) << '\t';
+      out.exactNumber(pair.second) << '\n';
+    }
+    break;
+  case LsAuxDirConfig::OutputFormat::JSON:
+    out << "{\"name\": ";
+    out.jsonString(name) << ", \"data\": [";
+    bool first = true;
+    for (auto& pair : dataset) {
+      out << (first ? "[" : ", [");
+      out.exactNumber(pair.first) << ", ";
+      out.exactNumber(pair.second) << ']';
+      first = false;
+    }
+    out << "]}\n";
+    break;
+  }
+}
+
+}  // namespace
+
 class LsAux : public Elements::Program {
 
   po::options_description defineSpecificProgramOptions() override {
@@ -38,33 +199,33 @@ class LsAux : public Elements::Program {
     auto& config_manager = ConfigManager::getInstance(config_manager_id);
     config_manager.initialize(args);
 
-    auto& conf = config_manager.getConfiguration<LsAuxDirConfig>();
-
-    auto provider = conf.getDatasetProvider();
+    auto& conf  = config_manager.getConfiguration<LsAuxDirConfig>();
+    auto& index = conf.getIndex();
 
     if (!conf.showData()) {
-      string group = conf.getGroup();
-      // Order the results
-      auto unordered = provider->listContents(group);
-      set<XYDataset::QualifiedName, XYDataset::QualifiedName::AlphabeticalComparator> ordered_set{unordered.begin(),
-                                                                                                  unordered.end()};
-      for (auto& name : ordered_set) {
-        cout << name.qualifiedName() << '\n';
-      }
+      // The index is already in alphabetical order
+      listDatasets(index.list(conf.getGroup(), conf.getGlob(), conf.getRegex()), conf.getFormat());
     } else {
-      auto name    = conf.getDatasetToShow();
-      auto dataset = provider->getDataset(name);
-      if (dataset) {
-        for (auto& pair : *dataset) {
-          cout << pair.first << '\t' << pair.second << '\n';
+      auto name  = conf.getDatasetToShow();
+      auto entry = index.find(name);
+      if (entry == nullptr) {
+        if (conf.getFormat() != LsAuxDirConfig::OutputFormat::TEXT) {
+          logger.error() << "Dataset \"" << name << "\" not found";
+          return Elements::ExitCode::NOT_OK;
         }
-      } else {
         cout << "Dataset \"" << name << "\" not found\n";
+        return Elements::ExitCode::OK;
+      }
+      XYDataset::AsciiParser parser{};
+      auto                   dataset = parser.getDataset((index.getRoot() / entry->path).string());
+      if (!dataset) {
+        throw Elements::Exception() << "Unable to read the dataset " << name << " from " << entry->path;
       }
+      showDataset(name, *dataset, conf.getFormat());
     }
 
     return Elements::ExitCode::OK;
   }
 };
 
-MAIN_FOR(LsAux)
\ No newline at end of file
+MAIN_FOR(LsAux)
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/OrderSeds.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PhzCLI/SedOrdering.h"
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Euclid::PhzCLI;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+static Elements::Logging logger = Elements::Logging::getLogger("PhosphorosOrderSeds");
+
+static const std::string DIRECTORY{"directory"};
+static const std::string START{"start"};
+static const std::string THREAD_NO{"thread-no"};
+
+class OrderSeds : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Order SEDs options"};
+    options.add_options()((DIRECTORY + ",d").c_str(), po::value<std::string>()->required(),
+                          "Directory of the SEDs location")(
+        (START + ",s").c_str(), po::value<std::string>()->default_value(""), "First SED file")(
+        THREAD_NO.c_str(), po::value<int>()->default_value(0), "Number of threads (0 for all the cores)");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto directory = args.at(DIRECTORY).as<std::string>();
+    auto thread_no = args.at(THREAD_NO).as<int>();
+    if (thread_no < 0) {
+      throw Elements::Exception() << "Invalid " << THREAD_NO << " : " << thread_no;
+    }
+
+    SedOrdering ordering{SedOrdering::readDirectory(directory)};
+    logger.info() << "Ordering " << ordering.getNames().size() << " SEDs resampled on "
+                  << ordering.getWavelengths().size() << " wavelengths";
+    auto ordered = ordering.order(args.at(START).as<std::string>(), static_cast<std::size_t>(thread_no));
+
+    auto out_filename = (fs::path{directory} / "order.txt").string();
+    logger.info() << "Writing file : " << out_filename;
+    std::ofstream out{out_filename};
+    for (auto& name : ordered) {
+      out << name << '\n';
+    }
+    out.close();
+    if (!out) {
+      throw Elements::Exception() << "Unable to write the file " << out_filename;
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(OrderSeds)
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/AuxDataIndex_test.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/AuxDataIndex.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include <boost/test/unit_test.hpp>
+#include <ctime>
+#include <fstream>
+
+using namespace Euclid::PhzCLI;
+
+namespace fs = boost::filesystem;
+
+struct AuxDataIndex_Fixture {
+  Elements::TempDir temp_dir{};
+  fs::path          root       = temp_dir.path() / "Filters";
+  fs::path          index_file = AuxDataIndex::getDefaultIndexFile(root);
+
+  AuxDataIndex_Fixture() {
+    fs::create_directories(root / "Euclid" / "Ground");
+    writeFile("Euclid/vis.txt", "VIS", {{5000, 0.1}, {6000, 0.5}, {9000, 0.2}});
+    writeFile("Euclid/Ground/u.txt", "", {{3000, 0.2}, {4000, 0.4}});
+    writeFile("Top.txt", "", {{1000, 1.}, {2000, 1.}});
+    std::ofstream{(root / "Euclid" / "notes.txt").string()} << "Not a dataset\n";
+    writeFile(".hidden.txt", "", {{1000, 1.}, {2000, 1.}});
+    backdate();
+  }
+
+  void writeFile(const std::string& name, const std::string& dataset_name,
+                 const std::vector<std::pair<double, double>>& values) {
+    std::ofstream out((root / name).string());
+    if (!dataset_name.empty()) {
+      out << "# " << dataset_name << "\n";
+    }
+    for (auto& pair : values) {
+      out << pair.first << " " << pair.second << "\n";
+    }
+  }
+
+  // Move the modification times of the whole tree to the past, so that the
+  // index does not have to check again the files modified during its scan
+  void backdate() {
+    auto past = std::time(nullptr) - 100;
+    fs::last_write_time(root, past);
+    for (fs::recursive_directory_iterator it{root}; it != fs::recursive_directory_iterator{}; ++it) {
+      fs::last_write_time(it->path(), past);
+    }
+  }
+
+  std::vector<std::string> names(const std::vector<const AuxDataIndex::Entry*>& entries) {
+    std::vector<std::string> result{};
+    for (auto entry : entries) {
+      result.push_back(entry->name.qualifiedName());
+    }
+    return result;
+  }
+};
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(AuxDataIndex_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(indexing_test, AuxDataIndex_Fixture) {
+  // WHEN
+  AuxDataIndex index{root, "", 2};
+
+  // THEN
+  auto& entries = index.getEntries();
+  BOOST_CHECK_EQUAL(index.getParsedFileNumber(), 4);
+  BOOST_REQUIRE_EQUAL(entries.size(), 3);
+  BOOST_CHECK_EQUAL(entries[0].name.qualifiedName(), "Euclid/Ground/u");
+  BOOST_CHECK_EQUAL(entries[1].name.qualifiedName(), "Euclid/VIS");
+  BOOST_CHECK_EQUAL(entries[2].name.qualifiedName(), "Top");
+  BOOST_CHECK_EQUAL(entries[1].path, "Euclid/vis.txt");
+  BOOST_CHECK_EQUAL(entries[1].samples, 3);
+  BOOST_CHECK_EQUAL(entries[1].min_wavelength, 5000);
+  BOOST_CHECK_EQUAL(entries[1].max_wavelength, 9000);
+  BOOST_CHECK(!fs::exists(index_file));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(persistence_test, AuxDataIndex_Fixture) {
+  // GIVEN
+  { AuxDataIndex index{root, index_file}; }
+  BOOST_CHECK(fs::exists(index_file));
+
+  // WHEN
+  AuxDataIndex index{root, index_file};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParsedFileNumber(), 0);
+  BOOST_CHECK_EQUAL(index.getEntries().size(), 3);
+  BOOST_REQUIRE(index.find("Euclid/VIS") != nullptr);
+  BOOST_CHECK_EQUAL(index.find("Euclid/VIS")->max_wavelength, 9000);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(new_file_test, AuxDataIndex_Fixture) {
+  // GIVEN
+  { AuxDataIndex index{root, index_file}; }
+
+  // WHEN
+  writeFile("Euclid/Ground/g.txt", "", {{4000, 0.2}, {5000, 0.4}});
+  AuxDataIndex index{root, index_file};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParsedFileNumber(), 1);
+  BOOST_CHECK_EQUAL(index.getEntries().size(), 4);
+  BOOST_CHECK(index.find("Euclid/Ground/g") != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(edited_file_test, AuxDataIndex_Fixture) {
+  // GIVEN
+  { AuxDataIndex index{root, index_file}; }
+
+  // WHEN
+  writeFile("Euclid/vis.txt", "VIS", {{5000, 0.1}, {6000, 0.5}, {9000, 0.2}, {9500, 0.1}});
+  backdate();
+  AuxDataIndex other_group_index{root, index_file, 1, false, "Euclid/Ground"};
+  AuxDataIndex index{root, index_file, 1, false, "Euclid"};
+
+  // THEN
+  BOOST_CHECK_EQUAL(other_group_index.getParsedFileNumber(), 0);
+  BOOST_CHECK_EQUAL(index.getParsedFileNumber(), 1);
+  BOOST_REQUIRE(index.find("Euclid/VIS") != nullptr);
+  BOOST_CHECK_EQUAL(index.find("Euclid/VIS")->max_wavelength, 9500);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(refresh_test, AuxDataIndex_Fixture) {
+  // GIVEN
+  { AuxDataIndex index{root, index_file}; }
+
+  // WHEN
+  AuxDataIndex index{root, index_file, 1, true};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParsedFileNumber(), 4);
+  BOOST_CHECK_EQUAL(index.getEntries().size(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(list_test, AuxDataIndex_Fixture) {
+  // GIVEN
+  AuxDataIndex index{root};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.list("").size(), 3);
+  BOOST_CHECK((names(index.list("Euclid")) == std::vector<std::string>{"Euclid/Ground/u", "Euclid/VIS"}));
+  BOOST_CHECK((names(index.list("Euclid/Ground/")) == std::vector<std::string>{"Euclid/Ground/u"}));
+  BOOST_CHECK(index.list("Eucl").empty());
+  BOOST_CHECK((names(index.list("", "*/V*")) == std::vector<std::string>{"Euclid/VIS"}));
+  BOOST_CHECK((names(index.list("", "", "[A-Z].*")) ==
+               std::vector<std::string>{"Euclid/Ground/u", "Euclid/VIS", "Top"}));
+  BOOST_CHECK((names(index.list("Euclid", "", ".*/[a-z]")) == std::vector<std::string>{"Euclid/Ground/u"}));
+  BOOST_CHECK_THROW(index.list("", "", "[A-"), Elements::Exception);
+  BOOST_CHECK(index.find("Euclid/notes") == nullptr);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/FlatGridPriorWriter_test.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/FlatGridPriorWriter.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include "GridContainer/serialize.h"
+#include "PhzDataModel/DoubleGrid.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid;
+using namespace Euclid::PhzCLI;
+
+namespace {
+
+PhzDataModel::ModelAxesTuple makeAxes(double max_z) {
+  return PhzDataModel::createAxesTuple({0., 0.5, max_z}, {0., 0.1}, {{"red_curve"}}, {{"sed_1"}, {"sed_2"}});
+}
+
+struct FlatGridPriorWriter_Fixture {
+  Elements::TempDir                                   temp_dir{};
+  boost::filesystem::path                             file = temp_dir.path() / "prior.fits";
+  std::map<std::string, PhzDataModel::ModelAxesTuple> regions{
+      {"region_1", makeAxes(1.)}, {"region_2", makeAxes(2.)}, {"region_3", makeAxes(3.)}};
+
+  void checkPrior(double value) {
+    // The regions must be in the map order, each followed by its axes HDUs
+    int hdu = 1;
+    for (auto& pair : regions) {
+      auto grid = GridContainer::gridFitsImport<PhzDataModel::DoubleGrid>(file, hdu);
+      BOOST_CHECK_EQUAL(grid.size(), 12);
+      auto& z_axis = grid.getAxis<PhzDataModel::ModelParameter::Z>();
+      BOOST_CHECK_EQUAL(z_axis[2], std::get<PhzDataModel::ModelParameter::Z>(pair.second)[2]);
+      for (auto& cell : grid) {
+        BOOST_CHECK_EQUAL(cell, value);
+      }
+      hdu += PhzDataModel::DoubleGrid::axisNumber() + 1;
+    }
+  }
+};
+
+}  // namespace
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(FlatGridPriorWriter_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(parallel_write_test, FlatGridPriorWriter_Fixture) {
+  // WHEN
+  FlatGridPriorWriter writer{regions, 0.5};
+  writer.write(file, 2);
+
+  // THEN
+  checkPrior(0.5);
+  // The temporary region files must have been removed
+  std::size_t file_number = std::distance(boost::filesystem::directory_iterator{temp_dir.path()}, {});
+  BOOST_CHECK_EQUAL(file_number, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(single_thread_write_test, FlatGridPriorWriter_Fixture) {
+  // WHEN
+  FlatGridPriorWriter writer{regions};
+  writer.write(file, 1);
+
+  // THEN
+  checkPrior(1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(overwrite_test, FlatGridPriorWriter_Fixture) {
+  // GIVEN
+  FlatGridPriorWriter{regions, 2.}.write(file);
+
+  // WHEN
+  FlatGridPriorWriter{regions, 3.}.write(file);
+
+  // THEN
+  checkPrior(3.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(no_region_test, FlatGridPriorWriter_Fixture) {
+  // THEN
+  BOOST_CHECK_THROW(FlatGridPriorWriter({}).write(file), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/SedOrdering_test.cpp
+ * @date 10/19/26
+ */
+
+#include "PhzCLI/SedOrdering.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <fstream>
+
+using namespace Euclid::PhzCLI;
+
+namespace {
+
+SedOrdering::SedData makeSed(const std::vector<double>& x, const std::vector<double>& y) {
+  SedOrdering::SedData sed{};
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    sed.emplace_back(x[i], y[i]);
+  }
+  return sed;
+}
+
+std::vector<std::pair<std::string, SedOrdering::SedData>> makeSeds() {
+  std::vector<double> x{1, 2, 3, 4};
+  return {{"A", makeSed(x, {1, 1, 1, 1})},
+          {"B", makeSed(x, {2, 2, 2, 2})},
+          {"C", makeSed(x, {1, 2, 3, 4})},
+          {"D", makeSed(x, {4, 3, 2, 1})}};
+}
+
+}  // namespace
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(SedOrdering_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(resampling_test) {
+  // GIVEN
+  std::vector<std::pair<std::string, SedOrdering::SedData>> seds{
+      {"A", makeSed({1000, 1500, 2000, 2500, 3000}, {1, 2, 3, 4, 5})},
+      {"B", makeSed({1500, 1750, 2000, 2250, 2500, 2750, 3000, 4000}, {1, 1, 1, 1, 1, 1, 1, 1})}};
+
+  // WHEN
+  SedOrdering ordering{seds};
+
+  // THEN
+  auto& wavelengths = ordering.getWavelengths();
+  BOOST_CHECK_EQUAL(wavelengths.size(), 7);
+  BOOST_CHECK_EQUAL(wavelengths.front(), 1500);
+  BOOST_CHECK_EQUAL(wavelengths.back(), 3000);
+  BOOST_CHECK_CLOSE(wavelengths[1], 1750, 1e-10);
+  auto& fluxes = ordering.getFluxes();
+  BOOST_CHECK_EQUAL(fluxes.size(), 14);
+  BOOST_CHECK_CLOSE(fluxes[1], 2.5, 1e-10);
+  BOOST_CHECK_EQUAL(fluxes[6], 5);
+  BOOST_CHECK_EQUAL(fluxes[9], 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(non_overlapping_test) {
+  std::vector<std::pair<std::string, SedOrdering::SedData>> seds{{"A", makeSed({1, 2}, {1, 1})},
+                                                                 {"B", makeSed({3, 4}, {1, 1})}};
+  BOOST_CHECK_THROW(SedOrdering{seds}, Elements::Exception);
+  BOOST_CHECK_THROW(SedOrdering{{}}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(distances_test) {
+  // GIVEN
+  SedOrdering ordering{makeSeds()};
+
+  // WHEN
+  auto distances = ordering.computeDistances(1);
+
+  // THEN
+  BOOST_CHECK_EQUAL(distances.size(), 16);
+  BOOST_CHECK_EQUAL(distances[0 * 4 + 1], 0.);
+  BOOST_CHECK_CLOSE(distances[0 * 4 + 2], 5., 1e-10);
+  BOOST_CHECK_CLOSE(distances[1 * 4 + 3], 5., 1e-10);
+  // The first SED is scaled to fit the second one
+  BOOST_CHECK_CLOSE(distances[2 * 4 + 3], 150. / 9., 1e-10);
+  for (std::size_t i = 0; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(distances[i * 4 + i], 0.);
+    for (std::size_t j = 0; j < 4; ++j) {
+      BOOST_CHECK_EQUAL(distances[i * 4 + j], distances[j * 4 + i]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+  // GIVEN
+  std::vector<std::pair<std::string, SedOrdering::SedData>> seds{};
+  std::vector<double>                                       x{};
+  for (int k = 0; k < 50; ++k) {
+    x.push_back(1000 + 10 * k);
+  }
+  for (int i = 0; i < 37; ++i) {
+    std::vector<double> y{};
+    for (int k = 0; k < 50; ++k) {
+      y.push_back(1 + std::sin(0.1 * i * k) * 0.5);
+    }
+    seds.emplace_back("S" + std::to_string(i), makeSed(x, y));
+  }
+  SedOrdering ordering{seds};
+
+  // WHEN
+  auto single = ordering.computeDistances(1);
+  auto multi  = ordering.computeDistances(4);
+
+  // THEN
+  BOOST_CHECK(single == multi);
+  BOOST_CHECK(ordering.order("", 1) == ordering.order("", 4));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(order_test) {
+  // GIVEN
+  SedOrdering ordering{makeSeds()};
+
+  // WHEN
+  auto ordered = ordering.order();
+
+  // THEN
+  // C and D are the most distant, with the same sum, then A and B are equally
+  // close to D
+  std::vector<std::string> expected{"D", "A", "B", "C"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(order_start_test) {
+  // GIVEN
+  SedOrdering ordering{makeSeds()};
+
+  // WHEN
+  auto ordered = ordering.order("C");
+
+  // THEN
+  std::vector<std::string> expected{"C", "A", "B", "D"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), expected.begin(), expected.end());
+  BOOST_CHECK_THROW(ordering.order("E"), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(readDirectory_test) {
+  // GIVEN
+  Elements::TempDir temp_dir{};
+  auto              write = [&](const std::string& name, const std::string& content) {
+    std::ofstream out{(temp_dir.path() / name).string()};
+    out << content;
+  };
+  write("A.sed", "1000 1\n2000 2\n");
+  write(".hidden.sed", "1000 1\n2000 2\n");
+  write("empty.sed", "");
+  write("order.txt", "A.sed\n");
+
+  // WHEN
+  auto seds = SedOrdering::readDirectory(temp_dir.path().string());
+
+  // THEN
+  BOOST_CHECK_EQUAL(seds.size(), 1);
+  BOOST_CHECK_EQUAL(seds[0].first, "A.sed");
+  BOOST_CHECK_EQUAL(seds[0].second.size(), 2);
+  BOOST_CHECK_THROW(SedOrdering::readDirectory((temp_dir.path() / "A.sed").string()), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
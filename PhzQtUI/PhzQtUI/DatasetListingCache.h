@@ -0,0 +1,95 @@
+#ifndef DATASET_LISTING_CACHE_H
+#define DATASET_LISTING_CACHE_H
+
+#include "XYDataset/FileParser.h"
+#include "XYDataset/FileSystemProvider.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+/**
+ * @class DatasetListingCache
+ *
+ * @brief
+ *  Persistent snapshot of the dataset names found in an auxiliary data
+ *  directory, used to speed up the construction of a FileSystemProvider.
+ *
+ *  When it is built, a FileSystemProvider opens every file of its directory
+ *  tree to check that it can be parsed and to read its dataset name. The
+ *  providers created by this class are given a parser which answers these two
+ *  questions from the snapshot for all the files whose size and modification
+ *  time are unchanged, so that a warm start only reads the files which have
+ *  been added or edited since the snapshot was saved. The datasets themselves
+ *  are still read by the original parser.
+ *
+ *  The snapshot is thread safe, however each directory is expected to have its
+ *  own snapshot file.
+ */
+class DatasetListingCache {
+public:
+  /**
+   * @brief Constructor, loads the snapshot from the cache file (if it exists).
+   *
+   * @param cache_file
+   * The file into which the snapshot is persisted. If empty the snapshot is kept
+   * in memory only.
+   */
+  explicit DatasetListingCache(std::string cache_file);
+
+  /**
+   * @brief Build a provider for the given directory, reading the files with a
+   * cached AsciiParser (see PhzUITools::CachedFileParser) and using this
+   * snapshot for their listing.
+   */
+  std::unique_ptr<XYDataset::FileSystemProvider> createProvider(const std::string& root_path);
+
+  /**
+   * @brief Wrap the given parser into a parser using this snapshot for
+   * isParsable and getName. The returned parser may outlive this object.
+   */
+  std::unique_ptr<XYDataset::FileParser> createParser(std::unique_ptr<XYDataset::FileParser> parser);
+
+  /**
+   * @brief Write the snapshot into the cache file (if any and if it has changed).
+   * Only the files which have been checked since the snapshot was loaded are
+   * kept, so that removed files do not accumulate.
+   */
+  void save();
+
+  /**
+   * @brief Get the snapshot file used for the directory of the given type of
+   * auxiliary data (e.g. "Filters") in the GUI configuration folder.
+   */
+  static std::string getCacheFile(const std::string& data_type);
+
+private:
+  class CachingParser;
+
+  struct Entry {
+    long long   mtime    = 0;
+    long long   size     = 0;
+    bool        parsable = false;
+    std::string name{};
+    bool        used = false;
+  };
+
+  struct State {
+    std::string                  cache_file;
+    std::map<std::string, Entry> entries{};
+    bool                         modified = false;
+    std::mutex                   mutex{};
+  };
+
+  void load();
+
+  std::shared_ptr<State> m_state;
+};
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
+
+#endif  // DATASET_LISTING_CACHE_H
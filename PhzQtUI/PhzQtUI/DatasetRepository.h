@@ -31,6 +31,7 @@ public:
   void reload() {
 
     m_content = m_provider->listContents("");
+    ++m_revision;
   }
 
   /**
@@ -70,9 +71,18 @@ public:
 	return list;
   }
 
+  /**
+   * @brief Get the number of times the content has been reloaded, allowing the
+   * users caching data derived from the content to detect a reload.
+   */
+  unsigned long getRevision() const {
+    return m_revision;
+  }
+
 private:
   T                                     m_provider;
   std::vector<XYDataset::QualifiedName> m_content;
+  unsigned long                         m_revision = 0;
 };
 
 }  // namespace PhzQtUI
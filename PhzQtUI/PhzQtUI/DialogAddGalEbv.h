@@ -1,8 +1,9 @@
 #ifndef DIALOGADDGALEBV_H
 #define DIALOGADDGALEBV_H
 
+#include "PhzUITools/CancellationToken.h"
 #include <QDialog>
-#include <QProcess>
+#include <QFutureWatcher>
 #include <memory>
 #include <string>
 #include <vector>
@@ -16,7 +17,9 @@ class DialogAddGalEbv;
 
 /**
  * @class DialogAddGalEbv
-
+ *
+ * @brief Popup adding the Planck galactic E(B-V) column to a catalog. The
+ * catalog is processed in a background thread of the GUI.
  */
 class DialogAddGalEbv : public QDialog {
   Q_OBJECT
@@ -45,12 +48,16 @@ public:
    */
   std::string getOutputName() const;
 
+signals:
+
+  /**
+   * @brief SIGNAL Update the progress text.
+   */
+  void signalUpdateStatus(QString);
+
 private slots:
 
-  void processFinished(int exitCode, QProcess::ExitStatus exitStatus);
-  void readError();
-  void readOutput();
-  void getError(QProcess::ProcessError error);
+  void runFinished();
 
   /**
    * @brief SLOT on_btn_create_clicked
@@ -63,13 +70,16 @@ private slots:
   void on_btn_cancel_clicked();
 
 private:
-  std::unique_ptr<Ui::DialogAddGalEbv> ui;
-  std::string                          m_input_name;
-  std::string                          m_ra_col;
-  std::string                          m_dec_col;
-  std::string                          m_name;
-  std::string                          m_dust_map_file;
-  QProcess*                            m_process = new QProcess(this);
+  std::unique_ptr<Ui::DialogAddGalEbv>           ui;
+  std::string                                    m_input_name;
+  std::string                                    m_ra_col;
+  std::string                                    m_dec_col;
+  std::string                                    m_name;
+  std::string                                    m_dust_map_file;
+  QFutureWatcher<std::string>                    m_future_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken> m_cancel_token{};
+
+  std::string runFunction();
 };
 
 }  // namespace PhzQtUI
@@ -9,6 +9,7 @@
 #define DIALOG_FILTER_SHIFT_GRIDGENERATION_H_
 
 #include "ElementsKernel/Exception.h"
+#include "PhzUITools/CancellationToken.h"
 #include <QDialog>
 #include <QFutureWatcher>
 #include <QTimer>
@@ -83,8 +84,14 @@ signals:
    */
   void signalUpdateBar(int);
 
+  /**
+   * @brief SIGNAL Update the throughput and remaining time text.
+   */
+  void signalUpdateStatus(QString);
+
 private:
   QFutureWatcher<std::string>                                   m_future_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken>                m_cancel_token{};
   std::map<std::string, boost::program_options::variable_value> m_config;
   std::unique_ptr<Ui::DialogFilterShiftGridGeneration>          ui;
   std::unique_ptr<QTimer>                                       m_timer;
@@ -5,7 +5,7 @@
 #include "XYDataset/FileSystemProvider.h"
 #include <QDialog>
 #include <QFrame>
-#include <QProcess>
+#include <QFutureWatcher>
 #include <QString>
 #include <QStringList>
 #include <QVBoxLayout>
@@ -38,6 +38,10 @@ public:
    */
   ~DialogInterpolateSed();
 
+signals:
+
+  void signalUpdateStatus(QString);
+
 private slots:
 
   void on_btn_plus_clicked();
@@ -56,15 +60,18 @@ private slots:
    */
   void on_btn_cancel_clicked();
 
-  void processingFinished(int, QProcess::ExitStatus);
+  void processingFinished();
 
 private:
   std::unique_ptr<Ui::DialogInterpolateSed> ui;
 
   QFrame*     createControls(bool first, bool del, std::string sed);
-  DatasetRepo m_seds_repository;
-  QStringList m_sed_list{};
-  QProcess*   m_is = nullptr;
+  std::string runFunction(std::string sed_folder, std::vector<std::string> seds, std::vector<std::size_t> numbers,
+                          std::string out_dir, bool copy_seds);
+
+  DatasetRepo                 m_seds_repository;
+  QStringList                 m_sed_list{};
+  QFutureWatcher<std::string> m_future_watcher{};
 };
 
 }  // namespace PhzQtUI
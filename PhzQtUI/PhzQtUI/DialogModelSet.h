@@ -2,8 +2,8 @@
 #define DIALOGMODELSET_H
 
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QItemSelection>
-#include <QProcess>
 #include <QVBoxLayout>
 #include <map>
 #include <memory>
@@ -70,7 +70,7 @@ signals:
 
 private slots:
   void sedProcessStarted();
-  void sedProcessfinished(int, QProcess::ExitStatus);
+  void sedProcessfinished();
 
   void addEmissionLineButtonClicked(const QString&);
   /**
@@ -104,6 +104,7 @@ private:
   int                          m_ref;
   std::map<int, ParameterRule> m_rules;
   std::vector<MessageButton*>  m_message_buttons;
+  QFutureWatcher<std::string>  m_emission_lines_watcher{};
 };
 
 }  // namespace PhzQtUI
@@ -1,7 +1,9 @@
 #ifndef DIALOGPSC_H
 #define DIALOGPSC_H
 
+#include "PhzUITools/CancellationToken.h"
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QProcess>
 #include <QString>
 #include <QTimer>
@@ -33,6 +35,9 @@ public:
   void setFolder(std::string output_folder);
   void setDefaultColumn(std::string id_column, std::string zref_column);
 
+signals:
+  void signalUpdateStatus(QString);
+
 private slots:
 
   /**
@@ -52,6 +57,8 @@ private slots:
 
   void processingFinished(int, QProcess::ExitStatus);
 
+  void statisticsFinished();
+
   void updateOutCons();
 
   void checkComputePossible();
@@ -62,6 +69,7 @@ private:
   std::string                    m_catalog;
   std::string                    m_id_column;
   std::string                    m_z_ref_column;
+  std::string                    m_phz_id_column = "ID";
 
   const std::list<std::string> m_list_columns_ok = {"MEDIAN",         "PHZ_MODE_1_SAMP", "PHZ_MODE_1_MEAN",
                                                     "PHZ_MODE_1_FIT", "PHZ_MODE_2_SAMP", "PHZ_MODE_2_MEAN",
@@ -71,6 +79,17 @@ private:
   QTimer*   m_timer;
   bool      m_processing = false;
   void      setCatalogFile(QString path);
+
+  /**
+   * @brief Compute the photo-z versus spec-z statistics without plots, in the
+   * GUI process (no Python process is spawned).
+   * @return the text to display
+   */
+  std::string computeStatistics(std::string specz_catalog, std::string specz_id_column, std::string specz_column,
+                                std::string phz_column, std::string pe_catalog);
+
+  QFutureWatcher<std::string>                    m_future_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken> m_cancel_token{};
 };
 
 }  // namespace PhzQtUI
@@ -2,6 +2,7 @@
 #define DIALOGPHOTOMETRICCORRECTIONCOMPUTATION_H
 
 #include "PhzQtUI/FilterMapping.h"
+#include "PhzUITools/CancellationToken.h"
 #include <QDialog>
 #include <QFutureWatcher>
 #include <list>
@@ -128,14 +129,13 @@ private slots:
 
   void runFinished();
   void lumFinished();
-  void sedFinished();
 
   void on_bt_Cancel_clicked();
 
 private:
   QFutureWatcher<std::string>                                   m_future_watcher{};
   QFutureWatcher<std::string>                                   m_future_lum_watcher{};
-  QFutureWatcher<std::string>                                   m_future_sed_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken>                m_cancel_token{};
   std::unique_ptr<Ui::DialogPhotometricCorrectionComputation>   ui;
   std::list<FilterMapping>                                      m_selected_filters;
   std::list<std::string>                                        m_excluded_filters;
@@ -146,12 +146,18 @@ private:
   std::string                                                   m_dec_col;
   std::map<std::string, boost::program_options::variable_value> m_run_option;
   std::map<std::string, boost::program_options::variable_value> m_sed_config;
+  std::map<std::string, boost::program_options::variable_value> m_correction_config;
+  QString                                                       m_output_name;
+  double                                                        m_tolerance = 0.;
   double                                                        m_non_detection;
   bool                                                          m_computing = false;
   void                                                          disablePage();
   void                                                          enablePage();
   std::string                                                   runFunction();
   std::string                                                   runSedFunction();
+  std::string                                                   runPipeline();
+  void                                                          startPipeline();
+  std::map<std::string, boost::program_options::variable_value> getCorrectionConfiguration() const;
   void                                                          setRunEnability();
   bool                                                          loadTestCatalog(QString file_name, bool with_warning);
 
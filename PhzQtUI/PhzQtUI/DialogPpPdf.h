@@ -1,13 +1,16 @@
 #ifndef DialogPpPdf_H
 #define DialogPpPdf_H
 
+#include "PhzUITools/CancellationToken.h"
+#include "PhzUITools/PosteriorSampleIndex.h"
+#include "PhzUITools/ProgressReporter.h"
 #include <QDialog>
-#include <QProcess>
+#include <QFutureWatcher>
 #include <QString>
-#include <QTimer>
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Euclid {
@@ -32,24 +35,44 @@ public:
 
   void setFolder(std::string result_folder);
 
+signals:
+  void signalUpdateStatus(QString);
+
 private slots:
 
   /**
    * @brief
    */
-  void updateOutCons();
-  void processingFinished(int, QProcess::ExitStatus);
+  void rangesComputed();
+  void pdfsComputed();
   void on_btn_cancel_clicked();
   void on_btn_save_clicked();
 
 private:
-  std::unique_ptr<Ui::DialogPpPdf> ui;
-  std::string                      m_result_folder = "";
-  QProcess*                        m_P;
-  QTimer*                          m_timer;
-  bool                             m_configured = false;
-  bool                             m_processing = false;
-  std::vector<std::string>         m_pps{};
+  /**
+   * @brief Index the posterior samples and compute the range of the physical
+   * parameters, in the GUI process.
+   * @return an error message, empty on success
+   */
+  std::string computeRanges();
+
+  /**
+   * @brief Compute the selected PDFs into pp_pdf.fits, in the GUI process.
+   * @return an error message, empty on success
+   */
+  std::string computePdfs(std::vector<PhzUITools::PosteriorSampleIndex::Binning> binnings,
+                          std::vector<std::pair<std::string, std::string>>       pdfs);
+
+  PhzUITools::ProgressReporter createProgress(const std::string& text);
+
+  std::unique_ptr<Ui::DialogPpPdf>                     ui;
+  std::string                                          m_result_folder = "";
+  bool                                                 m_configured    = false;
+  std::vector<std::string>                             m_pps{};
+  std::unique_ptr<PhzUITools::PosteriorSampleIndex>    m_index{};
+  std::vector<PhzUITools::PosteriorSampleIndex::Range> m_ranges{};
+  QFutureWatcher<std::string>                          m_future_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken>       m_cancel_token{};
 };
 
 }  // namespace PhzQtUI
@@ -9,6 +9,7 @@
 #define DIALOGRUNANALYSIS_H_
 
 #include "ElementsKernel/Exception.h"
+#include "PhzUITools/CancellationToken.h"
 #include <QDialog>
 #include <QFutureWatcher>
 #include <QTimer>
@@ -68,6 +69,8 @@ signals:
 
   void signalUpdateBar(int);
   void signalUpdateSedBar(int);
+  void signalUpdateStatus(QString);
+  void signalUpdateSedStatus(QString);
 
 private:
   bool needLuminosityGrid();
@@ -75,6 +78,7 @@ private:
 
   QFutureWatcher<std::string>                                   m_future_watcher{};
   QFutureWatcher<std::string>                                   m_future_sed_watcher{};
+  std::shared_ptr<PhzUITools::CancellationToken>                m_cancel_token{};
   std::map<std::string, boost::program_options::variable_value> m_config;
   std::map<std::string, boost::program_options::variable_value> m_original_config;
   std::map<std::string, boost::program_options::variable_value> m_sed_config;
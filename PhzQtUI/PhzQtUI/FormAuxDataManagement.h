@@ -7,9 +7,9 @@
 #include "PhzQtUI/SedTreeModel.h"
 #include "XYDataset/FileSystemProvider.h"
 #include <QFile>
+#include <QFutureWatcher>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QProcess>
 #include <QProgressDialog>
 #include <QTreeView>
 #include <QWidget>
@@ -49,7 +49,7 @@ signals:
 private slots:
 
   void sedProcessStarted();
-  void sedProcessfinished(int, QProcess::ExitStatus);
+  void sedProcessfinished();
 
   void deletFilterGroupButtonClicked(const QString& group);
   void deletSedGroupButtonClicked(const QString& group);
@@ -103,6 +103,7 @@ private:
   DatasetRepo                                m_redenig_curves_repository;
   DatasetRepo                                m_luminosity_repository;
   std::unique_ptr<DataPackHandler>           m_dataPackHandler;
+  QFutureWatcher<std::string>                m_emission_lines_watcher{};
 
   std::vector<std::unique_ptr<MessageButton>> m_message_buttons;
   std::vector<std::unique_ptr<MessageButton>> m_filter_del_buttons;
@@ -63,6 +63,10 @@ private slots:
   void copyProgress(qint64, qint64);
   void filter_model_changed(QStandardItem*);
 
+  void catalogLoaded(QString name);
+
+  void catalogsLoaded();
+
   void filterMappingSelectionChanged(const QItemSelection&, const QItemSelection&);
 
   void filterEditionPopupClosing(std::vector<std::string>);
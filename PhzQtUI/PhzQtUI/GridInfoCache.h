@@ -0,0 +1,59 @@
+#ifndef GRID_INFO_CACHE_H
+#define GRID_INFO_CACHE_H
+
+#include "PhzDataModel/PhotometryGridInfo.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+/**
+ * @class GridInfoCache
+ *
+ * @brief
+ *  Process wide cache of the model grid headers read by the GUI.
+ *
+ *  The grid files are identified by their absolute path, and an entry is only
+ *  reused while the size and modification time of its file are unchanged. The
+ *  cache hands out shared read-only views: a view stays valid as long as it is
+ *  referenced, even after its entry has been replaced. Only the headers
+ *  (PhotometryGridInfo) are read, the full grids being loaded by the
+ *  computations. Concurrent requests for the same file wait for a single read.
+ */
+class GridInfoCache {
+public:
+  /**
+   * @brief Get the cache shared by the whole application.
+   */
+  static GridInfoCache& getInstance();
+
+  /**
+   * @brief Get the header of the given grid file, only reading the file if it
+   * is not already known.
+   */
+  std::shared_ptr<const PhzDataModel::PhotometryGridInfo> getGridInfo(const std::string& file);
+
+  /**
+   * @brief Forget all the entries. The views already handed out are not affected.
+   */
+  void clear();
+
+private:
+  struct Entry {
+    long long                                               mtime = 0;
+    long long                                               size  = 0;
+    std::shared_ptr<const PhzDataModel::PhotometryGridInfo> info{};
+    std::shared_ptr<std::mutex>                             load_mutex{std::make_shared<std::mutex>()};
+  };
+
+  mutable std::mutex           m_mutex{};
+  std::map<std::string, Entry> m_entries{};
+};
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
+
+#endif  // GRID_INFO_CACHE_H
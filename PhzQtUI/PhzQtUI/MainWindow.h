@@ -3,8 +3,10 @@
 
 #include "PhzQtUI/DatasetRepository.h"
 #include "XYDataset/FileSystemProvider.h"
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QProcess>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <experimental/memory_resource>
@@ -65,10 +67,47 @@ private slots:
 
   void loadAuxData();
 
+  void auxDataLoaded();
+
+  void surveysLoaded();
+
 private:
   std::unique_ptr<Ui::MainWindow> ui;
   void                            resetRepo();
 
+  /// A repository built on a worker thread, or the error which prevented it
+  struct RepositoryLoad {
+    DatasetRepo repository{};
+    std::string error{};
+  };
+
+  /**
+   * @brief Build the repository of the datasets found under root_path, using
+   * the persisted listing snapshot of the given data type. Runs on a worker
+   * thread, the repository being handed to the GUI thread by auxDataLoaded.
+   */
+  static RepositoryLoad loadRepository(std::string root_path, std::string data_type);
+
+  void handleAuxDataError(std::string msg);
+
+  /*
+   * The pages are loaded the first time they are displayed (and again after
+   * a reset of the repositories), not at startup.
+   */
+  void loadSurveys(bool wait);
+
+  void loadModelSets();
+
+  void loadCatalogPage();
+
+  void loadModelPage();
+
+  void loadAnalysisPage();
+
+  void loadPostProcessingPage();
+
+  void loadOptionPage();
+
   DatasetRepo                      m_filter_repository;
   DatasetRepo                      m_seds_repository;
   DatasetRepo                      m_redenig_curves_repository;
@@ -77,6 +116,19 @@ private:
   std::shared_ptr<SurveyModel>     m_survey_model_ptr{new SurveyModel};
   std::shared_ptr<ModelSetModel>   m_model_set_model_ptr=nullptr;
   std::unique_ptr<DataPackHandler> m_dataPackHandler;
+  QFutureWatcher<RepositoryLoad>   m_filter_watcher{};
+  QFutureWatcher<RepositoryLoad>   m_seds_watcher{};
+  QFutureWatcher<RepositoryLoad>   m_redenig_curves_watcher{};
+  QFutureWatcher<RepositoryLoad>   m_luminosity_watcher{};
+  bool                             m_surveys_loaded              = false;
+  bool                             m_model_sets_loaded           = false;
+  bool                             m_catalog_page_loaded         = false;
+  bool                             m_model_page_loaded           = false;
+  bool                             m_analysis_page_loaded        = false;
+  bool                             m_post_processing_page_loaded = false;
+  bool                             m_option_page_loaded          = false;
+
+  std::chrono::steady_clock::time_point m_surveys_start{};
 };
 
 }  // namespace PhzQtUI
@@ -180,9 +180,18 @@ public:
 
   /**
    * @brief compute the ModelAxeTuple corresponding to this ModelSet
+   *
+   * The result is cached and only rebuilt when the parameter rules have been
+   * changed, the SED or reddening curve repositories reloaded, or the cache
+   * explicitly invalidated since the previous call.
    */
  const std::map<std::string, PhzDataModel::ModelAxesTuple>& getAxesTuple();
 
+  /**
+   * @brief Force the next call to getAxesTuple to rebuild the axes.
+   */
+  void invalidateAxesTuple();
+
   std::vector<std::string> getSeds();
 
 private:
@@ -194,6 +203,9 @@ private:
   std::vector<Range>           m_ebv_ranges{};
   std::set<double>             m_ebv_values{};
   std::map<std::string, PhzDataModel::ModelAxesTuple> m_axes_tuple{};
+  bool                         m_axes_tuple_dirty = true;
+  unsigned long                m_axes_sed_revision = 0;
+  unsigned long                m_axes_red_revision = 0;
   DatasetRepo m_sed_repo;
   DatasetRepo m_red_repo;
 };
@@ -0,0 +1,128 @@
+#ifndef SED_METADATA_INDEX_H
+#define SED_METADATA_INDEX_H
+
+#include "XYDataset/QualifiedName.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+/**
+ * @class SedMetadataIndex
+ *
+ * @brief
+ *  Index of the header metadata (dataset name and physical parameters) of the
+ *  SED files of an auxiliary data directory.
+ *
+ *  The headers of a SED group directory are parsed the first time the group is
+ *  requested; later requests are answered from memory. The index is persisted
+ *  into a cache file and each entry is invalidated when the modification time
+ *  of its file changes, so that a new session only re-parses the files which
+ *  have been added or edited in the meantime. Within a session a group is
+ *  listed again when the modification time of its directory changes (files
+ *  added, removed or renamed); a file edited in place is only detected after
+ *  a refresh.
+ *
+ *  All the public methods are thread safe. The headers are read outside of the
+ *  index lock, so that several threads can query (and parse) different SEDs
+ *  at the same time.
+ */
+class SedMetadataIndex {
+public:
+  /**
+   * @brief Metadata extracted from the header of a SED file.
+   */
+  struct Entry {
+    /// The file name (without directory)
+    std::string file_name;
+    /// The modification time of the file when it has been parsed (ms since epoch)
+    long long mtime = 0;
+    /// The dataset name given by the NAME keyword (or the legacy first line), may be empty
+    std::string name;
+    /// The PARAMETER keywords of the header: parameter name => unit
+    std::map<std::string, std::string> parameters;
+    /// False until the header of the file has been read
+    bool parsed = false;
+  };
+
+  /**
+   * @brief Create an index of the SEDs stored under sed_root_path.
+   *
+   * @param sed_root_path
+   * The SED root directory of the auxiliary data.
+   *
+   * @param cache_file
+   * The file into which the index is persisted. If empty the index is kept in
+   * memory only.
+   */
+  SedMetadataIndex(std::string sed_root_path, std::string cache_file);
+
+  /**
+   * @brief Get the index of the current SED root directory, persisted into the
+   * GUI configuration folder. A new index is created when the SED root
+   * directory has been changed.
+   */
+  static std::shared_ptr<SedMetadataIndex> getInstance();
+
+  /**
+   * @brief Get the path of the file containing the given SED.
+   * The file is matched on its base name first and then on the NAME keyword.
+   * @return the full path of the file or an empty string if not found.
+   */
+  std::string getFile(const XYDataset::QualifiedName& sed);
+
+  /**
+   * @brief Get the physical parameters (name => unit) of the given SED.
+   * @throw Elements::Exception if the SED file cannot be found.
+   */
+  std::map<std::string, std::string> getParameterList(const XYDataset::QualifiedName& sed);
+
+  /**
+   * @brief Mark all the groups to be checked against the file system again on
+   * their next access: only the files whose modification time changed are
+   * re-parsed.
+   */
+  void refresh();
+
+  /**
+   * @brief Write the index into the cache file (if any and if it has changed).
+   */
+  void save();
+
+private:
+  struct GroupIndex {
+    bool               validated = false;
+    long long          dir_mtime = 0;
+    std::vector<Entry> entries{};
+    /// Dataset name given in the header => index of its entry, complete once names_indexed is set
+    std::map<std::string, std::size_t> names{};
+    bool                               names_indexed = false;
+    /// Held while the headers of the group are parsed for a name lookup
+    std::shared_ptr<std::mutex> parse_mutex{std::make_shared<std::mutex>()};
+  };
+
+  Entry findEntry(const XYDataset::QualifiedName& sed, std::string& group_path);
+
+  bool findByName(GroupIndex& group, const std::string& name, Entry& found);
+
+  GroupIndex& getGroup(const std::string& group_path);
+
+  void parseEntries(const std::string& group_path, std::vector<Entry>& entries);
+
+  void load();
+
+  std::string                       m_sed_root_path;
+  std::string                       m_cache_file;
+  std::map<std::string, GroupIndex> m_groups{};
+  bool                              m_modified = false;
+  std::mutex                        m_mutex{};
+};
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
+
+#endif  // SED_METADATA_INDEX_H
@@ -6,7 +6,9 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include "PhzQtUI/DatasetRepository.h"
+#include "PhzUITools/SedHeader.h"
 
 /**
  * @brief The SedParamUtils class
@@ -17,6 +19,8 @@ namespace PhzQtUI {
 
 typedef std::shared_ptr<PhzQtUI::DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>> DatasetRepo;
 
+typedef PhzUITools::SedHeader SedHeader;
+
 class SedParamUtils : public QObject {
   Q_OBJECT
 public:
@@ -32,6 +36,13 @@ public:
 
   static std::string getFile(const XYDataset::QualifiedName& sed);
 
+  /**
+   * @brief Read the header of a SED file in a single pass, stopping at the
+   * first data line.
+   * @throw Elements::Exception if the file cannot be opened.
+   */
+  static SedHeader parseHeader(const std::string& file);
+
   static std::map<std::string, std::string> getParameterList(const std::string& file);
 
   static std::string getParameter(const std::string& file, const std::string& key_word);
@@ -1,6 +1,8 @@
 #ifndef SURVEYFILTERMAPPING_H
 #define SURVEYFILTERMAPPING_H
 #include "FilterMapping.h"
+#include <QFuture>
+#include <QString>
 #include <map>
 #include <set>
 #include <vector>
@@ -166,6 +168,18 @@ public:
    */
   static std::map<int, SurveyFilterMapping> loadCatalogMappings();
 
+  /**
+   * @brief Start reading all the SurveyFilterMapping in parallel.
+   *
+   * The mappings are cached in memory: a mapping is only read again when one
+   * of its files (configuration, filter mapping or error adjustment
+   * parameters) has been modified since it was last read.
+   *
+   * @return a future whose i-th result is the mapping of the i-th catalog
+   * listed by getAvailableCatalogs (its int key in loadCatalogMappings).
+   */
+  static QFuture<SurveyFilterMapping> loadCatalogMappingsAsync();
+
   /**
    * @brief load a SurveyFilterMapping from a xml file
    * @param name
@@ -204,6 +218,11 @@ private:
   bool   m_define_filter_shift = false;
 
   void ReadFilters();
+
+  void ReadFilters(const QString& intermediary_path);
+
+  static SurveyFilterMapping readCatalog(const QString& file_path, const std::string& catalog_name,
+                                         const std::string& root_path, const QString& intermediary_path);
 };
 
 }  // namespace PhzQtUI
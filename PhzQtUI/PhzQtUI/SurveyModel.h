@@ -2,6 +2,7 @@
 #define SURVEYMODEL_H
 
 #include "SurveyFilterMapping.h"
+#include <QFutureWatcher>
 #include <QStandardItemModel>
 #include <QString>
 #include <map>
@@ -29,6 +30,24 @@ public:
    */
   void loadSurvey();
 
+  /**
+   * @brief Start loading the surveys in the background. The rows are added to
+   * the model as the surveys are read (surveyLoaded is emitted for each of
+   * them) and the saved selection is restored once all are loaded
+   * (surveysLoaded is emitted).
+   */
+  void loadSurveyAsync();
+
+  /**
+   * @brief Returns true while the surveys are loaded in the background.
+   */
+  bool isLoading() const;
+
+  /**
+   * @brief Block until the surveys started by loadSurveyAsync are all loaded.
+   */
+  void waitForLoaded();
+
   /**
    * @brief Create a new survey and add it to the model.
    *
@@ -117,6 +136,11 @@ public:
 
   void reloaded();
 
+signals:
+  void surveyLoaded(QString name);
+
+  void surveysLoaded();
+
 public slots:
   void setNameToSelected(QString new_name);
   void setIdColumnToSelected(QString new_name);
@@ -133,14 +157,24 @@ public slots:
   void setDefineFilterShiftToSelected(bool new_define_shift);
   void setCopiedColumnsToSelected(std::map<std::string, std::string> copied_columns);
 
+private slots:
+  void surveyReadyAt(int index);
+  void loadingFinished();
+
 private:
-  bool                               m_in_edition     = false;
-  bool                               m_need_reload    = true;
-  int                                m_selected_row   = -1;
-  int                                m_selected_index = -1;
-  SurveyFilterMapping                m_edited_survey;
-  std::map<int, SurveyFilterMapping> m_survey_filter_mappings;
-  const QString                      getValue(int row, int column) const;
+  bool                                m_in_edition     = false;
+  bool                                m_need_reload    = true;
+  int                                 m_selected_row   = -1;
+  int                                 m_selected_index = -1;
+  SurveyFilterMapping                 m_edited_survey;
+  std::map<int, SurveyFilterMapping>  m_survey_filter_mappings;
+  QFutureWatcher<SurveyFilterMapping> m_load_watcher{};
+  bool                                m_loading = false;
+  const QString                       getValue(int row, int column) const;
+
+  void finishLoading();
+
+  void setHeaders();
 
   std::string getDuplicateName(std::string name) const;
 };
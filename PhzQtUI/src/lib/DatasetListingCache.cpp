@@ -0,0 +1,152 @@
+#include "PhzQtUI/DatasetListingCache.h"
+#include "ElementsKernel/Logging.h"
+#include "FileUtils.h"
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <boost/algorithm/string.hpp>
+#include <fstream>
+#include <vector>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("DatasetListingCache");
+
+// Cache file layout (tab separated):
+//   <file path> <mtime> <size> <parsable> <dataset name>
+static const std::string CACHE_HEADER = "# Phosphoros dataset listing v1";
+
+class DatasetListingCache::CachingParser : public XYDataset::FileParser {
+public:
+  CachingParser(std::shared_ptr<State> state, std::unique_ptr<XYDataset::FileParser> parser)
+      : m_state{std::move(state)}, m_parser{std::move(parser)} {}
+
+  std::string getName(const std::string& file) override {
+    auto entry = getEntry(file);
+    return entry.parsable ? entry.name : m_parser->getName(file);
+  }
+
+  std::string getParameter(const std::string& file, const std::string& key_word) override {
+    return m_parser->getParameter(file, key_word);
+  }
+
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const std::string& file) override {
+    return m_parser->getDataset(file);
+  }
+
+  bool isParsable(const std::string& file) override {
+    return getEntry(file).parsable;
+  }
+
+private:
+  Entry getEntry(const std::string& file) {
+    QFileInfo info(QString::fromStdString(file));
+    Entry     entry;
+    entry.mtime = info.lastModified().toMSecsSinceEpoch();
+    entry.size  = info.size();
+    entry.used  = true;
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      auto                        existing = m_state->entries.find(file);
+      if (existing != m_state->entries.end() && existing->second.mtime == entry.mtime &&
+          existing->second.size == entry.size) {
+        existing->second.used = true;
+        return existing->second;
+      }
+    }
+
+    // New or modified file: read it without holding the lock
+    entry.parsable = m_parser->isParsable(file);
+    if (entry.parsable) {
+      entry.name = m_parser->getName(file);
+    }
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->entries[file] = entry;
+    m_state->modified      = true;
+    return entry;
+  }
+
+  std::shared_ptr<State>                 m_state;
+  std::unique_ptr<XYDataset::FileParser> m_parser;
+};
+
+DatasetListingCache::DatasetListingCache(std::string cache_file) : m_state{std::make_shared<State>()} {
+  m_state->cache_file = std::move(cache_file);
+  load();
+}
+
+std::string DatasetListingCache::getCacheFile(const std::string& data_type) {
+  return FileUtils::getGUIConfigPath() + "/DatasetListing_" + data_type + ".txt";
+}
+
+std::unique_ptr<XYDataset::FileParser> DatasetListingCache::createParser(std::unique_ptr<XYDataset::FileParser> parser) {
+  return std::unique_ptr<XYDataset::FileParser>{new CachingParser{m_state, std::move(parser)}};
+}
+
+std::unique_ptr<XYDataset::FileSystemProvider> DatasetListingCache::createProvider(const std::string& root_path) {
+  auto parser = createParser(FileUtils::createDatasetParser());
+  return std::unique_ptr<XYDataset::FileSystemProvider>{new XYDataset::FileSystemProvider{root_path, std::move(parser)}};
+}
+
+void DatasetListingCache::load() {
+  if (m_state->cache_file.empty()) {
+    return;
+  }
+  std::ifstream in(m_state->cache_file);
+  std::string   line;
+  if (!std::getline(in, line) || line != CACHE_HEADER) {
+    return;
+  }
+  while (std::getline(in, line)) {
+    std::vector<std::string> tokens;
+    boost::split(tokens, line, boost::is_any_of("\t"));
+    if (tokens.size() != 5) {
+      continue;
+    }
+    Entry entry;
+    try {
+      entry.mtime = std::stoll(tokens[1]);
+      entry.size  = std::stoll(tokens[2]);
+    } catch (const std::exception&) {
+      continue;
+    }
+    entry.parsable              = tokens[3] == "1";
+    entry.name                  = tokens[4];
+    m_state->entries[tokens[0]] = std::move(entry);
+  }
+  logger.debug() << "Loaded " << m_state->entries.size() << " file(s) from " << m_state->cache_file;
+}
+
+void DatasetListingCache::save() {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  for (auto entry = m_state->entries.begin(); entry != m_state->entries.end();) {
+    if (entry->second.used) {
+      ++entry;
+    } else {
+      entry             = m_state->entries.erase(entry);
+      m_state->modified = true;
+    }
+  }
+  if (m_state->cache_file.empty() || !m_state->modified) {
+    return;
+  }
+
+  std::string   tmp_file = m_state->cache_file + ".tmp";
+  std::ofstream out(tmp_file);
+  out << CACHE_HEADER << '\n';
+  for (const auto& entry : m_state->entries) {
+    out << entry.first << '\t' << entry.second.mtime << '\t' << entry.second.size << '\t'
+        << (entry.second.parsable ? 1 : 0) << '\t' << entry.second.name << '\n';
+  }
+  out.close();
+  if (out) {
+    QFile::remove(QString::fromStdString(m_state->cache_file));
+    QFile::rename(QString::fromStdString(tmp_file), QString::fromStdString(m_state->cache_file));
+    m_state->modified = false;
+  }
+}
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
@@ -2,14 +2,17 @@
 #include "PhzQtUI/DialogAddGalEbv.h"
 #include "ElementsKernel/Logging.h"
 #include "FileUtils.h"
+#include "GalacticDustMap/CatalogEbvAnnotator.h"
+#include "GalacticDustMap/PlanckDustMap.h"
+#include "PhzUITools/ProgressReporter.h"
 #include "ui_DialogAddGalEbv.h"
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
-#include <QProcess>
 #include <QRegularExpressionValidator>
 #include <QTextStream>
+#include <QtConcurrent>
 
 using namespace std;
 
@@ -25,17 +28,15 @@ DialogAddGalEbv::DialogAddGalEbv(QWidget* parent) : QDialog(parent), ui(new Ui::
   ui->txt_name->setValidator(new QRegularExpressionValidator(rx));
   ui->label_process->setText(QString::fromStdString(""));
 
-  connect(m_process, SIGNAL(finished(int, QProcess::ExitStatus)), this,
-          SLOT(processFinished(int, QProcess::ExitStatus)));
-  connect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(readOutput()));
-  connect(m_process, SIGNAL(readyReadStandardError()), this, SLOT(readError()));
-  connect(m_process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(getError(QProcess::ProcessError)));
+  connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(runFinished()));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->label_process, SLOT(setText(QString)));
 }
 
 DialogAddGalEbv::~DialogAddGalEbv() {
-  disconnect(m_process, 0, 0, 0);
-  delete m_process;
-  m_process = NULL;
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
+  m_future_watcher.waitForFinished();
 }
 
 void DialogAddGalEbv::setInputs(std::string input_name, std::string ra_col, std::string dec_col,
@@ -52,8 +53,13 @@ void DialogAddGalEbv::setInputs(std::string input_name, std::string ra_col, std:
 }
 
 void DialogAddGalEbv::on_btn_cancel_clicked() {
-  m_process->kill();
-  reject();
+  if (m_cancel_token) {
+    // The dialog is closed once the computation has stopped
+    m_cancel_token->cancel();
+    ui->btn_cancel->setEnabled(false);
+  } else {
+    reject();
+  }
 }
 
 void DialogAddGalEbv::on_btn_create_clicked() {
@@ -76,50 +82,60 @@ void DialogAddGalEbv::on_btn_create_clicked() {
     ui->btn_cancel->setEnabled(true);
     ui->btn_create->setEnabled(false);
 
-    // Call the python code
-    std::string program = "AddGalDustToCatalog";
-    QStringList arguments;
-    arguments <<  "--planck-dust-map" << QString::fromStdString(m_dust_map_file)
-              <<  "--galatic-ebv-col" << "PLANCK_GAL_EBV"
-			  <<  "--input-catalog"   << QString::fromStdString(m_input_name)
-              <<  "--output-catalog"  << QString::fromStdString(m_name)
-			  <<  "--ra"              << QString::fromStdString(m_ra_col)
-			  <<  "--dec"             << QString::fromStdString(m_dec_col);
-
-    m_process->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-    m_process->start(QString::fromStdString(program), arguments);
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+    m_future_watcher.setFuture(QtConcurrent::run(&DialogAddGalEbv::runFunction, this));
 
   } else {
     return;
   }
 }
 
-void DialogAddGalEbv::processFinished(int exitCode, QProcess::ExitStatus exitStatus) {
-  logger.info() << "AddGalDustToCatalog: Exit code and status " << exitCode << "  " << exitStatus;
-  if (exitCode == 0) {
+std::string DialogAddGalEbv::runFunction() {
+  auto cancel_token = m_cancel_token;
+  try {
+    auto dust_map = std::make_shared<const GalacticDustMap::PlanckDustMap>(
+        GalacticDustMap::PlanckDustMap::open(m_dust_map_file));
+    GalacticDustMap::CatalogEbvAnnotator annotator{dust_map, m_ra_col, m_dec_col, "PLANCK_GAL_EBV"};
+
+    PhzUITools::ProgressReporter progress{[this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+                                            if (!cancel_token->isCancelled()) {
+                                              emit signalUpdateStatus(QString::fromStdString(
+                                                  "Creating the E(B-V) column for the catalog... " +
+                                                  PhzUITools::ProgressReporter::describe(status)));
+                                            }
+                                          },
+                                          "sources"};
+
+    annotator.annotate(m_input_name, m_name, progress, [cancel_token]() { return cancel_token->isCancelled(); });
+    return "";
+  } catch (const std::exception& e) {
+    if (cancel_token->isCancelled()) {
+      return "";
+    }
+    logger.error() << "Error while adding the E(B-V) column: " << e.what();
+    return e.what();
+  }
+}
+
+void DialogAddGalEbv::runFinished() {
+  bool cancelled = m_cancel_token->isCancelled();
+  m_cancel_token.reset();
+  auto message = m_future_watcher.result();
+  if (cancelled) {
+    reject();
+  } else if (message.empty()) {
     accept();
   } else {
     QMessageBox::warning(this, "Error during the computation...",
-                         "Something went wrong while adding Planck E(B-V) to the catalog. This may be caused by a "
-                         "corrupted Planck dust file. Try to download it again from the Configuration/Aux. Data page.",
+                         QString::fromStdString("Something went wrong while adding Planck E(B-V) to the catalog:\n" +
+                                                message +
+                                                "\nThis may be caused by a corrupted Planck dust file. Try to "
+                                                "download it again from the Configuration/Aux. Data page."),
                          QMessageBox::Ok);
     reject();
   }
 }
 
-void DialogAddGalEbv::readError() {
-  QByteArray byteArray = m_process->readAllStandardError();
-  logger.info() << "AddGalDustToCatalog :" << QString(byteArray).toStdString();
-}
-void DialogAddGalEbv::readOutput() {
-  QByteArray byteArray = m_process->readAllStandardOutput();
-  logger.info() << "AddGalDustToCatalog :" << QString(byteArray).toStdString();
-}
-
-void DialogAddGalEbv::getError(QProcess::ProcessError error) {
-  logger.info() << "Error in the processing of AddGalDustToCatalog " << error;
-}
-
 std::string DialogAddGalEbv::getOutputName() const {
   return m_name;
 }
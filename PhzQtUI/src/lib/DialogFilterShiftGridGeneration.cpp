@@ -9,6 +9,7 @@
 #include "Configuration/Utils.h"
 #include "DefaultOptionsCompleter.h"
 #include "ElementsKernel/ProgramHeaders.h"
+#include "EmissionLineUtils.h"
 #include "PhzConfiguration/ComputeFilterVariationCoefficientConfig.h"
 #include "PhzConfiguration/ComputeModelGridConfig.h"
 #include "PhzConfiguration/CosmologicalParameterConfig.h"
@@ -26,7 +27,7 @@
 #include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
 #include "PhzModeling/NormalizationFunctorFactory.h"
 #include "PhzModeling/SparseGridCreator.h"
-#include "PhzUtils/Multithreading.h"
+#include "PhzUITools/ProgressReporter.h"
 #include "ui_DialogFilterShiftGridGeneration.h"
 #include <QDir>
 #include <QFuture>
@@ -72,6 +73,7 @@ DialogFilterShiftGridGeneration::DialogFilterShiftGridGeneration(QWidget* parent
 
   connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(runFinished()));
   connect(this, SIGNAL(signalUpdateBar(int)), ui->progressBar, SLOT(setValue(int)));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->label_progress, SLOT(setText(QString)));
 }
 
 DialogFilterShiftGridGeneration::~DialogFilterShiftGridGeneration() {}
@@ -83,6 +85,8 @@ void DialogFilterShiftGridGeneration::setValues(
 }
 
 std::string DialogFilterShiftGridGeneration::runFunction() {
+  // Keep the job token alive until the computation is over, even if the dialog is closed
+  auto cancel_token = m_cancel_token;
   try {
     completeWithDefaults<PhzConfiguration::ComputeFilterVariationCoefficientConfig>(m_config);
     long  config_manager_id = Configuration::getUniqueManagerId();
@@ -92,7 +96,9 @@ std::string DialogFilterShiftGridGeneration::runFunction() {
     config_manager.initialize(m_config);
 
     auto& model_phot_grid = config_manager.getConfiguration<PhotometryGridConfig>().getPhotometryGridInfo();
-    auto& sed_provider    = config_manager.template getConfiguration<SedProviderConfig>().getSedDatasetProvider();
+    auto  sed_provider    = EmissionLineUtils::createSedProvider(
+        config_manager.template getConfiguration<SedProviderConfig>().getSedDatasetProvider(),
+        model_phot_grid.region_axes_map);
     auto& reddening_provider =
         config_manager.template getConfiguration<ReddeningProviderConfig>().getReddeningDatasetProvider();
     const auto& filter_provider =
@@ -117,14 +123,16 @@ std::string DialogFilterShiftGridGeneration::runFunction() {
       total += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
     }
 
-    auto monitor_function = [this](size_t step, size_t mon_total) {
-      int value = (step * 100) / mon_total;
-      if (!PhzUtils::getStopThreadsFlag()) {
-        // If the user has canceled we do not want to update the progress bar,
-        // because the GUI thread might have already deleted it
-        emit signalUpdateBar(value);
-      }
-    };
+    PhzUITools::ProgressReporter monitor_function{
+        [this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+          // If the user has canceled we do not want to update the progress bar,
+          // because the GUI thread might have already deleted it
+          if (!cancel_token->isCancelled() && status.total > 0) {
+            emit signalUpdateBar((status.step * 100) / status.total);
+            emit signalUpdateStatus(QString::fromStdString(PhzUITools::ProgressReporter::describe(status)));
+          }
+        },
+        "models"};
 
     PhzFilterVariation::FilterVariationSingleGridCreator grid_creator{sed_provider, reddening_provider, filter_provider,
                                                                       igm_abs_func, normalizer_functor, shift_sampling};
@@ -136,9 +144,9 @@ std::string DialogFilterShiftGridGeneration::runFunction() {
                          grid_creator.createGrid(grid_pair.second, model_phot_grid.filter_names, cosmology, reporter)));
     }
     monitor_function(already_done, total);
-    if (!PhzUtils::getStopThreadsFlag()) {
-      output_function(result_map);
-    }
+    // A canceled job leaves the existing grid untouched
+    cancel_token->throwIfCancelled();
+    output_function(result_map);
 
     return "";
   } catch (const Elements::Exception& e) {
@@ -151,14 +159,21 @@ std::string DialogFilterShiftGridGeneration::runFunction() {
 }
 
 void DialogFilterShiftGridGeneration::on_btn_cancel_clicked() {
-  PhzUtils::getStopThreadsFlag() = true;
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
 }
 
 void DialogFilterShiftGridGeneration::runFinished() {
+  bool cancelled = m_cancel_token && m_cancel_token->isCancelled();
+  m_cancel_token.reset();
   auto message = m_future_watcher.result();
   if (message.length() == 0) {
     this->accept();
     return;
+  } else if (cancelled) {
+    // Canceled by the user, nothing to report
+    this->reject();
   } else {
     QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
     this->reject();
@@ -166,6 +181,15 @@ void DialogFilterShiftGridGeneration::runFinished() {
 }
 
 void DialogFilterShiftGridGeneration::run() {
+  if (!m_cancel_token) {
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+  }
+  // A previous job may still be stopping: retry later from the GUI thread
+  // rather than blocking a thread of the pool
+  if (!m_cancel_token->canStart()) {
+    m_timer->start();
+    return;
+  }
   m_future_watcher.setFuture(QtConcurrent::run(&DialogFilterShiftGridGeneration::runFunction, this));
 }
 
@@ -7,6 +7,7 @@
 #include "PhzQtUI/DialogGridGeneration.h"
 #include "Configuration/Utils.h"
 #include "DefaultOptionsCompleter.h"
+#include "EmissionLineUtils.h"
 #include "PhzConfiguration/ComputeModelGridConfig.h"
 #include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/FilterConfig.h"
@@ -19,7 +20,7 @@
 #include "PhzConfiguration/SedProviderConfig.h"
 #include "PhzModeling/NormalizationFunctorFactory.h"
 #include "PhzModeling/SparseGridCreator.h"
-#include "PhzUtils/Multithreading.h"
+#include "PhzUITools/ProgressReporter.h"
 #include "ui_DialogGridGeneration.h"
 #include <QDir>
 #include <QFuture>
@@ -47,6 +48,7 @@ DialogGridGeneration::DialogGridGeneration(QWidget* parent) : QDialog(parent), u
 
   connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(runFinished()));
   connect(this, SIGNAL(signalUpdateBar(int)), ui->progressBar, SLOT(setValue(int)));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->label_progress, SLOT(setText(QString)));
 }
 
 DialogGridGeneration::~DialogGridGeneration() {}
@@ -58,6 +60,8 @@ void DialogGridGeneration::setValues(std::string
 }
 
 std::string DialogGridGeneration::runFunction() {
+  // Keep the job token alive until the computation is over, even if the dialog is closed
+  auto cancel_token = m_cancel_token;
   try {
     completeWithDefaults<ComputeModelGridConfig>(m_config);
     long  config_manager_id = Configuration::getUniqueManagerId();
@@ -66,7 +70,11 @@ std::string DialogGridGeneration::runFunction() {
     config_manager.closeRegistration();
     config_manager.initialize(m_config);
 
-    auto& sed_provider       = config_manager.getConfiguration<SedProviderConfig>().getSedDatasetProvider();
+    auto param_space_map = config_manager.getConfiguration<ParameterSpaceConfig>().getParameterSpaceRegions();
+    auto filter_list     = config_manager.getConfiguration<FilterConfig>().getFilterList();
+
+    auto sed_provider = EmissionLineUtils::createSedProvider(
+        config_manager.getConfiguration<SedProviderConfig>().getSedDatasetProvider(), param_space_map);
     auto& reddening_provider = config_manager.getConfiguration<ReddeningProviderConfig>().getReddeningDatasetProvider();
     const auto& filter_provider = config_manager.getConfiguration<FilterProviderConfig>().getFilterDatasetProvider();
     auto&       igm_abs_func    = config_manager.getConfiguration<IgmConfig>().getIgmAbsorptionFunction();
@@ -82,20 +90,21 @@ std::string DialogGridGeneration::runFunction() {
     Euclid::PhzModeling::SparseGridCreator creator{sed_provider, reddening_provider, filter_provider, igm_abs_func,
                                                    normalizer_functor};
 
-    auto monitor_function = [this](size_t step, size_t total) {
-      int value = (step * 100) / total;
-      if (!PhzUtils::getStopThreadsFlag()) {
-        // If the user has canceled we do not want to update the progress bar,
-        // because the GUI thread might have already deleted it
-        emit signalUpdateBar(value);
-      }
-    };
-
-    auto param_space_map = config_manager.getConfiguration<ParameterSpaceConfig>().getParameterSpaceRegions();
-    auto filter_list     = config_manager.getConfiguration<FilterConfig>().getFilterList();
+    PhzUITools::ProgressReporter monitor_function{
+        [this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+          // If the user has canceled we do not want to update the progress bar,
+          // because the GUI thread might have already deleted it
+          if (!cancel_token->isCancelled() && status.total > 0) {
+            emit signalUpdateBar((status.step * 100) / status.total);
+            emit signalUpdateStatus(QString::fromStdString(PhzUITools::ProgressReporter::describe(status)));
+          }
+        },
+        "models"};
 
     auto result = creator.createGrid(param_space_map, filter_list, cosmology, monitor_function);
 
+    // A canceled job leaves the existing grid untouched
+    cancel_token->throwIfCancelled();
     auto output = config_manager.getConfiguration<ModelGridOutputConfig>().getOutputFunction();
     output(result);
     return "";
@@ -109,14 +118,21 @@ std::string DialogGridGeneration::runFunction() {
 }
 
 void DialogGridGeneration::on_btn_cancel_clicked() {
-  PhzUtils::getStopThreadsFlag() = true;
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
 }
 
 void DialogGridGeneration::runFinished() {
+  bool cancelled = m_cancel_token && m_cancel_token->isCancelled();
+  m_cancel_token.reset();
   auto message = m_future_watcher.result();
   if (message.length() == 0) {
     this->accept();
     return;
+  } else if (cancelled) {
+    // Canceled by the user, nothing to report
+    this->reject();
   } else {
     QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
     this->reject();
@@ -124,6 +140,15 @@ void DialogGridGeneration::runFinished() {
 }
 
 void DialogGridGeneration::run() {
+  if (!m_cancel_token) {
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+  }
+  // A previous job may still be stopping: retry later from the GUI thread
+  // rather than blocking a thread of the pool
+  if (!m_cancel_token->canStart()) {
+    m_timer->start();
+    return;
+  }
   m_future_watcher.setFuture(QtConcurrent::run(&DialogGridGeneration::runFunction, this));
 }
 
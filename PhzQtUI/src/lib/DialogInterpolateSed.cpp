@@ -7,13 +7,15 @@
 #include <QFileInfo>
 #include <QHBoxLayout>
 #include <QMessageBox>
-#include <QProcess>
 #include <QUuid>
+#include <QtConcurrent>
 
 #include "ElementsKernel/Logging.h"
 #include "FileUtils.h"
 #include "PhzQtUI/DialogInterpolateSed.h"
 #include "PhzQtUI/DialogSedSelector.h"
+#include "PhzUITools/ProgressReporter.h"
+#include "SEDInterpolation/SedInterpolationEngine.h"
 #include "ui_DialogInterpolateSed.h"
 #include <QComboBox>
 #include <QDirIterator>
@@ -41,9 +43,14 @@ DialogInterpolateSed::DialogInterpolateSed(DatasetRepo sed_repo, QWidget* parent
   ui->scrollArea->setWidgetResizable(true);
 
   // ui->layout_SED->addWidget(createControls(true, false,"Toto"));
+
+  connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(processingFinished()));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->label_process, SLOT(setText(QString)));
 }
 
-DialogInterpolateSed::~DialogInterpolateSed() {}
+DialogInterpolateSed::~DialogInterpolateSed() {
+  m_future_watcher.waitForFinished();
+}
 
 void DialogInterpolateSed::on_btn_plus_clicked() {
 
@@ -157,17 +164,17 @@ void DialogInterpolateSed::on_btn_create_clicked() {
     }
   }
 
-  QStringList seds{};
-  QStringList numbers{};
-  int         total      = 0;
-  auto        frame_list = ui->scrollArea->findChildren<QFrame*>();
+  std::vector<std::string> seds{};
+  std::vector<std::size_t> numbers{};
+  int                      total      = 0;
+  auto                     frame_list = ui->scrollArea->findChildren<QFrame*>();
 
   for (auto frame_iter = frame_list.begin(); frame_iter != frame_list.end(); ++frame_iter) {
     if ((*frame_iter)->objectName() != "") {
       // add the number
       auto* sp = (*frame_iter)->findChild<QSpinBox*>();
       if (sp != nullptr) {
-        numbers << QString::number(sp->value());
+        numbers.push_back(static_cast<std::size_t>(sp->value()));
         total += sp->value();
       } else {
         logger.info() << "No number in Frame " << (*frame_iter)->objectName().toStdString();
@@ -176,7 +183,7 @@ void DialogInterpolateSed::on_btn_create_clicked() {
       // add the sed
       auto* cb = (*frame_iter)->findChild<QComboBox*>();
       if (cb != nullptr) {
-        seds << QString::fromStdString(
+        seds.push_back(
             FileUtils::getDataSetFilePath(cb->currentText().toStdString(), FileUtils::getSedRootPath(false)));
       } else {
         logger.warn() << "No SED in Frame " << (*frame_iter)->objectName().toStdString();
@@ -197,36 +204,42 @@ void DialogInterpolateSed::on_btn_create_clicked() {
 
   bool copy_seds = ui->cb_cp->isChecked();
 
-  QString     program = "Phosphoros";
-  QStringList arguments;
-  arguments << "IS" << "--sed-dir" << sed_folder << "--out-dir" << folder_name << "--seds" << seds.join(",") << "--numbers"
-            << numbers.join(",");
-
-  if (!copy_seds) {
-    arguments << "--copy-sed"
-              << "false";
-  }
-
-  m_is = new QProcess;
-  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-  m_is->setProcessEnvironment(env);
-
-  connect(m_is, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processingFinished(int, QProcess::ExitStatus)));
-
-
-  m_is->start(program, arguments);
+  auto out_dir = sed_folder.toStdString() + "/" + folder_name.toStdString();
+  ui->label_process->setText("Computing the SEDs...");
+  m_future_watcher.setFuture(QtConcurrent::run(&DialogInterpolateSed::runFunction, this, sed_folder.toStdString(),
+                                               seds, numbers, out_dir, copy_seds));
 
   ui->btn_cancel->setEnabled(false);
   ui->btn_create->setEnabled(false);
 }
 
-void DialogInterpolateSed::processingFinished(int code, QProcess::ExitStatus status) {
-  logger.info() << "Run return with code :" << code << " and status " << status;
-  if (code + status != 0) {
+std::string DialogInterpolateSed::runFunction(std::string sed_folder, std::vector<std::string> seds,
+                                              std::vector<std::size_t> numbers, std::string out_dir, bool copy_seds) {
+  try {
+    PhzUITools::ProgressReporter progress{[this](const PhzUITools::ProgressReporter::Status& status) {
+                                            emit signalUpdateStatus(QString::fromStdString(
+                                                "Computing the SEDs... " +
+                                                PhzUITools::ProgressReporter::describe(status)));
+                                          },
+                                          "SEDs"};
+    SEDInterpolation::SedInterpolationEngine engine{copy_seds};
+    engine.run(sed_folder, seds, numbers, out_dir, progress);
+    return "";
+  } catch (const std::exception& e) {
+    logger.error() << "Error while interpolating the SEDs: " << e.what();
+    return e.what();
+  }
+}
+
+void DialogInterpolateSed::processingFinished() {
+  auto message = m_future_watcher.result();
+  if (!message.empty()) {
     QMessageBox::warning(this, tr("SED Interpolation"),
                          tr("An error occure during the computation of the SEDs."
-                            "Check that the selected files are all SED files..."),
+                            "Check that the selected files are all SED files...\n") +
+                             QString::fromStdString(message),
                          QMessageBox::Ok, QMessageBox::Ok);
+    ui->label_process->setText("");
     ui->btn_cancel->setEnabled(true);
     ui->btn_create->setEnabled(true);
     return;
@@ -2,15 +2,17 @@
 #include "PhzQtUI/DialogModelSet.h"
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
+#include "EmissionLineUtils.h"
 #include "FileUtils.h"
 #include "FormUtils.h"
 #include "PhzQtUI/DataSetTreeModel.h"
+#include "PhzQtUI/SedMetadataIndex.h"
 #include "PhzQtUI/SedTreeModel.h"
 #include "ui_DialogModelSet.h"
 #include <QDir>
 #include <QMessageBox>
-#include <QProcess>
 #include <QStandardItemModel>
+#include <QtConcurrent>
 #include <algorithm>
 
 #include "PhzQtUI/GridButton.h"
@@ -18,7 +20,6 @@
 #include "PhzQtUI/ParameterRule.h"
 
 #include "PhzQtUI/DatasetRepository.h"
-#include "XYDataset/AsciiParser.h"
 #include "XYDataset/FileSystemProvider.h"
 
 #include <QProgressDialog>
@@ -78,7 +79,9 @@ DialogModelSet::DialogModelSet(DatasetRepo seds_repository, DatasetRepo redenig_
   }
 }
 
-DialogModelSet::~DialogModelSet() {}
+DialogModelSet::~DialogModelSet() {
+  m_emission_lines_watcher.waitForFinished();
+}
 
 void DialogModelSet::sedProcessStarted() {
   ui->labelMessage->setText("Adding emission Lines to the SEDs...");
@@ -87,7 +90,13 @@ void DialogModelSet::sedProcessStarted() {
   }
 }
 
-void DialogModelSet::sedProcessfinished(int, QProcess::ExitStatus) {
+void DialogModelSet::sedProcessfinished() {
+  auto message = m_emission_lines_watcher.result();
+  if (!message.empty()) {
+    QMessageBox::warning(this, "Error while adding the emission lines...", QString::fromStdString(message),
+                         QMessageBox::Ok);
+  }
+
   // remove the buttons
   for (auto button : m_message_buttons) {
     delete button;
@@ -96,10 +105,13 @@ void DialogModelSet::sedProcessfinished(int, QProcess::ExitStatus) {
   m_message_buttons = std::vector<MessageButton*>();
 
   // reload the provider and the model
-  std::unique_ptr<XYDataset::FileParser>         sed_file_parser{new XYDataset::AsciiParser{}};
+  std::unique_ptr<XYDataset::FileParser>         sed_file_parser{FileUtils::createDatasetParser()};
   std::unique_ptr<XYDataset::FileSystemProvider> sed_provider(
       new XYDataset::FileSystemProvider{FileUtils::getSedRootPath(true), std::move(sed_file_parser)});
   m_seds_repository->resetProvider(std::move(sed_provider));
+  // The reload invalidates the axes cached by the model sets; the SED headers
+  // index has to check the new group
+  SedMetadataIndex::getInstance()->refresh();
 
   loadSeds();
   if (m_view_popup) {
@@ -115,19 +127,11 @@ void DialogModelSet::addEmissionLineButtonClicked(const QString& group) {
                                 QString::fromStdString(" with added emission lines?"),
                             QMessageBox::Ok | QMessageBox::Cancel) == QMessageBox::Ok) {
     // do the procesing
-    QProcess* lineAdder = new QProcess();
-    lineAdder->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-
-    auto    aux_path = FileUtils::getAuxRootPath();
-    QString command  = QString::fromStdString("PhosphorosAddEmissionLines");
-    QStringList arguments;
-    arguments << "--sed-dir" <<  QString::fromStdString(aux_path) + QDir::separator() + QString::fromStdString("SEDs") + QDir::separator() + group;
-
-    connect(lineAdder, SIGNAL(finished(int, QProcess::ExitStatus)), this,
-            SLOT(sedProcessfinished(int, QProcess::ExitStatus)));
-    connect(lineAdder, SIGNAL(started()), this, SLOT(sedProcessStarted()));
-
-    lineAdder->start(command, arguments);
+    auto sed_dir = FileUtils::getAuxRootPath() + "/SEDs/" + group.toStdString();
+    connect(&m_emission_lines_watcher, SIGNAL(finished()), this, SLOT(sedProcessfinished()), Qt::UniqueConnection);
+    sedProcessStarted();
+    m_emission_lines_watcher.setFuture(
+        QtConcurrent::run(&EmissionLineUtils::addEmissionLines, sed_dir, EmissionLineUtils::Recipe::PHOSPHOROS));
   } else {
     ui->labelMessage->setText("");
   }
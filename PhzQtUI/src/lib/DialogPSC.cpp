@@ -9,10 +9,14 @@
 #include <QStringList>
 #include <QTextStream>
 #include <QThread>
+#include <QtConcurrent>
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include "PhzUITools/CatalogColumnReader.h"
+#include "PhzUITools/ProgressReporter.h"
+#include "PhzUITools/SpecZComparisonEngine.h"
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
 
@@ -29,9 +33,17 @@ static Elements::Logging logger = Elements::Logging::getLogger("DialogPSC");
 
 DialogPSC::DialogPSC(QWidget* parent) : QDialog(parent), ui(new Ui::DialogPSC) {
   ui->setupUi(this);
+
+  connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(statisticsFinished()));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->out_cons, SLOT(setPlainText(QString)));
 }
 
-DialogPSC::~DialogPSC() {}
+DialogPSC::~DialogPSC() {
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
+  m_future_watcher.waitForFinished();
+}
 
 void DialogPSC::setDefaultColumn(std::string id_column, std::string zref_column) {
   m_id_column    = id_column;
@@ -82,6 +94,11 @@ void DialogPSC::setFolder(std::string output_folder) {
     ui->cbb_pdf_col->setCurrentIndex(0);
     checkComputePossible();
 
+    // The ID column of the Phosphoros catalog is the source ID column of the
+    // catalog configuration (the one of the run if known), ID as a fallback
+    std::vector<std::string> id_candidates{m_id_column, "ID"};
+    auto                     phz_columns = column_reader.getColumnNames();
+
     // check if the config file exist
     if (boost::filesystem::exists(basepath / "run_config.config")) {
       // if so get the input file
@@ -91,9 +108,10 @@ void DialogPSC::setFolder(std::string output_folder) {
         QTextStream in(&inputFile);
         while (!in.atEnd()) {
           QString line = in.readLine();
-          if (line.startsWith("input-catalog-file")) {
+          if (line.startsWith("source-id-column-name")) {
+            id_candidates.insert(id_candidates.begin(), line.section('=', 1).trimmed().toStdString());
+          } else if (line.startsWith("input-catalog-file") && input_line == "") {
             input_line = line;
-            break;
           }
         }
         inputFile.close();
@@ -110,6 +128,13 @@ void DialogPSC::setFolder(std::string output_folder) {
       }
     }
 
+    for (auto& name : id_candidates) {
+      if (phz_columns.count(name) > 0) {
+        m_phz_id_column = name;
+        break;
+      }
+    }
+
   } else {
     ui->lbl_warning->setText("File 'phz_cat' not found or not in .fits format");
     ui->btn_compute->setEnabled(false);
@@ -163,6 +188,12 @@ void DialogPSC::on_btn_browse_clicked() {
 }
 
 void DialogPSC::on_btn_cancel_clicked() {
+  if (m_cancel_token) {
+    // The buttons are restored once the computation has stopped
+    m_cancel_token->cancel();
+    ui->btn_cancel->setEnabled(false);
+    return;
+  }
   if (m_processing) {
     m_P->terminate();
     m_processing = false;
@@ -184,6 +215,9 @@ void DialogPSC::on_gb_stacked_clicked(bool checked) {
 }
 
 void DialogPSC::on_btn_compute_clicked() {
+  if (m_cancel_token) {
+    return;
+  }
   if (m_processing) {
     m_P->terminate();
     m_processing = false;
@@ -195,13 +229,6 @@ void DialogPSC::on_btn_compute_clicked() {
   ui->btn_compute->hide();
   ui->out_cons->show();
   ui->out_cons->setReadOnly(true);
-  m_processing = true;
-  qApp->processEvents();
-
-  m_P = new QProcess(this);
-  m_P->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-
-  connect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processingFinished(int, QProcess::ExitStatus)));
 
   std::string point_estimate_column = ui->cbb_z_col->currentText().toStdString();
   std::string point_estimate_file   = "";
@@ -215,6 +242,26 @@ void DialogPSC::on_btn_compute_clicked() {
     }
   }
 
+  if (ui->gb_scater->isChecked() && ui->cb_no_plot->checkState() != Qt::Unchecked) {
+    // Statistics only: no need for the Python plotting stack
+    ui->btn_cancel->setEnabled(true);
+    ui->out_cons->setPlainText("Computing the statistics...");
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+    m_future_watcher.setFuture(QtConcurrent::run(
+        &DialogPSC::computeStatistics, this, ui->le_path->text().toStdString(),
+        ui->cdd_ref_id_col->currentText().toStdString(), ui->cbb_ref_z_col->currentText().toStdString(),
+        point_estimate_column, point_estimate_file));
+    return;
+  }
+
+  m_processing = true;
+  qApp->processEvents();
+
+  m_P = new QProcess(this);
+  m_P->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
+
+  connect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processingFinished(int, QProcess::ExitStatus)));
+
   QString cmd = QString("PhosphorosPlotSpecZComparison");
   QStringList arguments;
   if (ui->gb_scater->isChecked()) {
@@ -223,7 +270,8 @@ void DialogPSC::on_btn_compute_clicked() {
        << QString::fromStdString("--phz-column") << QString::fromStdString(point_estimate_column)
        << QString::fromStdString("--specz-catalog") << ui->le_path->text() << QString::fromStdString("--specz-cat-id")
        << ui->cdd_ref_id_col->currentText() << QString::fromStdString("--specz-column")
-       << ui->cbb_ref_z_col->currentText() << QString::fromStdString("--samp");
+       << ui->cbb_ref_z_col->currentText() << QString::fromStdString("--phz_id")
+       << QString::fromStdString(m_phz_id_column) << QString::fromStdString("--samp");
 
     if (point_estimate_file.length() > 0) {
       arguments << QString::fromStdString("--pe-catalog") << QString::fromStdString(point_estimate_file);
@@ -336,6 +384,59 @@ void DialogPSC::processingFinished(int, QProcess::ExitStatus) {
   ui->out_cons->setPlainText("Processing Finished");
 }
 
+std::string DialogPSC::computeStatistics(std::string specz_catalog, std::string specz_id_column,
+                                         std::string specz_column, std::string phz_column, std::string pe_catalog) {
+  auto cancel_token = m_cancel_token;
+  try {
+    PhzUITools::ProgressReporter progress{[this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+                                            if (!cancel_token->isCancelled()) {
+                                              emit signalUpdateStatus(QString::fromStdString(
+                                                  "Computing the statistics... " +
+                                                  PhzUITools::ProgressReporter::describe(status)));
+                                            }
+                                          },
+                                          "sources"};
+
+    PhzUITools::SpecZComparisonEngine engine{specz_id_column, specz_column, m_phz_id_column, phz_column};
+    auto metrics = engine.compute(specz_catalog, m_folder + "/phz_cat.fits", pe_catalog, progress,
+                                  [cancel_token]() { return cancel_token->isCancelled(); });
+
+    auto              summary = metrics.getSummary();
+    std::stringstream text;
+    text << "Distribution of : (PhotoZ - SpecZ)/(1 + SpecZ) for " << summary.count << " sources\n"
+         << "--> Mean                : " << summary.mean << "\n"
+         << "--> Median              : " << summary.median << "\n"
+         << "--> Sigma               : " << summary.sigma << "\n"
+         << "--> Mad                 : " << summary.mad << "\n"
+         << "--> NMad                : " << summary.nmad << "\n"
+         << "--> Outliers            : " << summary.outliers_percent << " %\n"
+         << "--> Sigma (no outliers) : " << summary.sigma_no_outliers << "\n"
+         << "--> Mean (no outliers)  : " << summary.mean_no_outliers << "\n\n"
+         << "SpecZ bin: median [first quartile, third quartile] (outliers %)\n";
+    for (auto& box : metrics.getBoxStatistics()) {
+      text << box.bin_min << " - " << box.bin_max << " (" << box.count << "): " << box.median << " ["
+           << box.first_quartile << ", " << box.third_quartile << "] (" << box.outliers_percent << " %)\n";
+    }
+    logger.info() << text.str();
+    return text.str();
+  } catch (const std::exception& e) {
+    if (cancel_token->isCancelled()) {
+      return "Processing stop by the user";
+    }
+    logger.error() << "Error while computing the statistics: " << e.what();
+    return std::string{"Error while computing the statistics: "} + e.what();
+  }
+}
+
+void DialogPSC::statisticsFinished() {
+  m_cancel_token.reset();
+  ui->out_cons->setPlainText(QString::fromStdString(m_future_watcher.result()));
+  ui->btn_cancel->setEnabled(true);
+  ui->btn_cancel->hide();
+  ui->btn_close->show();
+  ui->btn_compute->show();
+}
+
 void DialogPSC::updateOutCons() {
   QString result_all = m_P->readAllStandardOutput();
   ui->out_cons->setPlainText(ui->out_cons->toPlainText() + result_all);
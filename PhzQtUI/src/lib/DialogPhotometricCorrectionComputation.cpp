@@ -8,8 +8,12 @@
 #include <QFuture>
 #include <QMessageBox>
 #include <QStandardItem>
+#include <QTimer>
 #include <QtCore/qfuturewatcher.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <iomanip>
 #include <qfiledialog.h>
 #include <qtconcurrentrun.h>
 
@@ -35,7 +39,6 @@
 #include "PhzConfiguration/ReddeningProviderConfig.h"
 #include "PhzConfiguration/SedProviderConfig.h"
 #include "PhzExecutables/ComputePhotometricCorrections.h"
-#include "PhzUtils/Multithreading.h"
 
 #include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
@@ -67,7 +70,6 @@ DialogPhotometricCorrectionComputation::DialogPhotometricCorrectionComputation(Q
 
   connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(runFinished()));
   connect(&m_future_lum_watcher, SIGNAL(finished()), this, SLOT(lumFinished()));
-  connect(&m_future_sed_watcher, SIGNAL(finished()), this, SLOT(sedFinished()));
 }
 
 DialogPhotometricCorrectionComputation::~DialogPhotometricCorrectionComputation() {}
@@ -291,32 +293,73 @@ void DialogPhotometricCorrectionComputation::enablePage() {
   ui->txt_current_iteration->setText("");
 }
 
-std::string DialogPhotometricCorrectionComputation::runFunction() {
-
-  try {
+std::map<std::string, boost::program_options::variable_value>
+DialogPhotometricCorrectionComputation::getCorrectionConfiguration() const {
+  int  max_iter_number = ui->txt_Iteration->text().toInt();
+  auto config_map      = PhotometricCorrectionHandler::GetConfigurationMap(
+      m_run_option, ui->txt_survey->text().toStdString(), ui->txt_FileName->text().toStdString(), max_iter_number,
+      FormUtils::parseToDouble(ui->txt_Tolerence->text()), ui->cb_SelectionMethod->currentText().toStdString(),
+      ui->txt_catalog->text().toStdString(), ui->cb_SpectroColumn->currentText().toStdString());
 
-    int max_iter_number = ui->txt_Iteration->text().toInt();
+  completeWithDefaults<PhzConfiguration::ComputePhotometricCorrectionsConfig>(config_map);
+  return config_map;
+}
 
-    auto config_map = PhotometricCorrectionHandler::GetConfigurationMap(
-        m_run_option, ui->txt_survey->text().toStdString(), ui->txt_FileName->text().toStdString(), max_iter_number,
-        FormUtils::parseToDouble(ui->txt_Tolerence->text()), ui->cb_SelectionMethod->currentText().toStdString(),
-        ui->txt_catalog->text().toStdString(), ui->cb_SpectroColumn->currentText().toStdString());
+// GUI side estimate of the convergence: the largest relative change of the
+// corrections since the previous iteration, the corrections starting from 1.
+// It is only displayed, the stop criterion compared with the tolerance being
+// the one of the PhosphorosCore stop condition, which may differ.
+static double estimateMaxRelativeChange(const PhzDataModel::PhotometricCorrectionMap& previous,
+                                        const PhzDataModel::PhotometricCorrectionMap& current) {
+  double max_change = 0.;
+  for (auto& correction : current) {
+    auto   previous_correction = previous.find(correction.first);
+    double previous_value      = previous_correction != previous.end() ? previous_correction->second : 1.;
+    if (previous_value != 0.) {
+      max_change = std::max(max_change, std::abs(correction.second - previous_value) / std::abs(previous_value));
+    }
+  }
+  return max_change;
+}
 
-    completeWithDefaults<PhzConfiguration::ComputePhotometricCorrectionsConfig>(config_map);
+std::string DialogPhotometricCorrectionComputation::runFunction() {
+  // Keep the job token alive until the computation is over
+  auto cancel_token = m_cancel_token;
 
+  try {
     long  config_manager_id = Configuration::getUniqueManagerId();
     auto& config_manager    = Configuration::ConfigManager::getInstance(config_manager_id);
     config_manager.registerConfiguration<ComputePhotometricCorrectionsConfig>();
     config_manager.closeRegistration();
-    config_manager.initialize(config_map);
+    config_manager.initialize(m_correction_config);
 
     emit signalUpdateCurrentIteration(QString::fromStdString("Iteration : 0"));
-    auto progress_logger = [this, max_iter_number](size_t iter_no, const PhzDataModel::PhotometricCorrectionMap&) {
+
+    // Report an estimate of the convergence and the duration of each
+    // iteration, so that the tolerance can be tuned against the wall time
+    typedef std::chrono::steady_clock      clock;
+    auto                                   start           = clock::now();
+    auto                                   iteration_start = start;
+    size_t                                 iteration_no    = 0;
+    PhzDataModel::PhotometricCorrectionMap previous{};
+    auto progress_logger = [this, cancel_token, start, &iteration_start, &iteration_no,
+                            &previous](size_t iter_no, const PhzDataModel::PhotometricCorrectionMap& corrections) {
+      auto   now            = clock::now();
+      double change         = estimateMaxRelativeChange(previous, corrections);
+      double iteration_time = std::chrono::duration<double>(now - iteration_start).count();
+      double elapsed        = std::chrono::duration<double>(now - start).count();
+      iteration_start       = now;
+      iteration_no          = iter_no + 1;
+      previous              = corrections;
+      logger.info() << "Iteration " << iteration_no << ": estimated max relative change " << change << " (tolerance "
+                    << m_tolerance << "), " << iteration_time << "s, total " << elapsed << "s";
+
       // If the user has canceled we do not want to update the progress bar,
       // because the GUI thread might have already deleted it
-      if (!PhzUtils::getStopThreadsFlag()) {
+      if (!cancel_token->isCancelled()) {
         std::stringstream iter_no_message;
-        iter_no_message << "Iteration : " << (iter_no + 1);
+        iter_no_message << "Iteration : " << iteration_no << std::setprecision(1) << std::scientific << " (~"
+                        << change << ", " << std::fixed << iteration_time << "s)";
         emit signalUpdateCurrentIteration(QString::fromStdString(iter_no_message.str()));
       } else {
         emit signalUpdateCurrentIteration(QString::fromStdString("Canceling..."));
@@ -324,8 +367,12 @@ std::string DialogPhotometricCorrectionComputation::runFunction() {
     };
 
     PhzExecutables::ComputePhotometricCorrections{progress_logger}.run(config_manager);
+    logger.info() << "Photometric corrections computed in " << iteration_no << " iteration(s), "
+                  << std::chrono::duration<double>(clock::now() - start).count() << "s";
 
-    correctionComputed(ui->txt_FileName->text());
+    // A canceled job does not replace the existing corrections
+    cancel_token->throwIfCancelled();
+    correctionComputed(m_output_name);
     return "";
   } catch (const Elements::Exception& e) {
     return "Sorry, an error occurred during the computation:\n" + std::string(e.what());
@@ -337,6 +384,7 @@ std::string DialogPhotometricCorrectionComputation::runFunction() {
 }
 
 std::string DialogPhotometricCorrectionComputation::runSedFunction() {
+  auto cancel_token = m_cancel_token;
 
   try {
     completeWithDefaults<PhzConfiguration::ComputeSedWeightConfig>(m_sed_config);
@@ -346,11 +394,11 @@ std::string DialogPhotometricCorrectionComputation::runSedFunction() {
     config_manager.closeRegistration();
     config_manager.initialize(m_sed_config);
 
-    auto monitor_function = [this](size_t step, size_t total) {
+    auto monitor_function = [this, cancel_token](size_t step, size_t total) {
       int value = (step * 100) / total;
       // If the user has canceled we do not want to update the progress bar,
       // because the GUI thread might have already deleted it
-      if (!PhzUtils::getStopThreadsFlag()) {
+      if (!cancel_token->isCancelled()) {
         std::stringstream progress_message;
         progress_message << "SED's Weights: " << value << "%";
         emit signalUpdateCurrentIteration(QString::fromStdString(progress_message.str()));
@@ -372,28 +420,45 @@ std::string DialogPhotometricCorrectionComputation::runSedFunction() {
   }
 }
 
-void DialogPhotometricCorrectionComputation::lumFinished() {
-  auto message = m_future_lum_watcher.result();
-  if (message.length() == 0) {
-    if (m_sed_config.size() > 0) {
-      m_future_sed_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runSedFunction, this));
-    } else {
-      m_future_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runFunction, this));
+std::string DialogPhotometricCorrectionComputation::runPipeline() {
+  // The SEDs' weights and the corrections are computed in a single background
+  // job, the corrections starting as soon as the weights are written. Each
+  // step still builds its own ConfigManager, so the model grid and the catalog
+  // are loaded twice: the corrections read the weights from the SED weight
+  // file, which must exist when their configuration is initialized.
+  auto cancel_token = m_cancel_token;
+  if (cancel_token->isCancelled()) {
+    return "The computation has been canceled.";
+  }
+  if (m_sed_config.size() > 0) {
+    auto message = runSedFunction();
+    if (message.length() > 0) {
+      return message;
     }
-  } else {
-    m_computing = false;
-    this->ui->bt_Cancel->setEnabled(true);
-    QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
-    enablePage();
+    if (cancel_token->isCancelled()) {
+      return "The computation has been canceled.";
+    }
+  }
+  return runFunction();
+}
+
+void DialogPhotometricCorrectionComputation::startPipeline() {
+  // A previous run may still be stopping: wait for it from the GUI thread
+  // rather than blocking a thread of the pool
+  if (!m_cancel_token->canStart()) {
+    QTimer::singleShot(100, this, [this]() { startPipeline(); });
+    return;
   }
+  m_future_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runPipeline, this));
 }
 
-void DialogPhotometricCorrectionComputation::sedFinished() {
-  auto message = m_future_sed_watcher.result();
+void DialogPhotometricCorrectionComputation::lumFinished() {
+  auto message = m_future_lum_watcher.result();
   if (message.length() == 0) {
-    m_future_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runFunction, this));
+    startPipeline();
   } else {
     m_computing = false;
+    m_cancel_token.reset();
     this->ui->bt_Cancel->setEnabled(true);
     QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
     enablePage();
@@ -401,12 +466,17 @@ void DialogPhotometricCorrectionComputation::sedFinished() {
 }
 
 void DialogPhotometricCorrectionComputation::runFinished() {
-  std::string message = m_future_watcher.result();
-  m_computing         = false;
+  std::string message   = m_future_watcher.result();
+  bool        cancelled = m_cancel_token && m_cancel_token->isCancelled();
+  m_computing           = false;
+  m_cancel_token.reset();
   this->ui->bt_Cancel->setEnabled(true);
   if (message.length() == 0) {
     this->accept();
     return;
+  } else if (cancelled) {
+    // Canceled by the user, nothing to report
+    enablePage();
   } else {
     QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
     enablePage();
@@ -415,7 +485,9 @@ void DialogPhotometricCorrectionComputation::runFinished() {
 
 void DialogPhotometricCorrectionComputation::on_bt_Cancel_clicked() {
   if (m_computing) {
-    PhzUtils::getStopThreadsFlag() = true;
+    if (m_cancel_token) {
+      m_cancel_token->cancel();
+    }
     this->ui->bt_Cancel->setEnabled(false);
   } else {
     this->reject();
@@ -454,8 +526,7 @@ void DialogPhotometricCorrectionComputation::on_bt_Run_clicked() {
     }
   }
 
-  PhzUtils::getStopThreadsFlag() = false;
-  m_computing                    = true;
+  m_computing = true;
   string output_file_name        = FileUtils::addExt(ui->txt_FileName->text().toStdString(), ".txt");
   ui->txt_FileName->setText(QString::fromStdString(output_file_name));
   auto path_filename = FileUtils::getPhotCorrectionsRootPath(true, ui->txt_survey->text().toStdString()) +
@@ -470,23 +541,19 @@ void DialogPhotometricCorrectionComputation::on_bt_Run_clicked() {
     return;
   }
 
+  // The job only uses values read here, never the widgets
+  m_correction_config = getCorrectionConfiguration();
+  m_output_name       = ui->txt_FileName->text();
+  m_tolerance         = FormUtils::parseToDouble(ui->txt_Tolerence->text());
+
   disablePage();
-  if (m_sed_config.size() > 0) {
-    m_future_sed_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runSedFunction, this));
-  } else {
-    m_future_watcher.setFuture(QtConcurrent::run(&DialogPhotometricCorrectionComputation::runFunction, this));
-  }
+  m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+  startPipeline();
 }
 
 void DialogPhotometricCorrectionComputation::on_btn_conf_clicked() {
 
-  int  max_iter_number = ui->txt_Iteration->text().toInt();
-  auto config_map      = PhotometricCorrectionHandler::GetConfigurationMap(
-      m_run_option, ui->txt_survey->text().toStdString(), ui->txt_FileName->text().toStdString(), max_iter_number,
-      FormUtils::parseToDouble(ui->txt_Tolerence->text()), ui->cb_SelectionMethod->currentText().toStdString(),
-      ui->txt_catalog->text().toStdString(), ui->cb_SpectroColumn->currentText().toStdString());
-
-  completeWithDefaults<PhzConfiguration::ComputePhotometricCorrectionsConfig>(config_map);
+  auto                     config_map = getCorrectionConfiguration();
   std::vector<std::string> correction = {"PDF-sample-number",
                                          "create-output-best-likelihood-model",
                                          "create-output-best-model",
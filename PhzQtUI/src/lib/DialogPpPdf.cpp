@@ -5,12 +5,12 @@
 #include <QFileInfo>
 #include <QList>
 #include <QMessageBox>
-#include <QProcess>
 #include <QScrollBar>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QStringList>
 #include <QThread>
+#include <QtConcurrent>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
@@ -38,243 +38,251 @@ DialogPpPdf::DialogPpPdf(QWidget* parent) : QDialog(parent), ui(new Ui::DialogPp
 
   ui->wg_1d->hide();
   ui->wg_2d->hide();
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->out_cons, SLOT(setPlainText(QString)));
 }
 
-DialogPpPdf::~DialogPpPdf(){};
+DialogPpPdf::~DialogPpPdf() {
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
+  m_future_watcher.waitForFinished();
+}
 
 void DialogPpPdf::setFolder(std::string result_folder) {
   m_result_folder = result_folder;
-  ui->out_cons->setPlainText("");
-  QString     prog = QString::fromStdString("PhosphorosExtractPpPdf");
-  QStringList arguments;
-  arguments << "-z"
-            << "true"
-            << "--result-dir" << QString::fromStdString(m_result_folder) << "--output-range-file"
-            << QString::fromStdString(m_result_folder + "/pp_ranges.csv");
-
-  logger.info() << prog.toStdString() << " " << arguments.join(" ").toStdString();
-  m_P = new QProcess(this);
-  m_P->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-  m_P->setProcessChannelMode(QProcess::MergedChannels);
-  connect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processingFinished(int, QProcess::ExitStatus)));
-  m_processing = true;
-  m_P->start(prog, arguments);
-  m_timer = new QTimer(this);
-  connect(m_timer, SIGNAL(timeout()), this, SLOT(updateOutCons()));
-  m_timer->start(100);
+  ui->out_cons->setPlainText("Reading the posterior samples...");
+  ui->btn_save->setEnabled(false);
+
+  // The samples are indexed in the GUI process, no PhosphorosExtractPpPdf run is needed
+  m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+  connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(rangesComputed()));
+  m_future_watcher.setFuture(QtConcurrent::run(&DialogPpPdf::computeRanges, this));
 }
 
-void DialogPpPdf::updateOutCons() {
-  QString result_all = m_P->readAllStandardOutput();
-  ui->out_cons->setPlainText(ui->out_cons->toPlainText() + result_all);
-  ui->out_cons->verticalScrollBar()->setValue(ui->out_cons->verticalScrollBar()->maximum());
+PhzUITools::ProgressReporter DialogPpPdf::createProgress(const std::string& text) {
+  auto cancel_token = m_cancel_token;
+  return PhzUITools::ProgressReporter{[this, cancel_token, text](const PhzUITools::ProgressReporter::Status& status) {
+                                        if (!cancel_token->isCancelled()) {
+                                          emit signalUpdateStatus(QString::fromStdString(
+                                              text + " " + PhzUITools::ProgressReporter::describe(status)));
+                                        }
+                                      },
+                                      "sources"};
 }
 
-void DialogPpPdf::processingFinished(int, QProcess::ExitStatus) {
-  m_timer->stop();
-  disconnect(m_timer, SIGNAL(timeout()), 0, 0);
-  disconnect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), 0, 0);
-  m_processing = false;
-  if (m_configured) {
-    QMessageBox::information(this, tr("Completed"), tr("The computation of the PP's PDF has been completed!"),
-                             QMessageBox::Ok, QMessageBox::Ok);
-    this->accept();
-  } else {
-    ui->out_cons->setPlainText("");
-    m_configured = true;
-    m_pps        = std::vector<std::string>{};
-    std::vector<double>      min_val{};
-    std::vector<double>      max_val{};
-    std::vector<std::string> units{};
-    string                   row;
-    ifstream                 readFile(m_result_folder + "/pp_ranges.csv");
-    bool                     first_row = true;
-    while (getline(readFile, row)) {
-      if (first_row) {
-        first_row = false;
-      } else {
-        auto parts = QString::fromStdString(row).split(QString(","));
-        m_pps.push_back(parts[0].toStdString());
-        min_val.push_back(parts[1].toFloat());
-        max_val.push_back(parts[2].toFloat());
-        units.push_back(parts[3].toStdString());
-      }
+std::string DialogPpPdf::computeRanges() {
+  auto cancel_token = m_cancel_token;
+  try {
+    // As the -z true option of the former tool: the redshift is the last parameter
+    m_index.reset(new PhzUITools::PosteriorSampleIndex{m_result_folder + "/posteriors", true});
+    m_ranges = m_index->computeRanges(0, createProgress("Computing the parameter ranges..."),
+                                      [cancel_token]() { return cancel_token->isCancelled(); });
+    return "";
+  } catch (const std::exception& e) {
+    m_index.reset();
+    if (cancel_token->isCancelled()) {
+      return "Processing stop by the user";
     }
-    readFile.close();
-
-    QStandardItemModel* grid_model = new QStandardItemModel();
-    grid_model->setColumnCount(5);
-    QStringList setHeaders;
-    setHeaders << "Name"
-               << "Min"
-               << "Max"
-               << "Unit"
-               << "Sample #"
-               << "1D PDF";
-    grid_model->setHorizontalHeaderLabels(setHeaders);
-    for (size_t index = 0; index < m_pps.size(); ++index) {
-      QList<QStandardItem*> items;
-      QStandardItem*        item_id = new QStandardItem(QString::fromStdString(m_pps[index]));
-      item_id->setFlags(Qt::NoItemFlags);
-      items.push_back(item_id);
-      QStandardItem* item_min = new QStandardItem(QString::number(min_val[index]));
-      items.push_back(item_min);
-      QStandardItem* item_max = new QStandardItem(QString::number(max_val[index]));
-      items.push_back(item_max);
-
-      QStandardItem* item_unit = new QStandardItem(QString::fromStdString(units[index]));
-      item_unit->setFlags(Qt::NoItemFlags);
-      items.push_back(item_unit);
-
-      QStandardItem* item_sample = new QStandardItem(QString::number(50));
-      items.push_back(item_sample);
-
-      if (index == m_pps.size() - 1) {
-        QStandardItem* item_pdf = new QStandardItem(QString::number(0));
-        item_pdf->setFlags(Qt::NoItemFlags);
-        items.push_back(item_pdf);
-      } else {
-        QStandardItem* item_pdf = new QStandardItem(QString::number(1));
-        items.push_back(item_pdf);
-      }
+    logger.error() << "Error while reading the posterior samples: " << e.what();
+    return std::string{"Error while reading the posterior samples: "} + e.what();
+  }
+}
 
-      grid_model->appendRow(items);
-    }
-    ui->tv_range->setModel(grid_model);
-    ui->tv_range->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->tv_range->setItemDelegateForColumn(1, new NumberItemDelegate());
-    ui->tv_range->setItemDelegateForColumn(2, new NumberItemDelegate());
-    ui->tv_range->setItemDelegateForColumn(4, new IntItemDelegate(1, 5000));
-    ui->tv_range->setItemDelegateForColumn(5, new BoolItemDelegate());
-    ui->wg_1d->show();
-
-    //---------------------------------------------------------------
-
-    QStandardItemModel* grid_model_2d = new QStandardItemModel();
-    grid_model_2d->setColumnCount(m_pps.size());
-    QStringList setHeaders_2d;
-    setHeaders_2d << "Name";
-    for (size_t index = 1; index < m_pps.size(); ++index) {
-      setHeaders_2d << QString::fromStdString(m_pps[index]);
-    }
+void DialogPpPdf::rangesComputed() {
+  disconnect(&m_future_watcher, SIGNAL(finished()), this, SLOT(rangesComputed()));
+  bool cancelled = m_cancel_token->isCancelled();
+  m_cancel_token.reset();
+  ui->btn_cancel->setEnabled(true);
+  if (cancelled) {
+    accept();
+    return;
+  }
+  auto error = m_future_watcher.result();
+  if (!error.empty() || m_index->getParameters().empty()) {
+    ui->out_cons->setPlainText(QString::fromStdString(error.empty() ? "No physical parameter found" : error));
+    return;
+  }
 
-    grid_model_2d->setHorizontalHeaderLabels(setHeaders_2d);
-
-    for (size_t index = 0; index < m_pps.size() - 1; ++index) {
-      QList<QStandardItem*> items;
-      QStandardItem*        item_id = new QStandardItem(QString::fromStdString(m_pps[index]));
-      item_id->setFlags(Qt::NoItemFlags);
-      items.push_back(item_id);
-
-      for (size_t index_1 = 1; index_1 < m_pps.size(); ++index_1) {
-        if (index_1 <= index) {
-          QStandardItem* item = new QStandardItem(QString::fromStdString(""));
-          item->setFlags(Qt::NoItemFlags);
-          items.push_back(item);
-        } else {
-          QStandardItem* item_pdf = new QStandardItem(QString::number(0));
-          items.push_back(item_pdf);
-        }
-      }
-      grid_model_2d->appendRow(items);
+  ui->out_cons->setPlainText("");
+  ui->btn_save->setEnabled(true);
+  m_configured = true;
+  m_pps        = std::vector<std::string>{};
+  std::vector<double>      min_val{};
+  std::vector<double>      max_val{};
+  std::vector<std::string> units{};
+  for (std::size_t index = 0; index < m_index->getParameters().size(); ++index) {
+    m_pps.push_back(m_index->getParameters()[index].name);
+    min_val.push_back(m_ranges[index].min);
+    max_val.push_back(m_ranges[index].max);
+    units.push_back(m_index->getParameters()[index].unit);
+  }
+
+  QStandardItemModel* grid_model = new QStandardItemModel();
+  grid_model->setColumnCount(5);
+  QStringList setHeaders;
+  setHeaders << "Name"
+             << "Min"
+             << "Max"
+             << "Unit"
+             << "Sample #"
+             << "1D PDF";
+  grid_model->setHorizontalHeaderLabels(setHeaders);
+  for (size_t index = 0; index < m_pps.size(); ++index) {
+    QList<QStandardItem*> items;
+    QStandardItem*        item_id = new QStandardItem(QString::fromStdString(m_pps[index]));
+    item_id->setFlags(Qt::NoItemFlags);
+    items.push_back(item_id);
+    QStandardItem* item_min = new QStandardItem(QString::number(min_val[index]));
+    items.push_back(item_min);
+    QStandardItem* item_max = new QStandardItem(QString::number(max_val[index]));
+    items.push_back(item_max);
+
+    QStandardItem* item_unit = new QStandardItem(QString::fromStdString(units[index]));
+    item_unit->setFlags(Qt::NoItemFlags);
+    items.push_back(item_unit);
+
+    QStandardItem* item_sample = new QStandardItem(QString::number(50));
+    items.push_back(item_sample);
+
+    if (index == m_pps.size() - 1) {
+      QStandardItem* item_pdf = new QStandardItem(QString::number(0));
+      item_pdf->setFlags(Qt::NoItemFlags);
+      items.push_back(item_pdf);
+    } else {
+      QStandardItem* item_pdf = new QStandardItem(QString::number(1));
+      items.push_back(item_pdf);
     }
 
-    ui->tv_2d->setModel(grid_model_2d);
-    ui->tv_2d->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    for (size_t index = 1; index < m_pps.size(); ++index) {
-      ui->tv_2d->setItemDelegateForColumn(index, new BoolItemDelegate());
+    grid_model->appendRow(items);
+  }
+  ui->tv_range->setModel(grid_model);
+  ui->tv_range->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  ui->tv_range->setItemDelegateForColumn(1, new NumberItemDelegate());
+  ui->tv_range->setItemDelegateForColumn(2, new NumberItemDelegate());
+  ui->tv_range->setItemDelegateForColumn(4, new IntItemDelegate(1, 5000));
+  ui->tv_range->setItemDelegateForColumn(5, new BoolItemDelegate());
+  ui->wg_1d->show();
+
+  //---------------------------------------------------------------
+
+  QStandardItemModel* grid_model_2d = new QStandardItemModel();
+  grid_model_2d->setColumnCount(m_pps.size());
+  QStringList setHeaders_2d;
+  setHeaders_2d << "Name";
+  for (size_t index = 1; index < m_pps.size(); ++index) {
+    setHeaders_2d << QString::fromStdString(m_pps[index]);
+  }
+
+  grid_model_2d->setHorizontalHeaderLabels(setHeaders_2d);
+
+  for (size_t index = 0; index < m_pps.size() - 1; ++index) {
+    QList<QStandardItem*> items;
+    QStandardItem*        item_id = new QStandardItem(QString::fromStdString(m_pps[index]));
+    item_id->setFlags(Qt::NoItemFlags);
+    items.push_back(item_id);
+
+    for (size_t index_1 = 1; index_1 < m_pps.size(); ++index_1) {
+      if (index_1 <= index) {
+        QStandardItem* item = new QStandardItem(QString::fromStdString(""));
+        item->setFlags(Qt::NoItemFlags);
+        items.push_back(item);
+      } else {
+        QStandardItem* item_pdf = new QStandardItem(QString::number(0));
+        items.push_back(item_pdf);
+      }
     }
+    grid_model_2d->appendRow(items);
+  }
 
-    ui->wg_2d->show();
+  ui->tv_2d->setModel(grid_model_2d);
+  ui->tv_2d->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  for (size_t index = 1; index < m_pps.size(); ++index) {
+    ui->tv_2d->setItemDelegateForColumn(index, new BoolItemDelegate());
   }
+
+  ui->wg_2d->show();
 }
 
 void DialogPpPdf::on_btn_cancel_clicked() {
-  if (m_processing) {
-    m_P->kill();
-    m_timer->stop();
-    disconnect(m_timer, SIGNAL(timeout()), 0, 0);
-    disconnect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), 0, 0);
-    m_processing = false;
+  if (m_cancel_token) {
+    // The dialog is closed once the computation has stopped
+    m_cancel_token->cancel();
+    ui->btn_cancel->setEnabled(false);
+    return;
   }
   accept();
 }
 
 void DialogPpPdf::on_btn_save_clicked() {
-  // collect pdf 1d
-  std::vector<std::string> pdf_1d{};
-  std::vector<double>      min_v{};
-  std::vector<double>      max_v{};
-  std::vector<int>         number{};
+  if (!m_configured || m_cancel_token) {
+    return;
+  }
+
+  // collect the binnings and the pdf 1d
+  std::vector<PhzUITools::PosteriorSampleIndex::Binning> binnings{};
+  std::vector<std::pair<std::string, std::string>>       pdfs{};
   for (size_t index = 0; index < m_pps.size(); ++index) {
     if (ui->tv_range->model()->data(ui->tv_range->model()->index(index, 5)).toInt() == 1) {
-      pdf_1d.push_back(m_pps[index]);
+      pdfs.emplace_back(m_pps[index], "");
     }
-    min_v.push_back(ui->tv_range->model()->data(ui->tv_range->model()->index(index, 1)).toFloat());
-    max_v.push_back(ui->tv_range->model()->data(ui->tv_range->model()->index(index, 2)).toFloat());
-    number.push_back(std::max(1, ui->tv_range->model()->data(ui->tv_range->model()->index(index, 4)).toInt()));
+    double min_v  = ui->tv_range->model()->data(ui->tv_range->model()->index(index, 1)).toFloat();
+    double max_v  = ui->tv_range->model()->data(ui->tv_range->model()->index(index, 2)).toFloat();
+    int    number = std::max(1, ui->tv_range->model()->data(ui->tv_range->model()->index(index, 4)).toInt());
+    binnings.push_back({min_v, max_v, static_cast<std::size_t>(number)});
   }
 
   // collect pdf 2d
-  std::vector<std::string> pdf_2d{};
   for (size_t index = 0; index < m_pps.size() - 1; ++index) {
     for (size_t index_1 = 1; index_1 < m_pps.size(); ++index_1) {
       if (ui->tv_2d->model()->data(ui->tv_2d->model()->index(index, index_1)).toInt() == 1) {
-        std::string name_2d = m_pps[index] + "_" + m_pps[index_1];
-        pdf_2d.push_back(name_2d);
+        pdfs.emplace_back(m_pps[index], m_pps[index_1]);
       }
     }
   }
 
-  // Create the command
-  if (pdf_1d.size() + pdf_2d.size() == 0) {
+  if (pdfs.empty()) {
     QMessageBox::warning(this, tr("No PDF selected"), tr("Please select at least one PDF to be computed!"),
                          QMessageBox::Cancel, QMessageBox::Cancel);
   } else {
-    std::string bins   = "";
-    std::string ranges = "";
-    for (size_t index = 0; index < m_pps.size(); ++index) {
-      if (index > 0) {
-        bins += ",";
-        ranges += ",";
-      }
-      bins += m_pps[index] + ":" + std::to_string(number[index]);
-      ranges += m_pps[index] + ":" + std::to_string(min_v[index]) + ":" + std::to_string(max_v[index]);
-    }
-
-    std::string pdfs = "";
-    for (size_t index = 0; index < pdf_1d.size(); ++index) {
-      if (index > 0) {
-        pdfs += ",";
-      }
-      pdfs += pdf_1d[index];
-    }
+    ui->btn_save->setEnabled(false);
+    ui->out_cons->setPlainText("Computing the PDFs...");
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+    connect(&m_future_watcher, SIGNAL(finished()), this, SLOT(pdfsComputed()));
+    m_future_watcher.setFuture(QtConcurrent::run(&DialogPpPdf::computePdfs, this, binnings, pdfs));
+  }
+}
 
-    for (size_t index = 0; index < pdf_2d.size(); ++index) {
-      if (pdfs.length() > 0) {
-        pdfs += ",";
-      }
-      pdfs += pdf_2d[index];
+std::string DialogPpPdf::computePdfs(std::vector<PhzUITools::PosteriorSampleIndex::Binning> binnings,
+                                     std::vector<std::pair<std::string, std::string>>       pdfs) {
+  auto cancel_token = m_cancel_token;
+  try {
+    m_index->computePdfs(binnings, pdfs, m_result_folder + "/pp_pdf.fits", 0, createProgress("Computing the PDFs..."),
+                         [cancel_token]() { return cancel_token->isCancelled(); });
+    return "";
+  } catch (const std::exception& e) {
+    if (cancel_token->isCancelled()) {
+      return "Processing stop by the user";
     }
+    logger.error() << "Error while computing the PDFs: " << e.what();
+    return std::string{"Error while computing the PDFs: "} + e.what();
+  }
+}
 
-    QString     prog = QString::fromStdString("PhosphorosExtractPpPdf");
-    QStringList arguments;
-    arguments << "--result-dir" << QString::fromStdString(m_result_folder) << "--pdf-bin"
-              << QString::fromStdString(bins) << "--pdf-range" << QString::fromStdString(ranges) << "--pdf-list"
-              << QString::fromStdString(pdfs) << "--output-pdf-file"
-              << QString::fromStdString(m_result_folder + "/pp_pdf.fits");
-
-    logger.info() << prog.toStdString() << " " << arguments.join(" ").toStdString();
-
-    m_P = new QProcess(this);
-    m_P->setProcessChannelMode(QProcess::MergedChannels);
-    connect(m_P, SIGNAL(finished(int, QProcess::ExitStatus)), this,
-            SLOT(processingFinished(int, QProcess::ExitStatus)));
-    m_processing = true;
-    m_P->start(prog, arguments);
-    m_timer = new QTimer(this);
-    connect(m_timer, SIGNAL(timeout()), this, SLOT(updateOutCons()));
-    m_timer->start(100);
+void DialogPpPdf::pdfsComputed() {
+  disconnect(&m_future_watcher, SIGNAL(finished()), this, SLOT(pdfsComputed()));
+  bool cancelled = m_cancel_token->isCancelled();
+  m_cancel_token.reset();
+  ui->btn_cancel->setEnabled(true);
+  ui->btn_save->setEnabled(true);
+  auto error = m_future_watcher.result();
+  if (cancelled) {
+    accept();
+  } else if (!error.empty()) {
+    ui->out_cons->setPlainText(QString::fromStdString(error));
+  } else {
+    QMessageBox::information(this, tr("Completed"), tr("The computation of the PP's PDF has been completed!"),
+                             QMessageBox::Ok, QMessageBox::Ok);
+    this->accept();
   }
 }
 
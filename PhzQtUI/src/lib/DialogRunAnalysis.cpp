@@ -33,7 +33,7 @@
 #include "PhzConfiguration/SedProviderConfig.h"
 #include "PhzModeling/NoIgmFunctor.h"
 #include "PhzModeling/SparseGridCreator.h"
-#include "PhzUtils/Multithreading.h"
+#include "PhzUITools/ProgressReporter.h"
 
 #include "PhzConfiguration/ComputeSedWeightConfig.h"
 #include "PhzExecutables/ComputeRedshifts.h"
@@ -51,7 +51,6 @@ static Elements::Logging loggerDialog = Elements::Logging::getLogger("DialogRunA
 
 DialogRunAnalysis::DialogRunAnalysis(QWidget* parent) : QDialog(parent), ui(new Ui::DialogRunAnalysis) {
 
-  PhzUtils::getStopThreadsFlag() = false;
   ui->setupUi(this);
   ui->progressBar->setValue(0);
   ui->sed_progress->setValue(0);
@@ -67,6 +66,8 @@ DialogRunAnalysis::DialogRunAnalysis(QWidget* parent) : QDialog(parent), ui(new
   connect(&m_future_sed_watcher, SIGNAL(finished()), this, SLOT(sedFinished()));
   connect(this, SIGNAL(signalUpdateBar(int)), ui->progressBar, SLOT(setValue(int)));
   connect(this, SIGNAL(signalUpdateSedBar(int)), ui->sed_progress, SLOT(setValue(int)));
+  connect(this, SIGNAL(signalUpdateStatus(QString)), ui->label_progress, SLOT(setText(QString)));
+  connect(this, SIGNAL(signalUpdateSedStatus(QString)), ui->label_sed_progress, SLOT(setText(QString)));
 }
 
 DialogRunAnalysis::~DialogRunAnalysis() {}
@@ -94,26 +95,47 @@ void DialogRunAnalysis::setValues(std::string
 }
 
 std::string DialogRunAnalysis::runFunction() {
+  // Keep the job token alive until the computation is over, even if the dialog is closed
+  auto cancel_token = m_cancel_token;
 
   try {
-    completeWithDefaults<ComputeRedshiftsConfig>(m_config);
-
-    long  config_manager_id = Configuration::getUniqueManagerId();
-    auto& config_manager    = Configuration::ConfigManager::getInstance(config_manager_id);
-    config_manager.registerConfiguration<ComputeRedshiftsConfig>();
-    config_manager.closeRegistration();
-    config_manager.initialize(m_config);
-
-    auto monitor_function = [this](size_t step, size_t total) {
-      int value = (step * 100) / total;
-      // If the user has canceled we do not want to update the progress bar,
-      // because the GUI thread might have already deleted it
-      if (!PhzUtils::getStopThreadsFlag()) {
-        emit signalUpdateBar(value);
+    // Progress file polled by scripts and batch schedulers
+    std::string output_dir = boost::any_cast<std::string>(m_original_config.at("phz-output-dir").value());
+    QDir().mkpath(QString::fromStdString(output_dir));
+    PhzUITools::ProgressReporter monitor_function{
+        [this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+          // If the user has canceled we do not want to update the progress bar,
+          // because the GUI thread might have already deleted it
+          if (!cancel_token->isCancelled() && status.total > 0) {
+            emit signalUpdateBar((status.step * 100) / status.total);
+            emit signalUpdateStatus(QString::fromStdString(PhzUITools::ProgressReporter::describe(status)));
+          }
+        },
+        "sources", output_dir + "/progress.json"};
+
+    try {
+      completeWithDefaults<ComputeRedshiftsConfig>(m_config);
+
+      long  config_manager_id = Configuration::getUniqueManagerId();
+      auto& config_manager    = Configuration::ConfigManager::getInstance(config_manager_id);
+      config_manager.registerConfiguration<ComputeRedshiftsConfig>();
+      config_manager.closeRegistration();
+      config_manager.initialize(m_config);
+
+      PhzExecutables::ComputeRedshifts{monitor_function}.run(config_manager);
+      if (cancel_token->isCancelled()) {
+        monitor_function.markCancelled();
+        return "The computation has been canceled.";
       }
-    };
-
-    PhzExecutables::ComputeRedshifts{monitor_function}.run(config_manager);
+    } catch (...) {
+      // Leave a terminal state in the progress file for its readers
+      if (cancel_token->isCancelled()) {
+        monitor_function.markCancelled();
+      } else {
+        monitor_function.markFailed();
+      }
+      throw;
+    }
 
     return "";
 
@@ -127,6 +149,8 @@ std::string DialogRunAnalysis::runFunction() {
 }
 
 std::string DialogRunAnalysis::runSedFunction() {
+  // Keep the job token alive until the computation is over, even if the dialog is closed
+  auto cancel_token = m_cancel_token;
 
   try {
     completeWithDefaults<PhzConfiguration::ComputeSedWeightConfig>(m_sed_config);
@@ -136,16 +160,20 @@ std::string DialogRunAnalysis::runSedFunction() {
     config_manager.closeRegistration();
     config_manager.initialize(m_sed_config);
 
-    auto monitor_function = [this](size_t step, size_t total) {
-      int value = (step * 100) / total;
-      // If the user has canceled we do not want to update the progress bar,
-      // because the GUI thread might have already deleted it
-      if (!PhzUtils::getStopThreadsFlag()) {
-        emit signalUpdateSedBar(value);
-      }
-    };
+    PhzUITools::ProgressReporter monitor_function{
+        [this, cancel_token](const PhzUITools::ProgressReporter::Status& status) {
+          // If the user has canceled we do not want to update the progress bar,
+          // because the GUI thread might have already deleted it
+          if (!cancel_token->isCancelled() && status.total > 0) {
+            emit signalUpdateSedBar((status.step * 100) / status.total);
+            emit signalUpdateSedStatus(QString::fromStdString(PhzUITools::ProgressReporter::describe(status)));
+          }
+        },
+        "SEDs"};
 
     PhzExecutables::ComputeSedWeight{monitor_function}.run(config_manager);
+    // A canceled job does not go on with the redshifts
+    cancel_token->throwIfCancelled();
 
     return "";
 
@@ -159,10 +187,21 @@ std::string DialogRunAnalysis::runSedFunction() {
 }
 
 void DialogRunAnalysis::on_btn_cancel_clicked() {
-  PhzUtils::getStopThreadsFlag() = true;
+  if (m_cancel_token) {
+    m_cancel_token->cancel();
+  }
 }
 
 void DialogRunAnalysis::run() {
+  if (!m_cancel_token) {
+    m_cancel_token = std::make_shared<PhzUITools::CancellationToken>();
+  }
+  // A previous job may still be stopping: retry later from the GUI thread
+  // rather than blocking a thread of the pool
+  if (!m_cancel_token->canStart()) {
+    m_timer->start();
+    return;
+  }
   if (needSedWeights()) {
     m_future_sed_watcher.setFuture(QtConcurrent::run(&DialogRunAnalysis::runSedFunction, this));
   } else {
@@ -178,12 +217,18 @@ void DialogRunAnalysis::sedFinished() {
     m_future_watcher.setFuture(QtConcurrent::run(&DialogRunAnalysis::runFunction, this));
 
   } else {
-    QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
+    bool cancelled = m_cancel_token->isCancelled();
+    m_cancel_token.reset();
+    if (!cancelled) {
+      QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
+    }
     this->reject();
   }
 }
 
 void DialogRunAnalysis::runFinished() {
+  bool cancelled = m_cancel_token && m_cancel_token->isCancelled();
+  m_cancel_token.reset();
   auto message = m_future_watcher.result();
   if (message.length() == 0) {
     // Store the Run configuration in the output folder
@@ -195,6 +240,9 @@ void DialogRunAnalysis::runFinished() {
     this->accept();
     QMessageBox::information(this, "", "Requested computation completed successfully", QMessageBox::Close);
     return;
+  } else if (cancelled) {
+    // Canceled by the user, nothing to report
+    this->reject();
   } else {
     QMessageBox::warning(this, "Error in the computation...", QString::fromStdString(message), QMessageBox::Close);
     this->reject();
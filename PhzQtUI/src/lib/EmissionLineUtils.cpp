@@ -0,0 +1,89 @@
+#include "EmissionLineUtils.h"
+#include "ElementsKernel/Auxiliary.h"
+#include "ElementsKernel/Logging.h"
+#include "EmissionLines/SedDirectoryProcessor.h"
+#include "SEDInterpolation/VirtualSedProvider.h"
+#include <set>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("EmissionLineUtils");
+
+namespace {
+
+const std::string PHOSPHOROS_SUFFIX = "_el";
+const std::string LE_PHARE_SUFFIX   = "_lpel";
+
+bool endsWith(const std::string& value, const std::string& suffix) {
+  return value.size() > suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+std::shared_ptr<EmissionLines::EmissionLinesAdder> EmissionLineUtils::createAdder(Recipe recipe) {
+  // Same settings as the PhosphorosAddEmissionLines defaults and its documented Le Phare-like options
+  bool        le_phare   = recipe == Recipe::LE_PHARE;
+  std::string lines_file = le_phare ? "LePhare_lines.txt" : "Ha_lines.txt";
+  auto        uv_range   = le_phare ? std::make_pair(2100., 2500.) : std::make_pair(1500., 2800.);
+  double      factor     = le_phare ? 1.0e13 : 5.91e-6;
+  auto lines = EmissionLines::readEmissionLines(Elements::getAuxiliaryPath("EmissionLines/" + lines_file).string());
+  return std::make_shared<EmissionLines::EmissionLinesAdder>(uv_range, factor, lines);
+}
+
+std::string EmissionLineUtils::addEmissionLines(const std::string& sed_group_dir, Recipe recipe) {
+  std::string out_dir = sed_group_dir + (recipe == Recipe::LE_PHARE ? LE_PHARE_SUFFIX : PHOSPHOROS_SUFFIX);
+
+  try {
+    EmissionLines::SedDirectoryProcessor processor{*createAdder(recipe)};
+    processor.process(sed_group_dir, out_dir);
+    return "";
+  } catch (const std::exception& e) {
+    logger.error() << "Adding the emission lines to " << sed_group_dir << " failed: " << e.what();
+    return e.what();
+  }
+}
+
+std::shared_ptr<XYDataset::XYDatasetProvider>
+EmissionLineUtils::createSedProvider(std::shared_ptr<XYDataset::XYDatasetProvider>              base,
+                                     const std::map<std::string, PhzDataModel::ModelAxesTuple>& regions) {
+  // The emission line groups on the path of the SEDs, e.g. "CWW_el" for "CWW_el/Sub/Ell"
+  std::set<std::string> groups{};
+  for (auto& region : regions) {
+    for (auto& sed : std::get<PhzDataModel::ModelParameter::SED>(region.second)) {
+      std::string group{};
+      for (auto& part : sed.groups()) {
+        group += (group.empty() ? "" : "/") + part;
+        if (endsWith(part, PHOSPHOROS_SUFFIX) || endsWith(part, LE_PHARE_SUFFIX)) {
+          groups.insert(group);
+          break;
+        }
+      }
+    }
+  }
+
+  std::shared_ptr<SEDInterpolation::VirtualSedProvider> provider{};
+  for (auto& group : groups) {
+    if (!base->listContents(group).empty()) {
+      continue;
+    }
+    bool        le_phare   = endsWith(group, LE_PHARE_SUFFIX);
+    auto&       suffix     = le_phare ? LE_PHARE_SUFFIX : PHOSPHOROS_SUFFIX;
+    std::string base_group = group.substr(0, group.size() - suffix.size());
+    if (base->listContents(base_group).empty()) {
+      continue;
+    }
+    if (!provider) {
+      provider = std::make_shared<SEDInterpolation::VirtualSedProvider>(base);
+    }
+    provider->addEmissionLines(base_group, suffix, createAdder(le_phare ? Recipe::LE_PHARE : Recipe::PHOSPHOROS));
+    logger.info() << "The SEDs of " << group << " are computed on the fly from " << base_group;
+  }
+  if (!provider) {
+    return base;
+  }
+  return provider;
+}
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
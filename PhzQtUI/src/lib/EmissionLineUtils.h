@@ -0,0 +1,53 @@
+#ifndef EMISSIONLINEUTILS_H
+#define EMISSIONLINEUTILS_H
+#include "EmissionLines/EmissionLinesAdder.h"
+#include "PhzDataModel/PhzModel.h"
+#include "XYDataset/XYDatasetProvider.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+/**
+ * @brief The EmissionLineUtils class, adding emission lines to the SEDs of
+ * the auxiliary data in-process (see PhosphorosAddEmissionLines).
+ */
+class EmissionLineUtils {
+public:
+  /// The set of lines and the luminosity factor to use
+  enum class Recipe { PHOSPHOROS, LE_PHARE };
+
+  /**
+   * @brief Create the folder <group>_el (or <group>_lpel for the Le Phare-like
+   * recipe) next to the SED group, containing its SEDs with added emission
+   * lines. Can be called from a worker thread.
+   *
+   * @param sed_group_dir
+   * The full path of the SED group folder
+   * @return An error message, empty on success
+   */
+  static std::string addEmissionLines(const std::string& sed_group_dir, Recipe recipe);
+
+  /**
+   * @brief Get the SED provider of a grid computation.
+   *
+   * @details
+   * The <group>_el and <group>_lpel groups of the SEDs of the regions which
+   * have not been generated on disk are served by a
+   * SEDInterpolation::VirtualSedProvider wrapping the base provider, their
+   * SEDs being computed on demand from the ones of <group>. The base provider
+   * is returned as it is if there is no such group.
+   */
+  static std::shared_ptr<XYDataset::XYDatasetProvider>
+  createSedProvider(std::shared_ptr<XYDataset::XYDatasetProvider>              base,
+                    const std::map<std::string, PhzDataModel::ModelAxesTuple>& regions);
+
+private:
+  static std::shared_ptr<EmissionLines::EmissionLinesAdder> createAdder(Recipe recipe);
+};
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
+#endif  // EMISSIONLINEUTILS_H
@@ -7,15 +7,16 @@
 #include "PhzConfiguration/IntermediateDirConfig.h"
 #include "PhzConfiguration/PhosphorosRootDirConfig.h"
 #include "PhzConfiguration/ResultsDirConfig.h"
-#include "XYDataset/AsciiParser.h"
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileInfoList>
 #include <QTextStream>
+#include <algorithm>
 #include <chrono>
 #include <string>
 
+#include "PhzUITools/CachedFileParser.h"
 #include "PhzUITools/CatalogColumnReader.h"
 
 namespace Euclid {
@@ -163,6 +164,14 @@ std::string FileUtils::getGUIConfigPath() {
   return path.toStdString();
 }
 
+std::string FileUtils::getDatasetCachePath() {
+  return getRootPath(true) + ".cache/XYDataset";
+}
+
+std::unique_ptr<XYDataset::FileParser> FileUtils::createDatasetParser() {
+  return PhzUITools::CachedFileParser::create(getDatasetCachePath());
+}
+
 std::string FileUtils::getGUILuminosityPriorConfig(bool check, const std::string& catalog_type,
                                                    const std::string& model) {
   QString path = QString::fromStdString(FileUtils::getGUIConfigPath()) + QDir::separator() + "LuminosityPrior" +
@@ -607,9 +616,15 @@ std::string FileUtils::getDataSetFilePath(const std::string& dataset_name, const
   QDir directory(QString::fromStdString(folder));
   auto list = directory.entryList(QStringList() << "*.*", QDir::Files);
 
-  XYDataset::AsciiParser parser{};
+  // The files are usually named after their dataset, these ones are checked
+  // first. Only the names are read, from the cache or from the file headers.
+  std::stable_partition(list.begin(), list.end(), [&name](const QString& file) {
+    return QFileInfo(file).completeBaseName().toStdString() == name;
+  });
+  // The root directory cannot change while the GUI runs: one parser is enough
+  static auto parser = createDatasetParser();
   for (int i = 0; i < list.count(); ++i) {
-    if (parser.getName(folder + "/" + list[i].toStdString()) == name) {
+    if (parser->getName(folder + "/" + list[i].toStdString()) == name) {
       return sub_folder + "/" + list[i].toStdString();
     }
   }
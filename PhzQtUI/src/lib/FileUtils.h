@@ -1,9 +1,11 @@
 #ifndef FILEUTILS_H
 #define FILEUTILS_H
 #include "Configuration/ConfigManager.h"
+#include "XYDataset/FileParser.h"
 #include <QString>
 #include <boost/program_options.hpp>
 #include <map>
+#include <memory>
 #include <string>
 
 /**
@@ -116,6 +118,18 @@ public:
    */
   static std::string getGUIConfigPath();
 
+  /**
+   * @brief Get the path into which the binary copies of the parsed datasets
+   * are stored. it is computed as <rootPath>/.cache/XYDataset.
+   */
+  static std::string getDatasetCachePath();
+
+  /**
+   * @brief Build the parser of the auxiliary data files: an AsciiParser keeping
+   * its results in the getDatasetCachePath directory.
+   */
+  static std::unique_ptr<XYDataset::FileParser> createDatasetParser();
+
   /**
    * @brief Get the path into which the Luminosity GUI configs are stored.
    * it is computed as <GUIConfigPath>/LuminosityPrior/<catalog_type>/<model>.
@@ -8,7 +8,6 @@
 #include <QStandardItemModel>
 #include <QTextStream>
 #include <QUrl>
-#include <boost/archive/text_iarchive.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #include <functional>
@@ -32,6 +31,7 @@
 #include "PhzQtUI/DialogRunAnalysis.h"
 #include "PhzQtUI/DialogZeroPointName.h"
 #include "PhzQtUI/FormAnalysis.h"
+#include "PhzQtUI/GridInfoCache.h"
 #include "PhzQtUI/ModelSet.h"
 #include "PhzQtUI/PhotometricCorrectionHandler.h"
 #include "PhzQtUI/PhzGridInfoHandler.h"
@@ -1164,10 +1164,8 @@ bool FormAnalysis::checkSedWeightFile(std::string sed_weight_file_name) {
       std::string model_grid_file = FileUtils::getPhotmetricGridRootPath(true, survey_name) + "/" +
                                     ui->cb_CompatibleGrid->currentText().toStdString();
 
-      PhzDataModel::PhotometryGridInfo model_grid_info;
-      std::ifstream                    in{model_grid_file};
-      boost::archive::text_iarchive    bia{in};
-      bia >> model_grid_info;
+      auto  model_grid_info_ptr = GridInfoCache::getInstance().getGridInfo(model_grid_file);
+      auto& model_grid_info     = *model_grid_info_ptr;
 
       // check the axis
       if (model_grid_info.region_axes_map.size() != sed_weight_grids.size()) {
@@ -2080,8 +2078,6 @@ void FormAnalysis::on_btn_computeCorrections_clicked() {
 
   connect(popup.get(), SIGNAL(correctionComputed(const QString&)), SLOT(onCorrectionComputed(const QString&)));
   popup->exec();
-
-  PhzUtils::getStopThreadsFlag() = false;
 }
 
 void FormAnalysis::onCorrectionComputed(const QString& new_file_name) {
@@ -6,16 +6,17 @@
 #include <QMessageBox>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QProcess>
 #include <QProgressDialog>
 #include <QStandardItemModel>
 #include <QTreeView>
+#include <QtConcurrent>
 #include <QtCore/qurl.h>
 #include <QtGui/qdesktopservices.h>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 
 #include "AlexandriaKernel/memory_tools.h"
+#include "EmissionLineUtils.h"
 #include "FileUtils.h"
 #include "PhzQtUI/DataSetTreeModel.h"
 #include "PhzQtUI/DialogCreatesSubGroup.h"
@@ -24,8 +25,9 @@
 #include "PhzQtUI/DialogSedParam.h"
 #include "PhzQtUI/DialogSedSelector.h"
 #include "PhzQtUI/FormAuxDataManagement.h"
+#include "PhzQtUI/SedMetadataIndex.h"
 #include "PhzQtUI/filecopyer.h"
-#include "XYDataset/AsciiParser.h"
+#include "PhzUITools/CachedFileParser.h"
 #include "ui_FormAuxDataManagement.h"
 
 namespace Euclid {
@@ -36,9 +38,12 @@ FormAuxDataManagement::FormAuxDataManagement(QWidget* parent) : QWidget(parent),
   ui->setupUi(this);
   m_planck_file = FileUtils::getAuxRootPath() + "/GalacticDustMap/PlanckEbv.fits";
   ui->InfoPannel->setVisible(false);
+  connect(&m_emission_lines_watcher, SIGNAL(finished()), this, SLOT(sedProcessfinished()));
 }
 
-FormAuxDataManagement::~FormAuxDataManagement() {}
+FormAuxDataManagement::~FormAuxDataManagement() {
+  m_emission_lines_watcher.waitForFinished();
+}
 
 void FormAuxDataManagement::setRepositories(DatasetRepo filter_repository, DatasetRepo seds_repository,
                                             DatasetRepo redenig_curves_repository, DatasetRepo luminosity_repository) {
@@ -176,40 +181,14 @@ void FormAuxDataManagement::addEmissionLineButtonClicked(const QString& group) {
   }
 
   msgBox.exec();
-  QString command = QString::fromStdString("PhosphorosAddEmissionLines");
-  auto    aux_path = FileUtils::getAuxRootPath();
-  if (msgBox.clickedButton() == phosButton) {
-    QProcess* process = new QProcess();
-    process->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-    QStringList arguments;
-    arguments << "--sed-dir"
-    		  << QString::fromStdString(aux_path) + QDir::separator() + QString::fromStdString("SEDs") + QDir::separator() + group;
-
-    logger.info() << "Executing :" << command.toStdString() << " " << arguments.join(" ").toStdString();
-
-    connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), this,
-            SLOT(sedProcessfinished(int, QProcess::ExitStatus)));
-    connect(process, SIGNAL(started()), this, SLOT(sedProcessStarted()));
-
-    process->start(command, arguments);
-  } else if (msgBox.clickedButton() == lePhareButton) {
-    QProcess* process = new QProcess();
-    process->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
-    QStringList arguments;
-    arguments << "--suffix" << "_lpel"
-    		  << "--reference-factor" << "1.0e13"
-              << "--uv-range" << "2100,2500"
-			  << "--emission-lines" << "LePhare_lines.txt"
-			  << "--sed-dir" << QString::fromStdString(aux_path) + QDir::separator() + QString::fromStdString("SEDs") + QDir::separator() + group;
-
-
-    logger.info() << "Executing :" << command.toStdString() << " " << arguments.join(" ").toStdString();
-
-    connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), this,
-            SLOT(sedProcessfinished(int, QProcess::ExitStatus)));
-    connect(process, SIGNAL(started()), this, SLOT(sedProcessStarted()));
-
-    process->start(command, arguments);
+  auto sed_dir = FileUtils::getAuxRootPath() + "/SEDs/" + group.toStdString();
+  auto clicked = msgBox.clickedButton();
+  if (clicked != nullptr && (clicked == phosButton || clicked == lePhareButton)) {
+    auto recipe =
+        clicked == phosButton ? EmissionLineUtils::Recipe::PHOSPHOROS : EmissionLineUtils::Recipe::LE_PHARE;
+    logger.info() << "Adding emission lines to " << sed_dir;
+    sedProcessStarted();
+    m_emission_lines_watcher.setFuture(QtConcurrent::run(&EmissionLineUtils::addEmissionLines, sed_dir, recipe));
   } else {
     ui->labelMessage->setText("");
   }
@@ -304,13 +283,22 @@ void FormAuxDataManagement::handleDataException(std::string message) {
   }
 }
 
-void FormAuxDataManagement::sedProcessfinished(int, QProcess::ExitStatus) {
+void FormAuxDataManagement::sedProcessfinished() {
+  auto message = m_emission_lines_watcher.result();
+  if (!message.empty()) {
+    QMessageBox::warning(this, "Error while adding the emission lines...", QString::fromStdString(message),
+                         QMessageBox::Ok);
+  }
+
   // reload the provider and the model
   try {
-    std::unique_ptr<XYDataset::FileParser>         sed_file_parser{new XYDataset::AsciiParser{}};
+    std::unique_ptr<XYDataset::FileParser>         sed_file_parser{FileUtils::createDatasetParser()};
     std::unique_ptr<XYDataset::FileSystemProvider> sed_provider(
         new XYDataset::FileSystemProvider{FileUtils::getSedRootPath(true), std::move(sed_file_parser)});
     m_seds_repository->resetProvider(std::move(sed_provider));
+    // The reload invalidates the axes cached by the model sets; the SED headers
+    // index has to check the new group
+    SedMetadataIndex::getInstance()->refresh();
   } catch (Elements::Exception& e) {
     handleDataException(e.what());
     exit(0);
@@ -325,7 +313,7 @@ void FormAuxDataManagement::copyingFilterFinished(bool success, QVector<QString>
     logger.info() << "files modified ";
     // reset repo
     try {
-      std::unique_ptr<XYDataset::FileParser>         filter_file_parser{new XYDataset::AsciiParser{}};
+      std::unique_ptr<XYDataset::FileParser>         filter_file_parser{FileUtils::createDatasetParser()};
       std::unique_ptr<XYDataset::FileSystemProvider> filter_provider(
           new XYDataset::FileSystemProvider{FileUtils::getFilterRootPath(true), std::move(filter_file_parser)});
       m_filter_repository->resetProvider(std::move(filter_provider));
@@ -346,7 +334,7 @@ void FormAuxDataManagement::copyingSEDFinished(bool success, QVector<QString>) {
     logger.info() << "files modified ";
     // reload the provider and the model
     try {
-      std::unique_ptr<XYDataset::FileParser>         sed_file_parser{new XYDataset::AsciiParser{}};
+      std::unique_ptr<XYDataset::FileParser>         sed_file_parser{FileUtils::createDatasetParser()};
       std::unique_ptr<XYDataset::FileSystemProvider> sed_provider(
           new XYDataset::FileSystemProvider{FileUtils::getSedRootPath(true), std::move(sed_file_parser)});
       m_seds_repository->resetProvider(std::move(sed_provider));
@@ -365,7 +353,7 @@ void FormAuxDataManagement::copyingRedFinished(bool success, QVector<QString>) {
     logger.info() << "files modified ";
     // reload the provider and the model
     try {
-      std::unique_ptr<XYDataset::FileParser>         red_file_parser{new XYDataset::AsciiParser{}};
+      std::unique_ptr<XYDataset::FileParser>         red_file_parser{FileUtils::createDatasetParser()};
       std::unique_ptr<XYDataset::FileSystemProvider> red_provider(
           new XYDataset::FileSystemProvider{FileUtils::getRedCurveRootPath(true), std::move(red_file_parser)});
       m_redenig_curves_repository->resetProvider(std::move(red_provider));
@@ -385,7 +373,7 @@ void FormAuxDataManagement::copyingLumFinished(bool success, QVector<QString>) {
     // reload the provider and the model
 
     try {
-      std::unique_ptr<XYDataset::FileParser>         lum_file_parser{new XYDataset::AsciiParser{}};
+      std::unique_ptr<XYDataset::FileParser>         lum_file_parser{FileUtils::createDatasetParser()};
       std::unique_ptr<XYDataset::FileSystemProvider> lum_provider(new XYDataset::FileSystemProvider{
           FileUtils::getLuminosityFunctionCurveRootPath(true), std::move(lum_file_parser)});
       m_luminosity_repository->resetProvider(std::move(lum_provider));
@@ -420,6 +408,7 @@ void FormAuxDataManagement::deletFilterGroupButtonClicked(const QString& group)
   if (msgBox.exec() == QMessageBox::Apply) {
     std::string path = FileUtils::getFilterRootPath(false) + "/" + group.toStdString();
     boost::filesystem::remove_all(path);
+    PhzUITools::CachedFileParser::evictStale(FileUtils::getDatasetCachePath());
     copyingFilterFinished(true, {});
   }
 }
@@ -440,6 +429,7 @@ void FormAuxDataManagement::deletSedGroupButtonClicked(const QString& group) {
   if (msgBox.exec() == QMessageBox::Apply) {
     std::string path = FileUtils::getSedRootPath(false) + "/" + group.toStdString();
     boost::filesystem::remove_all(path);
+    PhzUITools::CachedFileParser::evictStale(FileUtils::getDatasetCachePath());
     copyingSEDFinished(true, {});
   }
 }
@@ -460,6 +450,7 @@ void FormAuxDataManagement::deletRedGroupButtonClicked(const QString& group) {
   if (msgBox.exec() == QMessageBox::Apply) {
     std::string path = FileUtils::getRedCurveRootPath(false) + "/" + group.toStdString();
     boost::filesystem::remove_all(path);
+    PhzUITools::CachedFileParser::evictStale(FileUtils::getDatasetCachePath());
     copyingRedFinished(true, {});
   }
 }
@@ -480,6 +471,7 @@ void FormAuxDataManagement::deletLumGroupButtonClicked(const QString& group) {
   if (msgBox.exec() == QMessageBox::Apply) {
     std::string path = FileUtils::getLuminosityFunctionCurveRootPath(false) + "/" + group.toStdString();
     boost::filesystem::remove_all(path);
+    PhzUITools::CachedFileParser::evictStale(FileUtils::getDatasetCachePath());
     copyingLumFinished(true, {});
   }
 }
@@ -62,6 +62,24 @@ void FormSurveyMapping::loadCatalogCB(std::string selected) {
   m_diconnect_cb = false;
 }
 
+void FormSurveyMapping::catalogLoaded(QString name) {
+  if (!m_survey_model_ptr->isInEdition() && m_survey_model_ptr->getSelectedRow() >= 0 &&
+      m_survey_model_ptr->getSelectedSurvey().getName() == name.toStdString()) {
+    // The saved catalog has just been read
+    updateSelection(true);
+  } else {
+    m_diconnect_cb = true;
+    ui->cb_catalog_type->addItem(name);
+    m_diconnect_cb = false;
+  }
+}
+
+void FormSurveyMapping::catalogsLoaded() {
+  if (!m_survey_model_ptr->isInEdition()) {
+    updateSelection(true);
+  }
+}
+
 void FormSurveyMapping::updateSelection(bool force_reload_cb) {
   if (force_reload_cb ||
       (m_survey_model_ptr->getSelectedRow() >= 0 &&
@@ -151,6 +169,11 @@ void FormSurveyMapping::loadMappingPage(std::shared_ptr<SurveyModel> survey_mode
   ui->txt_UpperLimit->setValidator(new QDoubleValidator());
   m_filter_repository = filter_repository;
 
+  // The catalogs may still be loading: they are added to the list as they come
+  connect(m_survey_model_ptr.get(), SIGNAL(surveyLoaded(QString)), this, SLOT(catalogLoaded(QString)),
+          Qt::UniqueConnection);
+  connect(m_survey_model_ptr.get(), SIGNAL(surveysLoaded()), this, SLOT(catalogsLoaded()), Qt::UniqueConnection);
+
   loadCatalogCB(m_survey_model_ptr->getSelectedSurvey().getName());
 
   if (new_path.length() > 0) {
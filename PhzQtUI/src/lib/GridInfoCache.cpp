@@ -0,0 +1,74 @@
+#include "PhzQtUI/GridInfoCache.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzDataModel/serialization/PhotometryGridInfo.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <boost/archive/text_iarchive.hpp>
+#include <fstream>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+GridInfoCache& GridInfoCache::getInstance() {
+  static GridInfoCache instance{};
+  return instance;
+}
+
+std::shared_ptr<const PhzDataModel::PhotometryGridInfo> GridInfoCache::getGridInfo(const std::string& file) {
+  QFileInfo file_info(QString::fromStdString(file));
+  if (!file_info.isFile()) {
+    throw Elements::Exception() << "The model grid file " << file << " does not exist";
+  }
+  std::string path  = file_info.absoluteFilePath().toStdString();
+  long long   mtime = file_info.lastModified().toMSecsSinceEpoch();
+  long long   size  = file_info.size();
+
+  std::shared_ptr<std::mutex> load_mutex{};
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto&                       entry = m_entries[path];
+    if (entry.mtime != mtime || entry.size != size) {
+      entry.mtime = mtime;
+      entry.size  = size;
+      entry.info.reset();
+    }
+    if (entry.info) {
+      return entry.info;
+    }
+    load_mutex = entry.load_mutex;
+  }
+
+  // Read the file without holding the cache lock, the concurrent requests for
+  // the same file waiting for this read
+  std::lock_guard<std::mutex> load_lock(*load_mutex);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto&                       entry = m_entries[path];
+    if (entry.mtime == mtime && entry.size == size && entry.info) {
+      return entry.info;
+    }
+  }
+
+  // The header is at the beginning of the file, the grids are not read
+  auto                          info = std::make_shared<PhzDataModel::PhotometryGridInfo>();
+  std::ifstream                 in{path};
+  boost::archive::text_iarchive bia{in};
+  bia >> *info;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto&                       entry = m_entries[path];
+  // The file may have been replaced during the read, in which case the entry
+  // is left to the requests for the new file
+  if (entry.mtime == mtime && entry.size == size && !entry.info) {
+    entry.info = info;
+  }
+  return info;
+}
+
+void GridInfoCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
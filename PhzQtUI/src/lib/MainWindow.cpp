@@ -3,15 +3,19 @@
 #include "ElementsKernel/Logging.h"
 #include "FileUtils.h"
 #include "PreferencesUtils.h"
-#include "XYDataset/AsciiParser.h"
+#include "PhzQtUI/DatasetListingCache.h"
+#include "PhzUITools/CachedFileParser.h"
+#include "StartupProfile.h"
 #include "ui_MainWindow.h"
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QtConcurrent>
+#include <chrono>
 #include <fstream>
+#include <utility>
 #include <stdio.h>
-#include <chrono>
 #include <QApplication>
 
 #include "PhzQtUI/DataPackHandler.h"
@@ -24,6 +28,7 @@ static Elements::Logging main_logger = Elements::Logging::getLogger("MainWindow"
 
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWindow) {
   main_logger.debug()<<"start loading";
+  StartupProfile::Phase profile_phase("MainWindow construction");
   QString title = QString::fromStdString(THIS_PROJECT_NAME_STRING + " " + THIS_PROJECT_VERSION_STRING);
   setWindowTitle(title);
 
@@ -102,6 +107,12 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 
   FileUtils::buildDirectories();
 
+  connect(&m_filter_watcher, SIGNAL(finished()), this, SLOT(auxDataLoaded()));
+  connect(&m_seds_watcher, SIGNAL(finished()), this, SLOT(auxDataLoaded()));
+  connect(&m_redenig_curves_watcher, SIGNAL(finished()), this, SLOT(auxDataLoaded()));
+  connect(&m_luminosity_watcher, SIGNAL(finished()), this, SLOT(auxDataLoaded()));
+  connect(m_survey_model_ptr.get(), SIGNAL(surveysLoaded()), this, SLOT(surveysLoaded()));
+
   /*  DataPack handling */
   m_dataPackHandler.reset(new DataPackHandler(this));
   connect(m_dataPackHandler.get(), SIGNAL(completed()), this, SLOT(loadAuxData()));
@@ -122,136 +133,249 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
   main_logger.debug()<<"loading done";
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+  // Do not leave the loading threads running past the window
+  for (auto watcher : {&m_filter_watcher, &m_seds_watcher, &m_redenig_curves_watcher, &m_luminosity_watcher}) {
+    watcher->waitForFinished();
+  }
+}
 
 void MainWindow::loadAuxData() {
-  main_logger.info()<<"Loading data";
-  try {
+  main_logger.info() << "Loading data";
+  StartupProfile::getInstance().milestone("Data pack checked");
+  ui->Lb_warning_time->setText("Loading the Auxiliary Data...");
+
+  // On a reload (after a data pack update) the pages using the repositories
+  // stay disabled until the new ones are ready, and are then rebuilt from them
+  ui->btn_HomeToCatalog->setEnabled(false);
+  ui->btn_HomeToModel->setEnabled(false);
+  ui->btn_HomeToAnalysis->setEnabled(false);
+  ui->btn_HomeToOption->setEnabled(false);
+  resetRepo();
 
-	ui->Lb_warning_time->setText("Loading the Filters...");
-	qApp->processEvents();
-    std::unique_ptr<XYDataset::FileParser>         filter_file_parser{new XYDataset::AsciiParser{}};
-    std::unique_ptr<XYDataset::FileSystemProvider> filter_provider(
-        new XYDataset::FileSystemProvider{FileUtils::getFilterRootPath(true), std::move(filter_file_parser)});
-    m_filter_repository.reset(
-        new DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>(std::move(filter_provider)));
-    m_filter_repository->reload();
-
-
-	ui->Lb_warning_time->setText("Loading the SEDs...");
-	qApp->processEvents();
-    std::unique_ptr<XYDataset::FileParser>         sed_file_parser{new XYDataset::AsciiParser{}};
-    std::unique_ptr<XYDataset::FileSystemProvider> sed_provider(
-        new XYDataset::FileSystemProvider{FileUtils::getSedRootPath(true), std::move(sed_file_parser)});
-    m_seds_repository.reset(
-        new DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>(std::move(sed_provider)));
-    m_seds_repository->reload();
-
-
-	ui->Lb_warning_time->setText("Loading the Reddening Curves...");
-	qApp->processEvents();
-    std::unique_ptr<XYDataset::FileParser>         reddening_file_parser{new XYDataset::AsciiParser{}};
-    std::unique_ptr<XYDataset::FileSystemProvider> red_curve_provider(
-        new XYDataset::FileSystemProvider{FileUtils::getRedCurveRootPath(true), std::move(reddening_file_parser)});
-    m_redenig_curves_repository.reset(
-        new DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>{std::move(red_curve_provider)});
-    m_redenig_curves_repository->reload();
-
-
-    m_model_set_model_ptr = std::shared_ptr<ModelSetModel>{new ModelSetModel{m_seds_repository, m_redenig_curves_repository}};
-
-
-	ui->Lb_warning_time->setText("Loading the Luminosity Functions...");
-	qApp->processEvents();
-    std::unique_ptr<XYDataset::FileParser>         luminosity_file_parser{new XYDataset::AsciiParser{}};
-    std::unique_ptr<XYDataset::FileSystemProvider> luminosity_curve_provider(new XYDataset::FileSystemProvider{
-        FileUtils::getLuminosityFunctionCurveRootPath(true), std::move(luminosity_file_parser)});
-    m_luminosity_repository.reset(
-        new DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>{std::move(luminosity_curve_provider)});
-    m_luminosity_repository->reload();
-    main_logger.info()<<"Loading data done";
-	ui->Lb_warning_time->setText("");
-	qApp->processEvents();
+  // The four repositories are built concurrently, the pages being enabled as
+  // soon as the repositories they need are ready (see auxDataLoaded)
+  m_filter_watcher.setFuture(
+      QtConcurrent::run(&MainWindow::loadRepository, FileUtils::getFilterRootPath(true), std::string("Filters")));
+  m_seds_watcher.setFuture(
+      QtConcurrent::run(&MainWindow::loadRepository, FileUtils::getSedRootPath(true), std::string("SEDs")));
+  m_redenig_curves_watcher.setFuture(QtConcurrent::run(
+      &MainWindow::loadRepository, FileUtils::getRedCurveRootPath(true), std::string("ReddeningCurves")));
+  m_luminosity_watcher.setFuture(QtConcurrent::run(&MainWindow::loadRepository,
+                                                   FileUtils::getLuminosityFunctionCurveRootPath(true),
+                                                   std::string("LuminosityFunctionCurves")));
+  // Drop the parsed copies of the datasets deleted or renamed since the last
+  // run. A copy rewritten meanwhile by the loading may go too: it is a cache miss
+  QtConcurrent::run(&PhzUITools::CachedFileParser::evictStale, FileUtils::getDatasetCachePath());
+
+  // The Post-Processing page only needs the catalogs
+  ui->btn_HomeToPP->setEnabled(true);
+}
+
+MainWindow::RepositoryLoad MainWindow::loadRepository(std::string root_path, std::string data_type) {
+  StartupProfile::Phase profile_phase(data_type + " repository");
+  RepositoryLoad        result{};
+  try {
+    DatasetListingCache listing_cache{DatasetListingCache::getCacheFile(data_type)};
+    auto                provider = listing_cache.createProvider(root_path);
+    listing_cache.save();
+    result.repository.reset(
+        new DatasetRepository<std::unique_ptr<XYDataset::FileSystemProvider>>{std::move(provider)});
+    result.repository->reload();
   } catch (Elements::Exception& e) {
-    std::string msg = e.what();
-    if (msg.rfind("Qualified name can not be inserted in the map.", 0) == 0) {
-
-      std::string msg_part = msg.replace(0, 61, "");
-      std::string name     = msg_part.substr(0, msg_part.find(":") - 5);
-      std::string path     = msg_part.substr(msg_part.find(":") + 1);
-      path                 = path.substr(0, path.find_last_of("/"));
-
-      QString text = QString::fromStdString(
-          std::string("Conflict in the auxiliary data: 2 files contain a dataset with the same name.\n\n"
-                      "Dataset name : \n") +
-          name + "\n\nPath containing the files : \n" + path + "\n\n" +
-          "Please remove one of the files and re-launch Phosphoros.");
-      QMessageBox::critical(this, "Error while loading the Auxiliary Data...", text, QMessageBox::Abort);
-    } else {
-      QString text = QString::fromStdString(std::string("An error occured  while loading the Auxiliary Data.\n "
-                                                        "Error : ") +
-                                            msg);
-      QMessageBox::critical(this, "Error while loading the Auxiliary Data...", text, QMessageBox::Abort);
+    result.error = e.what();
+  }
+  return result;
+}
+
+void MainWindow::auxDataLoaded() {
+  // The repositories built by the worker threads are only assigned here, on
+  // the GUI thread which uses them
+  bool model_set_outdated = false;
+  for (auto load : {std::make_pair(&m_filter_watcher, &m_filter_repository),
+                    std::make_pair(&m_seds_watcher, &m_seds_repository),
+                    std::make_pair(&m_redenig_curves_watcher, &m_redenig_curves_repository),
+                    std::make_pair(&m_luminosity_watcher, &m_luminosity_repository)}) {
+    if (!load.first->isFinished()) {
+      continue;
     }
+    auto result = load.first->result();
+    if (!result.error.empty()) {
+      handleAuxDataError(result.error);
+    }
+    if (result.repository != *load.second) {
+      *load.second = result.repository;
+      model_set_outdated |= load.second == &m_seds_repository || load.second == &m_redenig_curves_repository;
+    }
+  }
+  bool filters_ready    = m_filter_watcher.isFinished();
+  bool seds_ready       = m_seds_watcher.isFinished();
+  bool red_curves_ready = m_redenig_curves_watcher.isFinished();
+  bool luminosity_ready = m_luminosity_watcher.isFinished();
 
-    exit(0);
+  if (filters_ready) {
+    ui->btn_HomeToCatalog->setEnabled(true);
   }
 
-  ui->Lb_warning_time->setText("Loading the Pages...");
-  qApp->processEvents();
-  resetRepo();
+  // Rebuilt on every reload, as it holds the SEDs and reddening curves repositories
+  if (seds_ready && red_curves_ready && (model_set_outdated || m_model_set_model_ptr == nullptr)) {
+    m_model_set_model_ptr =
+        std::shared_ptr<ModelSetModel>{new ModelSetModel{m_seds_repository, m_redenig_curves_repository}};
+    ui->btn_HomeToModel->setEnabled(true);
+  }
 
-  m_option_model_ptr->loadOption(m_filter_repository, m_seds_repository, m_redenig_curves_repository,
-                                 m_luminosity_repository);
-  ui->widget_configuration->loadOptionPage(m_option_model_ptr);
+  if (filters_ready && seds_ready && red_curves_ready && luminosity_ready) {
+    ui->btn_HomeToAnalysis->setEnabled(true);
+    ui->btn_HomeToOption->setEnabled(true);
+    main_logger.info() << "Loading data done";
+    StartupProfile::getInstance().milestone("Home screen ready");
+    StartupProfile::getInstance().save();
+
+    ui->Lb_warning_time->setStyleSheet("font-weight: normal; color: #888888");
+    ui->Lb_warning_time->setText(
+        "TIP: To save disk space, purge grid data you do not use anymore (see 'Catalog Setup')");
+    return;
+  }
 
-  ui->btn_HomeToAnalysis->setEnabled(true);
-  ui->btn_HomeToCatalog->setEnabled(true);
-  ui->btn_HomeToModel->setEnabled(true);
-  ui->btn_HomeToOption->setEnabled(true);
-  ui->btn_HomeToPP->setEnabled(true);
+  QStringList loading{};
+  if (!filters_ready) {
+    loading << "Filters";
+  }
+  if (!seds_ready) {
+    loading << "SEDs";
+  }
+  if (!red_curves_ready) {
+    loading << "Reddening Curves";
+  }
+  if (!luminosity_ready) {
+    loading << "Luminosity Functions";
+  }
+  ui->Lb_warning_time->setText("Loading the " + loading.join(", ") + "...");
+}
+
+void MainWindow::handleAuxDataError(std::string msg) {
+  if (msg.rfind("Qualified name can not be inserted in the map.", 0) == 0) {
+
+    std::string msg_part = msg.replace(0, 61, "");
+    std::string name     = msg_part.substr(0, msg_part.find(":") - 5);
+    std::string path     = msg_part.substr(msg_part.find(":") + 1);
+    path                 = path.substr(0, path.find_last_of("/"));
+
+    QString text = QString::fromStdString(
+        std::string("Conflict in the auxiliary data: 2 files contain a dataset with the same name.\n\n"
+                    "Dataset name : \n") +
+        name + "\n\nPath containing the files : \n" + path + "\n\n" +
+        "Please remove one of the files and re-launch Phosphoros.");
+    QMessageBox::critical(this, "Error while loading the Auxiliary Data...", text, QMessageBox::Abort);
+  } else {
+    QString text = QString::fromStdString(std::string("An error occured  while loading the Auxiliary Data.\n "
+                                                      "Error : ") +
+                                          msg);
+    QMessageBox::critical(this, "Error while loading the Auxiliary Data...", text, QMessageBox::Abort);
+  }
+
+  exit(0);
+}
+
+void MainWindow::loadSurveys(bool wait) {
+  if (!m_surveys_loaded) {
+    m_survey_model_ptr->loadSurveyAsync();
+    m_surveys_start  = std::chrono::steady_clock::now();
+    m_surveys_loaded = true;
+  }
+  if (wait && m_survey_model_ptr->isLoading()) {
+    StartupProfile::Phase profile_phase("Wait for the surveys");
+    m_survey_model_ptr->waitForLoaded();
+  }
+}
+
+void MainWindow::surveysLoaded() {
+  StartupProfile::getInstance().record("Surveys", m_surveys_start);
+}
+
+void MainWindow::loadModelSets() {
+  if (!m_model_sets_loaded) {
+    StartupProfile::Phase profile_phase("Model sets");
+    m_model_set_model_ptr->loadSets();
+    m_model_sets_loaded = true;
+  }
+}
+
+void MainWindow::loadCatalogPage() {
+  if (!m_catalog_page_loaded) {
+    // The catalog list is filled as the surveys are read
+    loadSurveys(false);
+    {
+      StartupProfile::Phase profile_phase("Catalog page");
+      ui->widget_Catalog->loadMappingPage(m_survey_model_ptr, m_filter_repository, "");
+    }
+    m_catalog_page_loaded = true;
+    StartupProfile::getInstance().save();
+  }
+}
+
+void MainWindow::loadModelPage() {
+  if (!m_model_page_loaded) {
+    loadModelSets();
+    {
+      StartupProfile::Phase profile_phase("Model page");
+      ui->widget_ModelSet->loadSetPage(m_model_set_model_ptr, m_seds_repository, m_redenig_curves_repository);
+    }
+    m_model_page_loaded = true;
+    StartupProfile::getInstance().save();
+  }
+}
 
-  ui->Lb_warning_time->setStyleSheet("font-weight: normal; color: #888888");
-  ui->Lb_warning_time->setText("TIP: To save disk space, purge grid data you do not use anymore (see 'Catalog Setup')");
+void MainWindow::loadAnalysisPage() {
+  if (!m_analysis_page_loaded) {
+    loadSurveys(true);
+    loadModelSets();
+    {
+      StartupProfile::Phase profile_phase("Analysis page");
+      ui->widget_Analysis->loadAnalysisPage(m_survey_model_ptr, m_model_set_model_ptr, m_seds_repository,
+                                            m_redenig_curves_repository, m_filter_repository,
+                                            m_luminosity_repository);
+    }
+    m_analysis_page_loaded = true;
+    StartupProfile::getInstance().save();
+  }
+}
 
+void MainWindow::loadPostProcessingPage() {
+  if (!m_post_processing_page_loaded) {
+    loadSurveys(true);
+    {
+      StartupProfile::Phase profile_phase("Post Processing page");
+      ui->widget_postprocessing->loadPostProcessingPage(m_survey_model_ptr);
+    }
+    m_post_processing_page_loaded = true;
+    StartupProfile::getInstance().save();
+  }
+}
 
+void MainWindow::loadOptionPage() {
+  if (!m_option_page_loaded) {
+    {
+      StartupProfile::Phase profile_phase("Option page");
+      m_option_model_ptr->loadOption(m_filter_repository, m_seds_repository, m_redenig_curves_repository,
+                                     m_luminosity_repository);
+      ui->widget_configuration->loadOptionPage(m_option_model_ptr);
+    }
+    m_option_page_loaded = true;
+    StartupProfile::getInstance().save();
+  }
 }
 
 void MainWindow::resetRepo() {
-  auto start = std::chrono::high_resolution_clock::now();
-  main_logger.info()<<"Start reset repo";
-  m_survey_model_ptr->loadSurvey();
-
-  auto stop = std::chrono::high_resolution_clock::now();
-  auto duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
-  main_logger.info()<<"Survey loaded "<< duration << "[ms]";
-  start = stop;
-
-  ui->widget_Catalog->loadMappingPage(m_survey_model_ptr, m_filter_repository, "");
-  stop = std::chrono::high_resolution_clock::now();
-  duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
-  main_logger.info()<<"Catalog Page loaded "<< duration << "[ms]";
-  start = stop;
-
-  m_model_set_model_ptr->loadSets();
-  ui->widget_ModelSet->loadSetPage(m_model_set_model_ptr, m_seds_repository, m_redenig_curves_repository);
-  stop = std::chrono::high_resolution_clock::now();
-  duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
-  main_logger.info()<<"Model Page loaded "<< duration << "[ms]";
-  start = stop;
-
-  ui->widget_Analysis->loadAnalysisPage(m_survey_model_ptr, m_model_set_model_ptr, m_seds_repository, m_redenig_curves_repository,
-		                                m_filter_repository,  m_luminosity_repository);
-  stop = std::chrono::high_resolution_clock::now();
-  duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
-  main_logger.info()<<"Analyse Page loaded "<< duration << "[ms]";
-  start = stop;
-
-  ui->widget_postprocessing->loadPostProcessingPage(m_survey_model_ptr);
-  stop = std::chrono::high_resolution_clock::now();
-  duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
-  main_logger.debug()<<"Post Processing Page loaded "<< duration << "[ms]";
-  start = stop;
+  // The pages are reloaded the next time they are displayed
+  main_logger.info() << "Reset repo";
+  m_surveys_loaded              = false;
+  m_model_sets_loaded           = false;
+  m_catalog_page_loaded         = false;
+  m_model_page_loaded           = false;
+  m_analysis_page_loaded        = false;
+  m_post_processing_page_loaded = false;
+  m_option_page_loaded          = false;
 }
 
 //- Home Page
@@ -306,14 +430,21 @@ void MainWindow::navigateToConfig() {
 }
 
 void MainWindow::navigateToNewCatalog(std::string new_name) {
+  loadSurveys(true);
   changeMainStackedWidgetIndex(2);
   ui->widget_Catalog->loadMappingPage(m_survey_model_ptr, m_filter_repository, new_name);
+  m_catalog_page_loaded = true;
 }
 
 //--------------------------------------------------
 // Option Page
 //  - Slots opening the option tab
 void MainWindow::on_btn_HomeToOption_clicked() {
+  if (!ui->btn_HomeToOption->isEnabled()) {
+    // The auxiliary data needed by the page are still loading
+    return;
+  }
+  loadOptionPage();
   changeMainStackedWidgetIndex(4);
 }
 
@@ -321,11 +452,21 @@ void MainWindow::on_btn_HomeToOption_clicked() {
 // Model Set Page
 //  - Slots landing on this page
 void MainWindow::on_btn_HomeToModel_clicked() {
+  if (!ui->btn_HomeToModel->isEnabled()) {
+    // The auxiliary data needed by the page are still loading
+    return;
+  }
+  loadModelPage();
   changeMainStackedWidgetIndex(1);
   ui->widget_ModelSet->updateSelection();
 }
 
 void MainWindow::on_btn_HomeToCatalog_clicked() {
+  if (!ui->btn_HomeToCatalog->isEnabled()) {
+    // The auxiliary data needed by the page are still loading
+    return;
+  }
+  loadCatalogPage();
   changeMainStackedWidgetIndex(2);
   ui->widget_Catalog->updateSelection();
 }
@@ -334,11 +475,17 @@ void MainWindow::on_btn_HomeToCatalog_clicked() {
 // Analysis page  Page
 //  - Slots landing on this page
 void MainWindow::on_btn_HomeToAnalysis_clicked() {
+  if (!ui->btn_HomeToAnalysis->isEnabled()) {
+    // The auxiliary data needed by the page are still loading
+    return;
+  }
+  loadAnalysisPage();
   changeMainStackedWidgetIndex(3);
   ui->widget_Analysis->updateSelection();
 }
 
 void MainWindow::on_btn_HomeToPP_clicked() {
+  loadPostProcessingPage();
   changeMainStackedWidgetIndex(5);
   ui->widget_postprocessing->updateSelection(true);
 }
@@ -2,8 +2,9 @@
 #include <QDir>
 #include <QFile>
 #include <QTextStream>
-#include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 #include "Configuration/ConfigManager.h"
 #include "Configuration/Utils.h"
@@ -107,56 +108,60 @@ static std::vector<XYDataset::QualifiedName> getList(DatasetRepo repo, const Dat
 	return selected;
 }
 
-bool in_list(std::vector<double> list, double value, double tolerance){
-    bool result = false;
-    for (auto& v_l : list) {
-        result |= std::abs(v_l-value)<tolerance;
+/**
+ * @brief Merge the explicit values and the values spanned by the ranges into a
+ * sorted axis, values closer than the tolerance being considered as duplicates.
+ */
+static std::vector<double> expandAxis(const std::set<double>& values, const std::vector<Range>& ranges,
+                                      double tolerance) {
+  std::vector<double> axis(values.begin(), values.end());
+  for (const auto& range : ranges) {
+    size_t count = std::round((range.getMax() - range.getMin()) / range.getStep() + 1);
+    axis.reserve(axis.size() + count);
+    for (size_t index = 0; index < count; index++) {
+      axis.push_back(range.getMin() + index * range.getStep());
     }
-    return result;
+  }
+  std::sort(axis.begin(), axis.end());
+
+  // Sorted input: a single pass comparing each value to the last one kept is enough
+  auto last = std::unique(axis.begin(), axis.end(), [tolerance](double kept, double value) {
+    return std::abs(value - kept) < tolerance;
+  });
+  axis.erase(last, axis.end());
+  return axis;
+}
+
+void ModelSet::invalidateAxesTuple() {
+  m_axes_tuple_dirty = true;
 }
 
 const std::map<std::string, PhzDataModel::ModelAxesTuple>& ModelSet::getAxesTuple() {
-	std::map<std::string, PhzDataModel::ModelAxesTuple> result{};
-	for (auto& param_rule : getParameterRules()) {
-		const auto& name = param_rule.second.getName();
+  // The SED and reddening curve lists are read from the repositories, which
+  // may have been reloaded since the axes were built
+  unsigned long sed_revision = m_sed_repo ? m_sed_repo->getRevision() : 0;
+  unsigned long red_revision = m_red_repo ? m_red_repo->getRevision() : 0;
+  if (!m_axes_tuple_dirty && sed_revision == m_axes_sed_revision && red_revision == m_axes_red_revision) {
+    return m_axes_tuple;
+  }
 
-		std::vector<double> z_list{};
-		for (double z : param_rule.second.getRedshiftValues()) {
-			z_list.push_back(z);
-		}
-		
-		for (const auto& range : param_rule.second.getZRanges()) {
-			for (size_t index=0; index<std::round((range.getMax()-range.getMin())/range.getStep()+1); index++){
-			    double val = range.getMin()+index*range.getStep();
-			    if (!in_list(z_list,val, 0.000001)) {
-				    z_list.push_back(val);
-				}
-			}
-			
-		}
-		std::sort(z_list.begin(), z_list.end());
+  std::map<std::string, PhzDataModel::ModelAxesTuple> result{};
+  for (auto& param_rule : m_parameter_rules) {
+    const auto& name = param_rule.second.getName();
 
-		std::vector<double> ebv_list{};
-		for (double ebv : param_rule.second.getEbvValues()) {
-			ebv_list.push_back(ebv);
-		}
-		for (const auto& range : param_rule.second.getEbvRanges()) {
-			for (size_t index=0; index<std::round((range.getMax()-range.getMin())/range.getStep() +1); index++){
-			    double val = range.getMin()+index*range.getStep();
-			    if (!in_list(ebv_list,val, 0.000001)) {
-				    ebv_list.push_back(range.getMin()+index*range.getStep());
-			    }
-			}
-		}
-		std::sort(ebv_list.begin(), ebv_list.end());
+    auto z_list   = expandAxis(param_rule.second.getRedshiftValues(), param_rule.second.getZRanges(), 0.000001);
+    auto ebv_list = expandAxis(param_rule.second.getEbvValues(), param_rule.second.getEbvRanges(), 0.000001);
 
-		auto sed_list = getList(m_sed_repo, param_rule.second.getSedSelection());
-		auto red_list = getList(m_red_repo, param_rule.second.getRedCurveSelection());
+    auto sed_list = getList(m_sed_repo, param_rule.second.getSedSelection());
+    auto red_list = getList(m_red_repo, param_rule.second.getRedCurveSelection());
 
-		auto axe_tuple = PhzDataModel::createAxesTuple(z_list, ebv_list, red_list, sed_list);
-		result.emplace(name,axe_tuple);
-	}
-	m_axes_tuple = result;
+    auto axe_tuple = PhzDataModel::createAxesTuple(z_list, ebv_list, red_list, sed_list);
+    result.emplace(name, axe_tuple);
+  }
+  m_axes_tuple        = std::move(result);
+  m_axes_tuple_dirty  = false;
+  m_axes_sed_revision = sed_revision;
+  m_axes_red_revision = red_revision;
   return m_axes_tuple;
 }
 
@@ -367,6 +372,7 @@ ModelSet ModelSet::deserialize(QDomDocument& doc, ModelSet& model) {
 
     model.m_parameter_rules[i] = rule;
   }
+  model.invalidateAxesTuple();
 
   return model;
 }
@@ -572,6 +578,7 @@ std::map<int, ParameterRule> ModelSet::getParameterRules() const {
 
 void ModelSet::setParameterRules(std::map<int, ParameterRule> parameter_rules) {
   m_parameter_rules = std::move(parameter_rules);
+  invalidateAxesTuple();
 }
 
 template <typename ReturnType, int I>
@@ -4,7 +4,6 @@
 #include "PhzQtUI/DatasetRepository.h"
 #include "PhzUtils/Multithreading.h"
 #include "PreferencesUtils.h"
-#include "XYDataset/AsciiParser.h"
 #include "XYDataset/FileSystemProvider.h"
 #include <QString>
 #include <map>
@@ -206,19 +205,19 @@ void OptionModel::save() {
     PreferencesUtils::setBufferSize(m_buffer_size_saved);
     PreferencesUtils::setLogLevel(m_loglevel_saved.toStdString());
 
-    std::unique_ptr<XYDataset::FileParser>         filter_file_parser{new XYDataset::AsciiParser{}};
+    std::unique_ptr<XYDataset::FileParser>         filter_file_parser{FileUtils::createDatasetParser()};
     std::unique_ptr<XYDataset::FileSystemProvider> filter_provider(
         new XYDataset::FileSystemProvider{FileUtils::getFilterRootPath(true), std::move(filter_file_parser)});
     m_filter_repository->resetProvider(std::move(filter_provider));
-    std::unique_ptr<XYDataset::FileParser>         sed_file_parser{new XYDataset::AsciiParser{}};
+    std::unique_ptr<XYDataset::FileParser>         sed_file_parser{FileUtils::createDatasetParser()};
     std::unique_ptr<XYDataset::FileSystemProvider> sed_provider(
         new XYDataset::FileSystemProvider{FileUtils::getSedRootPath(true), std::move(sed_file_parser)});
     m_seds_repository->resetProvider(std::move(sed_provider));
-    std::unique_ptr<XYDataset::FileParser>         reddening_file_parser{new XYDataset::AsciiParser{}};
+    std::unique_ptr<XYDataset::FileParser>         reddening_file_parser{FileUtils::createDatasetParser()};
     std::unique_ptr<XYDataset::FileSystemProvider> red_curve_provider(
         new XYDataset::FileSystemProvider{FileUtils::getRedCurveRootPath(true), std::move(reddening_file_parser)});
     m_redenig_curves_repository->resetProvider(std::move(red_curve_provider));
-    std::unique_ptr<XYDataset::FileParser>         luminosity_file_parser{new XYDataset::AsciiParser{}};
+    std::unique_ptr<XYDataset::FileParser>         luminosity_file_parser{FileUtils::createDatasetParser()};
     std::unique_ptr<XYDataset::FileSystemProvider> luminosity_curve_provider(new XYDataset::FileSystemProvider{
         FileUtils::getLuminosityFunctionCurveRootPath(true), std::move(luminosity_file_parser)});
     m_luminosity_repository->resetProvider(std::move(luminosity_curve_provider));
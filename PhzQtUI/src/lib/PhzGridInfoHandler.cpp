@@ -10,7 +10,6 @@
 #include <QDir>
 #include <QFileInfo>
 #include <boost/archive/binary_iarchive.hpp>
-#include <boost/archive/text_iarchive.hpp>
 #include <boost/program_options.hpp>
 #include <cmath>
 #include <ctgmath>
@@ -23,6 +22,7 @@
 #include "FileUtils.h"
 #include "PhzDataModel/PhotometryGridInfo.h"
 #include "PhzDataModel/serialization/PhotometryGridInfo.h"
+#include "PhzQtUI/GridInfoCache.h"
 #include "PhzQtUI/PhzGridInfoHandler.h"
 #include "PreferencesUtils.h"
 #include "XYDataset/QualifiedName.h"
@@ -43,14 +43,11 @@ bool PhzGridInfoHandler::checkGridFileCompatibility(QString file_path,
   logger.debug()<<"Checking compatibility for grid in file "<< file_path.toStdString();
   auto start = std::chrono::high_resolution_clock::now();
   try {  // If a file cannot be opened or is ill formated: just skip it!
-    // We directly use the boost archive, because we just need the grid info
-    // from the beginning of the file. Reading the full file whould be very
-    // slow
-
-    PhzDataModel::PhotometryGridInfo grid_info;
-    std::ifstream                    in{file_path.toStdString()};
-    boost::archive::text_iarchive    bia{in};
-    bia >> grid_info;
+    // We just need the grid info from the beginning of the file. Reading the
+    // full file whould be very slow. The info is kept by the grid info cache,
+    // so the file is only read again when it changes.
+    auto  grid_info_ptr = GridInfoCache::getInstance().getGridInfo(file_path.toStdString());
+    auto& grid_info     = *grid_info_ptr;
     auto stop = std::chrono::high_resolution_clock::now();
     auto duration=(std::chrono::duration_cast<std::chrono::microseconds>(stop - start)).count()/1000;
   	logger.info()<<"Grid info loaded "<< duration << "[ms]";
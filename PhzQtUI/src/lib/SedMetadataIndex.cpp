@@ -0,0 +1,309 @@
+#include "PhzQtUI/SedMetadataIndex.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "FileUtils.h"
+#include "PhzQtUI/SedParamUtils.h"
+#include <QDateTime>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <boost/algorithm/string.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SedMetadataIndex");
+
+// Cache file layout (tab separated):
+//   D <group path>
+//   F <file name> <mtime> <dataset name> <param>=<unit> ...
+static const std::string CACHE_HEADER = "# Phosphoros SED metadata index v1";
+
+SedMetadataIndex::SedMetadataIndex(std::string sed_root_path, std::string cache_file)
+    : m_sed_root_path{std::move(sed_root_path)}, m_cache_file{std::move(cache_file)} {
+  load();
+}
+
+std::shared_ptr<SedMetadataIndex> SedMetadataIndex::getInstance() {
+  static std::mutex                        instance_mutex;
+  static std::shared_ptr<SedMetadataIndex> instance{};
+
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  std::string                 sed_root_path = FileUtils::getSedRootPath(false) + "/";
+  if (instance == nullptr || instance->m_sed_root_path != sed_root_path) {
+    std::string cache_file = FileUtils::getGUIConfigPath() + "/SedMetadataIndex.txt";
+    instance               = std::make_shared<SedMetadataIndex>(sed_root_path, cache_file);
+  }
+  return instance;
+}
+
+void SedMetadataIndex::load() {
+  if (m_cache_file.empty()) {
+    return;
+  }
+  std::ifstream in(m_cache_file);
+  std::string   line;
+  if (!std::getline(in, line) || line != CACHE_HEADER) {
+    return;
+  }
+  // The cache is shared by all the aux dirs: only keep the groups of this one
+  GroupIndex* current = nullptr;
+  while (std::getline(in, line)) {
+    std::vector<std::string> tokens;
+    boost::split(tokens, line, boost::is_any_of("\t"));
+    if (tokens.size() == 2 && tokens[0] == "D") {
+      current = FileUtils::starts_with(tokens[1], m_sed_root_path) ? &m_groups[tokens[1]] : nullptr;
+    } else if (current != nullptr && tokens.size() >= 4 && tokens[0] == "F") {
+      Entry entry;
+      entry.file_name = tokens[1];
+      try {
+        entry.mtime = std::stoll(tokens[2]);
+      } catch (const std::exception&) {
+        // Drop the damaged line: the file is parsed again on demand and the
+        // cache file is rewritten on the next save
+        logger.warn() << "Ignoring a malformed line of " << m_cache_file << " : " << line;
+        m_modified = true;
+        continue;
+      }
+      entry.name = tokens[3];
+      entry.parsed    = true;
+      for (size_t index = 4; index < tokens.size(); ++index) {
+        auto pos = tokens[index].find('=');
+        if (pos != std::string::npos) {
+          entry.parameters.emplace(tokens[index].substr(0, pos), tokens[index].substr(pos + 1));
+        }
+      }
+      current->entries.push_back(std::move(entry));
+    }
+  }
+  logger.debug() << "Loaded " << m_groups.size() << " SED group(s) from " << m_cache_file;
+}
+
+void SedMetadataIndex::save() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_cache_file.empty() || !m_modified) {
+    return;
+  }
+
+  // Keep the groups of the other aux dirs
+  std::stringstream others;
+  {
+    std::ifstream in(m_cache_file);
+    std::string   line;
+    bool          keep = false;
+    if (std::getline(in, line) && line == CACHE_HEADER) {
+      while (std::getline(in, line)) {
+        if (FileUtils::starts_with(line, "D\t")) {
+          keep = !FileUtils::starts_with(line.substr(2), m_sed_root_path);
+        }
+        if (keep) {
+          others << line << '\n';
+        }
+      }
+    }
+  }
+
+  std::string   tmp_file = m_cache_file + ".tmp";
+  std::ofstream out(tmp_file);
+  out << CACHE_HEADER << '\n' << others.str();
+  for (const auto& group : m_groups) {
+    out << "D\t" << group.first << '\n';
+    for (const auto& entry : group.second.entries) {
+      if (!entry.parsed) {
+        continue;
+      }
+      out << "F\t" << entry.file_name << '\t' << entry.mtime << '\t' << entry.name;
+      for (const auto& param : entry.parameters) {
+        out << '\t' << param.first << '=' << param.second;
+      }
+      out << '\n';
+    }
+  }
+  out.close();
+  if (out) {
+    QFile::remove(QString::fromStdString(m_cache_file));
+    QFile::rename(QString::fromStdString(tmp_file), QString::fromStdString(m_cache_file));
+    m_modified = false;
+  }
+}
+
+void SedMetadataIndex::refresh() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& group : m_groups) {
+    group.second.validated = false;
+  }
+}
+
+SedMetadataIndex::GroupIndex& SedMetadataIndex::getGroup(const std::string& group_path) {
+  auto& group = m_groups[group_path];
+  // Adding, removing or renaming a file changes the modification time of the
+  // directory, in which case the group is listed again
+  long long dir_mtime = QFileInfo(QString::fromStdString(group_path)).lastModified().toMSecsSinceEpoch();
+  if (group.validated && group.dir_mtime == dir_mtime) {
+    return group;
+  }
+
+  // Only list the directory here: the files which are new or have been
+  // modified since they were indexed are re-parsed on demand
+  std::map<std::string, Entry> previous{};
+  for (auto& entry : group.entries) {
+    previous.emplace(entry.file_name, std::move(entry));
+  }
+  group.entries.clear();
+
+  QDir directory(QString::fromStdString(group_path));
+  for (const QFileInfo& info : directory.entryInfoList(QStringList() << "*.*", QDir::Files, QDir::Name)) {
+    Entry entry;
+    entry.file_name = info.fileName().toStdString();
+    entry.mtime     = info.lastModified().toMSecsSinceEpoch();
+
+    auto existing = previous.find(entry.file_name);
+    if (existing != previous.end() && existing->second.mtime == entry.mtime) {
+      entry = std::move(existing->second);
+    }
+    m_modified = m_modified || !entry.parsed;
+    group.entries.push_back(std::move(entry));
+  }
+  group.names_indexed = false;
+  m_modified      = m_modified || group.entries.size() != previous.size();
+  group.validated = true;
+  group.dir_mtime = dir_mtime;
+  return group;
+}
+
+void SedMetadataIndex::parseEntries(const std::string& group_path, std::vector<Entry>& entries) {
+  // Called without holding the lock
+  for (auto& entry : entries) {
+    auto file_path = group_path + entry.file_name;
+    try {
+      auto header = SedParamUtils::parseHeader(file_path);
+      auto names  = header.keywords.find("NAME");
+      entry.name  = names != header.keywords.end() ? boost::algorithm::join(names->second, ";") : header.first_line_name;
+      entry.parameters = std::move(header.parameters);
+    } catch (const Elements::Exception& e) {
+      logger.warn() << "Unable to read the header of " << file_path << " : " << e.what();
+    }
+    entry.parsed = true;
+  }
+
+  std::lock_guard<std::mutex>   lock(m_mutex);
+  auto&                         group = m_groups[group_path];
+  std::map<std::string, Entry*> by_file_name{};
+  for (auto& entry : group.entries) {
+    by_file_name.emplace(entry.file_name, &entry);
+  }
+  for (auto& parsed : entries) {
+    auto entry = by_file_name.find(parsed.file_name);
+    // The file may have been modified in the meantime
+    if (entry != by_file_name.end() && entry->second->mtime == parsed.mtime) {
+      *entry->second = parsed;
+    }
+  }
+}
+
+bool SedMetadataIndex::findByName(GroupIndex& group, const std::string& name, Entry& found) {
+  if (!group.names_indexed) {
+    group.names.clear();
+    bool all_parsed = true;
+    for (size_t index = 0; index < group.entries.size(); ++index) {
+      const auto& entry = group.entries[index];
+      all_parsed        = all_parsed && entry.parsed;
+      if (entry.parsed && !entry.name.empty()) {
+        // The first file (in name order) giving a dataset name wins
+        group.names.emplace(entry.name, index);
+      }
+    }
+    if (!all_parsed) {
+      return false;
+    }
+    group.names_indexed = true;
+  }
+  auto entry = group.names.find(name);
+  found      = entry != group.names.end() ? group.entries[entry->second] : Entry{};
+  return true;
+}
+
+SedMetadataIndex::Entry SedMetadataIndex::findEntry(const XYDataset::QualifiedName& sed, std::string& group_path) {
+  group_path = m_sed_root_path;
+  for (const std::string& group : sed.groups()) {
+    group_path = group_path + group + "/";
+  }
+
+  Entry                       found{};
+  std::vector<Entry>          to_parse{};
+  std::shared_ptr<std::mutex> parse_mutex{};
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto&                       group = getGroup(group_path);
+    for (const auto& entry : group.entries) {
+      if (QFileInfo(QString::fromStdString(entry.file_name)).completeBaseName().toStdString() == sed.datasetName()) {
+        if (entry.parsed) {
+          return entry;
+        }
+        to_parse.push_back(entry);
+        break;
+      }
+    }
+    if (to_parse.empty() && findByName(group, sed.datasetName(), found)) {
+      return found;
+    }
+    parse_mutex = group.parse_mutex;
+  }
+
+  if (!to_parse.empty()) {
+    parseEntries(group_path, to_parse);
+    return to_parse[0];
+  }
+
+  // The name is given in the file: all the headers of the group are needed.
+  // They are parsed by a single thread, the concurrent requests waiting for
+  // the name map it builds
+  std::lock_guard<std::mutex> parse_lock(*parse_mutex);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto&                       group = getGroup(group_path);
+    if (findByName(group, sed.datasetName(), found)) {
+      return found;
+    }
+    for (const auto& entry : group.entries) {
+      if (!entry.parsed) {
+        to_parse.push_back(entry);
+      }
+    }
+  }
+  parseEntries(group_path, to_parse);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto&                       group = m_groups[group_path];
+  if (!findByName(group, sed.datasetName(), found)) {
+    // The group has been listed again during the parsing
+    found = Entry{};
+    for (const auto& entry : group.entries) {
+      if (entry.parsed && entry.name == sed.datasetName()) {
+        found = entry;
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+std::string SedMetadataIndex::getFile(const XYDataset::QualifiedName& sed) {
+  std::string group_path;
+  auto        entry = findEntry(sed, group_path);
+  return entry.file_name.empty() ? "" : group_path + entry.file_name;
+}
+
+std::map<std::string, std::string> SedMetadataIndex::getParameterList(const XYDataset::QualifiedName& sed) {
+  std::string group_path;
+  auto        entry = findEntry(sed, group_path);
+  if (entry.file_name.empty()) {
+    throw Elements::Exception() << "No file found for the SED : " << sed.qualifiedName();
+  }
+  return entry.parameters;
+}
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
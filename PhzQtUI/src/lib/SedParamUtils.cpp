@@ -7,18 +7,20 @@
 #include "ElementsKernel/Exception.h"
 #include "PhzConfiguration/BuildPPConfigConfig.h"
 #include "PhzExecutables/BuildPPConfig.h"
-#include <QDir>
-#include <QFileInfo>
 #include <QStandardItemModel>
-#include <QStringList>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
-#include <boost/regex.hpp>
+#include <exception>
 #include <fstream>
 #include <list>
 #include <vector>
 
 #include "ElementsKernel/Logging.h"
 #include "FileUtils.h"
+#include "PreferencesUtils.h"
+#include "PhzQtUI/SedMetadataIndex.h"
 #include "PhzQtUI/SedParamUtils.h"
 
 namespace Euclid {
@@ -29,123 +31,37 @@ static Elements::Logging logger = Elements::Logging::getLogger("SedParamUtils");
 
 SedParamUtils::SedParamUtils() {}
 
-std::map<std::string, std::string> SedParamUtils::getParameterList(const std::string& file) {
-  std::map<std::string, std::string> result{};
-
-  std::ifstream sfile(file);
-  if (!sfile) {
-    throw Elements::Exception() << "File does not exist : " << file;
-  }
-
-  std::string  value{};
-  std::string  line{};
-  std::string  dataset_name{};
-  std::string  reg_ex_str = "^\\s*#\\s*PARAMETER\\s*:\\s*([-_\\w]+)\\s*=.+\\s*$";
-  boost::regex expression(reg_ex_str);
-  std::string  reg_ex_str_unit = "^\\s*#\\s*PARAMETER\\s*:\\s*[-_\\w]+\\s*=.+\\[\\s*(\\w*)\\s*\\]\\s*$";
-  boost::regex unit_regex(reg_ex_str_unit);
-  std::string  regex_column = "^\\s*[\\d.-eE]*\\s*[\\d.\\-eE]*\\s*$";
-  boost::regex col_regex(regex_column);
-
-  while (sfile.good()) {
-    std::getline(sfile, line);
-    boost::smatch s_match;
-    boost::smatch s_unit_match;
-    boost::smatch s_col_match;
-    if (!line.empty() && boost::regex_match(line, s_match, expression)) {
-
-      std::string unit = "";
-      if (boost::regex_match(line, s_unit_match, unit_regex)) {
-        unit = s_unit_match[1].str();
-      }
-      result.insert(std::make_pair(s_match[1].str(), unit));
-      // logger.info() << " INSERTING PARAM " << s_match[1].str() << " With units " << unit;
-    } else if (boost::regex_match(line, s_col_match, col_regex)) {
-      break;
-    }
-  }
+SedHeader SedParamUtils::parseHeader(const std::string& file) {
+  return PhzUITools::parseSedHeader(file);
+}
 
-  return result;
+std::map<std::string, std::string> SedParamUtils::getParameterList(const std::string& file) {
+  return parseHeader(file).parameters;
 }
 
 std::string SedParamUtils::getParameter(const std::string& file, const std::string& key_word) {
-  std::ifstream sfile(file);
-  if (!sfile) {
-    throw Elements::Exception() << "File does not exist : " << file;
-  }
-
-  std::string  value{};
-  std::string  line{};
-  std::string  dataset_name{};
-  std::string  reg_ex_str = "^\\s*#\\s*" + key_word + "\\s*:\\s*(.+)\\s*$";
-  boost::regex expression(reg_ex_str);
-
-  while (sfile.good()) {
-    std::getline(sfile, line);
-    boost::smatch s_match;
-    if (!line.empty() && boost::regex_match(line, s_match, expression)) {
-      if (value != "") {
-        value += ";";
-      }
-      std::string new_val = s_match[1].str();
-      boost::trim(new_val);
-      value += new_val;
-    }
+  auto header = parseHeader(file);
+  auto values = header.keywords.find(key_word);
+  if (values == header.keywords.end()) {
+    return "";
   }
-  return value;
+  return boost::algorithm::join(values->second, ";");
 }
 
 std::string SedParamUtils::getName(const std::string& file) {
   // The data set name can be a parameter with keyword NAME
-  std::string dataset_name = getParameter(file, "NAME");
-
-  if (dataset_name == "") {
-    // IF not present chack the first non-empty line (Backward comatibility)
-    std::ifstream sfile(file);
-    std::string   line{};
-    // Check dataset name is in the file
-    // Convention: read until found first non empty line, removing empty lines.
-    while (line.empty() && sfile.good()) {
-      std::getline(sfile, line);
-    }
-
-    boost::regex  expression("^\\s*#\\s*(\\w+)\\s*$");
-    boost::smatch s_match;
-    if (boost::regex_match(line, s_match, expression)) {
-      dataset_name = s_match[1].str();
-    } else {
-      dataset_name = "";
-    }
+  auto header = parseHeader(file);
+  auto names  = header.keywords.find("NAME");
+  if (names != header.keywords.end()) {
+    return boost::algorithm::join(names->second, ";");
   }
 
-  return dataset_name;
+  // IF not present check the first non-empty line (Backward compatibility)
+  return header.first_line_name;
 }
 
 std::string SedParamUtils::getFile(const XYDataset::QualifiedName& sed) {
-  std::string root_path = FileUtils::getSedRootPath(false) + "/";
-
-  for (std::string group : sed.groups()) {
-    root_path = root_path + group + "/";
-  }
-
-  QDir        directory(QString::fromStdString(root_path));
-  QStringList seds_in_group = directory.entryList(QStringList() << "*.*", QDir::Files);
-
-  for (QString filename : seds_in_group) {
-    if (QFileInfo(filename).completeBaseName().toStdString() == sed.datasetName()) {
-      return root_path + filename.toStdString();
-    }
-  }
-
-  // name in the file
-  for (QString filename : seds_in_group) {
-    std::string name = getName(root_path + filename.toStdString());
-    if (name == sed.datasetName()) {
-      return root_path + filename.toStdString();
-    }
-  }
-
-  return "";
+  return SedMetadataIndex::getInstance()->getFile(sed);
 }
 
 std::set<std::string> SedParamUtils::getList() {
@@ -156,13 +72,38 @@ void SedParamUtils::listAvailableParam(ModelSet& model, DatasetRepo sed_repo, Da
   std::map<std::string, std::string> params{};
   bool                               firstSED = true;
 
+  auto index = SedMetadataIndex::getInstance();
+  index->refresh();
+
   auto sed_list = model.getSeds();
   m_total       = sed_list.size();
   m_progress    = 0;
-  for (auto& sed : sed_list) {
-    auto file_name = SedParamUtils::getFile(sed);
-    auto sed_param = SedParamUtils::getParameterList(file_name);
-    logger.info() << "SED NAME : " << sed << " FILE NAME : " << file_name;
+
+  // The headers are read on a thread pool, the results being consumed in order
+  // on the calling thread which keeps emitting the progress signal
+  QThreadPool pool{};
+  if (PreferencesUtils::getThreadNumberOverride() > 0) {
+    pool.setMaxThreadCount(PreferencesUtils::getThreadNumberOverride());
+  }
+  typedef std::pair<std::map<std::string, std::string>, std::exception_ptr> SedParamResult;
+  QFuture<SedParamResult> future =
+      QtConcurrent::mapped(&pool, sed_list.begin(), sed_list.end(), [index](const std::string& sed) {
+        try {
+          return SedParamResult{index->getParameterList(sed), nullptr};
+        } catch (...) {
+          return SedParamResult{{}, std::current_exception()};
+        }
+      });
+
+  for (size_t sed_index = 0; sed_index < sed_list.size(); ++sed_index) {
+    auto result = future.resultAt(sed_index);
+    if (result.second) {
+      future.cancel();
+      future.waitForFinished();
+      std::rethrow_exception(result.second);
+    }
+    auto& sed_param = result.first;
+    logger.debug() << "SED NAME : " << sed_list[sed_index] << " PARAMETERS : " << sed_param.size();
 
     if (firstSED) {
       params   = sed_param;
@@ -196,6 +137,7 @@ void SedParamUtils::listAvailableParam(ModelSet& model, DatasetRepo sed_repo, Da
   }
 
   m_list = ret;
+  index->save();
   progress(m_progress, m_total);
 }
 
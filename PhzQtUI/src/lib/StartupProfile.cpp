@@ -0,0 +1,81 @@
+#include "StartupProfile.h"
+#include "ElementsKernel/Logging.h"
+#include "FileUtils.h"
+#include "PhzUITools/JsonString.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QThread>
+#include <fstream>
+#include <iomanip>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+static Elements::Logging logger = Elements::Logging::getLogger("StartupProfile");
+
+static double toMs(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.;
+}
+
+StartupProfile::Phase::Phase(std::string name) : m_name{std::move(name)} {
+  // Makes sure the time origin is not after the start of the first phase
+  StartupProfile::getInstance();
+  m_start = std::chrono::steady_clock::now();
+}
+
+StartupProfile::Phase::~Phase() {
+  StartupProfile::getInstance().record(m_name, m_start);
+}
+
+StartupProfile::StartupProfile() : m_origin{std::chrono::steady_clock::now()} {}
+
+StartupProfile& StartupProfile::getInstance() {
+  static StartupProfile instance;
+  return instance;
+}
+
+void StartupProfile::record(const std::string& name, std::chrono::steady_clock::time_point start) {
+  auto   now         = std::chrono::steady_clock::now();
+  bool   main_thread = QCoreApplication::instance() != nullptr &&
+                     QThread::currentThread() == QCoreApplication::instance()->thread();
+  Record record{name, toMs(start - m_origin), toMs(now - start), main_thread};
+  logger.info() << name << " " << record.duration_ms << "[ms]";
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_records.push_back(std::move(record));
+}
+
+void StartupProfile::milestone(const std::string& name) {
+  record(name, std::chrono::steady_clock::now());
+}
+
+void StartupProfile::save() {
+  std::string   file     = FileUtils::getGUIConfigPath() + "/StartupProfile.json";
+  std::string   tmp_file = file + ".tmp";
+  std::ofstream out(tmp_file);
+  write(out);
+  out.close();
+  if (out) {
+    QFile::remove(QString::fromStdString(file));
+    QFile::rename(QString::fromStdString(tmp_file), QString::fromStdString(file));
+  }
+}
+
+void StartupProfile::write(std::ostream& out) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  out << "{\n  \"date\": "
+      << PhzUITools::toJsonString(QDateTime::currentDateTime().toString(Qt::ISODate).toStdString()) << ",\n";
+  out << "  \"phases\": [";
+  for (size_t index = 0; index < m_records.size(); ++index) {
+    const auto& record = m_records[index];
+    out << (index == 0 ? "\n" : ",\n") << "    {\"name\": " << PhzUITools::toJsonString(record.name)
+        << ", \"start_ms\": " << std::fixed << std::setprecision(1) << record.start_ms
+        << ", \"duration_ms\": " << record.duration_ms << ", \"thread\": \""
+        << (record.main_thread ? "main" : "worker") << "\"}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
@@ -0,0 +1,80 @@
+#ifndef STARTUPPROFILE_H
+#define STARTUPPROFILE_H
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzQtUI {
+
+/**
+ * @class StartupProfile
+ *
+ * @brief Records the duration of the phases of the GUI startup (loading of the
+ * auxiliary data, first display of each page...) and writes them into the
+ * StartupProfile.json file of the GUI configuration folder, so that a slow
+ * installation can be diagnosed.
+ *
+ * The time origin is the first call to getInstance(). The phases can be
+ * recorded from any thread.
+ */
+class StartupProfile {
+public:
+  /**
+   * @brief Record the duration of a phase from its construction to its
+   * destruction.
+   */
+  class Phase {
+  public:
+    explicit Phase(std::string name);
+    ~Phase();
+
+  private:
+    std::string                           m_name;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  static StartupProfile& getInstance();
+
+  /**
+   * @brief Record a phase which started at start and ends now.
+   */
+  void record(const std::string& name, std::chrono::steady_clock::time_point start);
+
+  /**
+   * @brief Record a milestone, i.e. a phase without duration.
+   */
+  void milestone(const std::string& name);
+
+  /**
+   * @brief Write the profile into the GUI configuration folder.
+   */
+  void save();
+
+  /**
+   * @brief Write the profile as a JSON document.
+   */
+  void write(std::ostream& out);
+
+private:
+  struct Record {
+    std::string name;
+    double      start_ms;
+    double      duration_ms;
+    bool        main_thread;
+  };
+
+  StartupProfile();
+
+  std::chrono::steady_clock::time_point m_origin;
+  std::vector<Record>                   m_records{};
+  std::mutex                            m_mutex{};
+};
+
+}  // namespace PhzQtUI
+}  // namespace Euclid
+
+#endif  // STARTUPPROFILE_H
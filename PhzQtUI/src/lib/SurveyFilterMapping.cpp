@@ -9,10 +9,13 @@ using boost::smatch;
 #include "FileUtils.h"
 #include <QDir>
 #include <QDirIterator>
+#include <QDateTime>
 #include <QDomDocument>
 #include <QFileInfo>
 #include <QTextStream>
+#include <QtConcurrent>
 #include <boost/algorithm/string.hpp>
+#include <mutex>
 
 #include "PhzDataModel/AdjustErrorParamMap.h"
 #include "PhzQtUI/SurveyFilterMapping.h"
@@ -151,42 +154,95 @@ std::vector<std::string> SurveyFilterMapping::getAvailableCatalogs() {
   return all_dirs;
 }
 
+namespace {
+
+// The last mapping read for each catalog, with the modification time of the
+// files it has been read from
+struct CachedMapping {
+  std::vector<qint64> mtimes;
+  SurveyFilterMapping mapping;
+};
+
+std::mutex                           mapping_cache_mutex;
+std::map<std::string, CachedMapping> mapping_cache{};
+
+qint64 getMTime(const QString& file) {
+  QFileInfo info(file);
+  return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+}  // namespace
+
 std::map<int, SurveyFilterMapping> SurveyFilterMapping::loadCatalogMappings() {
-  auto catalog_config_path = QString::fromStdString(FileUtils::getCatalogConfigRootPath(true));
+  auto future = loadCatalogMappingsAsync();
+  future.waitForFinished();
 
   std::map<int, SurveyFilterMapping> mappings{};
-  int                                id = 0;
+  for (int id = 0; id < future.resultCount(); ++id) {
+    mappings[id] = future.resultAt(id);
+  }
+
+  return mappings;
+}
 
-  // 1) list the folders under the Catalog folder
-  for (auto& catalog_name : getAvailableCatalogs()) {
-    // look for existing config
-    auto catalog_conf = catalog_config_path + QDir::separator() + QString::fromStdString(catalog_name) + ".xml";
+QFuture<SurveyFilterMapping> SurveyFilterMapping::loadCatalogMappingsAsync() {
+  // The paths are resolved here, the workers only access the catalog files
+  auto catalog_config_path = QString::fromStdString(FileUtils::getCatalogConfigRootPath(true)) + QDir::separator();
+  auto intermediary_path   = QString::fromStdString(FileUtils::getIntermediaryProductRootPath(true, "")) +
+                           QDir::separator();
+  auto root_path = FileUtils::getRootPath(true);
+
+  return QtConcurrent::mapped(getAvailableCatalogs(), [catalog_config_path, intermediary_path,
+                                                       root_path](const std::string& catalog_name) {
+    auto catalog_conf         = catalog_config_path + QString::fromStdString(catalog_name) + ".xml";
+    auto catalog_intermediary = intermediary_path + QString::fromStdString(catalog_name);
+    QDir().mkpath(catalog_intermediary);
+
+    std::vector<qint64> mtimes{getMTime(catalog_conf),
+                               getMTime(catalog_intermediary + QDir::separator() + "filter_mapping.txt"),
+                               getMTime(catalog_intermediary + QDir::separator() + "error_adjustment_param.txt")};
+    std::string         key = catalog_conf.toStdString() + "|" + root_path;
+    {
+      std::lock_guard<std::mutex> lock(mapping_cache_mutex);
+      auto                        cached = mapping_cache.find(key);
+      if (cached != mapping_cache.end() && cached->second.mtimes == mtimes) {
+        return cached->second.mapping;
+      }
+    }
 
-    QFileInfo info(catalog_conf);
-    if (info.exists()) {
-      mappings[id] = SurveyFilterMapping::loadCatalog(catalog_name + ".xml");
+    SurveyFilterMapping mapping{};
+    if (mtimes[0] >= 0) {
+      mapping = readCatalog(catalog_conf, catalog_name, root_path, catalog_intermediary);
     } else {
-      SurveyFilterMapping mapping{};
       mapping.setName(catalog_name);
-      mapping.ReadFilters();
-      mappings[id] = std::move(mapping);
+      mapping.ReadFilters(catalog_intermediary);
     }
-    ++id;
-  }
 
-  return mappings;
+    std::lock_guard<std::mutex> lock(mapping_cache_mutex);
+    mapping_cache[key] = CachedMapping{mtimes, mapping};
+    return mapping;
+  });
 }
 
 SurveyFilterMapping SurveyFilterMapping::loadCatalog(std::string name) {
   auto additional_info_path =
       QString::fromStdString(FileUtils::getGUIConfigPath()) + QDir::separator() + "Catalogs" + QDir::separator();
+  auto catalog_name = FileUtils::removeExt(name, ".xml");
 
+  return readCatalog(additional_info_path + QDir::separator() + QString::fromStdString(name), catalog_name,
+                     FileUtils::getRootPath(true),
+                     QString::fromStdString(FileUtils::getIntermediaryProductRootPath(true, catalog_name)));
+}
+
+SurveyFilterMapping SurveyFilterMapping::readCatalog(const QString& file_path, const std::string& catalog_name,
+                                                     const std::string& root_path,
+                                                     const QString&     intermediary_path) {
   SurveyFilterMapping survey;
-  survey.setName(FileUtils::removeExt(name, ".xml"));
+  survey.setName(catalog_name);
 
   // read the xml encoded additional info
   QDomDocument doc("CatalogInfo");
-  QFile        file(additional_info_path + QDir::separator() + QString::fromStdString(name));
+  QFile        file(file_path);
   if (!file.open(QIODevice::ReadOnly))
     return survey;
   if (!doc.setContent(&file)) {
@@ -210,8 +266,7 @@ SurveyFilterMapping SurveyFilterMapping::loadCatalog(std::string name) {
   std::string path = root_node.attribute("DefaultCatalogPath").toStdString();
 
   if (!FileUtils::starts_with(path, "/")) {
-    std::string root_path = FileUtils::getRootPath(true);
-    path                  = root_path + path;
+    path = root_path + path;
   }
 
   survey.setDefaultCatalogFile(path);
@@ -262,16 +317,19 @@ SurveyFilterMapping SurveyFilterMapping::loadCatalog(std::string name) {
     survey.m_column_list.insert(survey.getSourceIdColumn());
   }
 
-  survey.ReadFilters();
+  survey.ReadFilters(intermediary_path);
 
   return survey;
 }
 
 void SurveyFilterMapping::ReadFilters() {
+  ReadFilters(QString::fromStdString(FileUtils::getIntermediaryProductRootPath(true, getName())));
+}
+
+void SurveyFilterMapping::ReadFilters(const QString& intermediary_path) {
   std::vector<FilterMapping> mappings{};
 
-  auto mapping_path = QString::fromStdString(FileUtils::getIntermediaryProductRootPath(true, getName())) +
-                      QDir::separator() + "filter_mapping.txt";
+  auto mapping_path = intermediary_path + QDir::separator() + "filter_mapping.txt";
 
   try {
 
@@ -372,8 +430,7 @@ void SurveyFilterMapping::ReadFilters() {
   }
 
   // read the error re-computation parameters
-  auto error_param_path = QString::fromStdString(FileUtils::getIntermediaryProductRootPath(true, getName())) +
-                          QDir::separator() + "error_adjustment_param.txt";
+  auto error_param_path = intermediary_path + QDir::separator() + "error_adjustment_param.txt";
   try {
     std::ifstream in{error_param_path.toStdString()};
     auto          param_map = PhzDataModel::readAdjustErrorParamMap(in);
@@ -6,9 +6,13 @@ namespace Euclid {
 namespace PhzQtUI {
 static Elements::Logging logger = Elements::Logging::getLogger("SurveyModel");
 
-SurveyModel::SurveyModel() {}
+SurveyModel::SurveyModel() {
+  connect(&m_load_watcher, SIGNAL(resultReadyAt(int)), this, SLOT(surveyReadyAt(int)));
+  connect(&m_load_watcher, SIGNAL(finished()), this, SLOT(loadingFinished()));
+}
 
 void SurveyModel::newSurvey(bool duplicate_from_selected) {
+  waitForLoaded();
   // Get the new ref
   int max_ref = 0;
   for (auto it = m_survey_filter_mappings.begin(); it != m_survey_filter_mappings.end(); ++it) {
@@ -80,25 +84,100 @@ std::string SurveyModel::getDuplicateName(std::string name) const {
 
 /////////////////////////////////////////////////
 void SurveyModel::loadSurvey() {
-  m_survey_filter_mappings = SurveyFilterMapping::loadCatalogMappings();
-  this->setColumnCount(3);
+  loadSurveyAsync();
+  waitForLoaded();
+}
+
+void SurveyModel::loadSurveyAsync() {
+  m_survey_filter_mappings.clear();
+  m_selected_row   = -1;
+  m_selected_index = -1;
+  m_edited_survey  = SurveyFilterMapping();
+  m_in_edition     = false;
+  setHeaders();
+  this->setRowCount(0);
+
+  m_loading = true;
+  m_load_watcher.setFuture(SurveyFilterMapping::loadCatalogMappingsAsync());
+}
+
+bool SurveyModel::isLoading() const {
+  return m_loading;
+}
+
+void SurveyModel::waitForLoaded() {
+  if (m_loading) {
+    m_load_watcher.waitForFinished();
+    finishLoading();
+  }
+}
+
+void SurveyModel::surveyReadyAt(int index) {
+  if (!m_loading || m_survey_filter_mappings.count(index) > 0) {
+    return;
+  }
+  auto& survey = m_survey_filter_mappings[index] = m_load_watcher.resultAt(index);
+
+  QList<QStandardItem*> items;
+  items.push_back(new QStandardItem(QString::fromStdString(survey.getName())));
+  items.push_back(new QStandardItem(QString::number(survey.getFilterNumber())));
+  items.push_back(new QStandardItem(QString::number(index)));
+  this->appendRow(items);
+
+  // Select the saved catalog as soon as it is available
+  if (m_selected_row < 0 &&
+      survey.getName() == PreferencesUtils::getUserPreference("_global_selection_", "catalog")) {
+    selectSurvey(items[0]->row());
+  }
+
+  emit surveyLoaded(QString::fromStdString(survey.getName()));
+}
+
+void SurveyModel::loadingFinished() {
+  if (m_loading) {
+    finishLoading();
+  }
+}
+
+void SurveyModel::finishLoading() {
+  m_loading = false;
+
+  // The rows have been appended in the order the catalogs were read: rebuild
+  // them in the order of their ids
+  auto results = m_load_watcher.future().results();
+  for (int index = 0; index < results.size(); ++index) {
+    m_survey_filter_mappings[index] = results[index];
+  }
+  setHeaders();
   this->setRowCount(m_survey_filter_mappings.size());
-  QStringList setHeaders;
-  setHeaders << "Catalog Type"
-             << "Number of Filters"
-             << "Hidden_Id";
-  this->setHorizontalHeaderLabels(setHeaders);
 
   int i = 0;
   for (auto& it : m_survey_filter_mappings) {
     this->setItem(i, 0, new QStandardItem(QString::fromStdString(it.second.getName())));
     this->setItem(i, 1, new QStandardItem(QString::number(it.second.getFilterNumber())));
     this->setItem(i, 2, new QStandardItem(QString::number(it.first)));
+    if (it.first == m_selected_index) {
+      m_selected_row = i;
+    }
     ++i;
   }
-  auto saved_catalog = PreferencesUtils::getUserPreference("_global_selection_", "catalog");
-  logger.info() << "use the saved catalog " << saved_catalog << ".";
-  selectSurvey(QString::fromStdString(saved_catalog));
+
+  if (!m_in_edition) {
+    auto saved_catalog = PreferencesUtils::getUserPreference("_global_selection_", "catalog");
+    logger.info() << "use the saved catalog " << saved_catalog << ".";
+    selectSurvey(QString::fromStdString(saved_catalog));
+  }
+
+  emit surveysLoaded();
+}
+
+void SurveyModel::setHeaders() {
+  this->setColumnCount(3);
+  QStringList setHeaders;
+  setHeaders << "Catalog Type"
+             << "Number of Filters"
+             << "Hidden_Id";
+  this->setHorizontalHeaderLabels(setHeaders);
 }
 
 void SurveyModel::selectSurvey(int row) {
@@ -139,6 +218,7 @@ bool SurveyModel::isInEdition() {
 }
 
 bool SurveyModel::saveSelected() {
+  waitForLoaded();
   logger.info() << "Saving the selected catalog '" << m_edited_survey.getName() << "'.";
   bool pre_tests = checkUniqueName(QString::fromStdString(m_edited_survey.getName()), m_selected_row);
 
@@ -156,6 +236,7 @@ bool SurveyModel::saveSelected() {
 }
 
 void SurveyModel::deletSelected() {
+  waitForLoaded();
   if (m_selected_row >= 0) {
     logger.info() << "Deleting the selected catalog '" << m_edited_survey.getName() << "'.";
     m_survey_filter_mappings.at(m_selected_index).deleteSurvey();
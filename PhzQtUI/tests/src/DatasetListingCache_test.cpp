@@ -0,0 +1,135 @@
+/*
+ * DatasetListingCache_test.cpp
+ */
+#include "PhzQtUI/DatasetListingCache.h"
+#include "ElementsKernel/Temporary.h"  // for TempDir
+#include "XYDataset/AsciiParser.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <fstream>
+
+using namespace std;
+using namespace Euclid::PhzQtUI;
+using namespace Euclid::XYDataset;
+
+// Parser counting the files it has been asked to list
+class CountingParser : public FileParser {
+public:
+  explicit CountingParser(int& count) : m_count(count) {}
+
+  std::string getName(const std::string& file) override {
+    return m_parser.getName(file);
+  }
+
+  std::string getParameter(const std::string& file, const std::string& key_word) override {
+    return m_parser.getParameter(file, key_word);
+  }
+
+  std::unique_ptr<XYDataset> getDataset(const std::string& file) override {
+    return m_parser.getDataset(file);
+  }
+
+  bool isParsable(const std::string& file) override {
+    ++m_count;
+    return m_parser.isParsable(file);
+  }
+
+private:
+  int&        m_count;
+  AsciiParser m_parser{};
+};
+
+struct DatasetListingCache_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_root_path  = (m_top_dir.path() / "Filters").string();
+  std::string       m_cache_file = (m_top_dir.path() / "listing.txt").string();
+
+  DatasetListingCache_Fixture() {
+    boost::filesystem::create_directories(m_top_dir.path() / "Filters" / "Group");
+    writeFile("Group/by_file_name.txt", "");
+    writeFile("Group/file.txt", "ByKeyword");
+  }
+
+  void writeFile(const std::string& name, const std::string& dataset_name) {
+    ofstream out((m_top_dir.path() / "Filters" / name).string());
+    if (!dataset_name.empty()) {
+      out << "# " << dataset_name << "\n";
+    }
+    out << "1000 0.5\n";
+    out << "2000 1.0\n";
+  }
+
+  std::vector<std::string> listContents(DatasetListingCache& cache, int& count) {
+    auto                     parser = cache.createParser(std::unique_ptr<FileParser>{new CountingParser{count}});
+    FileSystemProvider       provider{m_root_path, std::move(parser)};
+    std::vector<std::string> names{};
+    for (auto& name : provider.listContents("")) {
+      names.push_back(name.qualifiedName());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+};
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(DatasetListingCache_test)
+
+BOOST_FIXTURE_TEST_CASE(listing_test, DatasetListingCache_Fixture) {
+  // GIVEN
+  int                 count = 0;
+  DatasetListingCache cache{m_cache_file};
+
+  // WHEN
+  auto names = listContents(cache, count);
+
+  // THEN
+  BOOST_CHECK_EQUAL(count, 2);
+  BOOST_CHECK_EQUAL(names.size(), 2);
+  BOOST_CHECK_EQUAL(names[0], "Group/ByKeyword");
+  BOOST_CHECK_EQUAL(names[1], "Group/by_file_name");
+}
+
+BOOST_FIXTURE_TEST_CASE(persistence_test, DatasetListingCache_Fixture) {
+  // GIVEN
+  int count = 0;
+  {
+    DatasetListingCache cache{m_cache_file};
+    listContents(cache, count);
+    cache.save();
+  }
+  BOOST_CHECK(boost::filesystem::exists(m_cache_file));
+
+  // WHEN
+  count = 0;
+  DatasetListingCache cache{m_cache_file};
+  auto                names = listContents(cache, count);
+
+  // THEN
+  BOOST_CHECK_EQUAL(count, 0);
+  BOOST_CHECK_EQUAL(names.size(), 2);
+  BOOST_CHECK_EQUAL(names[0], "Group/ByKeyword");
+}
+
+BOOST_FIXTURE_TEST_CASE(modified_file_test, DatasetListingCache_Fixture) {
+  // GIVEN
+  int count = 0;
+  {
+    DatasetListingCache cache{m_cache_file};
+    listContents(cache, count);
+    cache.save();
+  }
+
+  // WHEN
+  writeFile("Group/file.txt", "Renamed");
+  count = 0;
+  DatasetListingCache cache{m_cache_file};
+  auto                names = listContents(cache, count);
+
+  // THEN
+  BOOST_CHECK_EQUAL(count, 1);
+  BOOST_CHECK_EQUAL(names[0], "Group/Renamed");
+}
+
+// Ends the test suite
+BOOST_AUTO_TEST_SUITE_END()
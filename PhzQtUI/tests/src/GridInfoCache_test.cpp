@@ -0,0 +1,70 @@
+/*
+ * GridInfoCache_test.cpp
+ */
+#include "PhzQtUI/GridInfoCache.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"  // for TempDir
+#include "PhzDataModel/serialization/PhotometryGridInfo.h"
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <fstream>
+
+using namespace Euclid;
+using namespace Euclid::PhzQtUI;
+
+struct GridInfoCache_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_grid_file = (m_top_dir.path() / "grid.dat").string();
+
+  GridInfoCache_Fixture() {
+    writeGrid(m_grid_file, "MADAU");
+  }
+
+  // A grid file without region: only the header is written
+  void writeGrid(const std::string& file, const std::string& igm_method) {
+    PhzDataModel::PhotometryGridInfo info{};
+    info.igm_method = igm_method;
+    const auto&                   const_info = info;
+    std::ofstream                 out{file};
+    boost::archive::text_oarchive boa{out};
+    boa << const_info;
+  }
+};
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(GridInfoCache_test)
+
+BOOST_FIXTURE_TEST_CASE(grid_info_test, GridInfoCache_Fixture) {
+  // GIVEN
+  GridInfoCache cache{};
+
+  // WHEN
+  auto info       = cache.getGridInfo(m_grid_file);
+  auto info_again = cache.getGridInfo(m_grid_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(info->igm_method, "MADAU");
+  BOOST_CHECK_EQUAL(info.get(), info_again.get());
+}
+
+BOOST_FIXTURE_TEST_CASE(modified_file_test, GridInfoCache_Fixture) {
+  // GIVEN
+  GridInfoCache cache{};
+  auto          info = cache.getGridInfo(m_grid_file);
+
+  // WHEN
+  writeGrid(m_grid_file, "INOUE_LONGER");
+  auto new_info = cache.getGridInfo(m_grid_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(new_info->igm_method, "INOUE_LONGER");
+  BOOST_CHECK_EQUAL(info->igm_method, "MADAU");
+}
+
+BOOST_FIXTURE_TEST_CASE(missing_file_test, GridInfoCache_Fixture) {
+  GridInfoCache cache{};
+  BOOST_CHECK_THROW(cache.getGridInfo((m_top_dir.path() / "missing.dat").string()), Elements::Exception);
+}
+
+// Ends the test suite
+BOOST_AUTO_TEST_SUITE_END()
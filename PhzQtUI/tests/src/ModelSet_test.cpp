@@ -5,8 +5,13 @@
  *      Author: fdubath
  */
 #include "ElementsKernel/Real.h"  // isEqual
+#include "ElementsKernel/Temporary.h"  // for TempDir
 #include "PhzQtUI/ModelSet.h"
+#include "XYDataset/AsciiParser.h"
+#include "XYDataset/FileSystemProvider.h"
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <fstream>
 #include "PhzQtUI/DatasetRepository.h"
 
 using namespace Euclid::PhzQtUI;
@@ -152,5 +157,75 @@ BOOST_FIXTURE_TEST_CASE(serialize_test, ModelSet_Fixture) {
   BOOST_CHECK_EQUAL(excluded_nodes.at(0).toElement().text().toStdString(), ref_red_selection.getExclusions()[0]);
 }
 
+BOOST_FIXTURE_TEST_CASE(axes_tuple_test, ModelSet_Fixture) {
+  ParameterRule    rule{};
+  DatasetSelection sed_selection{};
+  sed_selection.setIsolated({"isolated_sed_1"});
+  DatasetSelection red_selection{};
+  red_selection.setIsolated({"isolated_red_1"});
+  rule.setName(ref_rule_1_name);
+  rule.setSedSelection(sed_selection);
+  rule.setRedCurveSelection(red_selection);
+  rule.setZRanges({Range{0., 6., 0.001}, Range{1., 2., 0.5}});
+  rule.setRedshiftValues({0.5, 6.});
+  rule.setEbvValues({0.1});
+
+  auto modelSet = ModelSet{sed_repo, red_repo};
+  modelSet.setParameterRules({std::make_pair(0, rule)});
+
+  auto& axes = modelSet.getAxesTuple();
+  BOOST_CHECK_EQUAL(axes.size(), 1);
+  auto& z_axis = std::get<Euclid::PhzDataModel::ModelParameter::Z>(axes.at(ref_rule_1_name));
+  BOOST_CHECK_EQUAL(z_axis.size(), 6001);
+  BOOST_CHECK(Elements::isEqual(z_axis[0], 0.));
+  BOOST_CHECK(std::abs(z_axis[z_axis.size() - 1] - 6.) < 0.000001);
+  auto& ebv_axis = std::get<Euclid::PhzDataModel::ModelParameter::EBV>(axes.at(ref_rule_1_name));
+  BOOST_CHECK_EQUAL(ebv_axis.size(), 1);
+
+  // Changing the rules invalidates the cached axes
+  rule.setZRanges({});
+  modelSet.setParameterRules({std::make_pair(0, rule)});
+  auto& new_z_axis = std::get<Euclid::PhzDataModel::ModelParameter::Z>(modelSet.getAxesTuple().at(ref_rule_1_name));
+  BOOST_CHECK_EQUAL(new_z_axis.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(axes_tuple_reload_test, ModelSet_Fixture) {
+  // GIVEN
+  Elements::TempDir temp_dir{};
+  auto              sed_dir = temp_dir.path() / "SEDs";
+  boost::filesystem::create_directories(sed_dir / "sed_group1");
+  std::ofstream{(sed_dir / "sed_group1" / "sed_1.txt").string()} << "1 1\n2 2\n";
+  std::unique_ptr<Euclid::XYDataset::FileParser> parser{new Euclid::XYDataset::AsciiParser{}};
+  auto repo = std::make_shared<DatasetRepository<std::unique_ptr<Euclid::XYDataset::FileSystemProvider>>>(
+      std::unique_ptr<Euclid::XYDataset::FileSystemProvider>{
+          new Euclid::XYDataset::FileSystemProvider{sed_dir.string(), std::move(parser)}});
+  repo->reload();
+
+  ParameterRule    rule{};
+  DatasetSelection sed_selection{};
+  sed_selection.setGroupes({"sed_group1"});
+  DatasetSelection red_selection{};
+  red_selection.setIsolated({"isolated_red_1"});
+  rule.setName(ref_rule_1_name);
+  rule.setSedSelection(sed_selection);
+  rule.setRedCurveSelection(red_selection);
+  rule.setRedshiftValues({0.});
+  rule.setEbvValues({0.});
+
+  auto modelSet = ModelSet{repo, red_repo};
+  modelSet.setParameterRules({std::make_pair(0, rule)});
+  auto& sed_axis = std::get<Euclid::PhzDataModel::ModelParameter::SED>(modelSet.getAxesTuple().at(ref_rule_1_name));
+  BOOST_CHECK_EQUAL(sed_axis.size(), 1);
+
+  // WHEN
+  std::ofstream{(sed_dir / "sed_group1" / "sed_2.txt").string()} << "1 1\n2 2\n";
+  repo->reload();
+
+  // THEN
+  auto& new_sed_axis =
+      std::get<Euclid::PhzDataModel::ModelParameter::SED>(modelSet.getAxesTuple().at(ref_rule_1_name));
+  BOOST_CHECK_EQUAL(new_sed_axis.size(), 2);
+}
+
 // Ends the test suite
 BOOST_AUTO_TEST_SUITE_END()
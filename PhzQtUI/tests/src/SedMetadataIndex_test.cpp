@@ -0,0 +1,142 @@
+/*
+ * SedMetadataIndex_test.cpp
+ */
+#include "PhzQtUI/SedMetadataIndex.h"
+#include "ElementsKernel/Temporary.h"  // for TempDir
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Euclid::PhzQtUI;
+using Euclid::XYDataset::QualifiedName;
+
+struct SedMetadataIndex_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_root_path  = (m_top_dir.path() / "SEDs").string() + "/";
+  std::string       m_cache_file = (m_top_dir.path() / "index.txt").string();
+
+  SedMetadataIndex_Fixture() {
+    boost::filesystem::create_directories(m_top_dir.path() / "SEDs" / "Group");
+    ofstream by_file_name((m_top_dir.path() / "SEDs" / "Group" / "Sed1.sed").string());
+    by_file_name << "# PARAMETER : AGE = 1.0 * L [Gyr]\n";
+    by_file_name << "# PARAMETER : MASS = 2.0 * L\n";
+    by_file_name << "1000 1.0\n";
+    by_file_name.close();
+
+    ofstream by_keyword((m_top_dir.path() / "SEDs" / "Group" / "file.txt").string());
+    by_keyword << "# NAME : Sed2\n";
+    by_keyword << "# PARAMETER : AGE = 3.0 * L [Gyr]\n";
+    by_keyword << "1000 1.0\n";
+    by_keyword.close();
+  }
+};
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(SedMetadataIndex_test)
+
+BOOST_FIXTURE_TEST_CASE(getFile_test, SedMetadataIndex_Fixture) {
+  // WHEN
+  SedMetadataIndex index{m_root_path, m_cache_file};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed1"}), m_root_path + "Group/Sed1.sed");
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed2"}), m_root_path + "Group/file.txt");
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed3"}), "");
+}
+
+BOOST_FIXTURE_TEST_CASE(getParameterList_test, SedMetadataIndex_Fixture) {
+  // WHEN
+  SedMetadataIndex index{m_root_path, m_cache_file};
+  auto             sed_1_params = index.getParameterList(QualifiedName{"Group/Sed1"});
+  auto             sed_2_params = index.getParameterList(QualifiedName{"Group/Sed2"});
+
+  // THEN
+  BOOST_CHECK_EQUAL(sed_1_params.size(), 2);
+  BOOST_CHECK_EQUAL(sed_1_params.at("AGE"), "Gyr");
+  BOOST_CHECK_EQUAL(sed_1_params.at("MASS"), "");
+  BOOST_CHECK_EQUAL(sed_2_params.size(), 1);
+  BOOST_CHECK_THROW(index.getParameterList(QualifiedName{"Group/Sed3"}), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(persistence_test, SedMetadataIndex_Fixture) {
+  // GIVEN
+  {
+    SedMetadataIndex index{m_root_path, m_cache_file};
+    index.getFile(QualifiedName{"Group/Sed1"});
+    index.save();
+  }
+  BOOST_CHECK(boost::filesystem::exists(m_cache_file));
+
+  // WHEN
+  SedMetadataIndex index{m_root_path, m_cache_file};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed2"}), m_root_path + "Group/file.txt");
+  BOOST_CHECK_EQUAL(index.getParameterList(QualifiedName{"Group/Sed1"}).at("AGE"), "Gyr");
+}
+
+BOOST_FIXTURE_TEST_CASE(malformed_cache_test, SedMetadataIndex_Fixture) {
+  // GIVEN
+  ofstream cache(m_cache_file);
+  cache << "# Phosphoros SED metadata index v1\n";
+  cache << "D\t" << m_root_path << "Group/\n";
+  cache << "F\tSed1.sed\tnot_a_time\tSed1\tAGE=Myr\n";
+  cache.close();
+
+  // WHEN
+  SedMetadataIndex index{m_root_path, m_cache_file};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParameterList(QualifiedName{"Group/Sed1"}).at("AGE"), "Gyr");
+}
+
+BOOST_FIXTURE_TEST_CASE(directory_change_test, SedMetadataIndex_Fixture) {
+  // GIVEN
+  SedMetadataIndex index{m_root_path, m_cache_file};
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed4"}), "");
+
+  // WHEN
+  auto     group_dir = m_top_dir.path() / "SEDs" / "Group";
+  auto     dir_mtime = boost::filesystem::last_write_time(group_dir);
+  ofstream new_sed((group_dir / "Sed4.sed").string());
+  new_sed << "1000 1.0\n";
+  new_sed.close();
+  boost::filesystem::last_write_time(group_dir, dir_mtime + 10);
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed4"}), m_root_path + "Group/Sed4.sed");
+}
+
+BOOST_FIXTURE_TEST_CASE(concurrent_name_test, SedMetadataIndex_Fixture) {
+  // GIVEN
+  for (int index = 0; index < 20; ++index) {
+    ofstream by_keyword((m_top_dir.path() / "SEDs" / "Group" / ("named_" + to_string(index) + ".txt")).string());
+    by_keyword << "# NAME : Named" << index << "\n";
+    by_keyword << "1000 1.0\n";
+  }
+  SedMetadataIndex index{m_root_path, m_cache_file};
+
+  // WHEN
+  std::vector<std::string> files(8);
+  std::vector<std::thread> threads{};
+  for (size_t thread = 0; thread < files.size(); ++thread) {
+    threads.emplace_back([&index, &files, thread]() {
+      files[thread] = index.getFile(QualifiedName{"Group/Named" + to_string(thread)});
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // THEN
+  for (size_t thread = 0; thread < files.size(); ++thread) {
+    BOOST_CHECK_EQUAL(files[thread], m_root_path + "Group/named_" + to_string(thread) + ".txt");
+  }
+  BOOST_CHECK_EQUAL(index.getFile(QualifiedName{"Group/Sed2"}), m_root_path + "Group/file.txt");
+}
+
+// Ends the test suite
+BOOST_AUTO_TEST_SUITE_END()
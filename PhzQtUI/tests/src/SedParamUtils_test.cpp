@@ -49,6 +49,36 @@ BOOST_FIXTURE_TEST_CASE(getParameter_test, SedParamUtils_Fixture) {
 
 }
 
+BOOST_FIXTURE_TEST_CASE(parseHeader_test, SedParamUtils_Fixture) {
+    // GIVEN
+	auto file_path = (m_top_dir.path()/ "sed.txt").string();
+	ofstream sed_file;
+    sed_file.open (file_path);
+    sed_file << "# SedName\n";
+    sed_file << "# PARAMETER : AGE = 1.5 * L [ Gyr ]\n";
+    sed_file << "#PARAMETER:MASS-STAR=2.0*L\n";
+    sed_file << "# PARAMETER : Z = 0.02 [km/s]\n";
+    sed_file << "# PARAMETER : BROKEN\n";
+    sed_file << "\n";
+    sed_file << "1000.0 1.0E-3\n";
+    sed_file << "# PARAMETER : AFTER = 1 [s]\n";
+    sed_file << "#KEY:AfterData\n";
+    sed_file.close();
+
+    // WHEN
+    auto header = SedParamUtils::parseHeader(file_path);
+    auto params = SedParamUtils::getParameterList(file_path);
+
+    // THEN
+    BOOST_CHECK_EQUAL(header.first_line_name, "SedName");
+    BOOST_CHECK_EQUAL(SedParamUtils::getName(file_path), "SedName");
+    BOOST_CHECK_EQUAL(params.size(), 3);
+    BOOST_CHECK_EQUAL(params.at("AGE"), "Gyr");
+    BOOST_CHECK_EQUAL(params.at("MASS-STAR"), "");
+    BOOST_CHECK_EQUAL(params.at("Z"), "");
+    BOOST_CHECK_EQUAL(SedParamUtils::getParameter(file_path, "KEY"), "");
+    BOOST_CHECK_THROW(SedParamUtils::parseHeader((m_top_dir.path()/ "missing.txt").string()), Elements::Exception);
+}
 
 // Ends the test suite
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,35 @@
+/*
+ * StartupProfile_test.cpp
+ */
+#include "src/lib/StartupProfile.h"
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace Euclid::PhzQtUI;
+
+BOOST_AUTO_TEST_SUITE(StartupProfile_test)
+
+BOOST_AUTO_TEST_CASE(write_test) {
+  // GIVEN
+  auto& profile = StartupProfile::getInstance();
+  {
+    StartupProfile::Phase phase("Catalog page");
+  }
+  std::thread([]() { StartupProfile::getInstance().milestone("Worker \"quoted\" C:\\dir"); }).join();
+
+  // WHEN
+  std::stringstream out{};
+  profile.write(out);
+
+  // THEN
+  auto text = out.str();
+  BOOST_CHECK_EQUAL(text.find("{\n  \"date\": \""), 0);
+  BOOST_CHECK(text.find("{\"name\": \"Catalog page\", \"start_ms\": ") != std::string::npos);
+  BOOST_CHECK(text.find("{\"name\": \"Worker \\\"quoted\\\" C:\\\\dir\", \"start_ms\": ") != std::string::npos);
+  BOOST_CHECK(text.find("\"thread\": \"worker\"}") != std::string::npos);
+  BOOST_CHECK_EQUAL(text.substr(text.size() - 7), "\n  ]\n}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * SurveyFilterMapping_test.cpp
+ */
+#include "PhzQtUI/SurveyFilterMapping.h"
+#include "ElementsKernel/Temporary.h"  // for TempDir
+#include "src/lib/FileUtils.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+
+using namespace Euclid::PhzQtUI;
+
+// A Phosphoros root directory holding the catalog configurations
+struct SurveyFilterMapping_Fixture {
+  Elements::TempDir       m_top_dir{};
+  boost::filesystem::path m_root  = m_top_dir.path();
+  std::time_t             m_mtime = 1700000000;
+
+  SurveyFilterMapping_Fixture() {
+    setenv("PHOSPHOROS_ROOT", m_root.c_str(), 1);
+  }
+
+  boost::filesystem::path getMappingFile(const std::string& name) {
+    return m_root / "IntermediateProducts" / name / "filter_mapping.txt";
+  }
+
+  void createCatalog(const std::string& name, const std::string& flux_column) {
+    boost::filesystem::create_directories(m_root / "Catalogs" / name);
+    boost::filesystem::create_directories(m_root / "config" / "GUI" / "Catalogs");
+    std::ofstream((m_root / "config" / "GUI" / "Catalogs" / (name + ".xml")).string())
+        << "<CatalogInfo SourceColumnId=\"ID_" << name << "\" RaColumn=\"RA\" DecColumn=\"DEC\""
+        << " DefaultCatalogPath=\"Catalogs/" << name << "/catalog.fits\"/>\n";
+    boost::filesystem::create_directories(getMappingFile(name).parent_path());
+    writeMapping(name, flux_column);
+  }
+
+  // The modification time is set explicitly, so that a rewrite can keep it
+  void writeMapping(const std::string& name, const std::string& flux_column) {
+    std::ofstream(getMappingFile(name).string())
+        << "# Filter, Flux Column, Error Column\n"
+        << "Filters/g " << flux_column << " ERR_G\n";
+    boost::filesystem::last_write_time(getMappingFile(name), m_mtime);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(SurveyFilterMapping_test)
+
+BOOST_FIXTURE_TEST_CASE(loadCatalogMappings_test, SurveyFilterMapping_Fixture) {
+  // GIVEN
+  createCatalog("CatA", "FLUX_A");
+  createCatalog("CatB", "FLUX_B");
+
+  // WHEN
+  auto catalogs = SurveyFilterMapping::getAvailableCatalogs();
+  auto mappings = SurveyFilterMapping::loadCatalogMappings();
+
+  // THEN: the key of a mapping is the index of its catalog in the listing
+  BOOST_REQUIRE_EQUAL(catalogs.size(), 2);
+  BOOST_REQUIRE_EQUAL(mappings.size(), 2);
+  for (int id = 0; id < 2; ++id) {
+    const auto& mapping = mappings.at(id);
+    BOOST_CHECK_EQUAL(mapping.getName(), catalogs[id]);
+    BOOST_CHECK_EQUAL(mapping.getSourceIdColumn(), "ID_" + catalogs[id]);
+    BOOST_CHECK_EQUAL(mapping.getDefaultCatalogFile(),
+                      FileUtils::getRootPath(true) + "Catalogs/" + catalogs[id] + "/catalog.fits");
+    BOOST_REQUIRE_EQUAL(mapping.getFilters().size(), 1);
+    BOOST_CHECK_EQUAL(mapping.getFilters()[0].getFluxColumn(), catalogs[id] == "CatA" ? "FLUX_A" : "FLUX_B");
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(mtime_cache_test, SurveyFilterMapping_Fixture) {
+  // GIVEN
+  createCatalog("CatA", "FLUX_A");
+  SurveyFilterMapping::loadCatalogMappings();
+
+  // WHEN: the content changes but not the modification time
+  writeMapping("CatA", "FLUX_EDITED");
+  auto cached = SurveyFilterMapping::loadCatalogMappings();
+
+  // THEN: the mapping is not read again
+  BOOST_REQUIRE_EQUAL(cached.at(0).getFilters().size(), 1);
+  BOOST_CHECK_EQUAL(cached.at(0).getFilters()[0].getFluxColumn(), "FLUX_A");
+
+  // WHEN: the modification time changes
+  m_mtime += 10;
+  writeMapping("CatA", "FLUX_EDITED");
+  auto reloaded = SurveyFilterMapping::loadCatalogMappings();
+
+  // THEN
+  BOOST_REQUIRE_EQUAL(reloaded.at(0).getFilters().size(), 1);
+  BOOST_CHECK_EQUAL(reloaded.at(0).getFilters()[0].getFluxColumn(), "FLUX_EDITED");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+/*
+ * CachedFileParser.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef CACHEDFILEPARSER_H_
+#define CACHEDFILEPARSER_H_
+
+#include "XYDataset/FileParser.h"
+#include "XYDataset/XYDataset.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class CachedFileParser
+ *
+ * @brief FileParser decorator keeping a binary copy of the parsed files.
+ *
+ * @details
+ * The first time a file is parsed, its dataset name and its (x, y) pairs are
+ * written in a small binary file of the cache directory, together with the
+ * path, size and modification time of the source file. Later calls for the
+ * same, unmodified, file memory-map this binary file instead of parsing the
+ * text again. A source whose size or modification time have changed is parsed
+ * again and its binary copy replaced.
+ *
+ * The files the wrapped parser rejects are also recorded, so that listing a
+ * directory does not read them again. The cache files use the native byte
+ * order and are only meant to be shared by the programs of a single machine.
+ * Any problem with the cache directory only disables the cache, the wrapped
+ * parser is then used directly.
+ *
+ * The getParameter calls are always forwarded to the wrapped parser, as the
+ * keywords are not part of the binary copy. A getName call missing the cache
+ * is also forwarded, without parsing the whole dataset.
+ *
+ * The copies are named after the path of their source, the ones of deleted or
+ * renamed sources are removed by evictStale.
+ */
+class CachedFileParser : public XYDataset::FileParser {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param parser
+   * The parser used to read the files missing from the cache.
+   *
+   * @param cache_directory
+   * The directory of the binary files, created if it does not exist.
+   */
+  CachedFileParser(std::unique_ptr<XYDataset::FileParser> parser, std::string cache_directory);
+
+  /**
+   * @brief Build an AsciiParser cached in the given directory (by default the
+   * one returned by getDefaultCacheDirectory).
+   */
+  static std::unique_ptr<XYDataset::FileParser> create(const std::string& cache_directory = "");
+
+  /**
+   * @brief The default cache directory: .cache/XYDataset in the Phosphoros
+   * root directory ($PHOSPHOROS_ROOT or $HOME/Phosphoros). The GUI uses the
+   * root directory of its configuration instead.
+   */
+  static std::string getDefaultCacheDirectory();
+
+  /**
+   * @brief Remove from the cache directory the copies whose source file no
+   * longer exists or has been modified since.
+   *
+   * @return The number of removed copies
+   */
+  static std::size_t evictStale(const std::string& cache_directory);
+
+  std::string getName(const std::string& file) override;
+
+  std::string getParameter(const std::string& file, const std::string& key_word) override;
+
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const std::string& file) override;
+
+  bool isParsable(const std::string& file) override;
+
+  /**
+   * @brief Get the binary file used for the given source file.
+   */
+  std::string getCacheFile(const std::string& file) const;
+
+private:
+  struct Entry {
+    bool                                   parsable = false;
+    std::string                            name{};
+    std::vector<std::pair<double, double>> values{};
+  };
+
+  Entry getEntry(const std::string& file, bool with_values);
+
+  bool findEntry(const std::string& file, bool with_values, Entry& entry) const;
+
+  bool readCache(const std::string& file, long long size, long long mtime, bool with_values, Entry& entry) const;
+
+  void writeCache(const std::string& file, long long size, long long mtime, const Entry& entry) const;
+
+  std::unique_ptr<XYDataset::FileParser> m_parser;
+  std::string                            m_cache_directory;
+  bool                                   m_enabled;
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* CACHEDFILEPARSER_H_ */
@@ -0,0 +1,94 @@
+/*
+ * CancellationToken.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef CANCELLATIONTOKEN_H_
+#define CANCELLATIONTOKEN_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class CancellationToken
+ *
+ * @brief Cancellation state of a single computation job.
+ *
+ * @details
+ * A token is created when a job starts and destroyed when it is over. It is
+ * owned by the job (usually through a shared pointer captured by the monitor
+ * functions), so that cancelling one job never affects the others.
+ *
+ * A cancelled job is stopped through checked flags, never by throwing from
+ * the callbacks of the engines: the PhosphorosCore engines may call their
+ * monitor functions from their own worker threads, where an exception would
+ * terminate the application. The monitor functions only check isCancelled
+ * (to stop updating the GUI), and the job checks it again on its own thread,
+ * once the engine has returned and before writing its outputs.
+ *
+ * The PhosphorosCore engines can only be interrupted through the process-wide
+ * PhzUtils stop flag they poll, so the tokens drive it: it is raised when
+ * every running job has been cancelled, and lowered only once none of the
+ * cancelled jobs is running anymore, so that a job being interrupted is never
+ * resumed. A cancelled job running next to a job which is not cancelled is
+ * therefore not interrupted, it runs to its end and its outputs are dropped.
+ * A new job must not start its engines while the flag is raised: canStart
+ * tells, without blocking, when it can, and the GUI retries it from a timer
+ * rather than holding a worker thread.
+ */
+class CancellationToken {
+public:
+  /**
+   * @brief Create the token of a new job and register it as running.
+   */
+  CancellationToken();
+
+  /**
+   * @brief Unregister the job.
+   */
+  ~CancellationToken();
+
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken& operator=(const CancellationToken&) = delete;
+
+  /**
+   * @brief Request the cancellation of the job.
+   */
+  void cancel();
+
+  /**
+   * @brief Check if the cancellation of the job has been requested.
+   */
+  bool isCancelled() const;
+
+  /**
+   * @brief Stop the job if it has been cancelled. Only to be called from the
+   * thread running the job, never from the callbacks of the engines.
+   * @throw Elements::Exception if the cancellation has been requested.
+   */
+  void throwIfCancelled() const;
+
+  /**
+   * @brief Check, without blocking, if the job can start its engines: false
+   * while the stop flag raised for other cancelled jobs is up. Always true
+   * once this job is cancelled, so that it can end at once.
+   */
+  bool canStart() const;
+
+  /**
+   * @brief Get the number of jobs currently running.
+   */
+  static size_t getRunningJobCount();
+
+private:
+  std::atomic<bool> m_cancelled{false};
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* CANCELLATIONTOKEN_H_ */
@@ -0,0 +1,24 @@
+/*
+ * JsonString.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef JSONSTRING_H_
+#define JSONSTRING_H_
+
+#include <string>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @brief Get the JSON string literal of a value: the value between double
+ * quotes, with the quotes, the backslashes and the control characters escaped.
+ */
+std::string toJsonString(const std::string& value);
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* JSONSTRING_H_ */
@@ -0,0 +1,107 @@
+/*
+ * MappedFitsTable.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef MAPPEDFITSTABLE_H_
+#define MAPPEDFITSTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class MappedFitsTable
+ *
+ * @brief Read-only, memory-mapped view of a binary table HDU of a FITS file.
+ *
+ * @details
+ * Only the header is parsed when the table is opened: the cells are decoded
+ * in place (FITS data are big endian) when they are accessed, so that the
+ * cost of reading a few rows does not depend on the size of the file and a
+ * scan of the table only reads the pages it touches. The scalar numerical
+ * columns (L, B, I, J, K, E and D formats, with their TSCAL / TZERO) and the
+ * character columns (A format) can be read, the other formats are listed but
+ * cannot be decoded.
+ *
+ * The view is cheap to copy, the copies share the mapping. All the accessors
+ * are thread safe.
+ */
+class MappedFitsTable {
+public:
+  struct Column {
+    std::string name;
+    std::string unit;
+    /// The FITS type code of the column (e.g. 'D', 'K' or 'A')
+    char type;
+    /// The number of elements of each cell
+    std::size_t repeat;
+    /// The position of the column in the rows, in bytes
+    std::size_t offset;
+    double      scale;
+    double      zero;
+
+    /// True for the integer and floating point formats
+    bool isNumeric() const;
+
+    /// True for the E and D formats
+    bool isFloatingPoint() const;
+  };
+
+  /**
+   * @brief Map a binary table HDU
+   *
+   * @param file_name
+   * The FITS file
+   * @param hdu
+   * The index of the HDU, 0 being the primary one (as in Table::FitsReader)
+   *
+   * @throws Elements::Exception if the file cannot be mapped or if the HDU is
+   * not a binary table
+   */
+  explicit MappedFitsTable(const std::string& file_name, std::size_t hdu = 1);
+
+  const std::string& getFileName() const;
+
+  std::size_t getRowNumber() const;
+
+  const std::vector<Column>& getColumns() const;
+
+  /// The index of the column with the given name, -1 if there is no such column
+  int findColumn(const std::string& name) const;
+
+  /// @throws Elements::Exception if there is no such column
+  std::size_t getColumn(const std::string& name) const;
+
+  /// The first element of a numerical cell, scaled
+  double getDouble(std::size_t row, std::size_t column) const;
+
+  /// The first element of an integer cell, offset by TZERO
+  std::int64_t getInt64(std::size_t row, std::size_t column) const;
+
+  /// A character cell, without its trailing spaces and NUL
+  std::string getString(std::size_t row, std::size_t column) const;
+
+private:
+  class Mapping;
+
+  const unsigned char* getCell(std::size_t row, std::size_t column) const;
+
+  std::string                    m_file_name;
+  std::shared_ptr<const Mapping> m_mapping;
+  const unsigned char*           m_data     = nullptr;
+  std::size_t                    m_row_no   = 0;
+  std::size_t                    m_row_size = 0;
+  std::vector<Column>            m_columns{};
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* MAPPEDFITSTABLE_H_ */
@@ -0,0 +1,59 @@
+/*
+ * ParallelFor.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @brief Get the number of threads to use for size items.
+ *
+ * @param thread_number
+ * The requested number of threads, 0 meaning one per core
+ *
+ * @param size
+ * The number of items to process
+ *
+ * @param grain
+ * The minimum number of items worth a thread
+ *
+ * @return The number of threads, at least 1 and at most size / grain
+ */
+std::size_t getThreadNumber(std::size_t thread_number, std::size_t size, std::size_t grain = 1);
+
+/**
+ * @brief Split [0, size) in contiguous blocks, one per thread, and call
+ * compute(thread_index, begin, end) for each of them.
+ *
+ * @details
+ * The calling thread computes the first block (thread index 0), the index
+ * being meant to address per-thread results. The thread number is resolved
+ * with getThreadNumber. If some blocks throw, the first exception is rethrown
+ * once all the threads are over.
+ */
+void forEachBlock(std::size_t size, std::size_t thread_number,
+                  const std::function<void(std::size_t, std::size_t, std::size_t)>& compute);
+
+/**
+ * @brief Call compute(index) for all the indices of [0, size), the indices
+ * being handed out one at a time to the threads.
+ *
+ * @details
+ * To be used when the cost of the items varies. The calling thread is one of
+ * the workers. The first exception stops all the threads and is rethrown once
+ * they are over.
+ */
+void forEachIndex(std::size_t size, std::size_t thread_number, const std::function<void(std::size_t)>& compute);
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* PARALLELFOR_H_ */
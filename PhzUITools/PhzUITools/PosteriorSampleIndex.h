@@ -0,0 +1,185 @@
+/*
+ * PosteriorSampleIndex.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef POSTERIORSAMPLEINDEX_H_
+#define POSTERIORSAMPLEINDEX_H_
+
+#include "PhzUITools/MappedFitsTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/// The names of the index file and of the columns of a posterior folder
+struct PosteriorColumnNames {
+  std::string index_file      = "Index_File_posterior.fits";
+  std::string id_column       = "OBJECT_ID";
+  std::string file_column     = "FILE_NAME";
+  std::string redshift_column = "Z";
+};
+
+/**
+ * @class PosteriorSampleIndex
+ *
+ * @brief Random access to the posterior samples written by Phosphoros in the
+ * posteriors folder of a result directory, and computation of the physical
+ * parameter PDFs from them.
+ *
+ * @details
+ * The index file lists the sources (ID column) and the sample file holding
+ * the samples of each of them (file name column, relative to the posteriors
+ * folder). If the index has no file name column, all the other FITS files of
+ * the folder are used. The samples are the rows of the first binary table of
+ * the sample files, the samples of a source being consecutive rows with its ID;
+ * the physical parameters are the floating point columns of these tables.
+ * The redshift column is left out unless requested, in which case it comes
+ * last (as with the -z option of the former PP PDF tool).
+ *
+ * This layout is the one of the posterior folder written by PhosphorosCore,
+ * which is not part of this repository: the names of the index file and of
+ * its columns can be overridden (see PosteriorColumnNames), and a file or a column
+ * which is not found raises an exception instead of being guessed.
+ *
+ * All the files are memory-mapped (see MappedFitsTable). The construction
+ * scans the ID column of the sample files once to build a hash index of the
+ * sample blocks, so that the samples of a source are then found in constant
+ * time and read in place. The ranges and the PDFs of the parameters are
+ * computed in a single pass over the samples, split between threads.
+ */
+class PosteriorSampleIndex {
+public:
+  /// Called after each chunk of sources with the number of processed and total sources
+  typedef std::function<void(std::size_t done, std::size_t total)> ProgressListener;
+
+  /// Polled between the chunks, the computation stops with an exception when it returns true
+  typedef std::function<bool()> CancellationCheck;
+
+  struct Parameter {
+    std::string name;
+    std::string unit;
+  };
+
+  struct Range {
+    double min;
+    double max;
+  };
+
+  struct Binning {
+    double      min;
+    double      max;
+    std::size_t bins;
+  };
+
+  typedef PosteriorColumnNames ColumnNames;
+
+  /**
+   * @class SampleBlock
+   * @brief The samples of one source, read in place
+   */
+  class SampleBlock {
+  public:
+    /// The number of samples, 0 for an unknown source
+    std::size_t size() const;
+
+    /// The value of a parameter (in the order of getParameters()) for a sample
+    double getValue(std::size_t sample, std::size_t parameter) const;
+
+  private:
+    friend class PosteriorSampleIndex;
+
+    const MappedFitsTable*          m_table   = nullptr;
+    const std::vector<std::size_t>* m_columns = nullptr;
+    std::size_t                     m_first   = 0;
+    std::size_t                     m_size    = 0;
+  };
+
+  /**
+   * @brief Map the index and the sample files and build the index of the
+   * sample blocks.
+   *
+   * @param include_redshift
+   * If the redshift column is a parameter (the last one)
+   *
+   * @throws Elements::Exception if a file cannot be read, if a sample file
+   * lacks a parameter or if the samples of a source are not consecutive
+   */
+  explicit PosteriorSampleIndex(const std::string& posterior_folder, bool include_redshift = false,
+                                const ColumnNames& names = ColumnNames{}, std::size_t chunk_size = 10000);
+
+  /// The physical parameters found in the sample files
+  const std::vector<Parameter>& getParameters() const;
+
+  /// The IDs of the sources having samples, in the order of the index
+  const std::vector<std::int64_t>& getSourceIds() const;
+
+  /// The samples of a source, an empty block if the source is unknown
+  SampleBlock getSamples(std::int64_t id) const;
+
+  /**
+   * @brief Compute the minimum and maximum of each parameter over all the
+   * samples (NaN are ignored)
+   */
+  std::vector<Range> computeRanges(std::size_t thread_no = 0, ProgressListener progress = {},
+                                   CancellationCheck is_cancelled = {}) const;
+
+  /**
+   * @brief Compute the 1D and 2D PDFs of the parameters for each source and
+   * write them into a FITS file.
+   *
+   * @details
+   * The PDF of a source is the histogram of its samples, divided by its
+   * number of samples (the samples outside the binning are dropped). The
+   * output is the layout read by read_pp_pdf_catalog of PlotSpecZComparison:
+   * - a PP_PDF HDU with the ID column and one column per PDF, "MC_<PP>" for
+   *   the 1D PDFs (vector) and "MC_<PP1>_<PP2>" for the 2D PDFs (array of
+   *   shape (PP1 bins, PP2 bins))
+   * - one "BINS_MC_PDF_<PP in upper case>" HDU per parameter of the PDFs,
+   *   with the centers of the bins in a BINS column having the parameter unit
+   *
+   * @param binnings
+   * The binning of each parameter, in the order of getParameters()
+   * @param pdfs
+   * The names of the parameters of the PDFs, the second name being empty for
+   * the 1D PDFs
+   *
+   * @throws Elements::Exception if a parameter is unknown, has an invalid
+   * binning or has a '_' in its name (the separator of the column names)
+   */
+  void computePdfs(const std::vector<Binning>& binnings, const std::vector<std::pair<std::string, std::string>>& pdfs,
+                   const std::string& output_file, std::size_t thread_no = 0, ProgressListener progress = {},
+                   CancellationCheck is_cancelled = {}) const;
+
+private:
+  struct SampleFile {
+    MappedFitsTable          table;
+    std::vector<std::size_t> columns;
+  };
+
+  struct Block {
+    std::size_t file;
+    std::size_t first;
+    std::size_t size;
+  };
+
+  std::size_t getParameterIndex(const std::string& name) const;
+
+  std::size_t                             m_chunk_size;
+  std::vector<Parameter>                  m_parameters{};
+  std::vector<SampleFile>                 m_files{};
+  std::vector<std::int64_t>               m_source_ids{};
+  std::unordered_map<std::int64_t, Block> m_blocks{};
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* POSTERIORSAMPLEINDEX_H_ */
@@ -0,0 +1,127 @@
+/*
+ * ProgressReporter.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef PROGRESSREPORTER_H_
+#define PROGRESSREPORTER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class ProgressReporter
+ *
+ * @brief Monitor function for the long computations, coalescing the
+ * (step, total) notifications coming from any number of threads.
+ *
+ * @details
+ * The computation engines call their monitor function once per step, which
+ * for millions of steps floods the listener. This reporter can be used in
+ * place of such a function: it forwards at most one update per interval (the
+ * first and the last ones are always forwarded) together with the throughput
+ * and the estimated remaining time. The check is lock free, only the thread
+ * elected to report an update takes a lock.
+ *
+ * Optionally each forwarded update is also written as a small JSON document
+ * into a progress file, which can be polled by scripts and batch schedulers.
+ * The GUI writes progress.json in the output directory of the redshift
+ * computation, and the command line programs built on the native engines
+ * write one when given the progress-file option. The "state" of the document
+ * is "running" until the computation ends with one of the terminal states
+ * "done", "cancelled" or "failed", after which the file is left unchanged.
+ *
+ * Copies share the same state, so that the reporter can be passed by value as
+ * a std::function.
+ */
+class ProgressReporter {
+public:
+  /**
+   * @brief The state of the computation passed to the listener.
+   */
+  struct Status {
+    size_t step;
+    size_t total;
+    /// Elapsed time since the first notification, in seconds
+    double elapsed;
+    /// Average number of steps per second
+    double rate;
+    /// Estimated remaining time in seconds, negative if unknown
+    double eta;
+    /// True for the last notification (step == total)
+    bool done;
+    /// The name of the processed items, as given to the constructor
+    std::string unit;
+  };
+
+  typedef std::function<void(const Status& status)> Listener;
+
+  /**
+   * @brief Constructor
+   *
+   * @param listener
+   * The function receiving the coalesced updates.
+   *
+   * @param unit
+   * The name of the processed items (e.g. "sources", "models") used in the
+   * text description and in the progress file.
+   *
+   * @param progress_file
+   * The path of the progress file, if empty no file is written.
+   *
+   * @param interval
+   * The minimum time between two updates.
+   */
+  ProgressReporter(Listener listener, std::string unit, std::string progress_file = "",
+                   std::chrono::milliseconds interval = std::chrono::milliseconds(250));
+
+  /**
+   * @brief The monitor function entry point, thread safe.
+   */
+  void operator()(size_t step, size_t total) const;
+
+  /**
+   * @brief Build a short human readable description of the status, like
+   * "1.2e+04 models/s, ETA 00:01:23".
+   */
+  static std::string describe(const Status& status);
+
+  /**
+   * @brief Write the terminal "cancelled" state to the progress file, to be
+   * called when the user stops the computation. The notifications received
+   * afterwards are ignored.
+   */
+  void markCancelled() const;
+
+  /**
+   * @brief Write the terminal "failed" state to the progress file, to be
+   * called when the computation throws. The notifications received afterwards
+   * are ignored.
+   */
+  void markFailed() const;
+
+private:
+  struct State;
+
+  void report(size_t step, size_t total, bool done) const;
+
+  void finish(const std::string& state) const;
+
+  void writeProgressFile(const Status& status, const std::string& state) const;
+
+  std::shared_ptr<State> m_state;
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* PROGRESSREPORTER_H_ */
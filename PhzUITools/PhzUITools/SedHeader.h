@@ -0,0 +1,47 @@
+/*
+ * SedHeader.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SEDHEADER_H_
+#define SEDHEADER_H_
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @brief Content of the header of a SED file, as extracted by parseSedHeader.
+ */
+struct SedHeader {
+  /// Legacy dataset name given alone on the first non-empty line ("# name")
+  std::string first_line_name{};
+  /// The "# KEY : value" lines, all the values of a repeated keyword are kept in order
+  std::map<std::string, std::vector<std::string>> keywords{};
+  /// The keys of the keywords, in their order of first appearance
+  std::vector<std::string> keyword_order{};
+  /// The "# PARAMETER : name = value [unit]" lines: parameter name => unit
+  std::map<std::string, std::string> parameters{};
+};
+
+/**
+ * @brief Read the header of a SED in a single pass, stopping at the first
+ * data line.
+ */
+SedHeader parseSedHeader(std::istream& in);
+
+/**
+ * @brief Read the header of a SED file.
+ * @throw Elements::Exception if the file cannot be opened.
+ */
+SedHeader parseSedHeader(const std::string& file);
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* SEDHEADER_H_ */
@@ -0,0 +1,74 @@
+/*
+ * SpecZComparisonEngine.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SPECZCOMPARISONENGINE_H_
+#define SPECZCOMPARISONENGINE_H_
+
+#include "PhzUITools/SpecZComparisonMetrics.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class SpecZComparisonEngine
+ *
+ * @brief Compare the photo-z of a Phosphoros catalog with the spec-z of a
+ * reference catalog, streaming both catalogs.
+ *
+ * @details
+ * The spec-z catalog is read first into a hash index (ID -> spec-z). The
+ * photo-z catalog (and the optional point estimate catalog, read in the same
+ * row order) is then streamed by chunks and joined on the ID, each matched
+ * source being added to the metrics. Only the index and one chunk are kept in
+ * memory. The catalogs can be FITS or ASCII files.
+ *
+ * The box plot bins span the spec-z range of the spec-z catalog.
+ */
+class SpecZComparisonEngine {
+public:
+  /// Called after each chunk with the number of processed and total rows of the photo-z catalog
+  typedef std::function<void(std::size_t done, std::size_t total)> ProgressListener;
+
+  /// Polled between the chunks, the computation stops with an exception when it returns true
+  typedef std::function<bool()> CancellationCheck;
+
+  SpecZComparisonEngine(std::string specz_id_column, std::string specz_column, std::string phz_id_column,
+                        std::string phz_column, std::size_t box_bins = 10, std::size_t chunk_size = 100000);
+
+  /**
+   * @brief Compute the metrics.
+   *
+   * @param specz_catalog
+   * The catalog containing the spec-z
+   * @param phz_catalog
+   * The Phosphoros catalog
+   * @param pe_catalog
+   * The catalog containing the photo-z column, row by row with the Phosphoros
+   * catalog. If empty the photo-z is read from the Phosphoros catalog.
+   *
+   * @throw Elements::Exception if a column is missing, if no source is found
+   * in both catalogs or if the computation is cancelled
+   */
+  SpecZComparisonMetrics compute(const std::string& specz_catalog, const std::string& phz_catalog,
+                                 const std::string& pe_catalog = "", ProgressListener progress = {},
+                                 CancellationCheck is_cancelled = {}) const;
+
+private:
+  std::string m_specz_id_column;
+  std::string m_specz_column;
+  std::string m_phz_id_column;
+  std::string m_phz_column;
+  std::size_t m_box_bins;
+  std::size_t m_chunk_size;
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* SPECZCOMPARISONENGINE_H_ */
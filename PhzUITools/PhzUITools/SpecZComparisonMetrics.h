@@ -0,0 +1,122 @@
+/*
+ * SpecZComparisonMetrics.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SPECZCOMPARISONMETRICS_H_
+#define SPECZCOMPARISONMETRICS_H_
+
+#include "PhzUITools/TDigest.h"
+#include <cstddef>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class SpecZComparisonMetrics
+ *
+ * @brief Streaming statistics of the photo-z versus spec-z comparison.
+ *
+ * @details
+ * The statistics are computed on dz = (photo-z - spec-z) / (1 + spec-z), the
+ * sources with |dz| above the outlier limit being the outliers. The mean and
+ * the standard deviations are exact (Welford updates), the median, the MAD and
+ * the box plot quartiles are estimated with t-digests, so that the memory does
+ * not depend on the number of sources.
+ *
+ * The box plots are computed in regular spec-z bins.
+ */
+class SpecZComparisonMetrics {
+public:
+  /// The global statistics
+  struct Summary {
+    std::size_t count;
+    double      mean;
+    double      median;
+    double      sigma;
+    double      mad;
+    double      nmad;
+    /// Percentage of outliers
+    double      outliers_percent;
+    double      mean_no_outliers;
+    double      sigma_no_outliers;
+  };
+
+  /// The statistics of one spec-z bin
+  struct BoxStatistics {
+    double      bin_min;
+    double      bin_max;
+    std::size_t count;
+    /// The extreme values within 1.5 IQR of the quartiles (like matplotlib)
+    double      lower_whisker;
+    double      first_quartile;
+    double      median;
+    double      third_quartile;
+    double      upper_whisker;
+    double      outliers_percent;
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param bin_min
+   * The lower spec-z of the box plot bins
+   * @param bin_max
+   * The upper spec-z of the box plot bins
+   * @param box_bins
+   * The number of box plot bins, 0 for none
+   * @param outlier_limit
+   * The |dz| above which a source is an outlier
+   */
+  SpecZComparisonMetrics(double bin_min, double bin_max, std::size_t box_bins = 10, double outlier_limit = 0.15);
+
+  /**
+   * @brief Add a source, ignored if any of its redshifts is not finite.
+   */
+  void add(double specz, double photoz);
+
+  /**
+   * @brief Get the global statistics, NaN if no source has been added.
+   */
+  Summary getSummary() const;
+
+  /**
+   * @brief Get the statistics of the box plot bins.
+   */
+  std::vector<BoxStatistics> getBoxStatistics() const;
+
+  /// The factor converting the MAD into a standard deviation for a normal distribution
+  static constexpr double NMAD_FACTOR = 1.4826;
+
+private:
+  // Streaming mean and variance
+  struct Moments {
+    std::size_t count = 0;
+    double      mean  = 0.;
+    double      m2    = 0.;
+
+    void   add(double value);
+    double getMean() const;
+    double getSigma() const;
+  };
+
+  struct Bin {
+    TDigest     digest{};
+    std::size_t outliers = 0;
+  };
+
+  double           m_bin_min;
+  double           m_bin_max;
+  double           m_outlier_limit;
+  Moments          m_all{};
+  Moments          m_no_outliers{};
+  TDigest          m_digest{};
+  std::vector<Bin> m_bins;
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* SPECZCOMPARISONMETRICS_H_ */
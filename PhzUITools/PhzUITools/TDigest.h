@@ -0,0 +1,92 @@
+/*
+ * TDigest.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef TDIGEST_H_
+#define TDIGEST_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+/**
+ * @class TDigest
+ *
+ * @brief Streaming quantile sketch (merging t-digest).
+ *
+ * @details
+ * The values are summarized into a bounded number of weighted centroids,
+ * small near the tails and larger around the median, so that the quantiles
+ * of any number of values are estimated with a relative accuracy better than
+ * 1/compression in memory proportional to the compression. The values are
+ * buffered and merged into the centroids by batches, so that adding a value
+ * is amortized constant time.
+ *
+ * While less values than about the compression have been added every value
+ * is its own centroid and the quantiles are exact (with the interpolation
+ * numpy uses for the median).
+ */
+class TDigest {
+public:
+  explicit TDigest(double compression = 200.);
+
+  /**
+   * @brief Add a value, non finite values are ignored.
+   */
+  void add(double value, double weight = 1.);
+
+  /**
+   * @brief Add all the values summarized by another digest.
+   */
+  void merge(const TDigest& other);
+
+  /**
+   * @brief Estimate the quantile q (in [0, 1]), NaN if the digest is empty.
+   */
+  double quantile(double q) const;
+
+  /**
+   * @brief Estimate the fraction of the values below x.
+   */
+  double cdf(double x) const;
+
+  /**
+   * @brief Estimate the median of the absolute deviations from the given center.
+   */
+  double medianAbsoluteDeviation(double center) const;
+
+  double getCount() const;
+
+  double getMin() const {
+    return m_min;
+  }
+
+  double getMax() const {
+    return m_max;
+  }
+
+private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  void flush() const;
+
+  double                        m_compression;
+  double                        m_min;
+  double                        m_max;
+  mutable std::vector<Centroid> m_centroids{};
+  mutable std::vector<Centroid> m_buffer{};
+  mutable double                m_centroid_weight = 0.;
+  mutable double                m_buffer_weight   = 0.;
+};
+
+}  // namespace PhzUITools
+}  // namespace Euclid
+
+#endif /* TDIGEST_H_ */
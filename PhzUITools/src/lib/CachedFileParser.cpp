@@ -0,0 +1,325 @@
+/*
+ * CachedFileParser.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/CachedFileParser.h"
+#include "ElementsKernel/Logging.h"
+#include "XYDataset/AsciiParser.h"
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Euclid {
+namespace PhzUITools {
+
+static Elements::Logging logger = Elements::Logging::getLogger("CachedFileParser");
+
+namespace {
+
+// Cache file layout (native byte order):
+//   the header below,
+//   the dataset name and the source path, padded with zeros to a multiple of 8 bytes,
+//   pair_number (x, y) pairs of doubles
+const char CACHE_MAGIC[8] = {'P', 'H', 'Z', 'X', 'Y', 'D', '1', '\0'};
+
+struct CacheHeader {
+  char          magic[8];
+  std::uint64_t source_size;
+  std::int64_t  source_mtime;
+  std::uint64_t pair_number;
+  std::uint32_t parsable;
+  std::uint32_t name_length;
+  std::uint32_t path_length;
+  std::uint32_t reserved;
+};
+
+static_assert(sizeof(CacheHeader) == 48, "Unexpected padding in the cache header");
+
+std::size_t getPaddedSize(std::size_t size) {
+  return (size + 7) / 8 * 8;
+}
+
+// The size and the modification time (in ns) of a file
+bool getStatus(const std::string& file, long long& size, long long& mtime) {
+  struct stat status {};
+  if (::stat(file.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+    return false;
+  }
+  size = static_cast<long long>(status.st_size);
+#ifdef __APPLE__
+  mtime = static_cast<long long>(status.st_mtimespec.tv_sec) * 1000000000LL + status.st_mtimespec.tv_nsec;
+#else
+  mtime = static_cast<long long>(status.st_mtim.tv_sec) * 1000000000LL + status.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+
+std::string getAbsolutePath(const std::string& file) {
+  return boost::filesystem::absolute(file).string();
+}
+
+// Read-only mapping of a whole file, empty if the file cannot be mapped
+class Mapping {
+public:
+  explicit Mapping(const std::string& file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+      m_size    = static_cast<std::size_t>(status.st_size);
+      m_address = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (m_address == MAP_FAILED) {
+      m_address = nullptr;
+    }
+  }
+
+  ~Mapping() {
+    if (m_address != nullptr) {
+      ::munmap(m_address, m_size);
+    }
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const unsigned char* data() const {
+    return static_cast<const unsigned char*>(m_address);
+  }
+
+  std::size_t size() const {
+    return m_address == nullptr ? 0 : m_size;
+  }
+
+private:
+  void*       m_address = nullptr;
+  std::size_t m_size    = 0;
+};
+
+}  // namespace
+
+CachedFileParser::CachedFileParser(std::unique_ptr<XYDataset::FileParser> parser, std::string cache_directory)
+    : m_parser{std::move(parser)}, m_cache_directory{std::move(cache_directory)}, m_enabled{true} {
+  boost::system::error_code error{};
+  boost::filesystem::create_directories(m_cache_directory, error);
+  if (error || !boost::filesystem::is_directory(m_cache_directory)) {
+    logger.warn() << "Unable to use the dataset cache directory " << m_cache_directory << ", the cache is disabled";
+    m_enabled = false;
+  }
+}
+
+std::unique_ptr<XYDataset::FileParser> CachedFileParser::create(const std::string& cache_directory) {
+  return std::unique_ptr<XYDataset::FileParser>{
+      new CachedFileParser{std::unique_ptr<XYDataset::FileParser>{new XYDataset::AsciiParser{}},
+                           cache_directory.empty() ? getDefaultCacheDirectory() : cache_directory}};
+}
+
+std::string CachedFileParser::getDefaultCacheDirectory() {
+  auto phos_root = std::getenv("PHOSPHOROS_ROOT");
+  auto home      = std::getenv("HOME");
+  auto root = phos_root ? boost::filesystem::path{phos_root} : boost::filesystem::path{home ? home : ""} / "Phosphoros";
+  return (root / ".cache" / "XYDataset").string();
+}
+
+std::string CachedFileParser::getCacheFile(const std::string& file) const {
+  // FNV-1a hash of the absolute path, collisions are detected with the path stored in the file
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : getAbsolutePath(file)) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  char name[24];
+  std::snprintf(name, sizeof(name), "%016llx.xyd", static_cast<unsigned long long>(hash));
+  return (boost::filesystem::path{m_cache_directory} / name).string();
+}
+
+std::size_t CachedFileParser::evictStale(const std::string& cache_directory) {
+  std::size_t               removed = 0;
+  boost::system::error_code error{};
+  for (boost::filesystem::directory_iterator it{cache_directory, error}, end{}; !error && it != end;
+       it.increment(error)) {
+    auto cache_file = it->path();
+    if (cache_file.extension() != ".xyd") {
+      continue;
+    }
+    // Only the header and the source path are needed
+    std::ifstream in(cache_file.string(), std::ios::binary);
+    CacheHeader   header{};
+    bool          stale = !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                 std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0;
+    if (!stale) {
+      std::string path(header.path_length, '\0');
+      long long   size  = 0;
+      long long   mtime = 0;
+      in.seekg(header.name_length, std::ios::cur);
+      stale = !in.read(&path[0], path.size()) || !getStatus(path, size, mtime) ||
+              header.source_size != static_cast<std::uint64_t>(size) || header.source_mtime != mtime;
+    }
+    in.close();
+    if (stale && boost::filesystem::remove(cache_file, error)) {
+      ++removed;
+    }
+    error.clear();
+  }
+  if (removed > 0) {
+    logger.debug() << "Removed " << removed << " outdated dataset cache files from " << cache_directory;
+  }
+  return removed;
+}
+
+std::string CachedFileParser::getName(const std::string& file) {
+  // The wrapped parser only reads the header for the name, the copy is written
+  // when the dataset or its parsability are requested
+  Entry entry{};
+  return findEntry(file, false, entry) && entry.parsable ? entry.name : m_parser->getName(file);
+}
+
+std::string CachedFileParser::getParameter(const std::string& file, const std::string& key_word) {
+  return m_parser->getParameter(file, key_word);
+}
+
+std::unique_ptr<XYDataset::XYDataset> CachedFileParser::getDataset(const std::string& file) {
+  auto entry = getEntry(file, true);
+  if (!entry.parsable) {
+    // Let the wrapped parser report the problem its own way
+    return m_parser->getDataset(file);
+  }
+  return std::unique_ptr<XYDataset::XYDataset>{new XYDataset::XYDataset{std::move(entry.values)}};
+}
+
+bool CachedFileParser::isParsable(const std::string& file) {
+  return getEntry(file, false).parsable;
+}
+
+bool CachedFileParser::findEntry(const std::string& file, bool with_values, Entry& entry) const {
+  long long size  = 0;
+  long long mtime = 0;
+  return m_enabled && getStatus(file, size, mtime) && readCache(file, size, mtime, with_values, entry);
+}
+
+CachedFileParser::Entry CachedFileParser::getEntry(const std::string& file, bool with_values) {
+  Entry     entry{};
+  long long size      = 0;
+  long long mtime     = 0;
+  bool      cacheable = m_enabled && getStatus(file, size, mtime);
+  if (cacheable && readCache(file, size, mtime, with_values, entry)) {
+    return entry;
+  }
+
+  // Missing or outdated copy: the whole dataset is parsed, so that the copy
+  // written during a directory listing is complete
+  entry.parsable = m_parser->isParsable(file);
+  if (entry.parsable) {
+    auto dataset = m_parser->getDataset(file);
+    if (dataset) {
+      entry.name = m_parser->getName(file);
+      entry.values.reserve(dataset->size());
+      for (const auto& pair : *dataset) {
+        entry.values.emplace_back(pair.first, pair.second);
+      }
+    } else {
+      entry.parsable = false;
+    }
+  }
+  if (cacheable) {
+    writeCache(file, size, mtime, entry);
+  }
+  return entry;
+}
+
+bool CachedFileParser::readCache(const std::string& file, long long size, long long mtime, bool with_values,
+                                 Entry& entry) const {
+  Mapping mapping{getCacheFile(file)};
+  if (mapping.size() < sizeof(CacheHeader)) {
+    return false;
+  }
+  CacheHeader header;
+  std::memcpy(&header, mapping.data(), sizeof(CacheHeader));
+  if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+      header.source_size != static_cast<std::uint64_t>(size) || header.source_mtime != mtime) {
+    return false;
+  }
+  auto strings_size = getPaddedSize(std::size_t{header.name_length} + header.path_length);
+  if (header.pair_number > mapping.size() / (2 * sizeof(double))) {
+    return false;
+  }
+  auto values_size = header.pair_number * 2 * sizeof(double);
+  if (mapping.size() != sizeof(CacheHeader) + strings_size + values_size) {
+    return false;
+  }
+  auto        strings = reinterpret_cast<const char*>(mapping.data() + sizeof(CacheHeader));
+  std::string path(strings + header.name_length, header.path_length);
+  if (path != getAbsolutePath(file)) {
+    return false;
+  }
+
+  entry.parsable = header.parsable != 0;
+  entry.name.assign(strings, header.name_length);
+  if (with_values) {
+    auto values = mapping.data() + sizeof(CacheHeader) + strings_size;
+    entry.values.resize(header.pair_number);
+    for (std::size_t i = 0; i < header.pair_number; ++i) {
+      std::memcpy(&entry.values[i].first, values + 16 * i, sizeof(double));
+      std::memcpy(&entry.values[i].second, values + 16 * i + 8, sizeof(double));
+    }
+  }
+  return true;
+}
+
+void CachedFileParser::writeCache(const std::string& file, long long size, long long mtime,
+                                  const Entry& entry) const {
+  auto path = getAbsolutePath(file);
+
+  CacheHeader header{};
+  std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.source_size  = static_cast<std::uint64_t>(size);
+  header.source_mtime = mtime;
+  header.pair_number  = entry.values.size();
+  header.parsable     = entry.parsable ? 1 : 0;
+  header.name_length  = static_cast<std::uint32_t>(entry.name.size());
+  header.path_length  = static_cast<std::uint32_t>(path.size());
+
+  std::vector<double> values{};
+  values.reserve(2 * entry.values.size());
+  for (const auto& pair : entry.values) {
+    values.push_back(pair.first);
+    values.push_back(pair.second);
+  }
+  std::string padding(getPaddedSize(entry.name.size() + path.size()) - entry.name.size() - path.size(), '\0');
+
+  // Write a temporary file then rename it, so that a concurrent reader never
+  // sees a partial copy
+  auto cache_file = getCacheFile(file);
+  auto tmp_file   = cache_file + boost::filesystem::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+  {
+    std::ofstream out(tmp_file, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(entry.name.data(), entry.name.size());
+    out.write(path.data(), path.size());
+    out.write(padding.data(), padding.size());
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    if (out.flush()) {
+      out.close();
+      if (std::rename(tmp_file.c_str(), cache_file.c_str()) == 0) {
+        return;
+      }
+    }
+  }
+  logger.debug() << "Unable to write the dataset cache file " << cache_file << " for " << file;
+  std::remove(tmp_file.c_str());
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
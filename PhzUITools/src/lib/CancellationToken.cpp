@@ -0,0 +1,78 @@
+/*
+ * CancellationToken.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include "PhzUITools/CancellationToken.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzUtils/Multithreading.h"
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace Euclid {
+namespace PhzUITools {
+
+namespace {
+
+std::mutex                   registry_mutex;
+std::set<CancellationToken*> running_jobs;
+
+// Must be called with the registry lock held
+bool anyCancelled() {
+  return std::any_of(running_jobs.begin(), running_jobs.end(),
+                     [](CancellationToken* job) { return job->isCancelled(); });
+}
+
+// Must be called with the registry lock held
+bool allCancelled() {
+  return !running_jobs.empty() && std::all_of(running_jobs.begin(), running_jobs.end(),
+                                              [](CancellationToken* job) { return job->isCancelled(); });
+}
+
+}  // namespace
+
+CancellationToken::CancellationToken() {
+  // The flag is left as it is: it may be interrupting cancelled jobs
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  running_jobs.insert(this);
+}
+
+CancellationToken::~CancellationToken() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  running_jobs.erase(this);
+  if (!anyCancelled()) {
+    PhzUtils::getStopThreadsFlag() = false;
+  }
+}
+
+void CancellationToken::cancel() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  m_cancelled = true;
+  if (allCancelled()) {
+    PhzUtils::getStopThreadsFlag() = true;
+  }
+}
+
+bool CancellationToken::isCancelled() const {
+  return m_cancelled;
+}
+
+void CancellationToken::throwIfCancelled() const {
+  if (m_cancelled) {
+    throw Elements::Exception() << "The computation has been cancelled";
+  }
+}
+
+bool CancellationToken::canStart() const {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  return m_cancelled || !PhzUtils::getStopThreadsFlag();
+}
+
+size_t CancellationToken::getRunningJobCount() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  return running_jobs.size();
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
@@ -0,0 +1,47 @@
+/*
+ * JsonString.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/JsonString.h"
+#include <cstdio>
+
+namespace Euclid {
+namespace PhzUITools {
+
+std::string toJsonString(const std::string& value) {
+  std::string result{"\""};
+  result.reserve(value.size() + 2);
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      result += "\\\"";
+      break;
+    case '\\':
+      result += "\\\\";
+      break;
+    case '\n':
+      result += "\\n";
+      break;
+    case '\r':
+      result += "\\r";
+      break;
+    case '\t':
+      result += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+        result += escaped;
+      } else {
+        result += c;
+      }
+    }
+  }
+  return result + "\"";
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
@@ -0,0 +1,342 @@
+/*
+ * MappedFitsTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/MappedFitsTable.h"
+#include "ElementsKernel/Exception.h"
+#include <boost/algorithm/string/trim.hpp>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Euclid {
+namespace PhzUITools {
+
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 2880;
+constexpr std::size_t CARD_SIZE  = 80;
+
+typedef std::map<std::string, std::string> Header;
+
+// Parse the header starting at offset and move offset to the data
+Header parseHeader(const unsigned char* data, std::size_t size, std::size_t& offset, const std::string& file_name) {
+  Header header{};
+  for (;; offset += CARD_SIZE) {
+    if (offset + CARD_SIZE > size) {
+      throw Elements::Exception() << "Truncated FITS header in " << file_name;
+    }
+    std::string card(reinterpret_cast<const char*>(data + offset), CARD_SIZE);
+    std::string keyword = boost::algorithm::trim_copy(card.substr(0, 8));
+    if (keyword == "END") {
+      break;
+    }
+    if (card.compare(8, 2, "= ") != 0) {
+      continue;
+    }
+    std::string value = card.substr(10);
+    auto        quote = value.find('\'');
+    if (quote != std::string::npos && value.find_first_not_of(' ') == quote) {
+      // String value, where '' stands for a quote
+      std::string text{};
+      for (auto i = quote + 1; i < value.size(); ++i) {
+        if (value[i] == '\'') {
+          if (i + 1 < value.size() && value[i + 1] == '\'') {
+            text += '\'';
+            ++i;
+            continue;
+          }
+          break;
+        }
+        text += value[i];
+      }
+      value = boost::algorithm::trim_right_copy(text);
+    } else {
+      value = boost::algorithm::trim_copy(value.substr(0, value.find('/')));
+    }
+    header[keyword] = value;
+  }
+  offset = (offset + CARD_SIZE + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+  return header;
+}
+
+long long getInteger(const Header& header, const std::string& keyword, long long default_value) {
+  auto value = header.find(keyword);
+  return value == header.end() ? default_value : std::atoll(value->second.c_str());
+}
+
+double getReal(const Header& header, const std::string& keyword, double default_value) {
+  auto value = header.find(keyword);
+  return value == header.end() ? default_value : std::atof(value->second.c_str());
+}
+
+std::size_t getElementSize(char type, std::size_t repeat) {
+  switch (type) {
+  case 'L':
+  case 'B':
+  case 'A':
+    return repeat;
+  case 'X':
+    return (repeat + 7) / 8;
+  case 'I':
+    return 2 * repeat;
+  case 'J':
+  case 'E':
+    return 4 * repeat;
+  case 'K':
+  case 'D':
+  case 'C':
+  case 'P':
+    return 8 * repeat;
+  case 'M':
+  case 'Q':
+    return 16 * repeat;
+  default:
+    return 0;
+  }
+}
+
+std::uint64_t readBigEndian(const unsigned char* cell, std::size_t size) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value = (value << 8) | cell[i];
+  }
+  return value;
+}
+
+}  // namespace
+
+// Read-only mapping of a whole file, unmapped when the last view using it is destroyed
+class MappedFitsTable::Mapping {
+public:
+  explicit Mapping(const std::string& file_name) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw Elements::Exception() << "Unable to open the FITS file " << file_name;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size == 0) {
+      ::close(fd);
+      throw Elements::Exception() << file_name << " is not a FITS file";
+    }
+    m_size    = static_cast<std::size_t>(status.st_size);
+    m_address = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_address == MAP_FAILED) {
+      throw Elements::Exception() << "Unable to map the FITS file " << file_name;
+    }
+  }
+
+  ~Mapping() {
+    ::munmap(m_address, m_size);
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const unsigned char* data() const {
+    return static_cast<const unsigned char*>(m_address);
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+private:
+  void*       m_address = nullptr;
+  std::size_t m_size    = 0;
+};
+
+bool MappedFitsTable::Column::isNumeric() const {
+  return std::strchr("LBIJKED", type) != nullptr && repeat > 0;
+}
+
+bool MappedFitsTable::Column::isFloatingPoint() const {
+  return (type == 'E' || type == 'D') && repeat > 0;
+}
+
+MappedFitsTable::MappedFitsTable(const std::string& file_name, std::size_t hdu)
+    : m_file_name{file_name}, m_mapping{std::make_shared<const Mapping>(file_name)} {
+  const unsigned char* data   = m_mapping->data();
+  std::size_t          size   = m_mapping->size();
+  std::size_t          offset = 0;
+  Header               header{};
+  for (std::size_t index = 0;; ++index) {
+    header = parseHeader(data, size, offset, file_name);
+    if (index == hdu) {
+      break;
+    }
+    // Skip the data of the HDU
+    std::size_t data_size = 0;
+    auto        naxis     = getInteger(header, "NAXIS", 0);
+    if (naxis > 0) {
+      data_size = 1;
+      for (long long axis = 1; axis <= naxis; ++axis) {
+        data_size *= static_cast<std::size_t>(getInteger(header, "NAXIS" + std::to_string(axis), 0));
+      }
+      data_size = (data_size + static_cast<std::size_t>(getInteger(header, "PCOUNT", 0))) *
+                  static_cast<std::size_t>(getInteger(header, "GCOUNT", 1)) *
+                  static_cast<std::size_t>(std::abs(getInteger(header, "BITPIX", 8))) / 8;
+    }
+    offset += (data_size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+    if (offset >= size) {
+      throw Elements::Exception() << "The FITS file " << file_name << " has no HDU " << hdu;
+    }
+  }
+
+  auto xtension = header.find("XTENSION");
+  if (xtension == header.end() || xtension->second != "BINTABLE") {
+    throw Elements::Exception() << "The HDU " << hdu << " of " << file_name << " is not a binary table";
+  }
+  m_row_size = static_cast<std::size_t>(getInteger(header, "NAXIS1", 0));
+  m_row_no   = static_cast<std::size_t>(getInteger(header, "NAXIS2", 0));
+  m_data     = data + offset;
+  if (offset + m_row_size * m_row_no > size) {
+    throw Elements::Exception() << "The FITS file " << file_name << " is truncated";
+  }
+
+  auto        field_no = getInteger(header, "TFIELDS", 0);
+  std::size_t position = 0;
+  for (long long field = 1; field <= field_no; ++field) {
+    auto        suffix = std::to_string(field);
+    std::string format = header["TFORM" + suffix];
+    std::size_t digits = 0;
+    while (digits < format.size() && std::isdigit(static_cast<unsigned char>(format[digits]))) {
+      ++digits;
+    }
+    if (digits == format.size()) {
+      throw Elements::Exception() << "Invalid TFORM" << suffix << " in " << file_name;
+    }
+    Column column{};
+    column.name   = header["TTYPE" + suffix];
+    column.unit   = header["TUNIT" + suffix];
+    column.type   = format[digits];
+    column.repeat = digits > 0 ? std::stoul(format.substr(0, digits)) : 1;
+    column.offset = position;
+    column.scale  = getReal(header, "TSCAL" + suffix, 1.);
+    column.zero   = getReal(header, "TZERO" + suffix, 0.);
+    position += getElementSize(column.type, column.repeat);
+    m_columns.push_back(std::move(column));
+  }
+  if (position > m_row_size) {
+    throw Elements::Exception() << "The columns of " << file_name << " do not match the row size";
+  }
+}
+
+const std::string& MappedFitsTable::getFileName() const {
+  return m_file_name;
+}
+
+std::size_t MappedFitsTable::getRowNumber() const {
+  return m_row_no;
+}
+
+const std::vector<MappedFitsTable::Column>& MappedFitsTable::getColumns() const {
+  return m_columns;
+}
+
+int MappedFitsTable::findColumn(const std::string& name) const {
+  for (std::size_t index = 0; index < m_columns.size(); ++index) {
+    if (m_columns[index].name == name) {
+      return static_cast<int>(index);
+    }
+  }
+  return -1;
+}
+
+std::size_t MappedFitsTable::getColumn(const std::string& name) const {
+  auto index = findColumn(name);
+  if (index < 0) {
+    throw Elements::Exception() << "The FITS file " << m_file_name << " does not have column with name " << name;
+  }
+  return static_cast<std::size_t>(index);
+}
+
+const unsigned char* MappedFitsTable::getCell(std::size_t row, std::size_t column) const {
+  return m_data + row * m_row_size + m_columns[column].offset;
+}
+
+double MappedFitsTable::getDouble(std::size_t row, std::size_t column) const {
+  const auto& info = m_columns[column];
+  auto        cell = getCell(row, column);
+  double      raw  = 0.;
+  switch (info.type) {
+  case 'L':
+    raw = cell[0] == 'T' ? 1. : 0.;
+    break;
+  case 'B':
+    raw = cell[0];
+    break;
+  case 'I':
+    raw = static_cast<std::int16_t>(readBigEndian(cell, 2));
+    break;
+  case 'J':
+    raw = static_cast<std::int32_t>(readBigEndian(cell, 4));
+    break;
+  case 'K':
+    raw = static_cast<double>(static_cast<std::int64_t>(readBigEndian(cell, 8)));
+    break;
+  case 'E': {
+    auto  bits  = static_cast<std::uint32_t>(readBigEndian(cell, 4));
+    float value = 0.f;
+    std::memcpy(&value, &bits, sizeof(value));
+    raw = value;
+    break;
+  }
+  case 'D': {
+    auto bits = readBigEndian(cell, 8);
+    std::memcpy(&raw, &bits, sizeof(raw));
+    break;
+  }
+  default:
+    throw Elements::Exception() << "The column " << info.name << " of " << m_file_name << " is not numerical";
+  }
+  return raw * info.scale + info.zero;
+}
+
+std::int64_t MappedFitsTable::getInt64(std::size_t row, std::size_t column) const {
+  const auto&  info = m_columns[column];
+  auto         cell = getCell(row, column);
+  std::int64_t raw  = 0;
+  switch (info.type) {
+  case 'B':
+    raw = cell[0];
+    break;
+  case 'I':
+    raw = static_cast<std::int16_t>(readBigEndian(cell, 2));
+    break;
+  case 'J':
+    raw = static_cast<std::int32_t>(readBigEndian(cell, 4));
+    break;
+  case 'K':
+    raw = static_cast<std::int64_t>(readBigEndian(cell, 8));
+    break;
+  default:
+    throw Elements::Exception() << "The column " << info.name << " of " << m_file_name << " is not an integer one";
+  }
+  if (info.zero == 9223372036854775808.) {
+    // Unsigned 64 bits integers, as written by CFITSIO
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(raw) ^ (std::uint64_t{1} << 63));
+  }
+  return raw + static_cast<std::int64_t>(info.zero);
+}
+
+std::string MappedFitsTable::getString(std::size_t row, std::size_t column) const {
+  const auto& info = m_columns[column];
+  if (info.type != 'A') {
+    throw Elements::Exception() << "The column " << info.name << " of " << m_file_name << " is not a string one";
+  }
+  auto        cell = reinterpret_cast<const char*>(getCell(row, column));
+  std::string value(cell, strnlen(cell, info.repeat));
+  return boost::algorithm::trim_right_copy(value);
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
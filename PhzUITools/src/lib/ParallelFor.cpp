@@ -0,0 +1,106 @@
+/*
+ * ParallelFor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Euclid {
+namespace PhzUITools {
+
+namespace {
+
+// Keep the first of the exceptions thrown by the workers
+class FirstError {
+public:
+  void set(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error) {
+      m_error = error;
+    }
+    m_failed = true;
+  }
+
+  bool failed() const {
+    return m_failed;
+  }
+
+  void rethrow() {
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+private:
+  std::mutex         m_mutex{};
+  std::exception_ptr m_error{};
+  std::atomic<bool>  m_failed{false};
+};
+
+// Run the worker on thread_number threads, the calling thread being one of them
+void run(std::size_t thread_number, const std::function<void(std::size_t)>& worker) {
+  std::vector<std::thread> threads{};
+  for (std::size_t index = 1; index < thread_number; ++index) {
+    threads.emplace_back(worker, index);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+std::size_t getThreadNumber(std::size_t thread_number, std::size_t size, std::size_t grain) {
+  if (thread_number == 0) {
+    thread_number = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<std::size_t>(1, std::min(thread_number, size / std::max<std::size_t>(1, grain)));
+}
+
+void forEachBlock(std::size_t size, std::size_t thread_number,
+                  const std::function<void(std::size_t, std::size_t, std::size_t)>& compute) {
+  thread_number     = getThreadNumber(thread_number, size);
+  std::size_t block = (size + thread_number - 1) / thread_number;
+
+  FirstError error{};
+  run(thread_number, [&](std::size_t index) {
+    std::size_t begin = std::min(index * block, size);
+    std::size_t end   = std::min(begin + block, size);
+    try {
+      if (begin < end || index == 0) {
+        compute(index, begin, end);
+      }
+    } catch (...) {
+      error.set(std::current_exception());
+    }
+  });
+  error.rethrow();
+}
+
+void forEachIndex(std::size_t size, std::size_t thread_number, const std::function<void(std::size_t)>& compute) {
+  thread_number = getThreadNumber(thread_number, size);
+
+  std::atomic<std::size_t> next{0};
+  FirstError               error{};
+  run(thread_number, [&](std::size_t) {
+    for (std::size_t index = next++; index < size && !error.failed(); index = next++) {
+      try {
+        compute(index);
+      } catch (...) {
+        error.set(std::current_exception());
+      }
+    }
+  });
+  error.rethrow();
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
@@ -0,0 +1,337 @@
+/*
+ * PosteriorSampleIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/PosteriorSampleIndex.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "NdArray/NdArray.h"
+#include "PhzUITools/ParallelFor.h"
+#include "Table/FitsWriter.h"
+#include "Table/Table.h"
+#include <algorithm>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace Euclid {
+namespace PhzUITools {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PosteriorSampleIndex");
+
+namespace {
+
+// A thread is only worth for a few tens of sources
+constexpr std::size_t SOURCES_PER_THREAD = 64;
+
+// The bin of a value, -1 if it is outside of the binning (or NaN)
+inline std::ptrdiff_t findBin(double value, const PosteriorSampleIndex::Binning& binning) {
+  if (!(value >= binning.min && value <= binning.max)) {
+    return -1;
+  }
+  auto bin = static_cast<std::size_t>((value - binning.min) / (binning.max - binning.min) * binning.bins);
+  return static_cast<std::ptrdiff_t>(std::min(bin, binning.bins - 1));
+}
+
+}  // namespace
+
+std::size_t PosteriorSampleIndex::SampleBlock::size() const {
+  return m_size;
+}
+
+double PosteriorSampleIndex::SampleBlock::getValue(std::size_t sample, std::size_t parameter) const {
+  return m_table->getDouble(m_first + sample, (*m_columns)[parameter]);
+}
+
+PosteriorSampleIndex::PosteriorSampleIndex(const std::string& posterior_folder, bool include_redshift,
+                                           const ColumnNames& names, std::size_t chunk_size)
+    : m_chunk_size{std::max<std::size_t>(1, chunk_size)} {
+  const auto&             id_column  = names.id_column;
+  const auto&             index_file = names.index_file;
+  boost::filesystem::path folder{posterior_folder};
+  MappedFitsTable         index{(folder / index_file).string()};
+  auto                    index_id_column   = index.getColumn(id_column);
+  auto                    index_file_column = index.findColumn(names.file_column);
+
+  // The sample files, in the order they appear in the index
+  std::vector<std::string> file_names{};
+  if (index_file_column >= 0) {
+    for (std::size_t row = 0; row < index.getRowNumber(); ++row) {
+      auto name = index.getString(row, static_cast<std::size_t>(index_file_column));
+      if (std::find(file_names.begin(), file_names.end(), name) == file_names.end()) {
+        file_names.push_back(name);
+      }
+    }
+  } else {
+    for (auto& entry : boost::filesystem::directory_iterator(folder)) {
+      auto name = entry.path().filename().string();
+      if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".fits" &&
+          name != index_file) {
+        file_names.push_back(name);
+      }
+    }
+    std::sort(file_names.begin(), file_names.end());
+  }
+
+  for (auto& name : file_names) {
+    MappedFitsTable table{(folder / name).string()};
+    auto            table_id_column = table.getColumn(id_column);
+    if (m_files.empty()) {
+      for (auto& column : table.getColumns()) {
+        if (column.isFloatingPoint() && column.name != id_column && column.name != names.redshift_column) {
+          m_parameters.push_back({column.name, column.unit});
+        }
+      }
+      if (include_redshift) {
+        auto& redshift = table.getColumns()[table.getColumn(names.redshift_column)];
+        m_parameters.push_back({redshift.name, redshift.unit});
+      }
+    }
+    std::vector<std::size_t> columns{};
+    for (auto& parameter : m_parameters) {
+      columns.push_back(table.getColumn(parameter.name));
+    }
+
+    // Index the runs of consecutive rows with the same ID
+    std::size_t file = m_files.size();
+    for (std::size_t first = 0; first < table.getRowNumber();) {
+      auto        id   = table.getInt64(first, table_id_column);
+      std::size_t last = first + 1;
+      while (last < table.getRowNumber() && table.getInt64(last, table_id_column) == id) {
+        ++last;
+      }
+      if (!m_blocks.emplace(id, Block{file, first, last - first}).second) {
+        throw Elements::Exception() << "The samples of the source " << id << " are not consecutive in "
+                                    << table.getFileName();
+      }
+      first = last;
+    }
+    m_files.push_back(SampleFile{std::move(table), std::move(columns)});
+  }
+
+  std::size_t missing = 0;
+  for (std::size_t row = 0; row < index.getRowNumber(); ++row) {
+    auto id = index.getInt64(row, index_id_column);
+    if (m_blocks.count(id) > 0) {
+      m_source_ids.push_back(id);
+    } else {
+      ++missing;
+    }
+  }
+  if (missing > 0) {
+    logger.warn() << missing << " source(s) of the index have no sample";
+  }
+  logger.info() << "Indexed the samples of " << m_source_ids.size() << " source(s) in " << m_files.size()
+                << " file(s)";
+}
+
+const std::vector<PosteriorSampleIndex::Parameter>& PosteriorSampleIndex::getParameters() const {
+  return m_parameters;
+}
+
+const std::vector<std::int64_t>& PosteriorSampleIndex::getSourceIds() const {
+  return m_source_ids;
+}
+
+PosteriorSampleIndex::SampleBlock PosteriorSampleIndex::getSamples(std::int64_t id) const {
+  SampleBlock samples{};
+  auto        block = m_blocks.find(id);
+  if (block != m_blocks.end()) {
+    const auto& file  = m_files[block->second.file];
+    samples.m_table   = &file.table;
+    samples.m_columns = &file.columns;
+    samples.m_first   = block->second.first;
+    samples.m_size    = block->second.size;
+  }
+  return samples;
+}
+
+std::size_t PosteriorSampleIndex::getParameterIndex(const std::string& name) const {
+  for (std::size_t index = 0; index < m_parameters.size(); ++index) {
+    if (m_parameters[index].name == name) {
+      return index;
+    }
+  }
+  throw Elements::Exception() << "Unknown physical parameter " << name;
+}
+
+std::vector<PosteriorSampleIndex::Range> PosteriorSampleIndex::computeRanges(std::size_t       thread_no,
+                                                                             ProgressListener  progress,
+                                                                             CancellationCheck is_cancelled) const {
+  std::size_t parameter_no = m_parameters.size();
+  Range       empty{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+  std::vector<Range> ranges(parameter_no, empty);
+
+  std::size_t total = m_source_ids.size();
+  for (std::size_t chunk = 0; chunk < total; chunk += m_chunk_size) {
+    if (is_cancelled && is_cancelled()) {
+      throw Elements::Exception() << "The computation of the parameter ranges has been cancelled";
+    }
+    std::size_t                     chunk_end     = std::min(chunk + m_chunk_size, total);
+    std::size_t                     thread_number = getThreadNumber(thread_no, chunk_end - chunk, SOURCES_PER_THREAD);
+    std::vector<std::vector<Range>> partial(thread_number, std::vector<Range>(parameter_no, empty));
+    forEachBlock(chunk_end - chunk, thread_number, [&](std::size_t index, std::size_t begin, std::size_t end) {
+      auto& local = partial[index];
+      for (std::size_t source = chunk + begin; source < chunk + end; ++source) {
+        auto samples = getSamples(m_source_ids[source]);
+        for (std::size_t sample = 0; sample < samples.size(); ++sample) {
+          for (std::size_t parameter = 0; parameter < parameter_no; ++parameter) {
+            double value = samples.getValue(sample, parameter);
+            if (!std::isnan(value)) {
+              local[parameter].min = std::min(local[parameter].min, value);
+              local[parameter].max = std::max(local[parameter].max, value);
+            }
+          }
+        }
+      }
+    });
+    for (std::size_t index = 0; index < thread_number; ++index) {
+      for (std::size_t parameter = 0; parameter < parameter_no; ++parameter) {
+        ranges[parameter].min = std::min(ranges[parameter].min, partial[index][parameter].min);
+        ranges[parameter].max = std::max(ranges[parameter].max, partial[index][parameter].max);
+      }
+    }
+    if (progress) {
+      progress(chunk_end, total);
+    }
+  }
+  return ranges;
+}
+
+void PosteriorSampleIndex::computePdfs(const std::vector<Binning>&                              binnings,
+                                       const std::vector<std::pair<std::string, std::string>>& pdfs,
+                                       const std::string& output_file, std::size_t thread_no,
+                                       ProgressListener progress, CancellationCheck is_cancelled) const {
+  if (binnings.size() != m_parameters.size()) {
+    throw Elements::Exception() << "Expected " << m_parameters.size() << " binnings, got " << binnings.size();
+  }
+  if (pdfs.empty()) {
+    throw Elements::Exception() << "No PDF to compute";
+  }
+  if (m_source_ids.empty()) {
+    throw Elements::Exception() << "No source has posterior samples";
+  }
+
+  // The parameters of each PDF (the second one being -1 for a 1D PDF), the
+  // position of the PDFs in the per source buffer and the parameters whose
+  // binning is written
+  std::vector<std::pair<std::size_t, std::ptrdiff_t>> axes{};
+  std::vector<std::size_t>                            offsets{0};
+  std::vector<std::size_t>                            used_parameters{};
+  std::vector<Table::ColumnInfo::info_type> info_list{Table::ColumnInfo::info_type("ID", typeid(std::int64_t))};
+  for (auto& pdf : pdfs) {
+    auto           x    = getParameterIndex(pdf.first);
+    std::ptrdiff_t y    = pdf.second.empty() ? -1 : static_cast<std::ptrdiff_t>(getParameterIndex(pdf.second));
+    std::size_t    size = binnings[x].bins;
+    std::string    name = "MC_" + pdf.first;
+    if (y >= 0) {
+      size *= binnings[y].bins;
+      name += "_" + pdf.second;
+    }
+    for (auto parameter : {static_cast<std::ptrdiff_t>(x), y}) {
+      if (parameter < 0) {
+        continue;
+      }
+      const auto& parameter_name = m_parameters[parameter].name;
+      if (binnings[parameter].bins == 0 || !(binnings[parameter].max > binnings[parameter].min)) {
+        throw Elements::Exception() << "Invalid binning for the parameter " << parameter_name;
+      }
+      if (parameter_name.find('_') != std::string::npos) {
+        throw Elements::Exception() << "The PDF of the parameter " << parameter_name
+                                    << " cannot be stored: the names of the PDF columns use '_' as separator";
+      }
+      if (std::find(used_parameters.begin(), used_parameters.end(), parameter) == used_parameters.end()) {
+        used_parameters.push_back(parameter);
+      }
+    }
+    axes.emplace_back(x, y);
+    offsets.push_back(offsets.back() + size);
+    info_list.emplace_back(name, y >= 0 ? typeid(NdArray::NdArray<double>) : typeid(std::vector<double>));
+  }
+  auto              column_info = std::make_shared<Table::ColumnInfo>(info_list);
+  std::size_t       pdf_size    = offsets.back();
+  Table::FitsWriter writer{output_file, true};
+  writer.setHduName("PP_PDF");
+
+  std::size_t total = m_source_ids.size();
+  for (std::size_t chunk = 0; chunk < total; chunk += m_chunk_size) {
+    if (is_cancelled && is_cancelled()) {
+      throw Elements::Exception() << "The computation of the physical parameter PDFs has been cancelled";
+    }
+    std::size_t         chunk_end     = std::min(chunk + m_chunk_size, total);
+    std::size_t         thread_number = getThreadNumber(thread_no, chunk_end - chunk, SOURCES_PER_THREAD);
+    std::vector<double> values((chunk_end - chunk) * pdf_size, 0.);
+    forEachBlock(chunk_end - chunk, thread_number, [&](std::size_t, std::size_t begin, std::size_t end) {
+      for (std::size_t source = begin; source < end; ++source) {
+        auto    samples = getSamples(m_source_ids[chunk + source]);
+        double* result  = values.data() + source * pdf_size;
+        for (std::size_t sample = 0; sample < samples.size(); ++sample) {
+          for (std::size_t pdf = 0; pdf < axes.size(); ++pdf) {
+            auto x_bin = findBin(samples.getValue(sample, axes[pdf].first), binnings[axes[pdf].first]);
+            if (x_bin < 0) {
+              continue;
+            }
+            if (axes[pdf].second < 0) {
+              result[offsets[pdf] + x_bin] += 1.;
+              continue;
+            }
+            const auto& y_binning = binnings[axes[pdf].second];
+            auto        y_bin     = findBin(samples.getValue(sample, axes[pdf].second), y_binning);
+            if (y_bin >= 0) {
+              result[offsets[pdf] + x_bin * y_binning.bins + y_bin] += 1.;
+            }
+          }
+        }
+        if (samples.size() > 0) {
+          for (std::size_t bin = 0; bin < pdf_size; ++bin) {
+            result[bin] /= static_cast<double>(samples.size());
+          }
+        }
+      }
+    });
+
+    std::vector<Table::Row> rows{};
+    for (std::size_t source = 0; source < chunk_end - chunk; ++source) {
+      std::vector<Table::Row::cell_type> cells{m_source_ids[chunk + source]};
+      const double*                      result = values.data() + source * pdf_size;
+      for (std::size_t pdf = 0; pdf < axes.size(); ++pdf) {
+        std::vector<double> pdf_values(result + offsets[pdf], result + offsets[pdf + 1]);
+        if (axes[pdf].second < 0) {
+          cells.emplace_back(std::move(pdf_values));
+        } else {
+          std::vector<std::size_t> shape{binnings[axes[pdf].first].bins, binnings[axes[pdf].second].bins};
+          cells.emplace_back(NdArray::NdArray<double>(shape, std::move(pdf_values)));
+        }
+      }
+      rows.emplace_back(std::move(cells), column_info);
+    }
+    writer.addData(Table::Table{rows});
+    if (progress) {
+      progress(chunk_end, total);
+    }
+  }
+
+  // One HDU per parameter with the centers of its bins
+  for (auto parameter : used_parameters) {
+    const auto& binning = binnings[parameter];
+    auto        info    = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("BINS", typeid(double), m_parameters[parameter].unit)});
+    std::vector<Table::Row> rows{};
+    double                  width = (binning.max - binning.min) / static_cast<double>(binning.bins);
+    for (std::size_t bin = 0; bin < binning.bins; ++bin) {
+      rows.emplace_back(std::vector<Table::Row::cell_type>{binning.min + (static_cast<double>(bin) + 0.5) * width},
+                        info);
+    }
+    Table::FitsWriter bins_writer{output_file};
+    bins_writer.setHduName("BINS_MC_PDF_" + boost::to_upper_copy(m_parameters[parameter].name));
+    bins_writer.addData(Table::Table{rows});
+  }
+  logger.info() << "Written the PDFs of " << total << " source(s) into " << output_file;
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
@@ -0,0 +1,145 @@
+/*
+ * ProgressReporter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include "PhzUITools/ProgressReporter.h"
+#include "PhzUITools/JsonString.h"
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Euclid {
+namespace PhzUITools {
+
+struct ProgressReporter::State {
+  Listener                    listener;
+  std::string                 unit;
+  std::string                 progress_file;
+  std::int64_t                interval_ns;
+  std::atomic<std::int64_t>   first_ns{-1};
+  std::atomic<std::int64_t>   next_report_ns{0};
+  std::mutex                  report_mutex{};
+  size_t                      last_step  = 0;
+  size_t                      last_total = 0;
+  bool                        finished   = false;
+};
+
+static std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ProgressReporter::ProgressReporter(Listener listener, std::string unit, std::string progress_file,
+                                   std::chrono::milliseconds interval)
+    : m_state{std::make_shared<State>()} {
+  m_state->listener      = std::move(listener);
+  m_state->unit          = std::move(unit);
+  m_state->progress_file = std::move(progress_file);
+  m_state->interval_ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+}
+
+void ProgressReporter::operator()(size_t step, size_t total) const {
+  auto now   = nowNs();
+  auto first = std::int64_t{-1};
+  m_state->first_ns.compare_exchange_strong(first, now);
+
+  bool done = step >= total;
+  if (!done) {
+    // Only the thread which moves the next report time forward reports
+    auto next = m_state->next_report_ns.load(std::memory_order_relaxed);
+    if (now < next || !m_state->next_report_ns.compare_exchange_strong(next, now + m_state->interval_ns)) {
+      return;
+    }
+  }
+  report(step, total, done);
+}
+
+void ProgressReporter::report(size_t step, size_t total, bool done) const {
+  std::lock_guard<std::mutex> lock(m_state->report_mutex);
+  if (m_state->finished || step < m_state->last_step) {
+    // The computation has already ended, or a more recent update has already
+    // been reported by another thread
+    return;
+  }
+  m_state->last_step  = step;
+  m_state->last_total = total;
+  m_state->finished   = done;
+
+  Status status{step, total, 0., 0., -1., done, m_state->unit};
+  status.elapsed = static_cast<double>(nowNs() - m_state->first_ns.load()) * 1e-9;
+  if (status.elapsed > 0 && step > 0) {
+    status.rate = static_cast<double>(step) / status.elapsed;
+    status.eta  = total > step ? static_cast<double>(total - step) / status.rate : 0.;
+  }
+
+  if (m_state->listener) {
+    m_state->listener(status);
+  }
+  if (!m_state->progress_file.empty()) {
+    writeProgressFile(status, done ? "done" : "running");
+  }
+}
+
+void ProgressReporter::markCancelled() const {
+  finish("cancelled");
+}
+
+void ProgressReporter::markFailed() const {
+  finish("failed");
+}
+
+void ProgressReporter::finish(const std::string& state) const {
+  std::lock_guard<std::mutex> lock(m_state->report_mutex);
+  if (m_state->finished) {
+    return;
+  }
+  m_state->finished = true;
+  if (m_state->progress_file.empty()) {
+    return;
+  }
+
+  // The last reported step, the computation may have stopped before the first notification
+  Status status{m_state->last_step, m_state->last_total, 0., 0., -1., false, m_state->unit};
+  auto   first = m_state->first_ns.load();
+  if (first >= 0) {
+    status.elapsed = static_cast<double>(nowNs() - first) * 1e-9;
+  }
+  writeProgressFile(status, state);
+}
+
+std::string ProgressReporter::describe(const Status& status) {
+  std::stringstream text;
+  text << std::setprecision(3) << status.rate << " " << status.unit << "/s";
+  if (status.done) {
+    text << ", done in " << std::setprecision(1) << std::fixed << status.elapsed << "s";
+  } else if (status.eta >= 0) {
+    auto seconds = static_cast<long>(std::round(status.eta));
+    text << ", ETA " << std::setfill('0') << std::setw(2) << seconds / 3600 << ":" << std::setw(2)
+         << (seconds / 60) % 60 << ":" << std::setw(2) << seconds % 60;
+  }
+  return text.str();
+}
+
+void ProgressReporter::writeProgressFile(const Status& status, const std::string& state) const {
+  // Write a temporary file then rename it, so that a reader never sees a partial
+  // document. The name is unique as several processes may share the file.
+  std::string tmp_file = m_state->progress_file + boost::filesystem::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+  {
+    std::ofstream out(tmp_file);
+    out << "{\"unit\": " << toJsonString(status.unit) << ", \"step\": " << status.step
+        << ", \"total\": " << status.total << ", \"fraction\": " << (status.total > 0 ? static_cast<double>(status.step) / status.total : 0.)
+        << ", \"elapsed\": " << status.elapsed << ", \"rate\": " << status.rate << ", \"eta\": " << status.eta
+        << ", \"state\": \"" << state << "\"}\n";
+  }
+  if (std::rename(tmp_file.c_str(), m_state->progress_file.c_str()) != 0) {
+    std::remove(tmp_file.c_str());
+  }
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
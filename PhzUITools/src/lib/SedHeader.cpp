@@ -0,0 +1,103 @@
+/*
+ * SedHeader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/SedHeader.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <cctype>
+#include <fstream>
+
+namespace Euclid {
+namespace PhzUITools {
+
+namespace {
+
+bool isWordChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isWord(const std::string& value) {
+  return std::all_of(value.begin(), value.end(), isWordChar);
+}
+
+// Parse the value of a "# PARAMETER : name = value [unit]" line, return false if malformed
+bool parseParameter(const std::string& value, std::string& name, std::string& unit) {
+  size_t pos = 0;
+  while (pos < value.size() && (isWordChar(value[pos]) || value[pos] == '-')) {
+    ++pos;
+  }
+  name = value.substr(0, pos);
+  while (pos < value.size() && std::isspace(static_cast<unsigned char>(value[pos]))) {
+    ++pos;
+  }
+  if (name.empty() || pos + 1 >= value.size() || value[pos] != '=') {
+    return false;
+  }
+
+  unit      = "";
+  auto open = value.rfind('[');
+  if (value.back() == ']' && open != std::string::npos && open > pos + 1) {
+    auto candidate = boost::trim_copy(value.substr(open + 1, value.size() - open - 2));
+    if (isWord(candidate)) {
+      unit = candidate;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+SedHeader parseSedHeader(std::istream& in) {
+  SedHeader   header{};
+  std::string line{};
+  bool        first_line = true;
+  while (std::getline(in, line)) {
+    auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+      continue;
+    }
+    if (line[first] != '#') {
+      // First data line: the header is over
+      break;
+    }
+
+    auto content = boost::trim_copy(line.substr(first + 1));
+    auto colon   = content.find(':');
+    if (colon == std::string::npos) {
+      if (first_line && !content.empty() && isWord(content)) {
+        header.first_line_name = content;
+      }
+    } else {
+      auto key   = boost::trim_copy(content.substr(0, colon));
+      auto value = boost::trim_copy(content.substr(colon + 1));
+      if (!key.empty() && !value.empty()) {
+        auto& values = header.keywords[key];
+        if (values.empty()) {
+          header.keyword_order.push_back(key);
+        }
+        values.push_back(value);
+        std::string name, unit;
+        if (key == "PARAMETER" && parseParameter(value, name, unit)) {
+          header.parameters.emplace(name, unit);
+        }
+      }
+    }
+    first_line = false;
+  }
+  return header;
+}
+
+SedHeader parseSedHeader(const std::string& file) {
+  std::ifstream in(file);
+  if (!in) {
+    throw Elements::Exception() << "File does not exist : " << file;
+  }
+  return parseSedHeader(in);
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
@@ -0,0 +1,187 @@
+/*
+ * SpecZComparisonEngine.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/SpecZComparisonEngine.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "Table/AsciiReader.h"
+#include "Table/FitsReader.h"
+#include <algorithm>
+#include <array>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Euclid {
+namespace PhzUITools {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SpecZComparisonEngine");
+
+namespace {
+
+// Convert the numerical cells into double, anything else into NaN
+class ToDoubleVisitor : public boost::static_visitor<double> {
+public:
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, double>::type operator()(const T& value) const {
+    return static_cast<double>(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value, double>::type operator()(const T&) const {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+};
+
+// Convert the ID cells into the join key, integral numbers being matched
+// whatever their type
+class ToKeyVisitor : public boost::static_visitor<std::string> {
+public:
+  std::string operator()(const std::string& value) const {
+    return boost::algorithm::trim_copy(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, std::string>::type operator()(const T& value) const {
+    return std::to_string(static_cast<long long>(value));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value, std::string>::type operator()(const T& value) const {
+    if (std::isfinite(value) && value == std::floor(value) && std::abs(value) < 9e18) {
+      return std::to_string(static_cast<long long>(value));
+    }
+    return std::to_string(value);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value, std::string>::type operator()(const T&) const {
+    throw Elements::Exception() << "Unsupported type for an ID column";
+  }
+};
+
+std::unique_ptr<Table::TableReader> createReader(const std::string& file_name) {
+  std::ifstream        in{file_name};
+  std::array<char, 10> header{};
+  in.read(header.data(), 9);
+  if (std::string{header.data()} == "SIMPLE  =") {
+    return std::unique_ptr<Table::TableReader>{new Table::FitsReader{file_name, 1}};
+  }
+  return std::unique_ptr<Table::TableReader>{new Table::AsciiReader{file_name}};
+}
+
+std::size_t getColumnIndex(const Table::ColumnInfo& column_info, const std::string& name, const std::string& file) {
+  auto index = column_info.find(name);
+  if (index == nullptr) {
+    throw Elements::Exception() << "The catalog " << file << " does not have column with name " << name;
+  }
+  return *index;
+}
+
+}  // namespace
+
+SpecZComparisonEngine::SpecZComparisonEngine(std::string specz_id_column, std::string specz_column,
+                                             std::string phz_id_column, std::string phz_column, std::size_t box_bins,
+                                             std::size_t chunk_size)
+    : m_specz_id_column{std::move(specz_id_column)}
+    , m_specz_column{std::move(specz_column)}
+    , m_phz_id_column{std::move(phz_id_column)}
+    , m_phz_column{std::move(phz_column)}
+    , m_box_bins{box_bins}
+    , m_chunk_size{std::max<std::size_t>(1, chunk_size)} {}
+
+SpecZComparisonMetrics SpecZComparisonEngine::compute(const std::string& specz_catalog,
+                                                      const std::string& phz_catalog, const std::string& pe_catalog,
+                                                      ProgressListener progress, CancellationCheck is_cancelled) const {
+  auto check_cancelled = [&is_cancelled]() {
+    if (is_cancelled && is_cancelled()) {
+      throw Elements::Exception() << "The spec-z comparison has been cancelled";
+    }
+  };
+  ToDoubleVisitor to_double{};
+  ToKeyVisitor    to_key{};
+
+  // Index the spec-z catalog
+  std::unordered_map<std::string, double> specz_index{};
+  double                                  specz_min  = std::numeric_limits<double>::infinity();
+  double                                  specz_max  = -std::numeric_limits<double>::infinity();
+  std::size_t                             duplicates = 0;
+  {
+    auto reader    = createReader(specz_catalog);
+    auto id_index  = getColumnIndex(reader->getInfo(), m_specz_id_column, specz_catalog);
+    auto z_index   = getColumnIndex(reader->getInfo(), m_specz_column, specz_catalog);
+    while (reader->hasMoreRows()) {
+      check_cancelled();
+      auto table = reader->read(m_chunk_size);
+      for (const auto& row : table) {
+        double specz = boost::apply_visitor(to_double, row[z_index]);
+        if (!specz_index.emplace(boost::apply_visitor(to_key, row[id_index]), specz).second) {
+          ++duplicates;
+        } else if (std::isfinite(specz)) {
+          specz_min = std::min(specz_min, specz);
+          specz_max = std::max(specz_max, specz);
+        }
+      }
+    }
+  }
+  if (duplicates > 0) {
+    logger.warn() << duplicates << " duplicated ID(s) in the spec-z catalog, only the first occurrence is used";
+  }
+  logger.info() << "Indexed " << specz_index.size() << " sources of the spec-z catalog " << specz_catalog;
+
+  SpecZComparisonMetrics metrics{specz_min, specz_max, std::isfinite(specz_min) ? m_box_bins : 0};
+
+  // Stream the photo-z catalog(s) and join on the ID
+  bool own_pe    = !pe_catalog.empty() && pe_catalog != phz_catalog;
+  auto reader    = createReader(phz_catalog);
+  auto id_index  = getColumnIndex(reader->getInfo(), m_phz_id_column, phz_catalog);
+  auto pe_reader = own_pe ? createReader(pe_catalog) : nullptr;
+  auto pe_index  = getColumnIndex(own_pe ? pe_reader->getInfo() : reader->getInfo(), m_phz_column,
+                                  own_pe ? pe_catalog : phz_catalog);
+
+  std::size_t total   = reader->rowsLeft();
+  std::size_t done    = 0;
+  std::size_t matched = 0;
+  while (reader->hasMoreRows()) {
+    check_cancelled();
+    auto                          table = reader->read(m_chunk_size);
+    std::unique_ptr<Table::Table> pe_chunk{};
+    if (own_pe) {
+      pe_chunk.reset(new Table::Table{pe_reader->read(table.size())});
+      if (pe_chunk->size() != table.size()) {
+        throw Elements::Exception() << "The point estimate catalog " << pe_catalog
+                                    << " has less rows than the Phosphoros catalog";
+      }
+    }
+    const auto& pe_table = own_pe ? *pe_chunk : table;
+    for (std::size_t row = 0; row < table.size(); ++row) {
+      auto specz = specz_index.find(boost::apply_visitor(to_key, table[row][id_index]));
+      if (specz != specz_index.end()) {
+        metrics.add(specz->second, boost::apply_visitor(to_double, pe_table[row][pe_index]));
+        ++matched;
+      }
+    }
+    done += table.size();
+    if (progress) {
+      progress(done, total);
+    }
+  }
+
+  if (matched == 0) {
+    throw Elements::Exception() << "No matching objects found between the SpecZ and the PhotoZ catalogs, "
+                                << "was the proper ID column chosen?";
+  }
+  logger.info() << "Matched " << matched << " sources out of " << done;
+  return metrics;
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
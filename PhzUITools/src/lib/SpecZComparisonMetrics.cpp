@@ -0,0 +1,96 @@
+/*
+ * SpecZComparisonMetrics.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/SpecZComparisonMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Euclid {
+namespace PhzUITools {
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+constexpr double SpecZComparisonMetrics::NMAD_FACTOR;
+
+void SpecZComparisonMetrics::Moments::add(double value) {
+  ++count;
+  double delta = value - mean;
+  mean += delta / static_cast<double>(count);
+  m2 += delta * (value - mean);
+}
+
+double SpecZComparisonMetrics::Moments::getMean() const {
+  return count > 0 ? mean : NaN;
+}
+
+double SpecZComparisonMetrics::Moments::getSigma() const {
+  return count > 0 ? std::sqrt(m2 / static_cast<double>(count)) : NaN;
+}
+
+SpecZComparisonMetrics::SpecZComparisonMetrics(double bin_min, double bin_max, std::size_t box_bins,
+                                               double outlier_limit)
+    : m_bin_min{bin_min}, m_bin_max{bin_max}, m_outlier_limit{outlier_limit}, m_bins(box_bins) {}
+
+void SpecZComparisonMetrics::add(double specz, double photoz) {
+  if (!std::isfinite(specz) || !std::isfinite(photoz)) {
+    return;
+  }
+  double dz      = (photoz - specz) / (1. + specz);
+  bool   outlier = std::abs(dz) > m_outlier_limit;
+  m_all.add(dz);
+  if (!outlier) {
+    m_no_outliers.add(dz);
+  }
+  m_digest.add(dz);
+
+  if (!m_bins.empty() && specz >= m_bin_min && specz <= m_bin_max && m_bin_max > m_bin_min) {
+    auto  index = static_cast<std::size_t>((specz - m_bin_min) / (m_bin_max - m_bin_min) * m_bins.size());
+    auto& bin   = m_bins[std::min(index, m_bins.size() - 1)];
+    bin.digest.add(dz);
+    if (outlier) {
+      ++bin.outliers;
+    }
+  }
+}
+
+SpecZComparisonMetrics::Summary SpecZComparisonMetrics::getSummary() const {
+  Summary summary{};
+  summary.count             = m_all.count;
+  summary.mean              = m_all.getMean();
+  summary.median            = m_digest.quantile(0.5);
+  summary.sigma             = m_all.getSigma();
+  summary.mad               = m_digest.medianAbsoluteDeviation(summary.median);
+  summary.nmad              = NMAD_FACTOR * summary.mad;
+  summary.outliers_percent  = m_all.count > 0 ? 100. * (m_all.count - m_no_outliers.count) / m_all.count : NaN;
+  summary.mean_no_outliers  = m_no_outliers.getMean();
+  summary.sigma_no_outliers = m_no_outliers.getSigma();
+  return summary;
+}
+
+std::vector<SpecZComparisonMetrics::BoxStatistics> SpecZComparisonMetrics::getBoxStatistics() const {
+  std::vector<BoxStatistics> result{};
+  double width = (m_bin_max - m_bin_min) / static_cast<double>(std::max<std::size_t>(1, m_bins.size()));
+  for (std::size_t index = 0; index < m_bins.size(); ++index) {
+    const auto&   bin = m_bins[index];
+    BoxStatistics box{};
+    box.bin_min          = m_bin_min + width * static_cast<double>(index);
+    box.bin_max          = m_bin_min + width * static_cast<double>(index + 1);
+    box.count            = static_cast<std::size_t>(bin.digest.getCount());
+    box.first_quartile   = bin.digest.quantile(0.25);
+    box.median           = bin.digest.quantile(0.5);
+    box.third_quartile   = bin.digest.quantile(0.75);
+    double fence         = 1.5 * (box.third_quartile - box.first_quartile);
+    box.lower_whisker    = box.count > 0 ? std::max(bin.digest.getMin(), box.first_quartile - fence) : NaN;
+    box.upper_whisker    = box.count > 0 ? std::min(bin.digest.getMax(), box.third_quartile + fence) : NaN;
+    box.outliers_percent = box.count > 0 ? 100. * static_cast<double>(bin.outliers) / box.count : NaN;
+    result.push_back(box);
+  }
+  return result;
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
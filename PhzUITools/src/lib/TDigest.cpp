@@ -0,0 +1,174 @@
+/*
+ * TDigest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PhzUITools/TDigest.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Euclid {
+namespace PhzUITools {
+
+static const double PI = std::acos(-1.);
+
+TDigest::TDigest(double compression)
+    : m_compression{std::max(20., compression)}
+    , m_min{std::numeric_limits<double>::infinity()}
+    , m_max{-std::numeric_limits<double>::infinity()} {}
+
+void TDigest::add(double value, double weight) {
+  if (!std::isfinite(value) || !(weight > 0)) {
+    return;
+  }
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_buffer.push_back({value, weight});
+  m_buffer_weight += weight;
+  if (m_buffer.size() >= 8 * static_cast<std::size_t>(m_compression)) {
+    flush();
+  }
+}
+
+void TDigest::merge(const TDigest& other) {
+  other.flush();
+  for (auto& centroid : other.m_centroids) {
+    m_buffer.push_back(centroid);
+    m_buffer_weight += centroid.weight;
+  }
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  flush();
+}
+
+void TDigest::flush() const {
+  if (m_buffer.empty()) {
+    return;
+  }
+  m_buffer.insert(m_buffer.end(), m_centroids.begin(), m_centroids.end());
+  std::sort(m_buffer.begin(), m_buffer.end(),
+            [](const Centroid& left, const Centroid& right) { return left.mean < right.mean; });
+  double total = 0.;
+  for (auto& centroid : m_buffer) {
+    total += centroid.weight;
+  }
+
+  // Scale function k1: the centroids are allowed to span one unit of
+  // k(q) = compression / (2 pi) * asin(2q - 1)
+  auto k_to_q = [this](double k) {
+    return (std::sin(std::min(PI / 2, k * 2 * PI / m_compression)) + 1.) / 2.;
+  };
+  auto q_to_k = [this](double q) {
+    return m_compression / (2 * PI) * std::asin(std::max(-1., std::min(1., 2 * q - 1)));
+  };
+
+  m_centroids.clear();
+  double so_far = 0.;
+  double limit  = total * k_to_q(q_to_k(0.) + 1.);
+  auto   current = m_buffer.front();
+  for (std::size_t index = 1; index < m_buffer.size(); ++index) {
+    const auto& next = m_buffer[index];
+    if (so_far + current.weight + next.weight <= limit) {
+      current.mean += (next.mean - current.mean) * next.weight / (current.weight + next.weight);
+      current.weight += next.weight;
+    } else {
+      so_far += current.weight;
+      m_centroids.push_back(current);
+      limit   = total * k_to_q(q_to_k(so_far / total) + 1.);
+      current = next;
+    }
+  }
+  m_centroids.push_back(current);
+  m_centroid_weight = total;
+  m_buffer.clear();
+  m_buffer_weight = 0.;
+}
+
+double TDigest::getCount() const {
+  return m_centroid_weight + m_buffer_weight;
+}
+
+double TDigest::quantile(double q) const {
+  flush();
+  if (m_centroids.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (m_centroids.size() == 1) {
+    return m_centroids.front().mean;
+  }
+  q            = std::max(0., std::min(1., q));
+  double index = q * m_centroid_weight;
+
+  // Each centroid weight is centered on its mean, the tails are interpolated
+  // up to the extreme values
+  const auto& first = m_centroids.front();
+  if (index < first.weight / 2) {
+    return m_min + (first.mean - m_min) * index / (first.weight / 2);
+  }
+  double so_far = first.weight / 2;
+  for (std::size_t i = 0; i + 1 < m_centroids.size(); ++i) {
+    const auto& left  = m_centroids[i];
+    const auto& right = m_centroids[i + 1];
+    double      step  = (left.weight + right.weight) / 2;
+    if (so_far + step > index) {
+      return left.mean + (right.mean - left.mean) * (index - so_far) / step;
+    }
+    so_far += step;
+  }
+  const auto& last = m_centroids.back();
+  double      tail = last.weight / 2;
+  return last.mean + (m_max - last.mean) * std::min(1., (index - so_far) / tail);
+}
+
+double TDigest::cdf(double x) const {
+  flush();
+  if (m_centroids.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (x < m_min) {
+    return 0.;
+  }
+  if (x >= m_max) {
+    return 1.;
+  }
+  const auto& first = m_centroids.front();
+  if (x < first.mean) {
+    return first.weight / 2 * (x - m_min) / (first.mean - m_min) / m_centroid_weight;
+  }
+  double so_far = first.weight / 2;
+  for (std::size_t i = 0; i + 1 < m_centroids.size(); ++i) {
+    const auto& left  = m_centroids[i];
+    const auto& right = m_centroids[i + 1];
+    double      step  = (left.weight + right.weight) / 2;
+    if (x < right.mean) {
+      return (so_far + step * (x - left.mean) / (right.mean - left.mean)) / m_centroid_weight;
+    }
+    so_far += step;
+  }
+  const auto& last = m_centroids.back();
+  return (so_far + last.weight / 2 * (x - last.mean) / (m_max - last.mean)) / m_centroid_weight;
+}
+
+double TDigest::medianAbsoluteDeviation(double center) const {
+  if (getCount() == 0 || !std::isfinite(center)) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  // Bisection on the half width t of the interval around the center holding
+  // half of the values
+  double low  = 0.;
+  double high = std::max(m_max - center, center - m_min);
+  for (int iteration = 0; iteration < 100 && high - low > 1e-15 * std::max(1., high); ++iteration) {
+    double middle = (low + high) / 2;
+    if (cdf(center + middle) - cdf(center - middle) < 0.5) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return (low + high) / 2;
+}
+
+}  // namespace PhzUITools
+}  // namespace Euclid
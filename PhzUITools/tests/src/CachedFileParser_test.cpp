@@ -0,0 +1,186 @@
+/*
+ * CachedFileParser_test.cpp
+ */
+#include "PhzUITools/CachedFileParser.h"
+#include "ElementsKernel/Temporary.h"
+#include "XYDataset/AsciiParser.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace Euclid;
+using namespace Euclid::PhzUITools;
+
+// Parser counting the datasets it has been asked to read
+class CountingParser : public XYDataset::FileParser {
+public:
+  explicit CountingParser(int& count) : m_count(count) {}
+
+  std::string getName(const std::string& file) override {
+    return m_parser.getName(file);
+  }
+
+  std::string getParameter(const std::string& file, const std::string& key_word) override {
+    return m_parser.getParameter(file, key_word);
+  }
+
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const std::string& file) override {
+    ++m_count;
+    return m_parser.getDataset(file);
+  }
+
+  bool isParsable(const std::string& file) override {
+    return m_parser.isParsable(file);
+  }
+
+private:
+  int&                   m_count;
+  XYDataset::AsciiParser m_parser{};
+};
+
+struct CachedFileParser_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_file      = (m_top_dir.path() / "sed.txt").string();
+  std::string       m_cache_dir = (m_top_dir.path() / "cache").string();
+  int               m_count     = 0;
+
+  CachedFileParser_Fixture() {
+    writeFile("Sed", {{1000., 0.5}, {2000., 1.}});
+  }
+
+  void writeFile(const std::string& dataset_name, const std::vector<std::pair<double, double>>& values) {
+    std::ofstream out(m_file);
+    out << "# " << dataset_name << "\n";
+    for (auto& pair : values) {
+      out << pair.first << " " << pair.second << "\n";
+    }
+  }
+
+  CachedFileParser createParser() {
+    return CachedFileParser{std::unique_ptr<XYDataset::FileParser>{new CountingParser{m_count}}, m_cache_dir};
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(CachedFileParser_test)
+
+BOOST_FIXTURE_TEST_CASE(cache_test, CachedFileParser_Fixture) {
+  // GIVEN
+  auto parser = createParser();
+
+  // WHEN
+  BOOST_CHECK(parser.isParsable(m_file));
+  auto name    = parser.getName(m_file);
+  auto dataset = parser.getDataset(m_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(m_count, 1);
+  BOOST_CHECK(boost::filesystem::exists(parser.getCacheFile(m_file)));
+  BOOST_CHECK_EQUAL(name, "Sed");
+  BOOST_REQUIRE(dataset);
+  BOOST_CHECK_EQUAL(dataset->size(), 2);
+  BOOST_CHECK_EQUAL(dataset->front().first, 1000.);
+  BOOST_CHECK_EQUAL(dataset->back().second, 1.);
+}
+
+BOOST_FIXTURE_TEST_CASE(persistence_test, CachedFileParser_Fixture) {
+  // GIVEN
+  createParser().getDataset(m_file);
+  m_count = 0;
+
+  // WHEN
+  auto parser  = createParser();
+  auto name    = parser.getName(m_file);
+  auto dataset = parser.getDataset(m_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(m_count, 0);
+  BOOST_CHECK_EQUAL(name, "Sed");
+  BOOST_REQUIRE(dataset);
+  BOOST_CHECK_EQUAL(dataset->size(), 2);
+  BOOST_CHECK_EQUAL(dataset->back().first, 2000.);
+}
+
+BOOST_FIXTURE_TEST_CASE(modified_file_test, CachedFileParser_Fixture) {
+  // GIVEN
+  createParser().getDataset(m_file);
+  writeFile("Renamed", {{1000., 0.5}, {1500., 0.75}, {2000., 1.}});
+  m_count = 0;
+
+  // WHEN
+  auto parser  = createParser();
+  auto name    = parser.getName(m_file);
+  auto dataset = parser.getDataset(m_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(m_count, 1);
+  BOOST_CHECK_EQUAL(name, "Renamed");
+  BOOST_REQUIRE(dataset);
+  BOOST_CHECK_EQUAL(dataset->size(), 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(not_parsable_test, CachedFileParser_Fixture) {
+  // GIVEN
+  std::ofstream{m_file} << "not a dataset\n";
+  createParser().isParsable(m_file);
+  m_count = 0;
+
+  // WHEN
+  auto parser = createParser();
+
+  // THEN
+  BOOST_CHECK(!parser.isParsable(m_file));
+  BOOST_CHECK_EQUAL(m_count, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(corrupted_cache_test, CachedFileParser_Fixture) {
+  // GIVEN
+  auto parser = createParser();
+  parser.getDataset(m_file);
+  std::ofstream(parser.getCacheFile(m_file), std::ios::binary | std::ios::trunc) << "garbage";
+  m_count = 0;
+
+  // WHEN
+  auto dataset = parser.getDataset(m_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(m_count, 1);
+  BOOST_REQUIRE(dataset);
+  BOOST_CHECK_EQUAL(dataset->size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(name_only_test, CachedFileParser_Fixture) {
+  // GIVEN
+  auto parser = createParser();
+
+  // WHEN
+  auto name = parser.getName(m_file);
+
+  // THEN
+  BOOST_CHECK_EQUAL(name, "Sed");
+  BOOST_CHECK_EQUAL(m_count, 0);
+  BOOST_CHECK(!boost::filesystem::exists(parser.getCacheFile(m_file)));
+}
+
+BOOST_FIXTURE_TEST_CASE(evict_stale_test, CachedFileParser_Fixture) {
+  // GIVEN
+  auto kept_file    = (m_top_dir.path() / "kept.txt").string();
+  auto renamed_file = (m_top_dir.path() / "renamed.txt").string();
+  boost::filesystem::copy_file(m_file, kept_file);
+  auto parser = createParser();
+  parser.getDataset(m_file);
+  parser.getDataset(kept_file);
+  boost::filesystem::rename(m_file, renamed_file);
+  std::ofstream((m_top_dir.path() / "cache" / "other.txt").string()) << "not a cache file\n";
+
+  // WHEN
+  auto removed = CachedFileParser::evictStale(m_cache_dir);
+
+  // THEN
+  BOOST_CHECK_EQUAL(removed, 1);
+  BOOST_CHECK(!boost::filesystem::exists(parser.getCacheFile(m_file)));
+  BOOST_CHECK(boost::filesystem::exists(parser.getCacheFile(kept_file)));
+  BOOST_CHECK(boost::filesystem::exists(m_top_dir.path() / "cache" / "other.txt"));
+  BOOST_CHECK_EQUAL(CachedFileParser::evictStale((m_top_dir.path() / "missing").string()), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/*
+ * CancellationToken_test.cpp
+ */
+#include "PhzUITools/CancellationToken.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzUtils/Multithreading.h"
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PhzUITools;
+
+BOOST_AUTO_TEST_SUITE(CancellationToken_test)
+
+BOOST_AUTO_TEST_CASE(perJob_test) {
+  // GIVEN
+  CancellationToken first{};
+  CancellationToken second{};
+
+  // WHEN
+  first.cancel();
+
+  // THEN
+  BOOST_CHECK_EQUAL(CancellationToken::getRunningJobCount(), 2);
+  BOOST_CHECK(first.isCancelled());
+  BOOST_CHECK(!second.isCancelled());
+  BOOST_CHECK_THROW(first.throwIfCancelled(), Elements::Exception);
+  BOOST_CHECK_NO_THROW(second.throwIfCancelled());
+  // The other job is not interrupted
+  BOOST_CHECK(!PhzUtils::getStopThreadsFlag());
+}
+
+BOOST_AUTO_TEST_CASE(stopFlag_test) {
+  // GIVEN
+  auto first = std::make_shared<CancellationToken>();
+
+  // WHEN
+  first->cancel();
+
+  // THEN
+  BOOST_CHECK(PhzUtils::getStopThreadsFlag());
+  {
+    // A new job does not resume the one being interrupted
+    CancellationToken second{};
+    BOOST_CHECK(PhzUtils::getStopThreadsFlag());
+    first.reset();
+    BOOST_CHECK(!PhzUtils::getStopThreadsFlag());
+  }
+  BOOST_CHECK_EQUAL(CancellationToken::getRunningJobCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(canStart_test) {
+  // GIVEN
+  auto              interrupted = std::make_shared<CancellationToken>();
+  CancellationToken job{};
+  CancellationToken cancelled_job{};
+  interrupted->cancel();
+  cancelled_job.cancel();
+
+  // THEN
+  // A job is still running, the cancelled ones are not interrupted
+  BOOST_CHECK(!PhzUtils::getStopThreadsFlag());
+  BOOST_CHECK(job.canStart());
+}
+
+BOOST_AUTO_TEST_CASE(canStartInterrupted_test) {
+  // GIVEN
+  auto interrupted = std::make_shared<CancellationToken>();
+  interrupted->cancel();
+  CancellationToken job{};
+
+  // THEN
+  BOOST_CHECK(PhzUtils::getStopThreadsFlag());
+  BOOST_CHECK(!job.canStart());
+
+  // WHEN
+  interrupted.reset();
+
+  // THEN
+  BOOST_CHECK(job.canStart());
+  BOOST_CHECK(!PhzUtils::getStopThreadsFlag());
+}
+
+BOOST_AUTO_TEST_CASE(canStartCancelled_test) {
+  // GIVEN
+  auto interrupted = std::make_shared<CancellationToken>();
+  interrupted->cancel();
+  CancellationToken job{};
+
+  // WHEN
+  job.cancel();
+
+  // THEN
+  // The cancelled job can start, to end at once, without resuming the other one
+  BOOST_CHECK(job.canStart());
+  interrupted.reset();
+  BOOST_CHECK(PhzUtils::getStopThreadsFlag());
+}
+
+BOOST_AUTO_TEST_CASE(concurrentJobs_test) {
+  // GIVEN
+  std::vector<std::thread> threads{};
+  std::atomic<int>         cancelled_seen{0};
+
+  // WHEN
+  for (int index = 0; index < 8; ++index) {
+    threads.emplace_back([index, &cancelled_seen]() {
+      for (int job_no = 0; job_no < 200; ++job_no) {
+        CancellationToken job{};
+        if ((index + job_no) % 2 == 0) {
+          job.cancel();
+        } else {
+          while (!job.canStart()) {
+            std::this_thread::yield();
+          }
+        }
+        try {
+          job.throwIfCancelled();
+        } catch (const Elements::Exception&) {
+          ++cancelled_seen;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // THEN
+  BOOST_CHECK_EQUAL(cancelled_seen.load(), 800);
+  BOOST_CHECK_EQUAL(CancellationToken::getRunningJobCount(), 0);
+  BOOST_CHECK(!PhzUtils::getStopThreadsFlag());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
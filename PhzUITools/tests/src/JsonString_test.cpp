@@ -0,0 +1,25 @@
+/*
+ * JsonString_test.cpp
+ */
+#include "PhzUITools/JsonString.h"
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using namespace Euclid::PhzUITools;
+
+BOOST_AUTO_TEST_SUITE(JsonString_test)
+
+BOOST_AUTO_TEST_CASE(plain_test) {
+  BOOST_CHECK_EQUAL(toJsonString(""), "\"\"");
+  BOOST_CHECK_EQUAL(toJsonString("SEDs repository"), "\"SEDs repository\"");
+}
+
+BOOST_AUTO_TEST_CASE(escape_test) {
+  BOOST_CHECK_EQUAL(toJsonString("a \"b\""), "\"a \\\"b\\\"\"");
+  BOOST_CHECK_EQUAL(toJsonString("C:\\dir"), "\"C:\\\\dir\"");
+  BOOST_CHECK_EQUAL(toJsonString("line\nnext\ttab\r"), "\"line\\nnext\\ttab\\r\"");
+  BOOST_CHECK_EQUAL(toJsonString(std::string("\x01", 1)), "\"\\u0001\"");
+  BOOST_CHECK_EQUAL(toJsonString("\xc3\xa9"), "\"\xc3\xa9\"");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+/*
+ * ParallelFor_test.cpp
+ */
+#include "PhzUITools/ParallelFor.h"
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace Euclid::PhzUITools;
+
+BOOST_AUTO_TEST_SUITE(ParallelFor_test)
+
+BOOST_AUTO_TEST_CASE(thread_number_test) {
+  BOOST_CHECK_EQUAL(getThreadNumber(4, 100), 4);
+  BOOST_CHECK_EQUAL(getThreadNumber(4, 2), 2);
+  BOOST_CHECK_EQUAL(getThreadNumber(4, 0), 1);
+  BOOST_CHECK_EQUAL(getThreadNumber(8, 1000, 256), 3);
+  BOOST_CHECK_GE(getThreadNumber(0, 100), 1);
+}
+
+BOOST_AUTO_TEST_CASE(for_each_block_test) {
+  // GIVEN
+  std::vector<int>         visits(1001, 0);
+  std::vector<std::size_t> block_threads(4, 99);
+
+  // WHEN
+  forEachBlock(visits.size(), 4, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+    block_threads[thread] = thread;
+    for (std::size_t index = begin; index < end; ++index) {
+      ++visits[index];
+    }
+  });
+
+  // THEN
+  for (auto visit : visits) {
+    BOOST_CHECK_EQUAL(visit, 1);
+  }
+  for (std::size_t thread = 0; thread < block_threads.size(); ++thread) {
+    BOOST_CHECK_EQUAL(block_threads[thread], thread);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(for_each_block_empty_test) {
+  int calls = 0;
+  forEachBlock(0, 4, [&](std::size_t, std::size_t begin, std::size_t end) {
+    ++calls;
+    BOOST_CHECK_EQUAL(begin, end);
+  });
+  BOOST_CHECK_EQUAL(calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(for_each_index_test) {
+  // GIVEN
+  std::vector<std::atomic<int>> visits(500);
+
+  // WHEN
+  forEachIndex(visits.size(), 3, [&](std::size_t index) { ++visits[index]; });
+
+  // THEN
+  for (auto& visit : visits) {
+    BOOST_CHECK_EQUAL(visit.load(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+  std::atomic<int> calls{0};
+  BOOST_CHECK_THROW(forEachIndex(1000, 1,
+                                 [&](std::size_t index) {
+                                   ++calls;
+                                   if (index == 10) {
+                                     throw std::runtime_error("failure");
+                                   }
+                                 }),
+                    std::runtime_error);
+  BOOST_CHECK_EQUAL(calls.load(), 11);
+  BOOST_CHECK_THROW(forEachBlock(1000, 4,
+                                 [](std::size_t thread, std::size_t, std::size_t) {
+                                   if (thread == 2) {
+                                     throw std::runtime_error("failure");
+                                   }
+                                 }),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+/*
+ * PosteriorSampleIndex_test.cpp
+ */
+#include "PhzUITools/PosteriorSampleIndex.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"  // for TempDir
+#include "NdArray/NdArray.h"
+#include "PhzUITools/MappedFitsTable.h"
+#include "Table/FitsReader.h"
+#include "Table/FitsWriter.h"
+#include "Table/Table.h"
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PhzUITools;
+
+struct PosteriorSampleIndex_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_folder = m_top_dir.path().string();
+
+  // (ID, SED index, Z, mass) per sample
+  typedef std::tuple<std::int64_t, std::int32_t, double, float> Sample;
+
+  PosteriorSampleIndex_Fixture() {
+    writeIndex({{1, "Sample_File_1.fits"}, {2, "Sample_File_1.fits"}, {3, "Sample_File_2.fits"},
+                {4, "Sample_File_2.fits"}});
+    writeSamples("Sample_File_1.fits", {Sample{1, 0, 0.5, 10.f}, Sample{1, 1, 1.5, 11.f}, Sample{1, 2, 1.7, 9.f},
+                                        Sample{2, 0, 0.1, 8.f}, Sample{2, 3, 0.2, 8.5f}});
+    writeSamples("Sample_File_2.fits", {Sample{3, 1, 3.0, 12.f}});
+  }
+
+  void writeIndex(const std::vector<std::pair<std::int64_t, std::string>>& entries) {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("OBJECT_ID", typeid(std::int64_t)),
+        Table::ColumnInfo::info_type("FILE_NAME", typeid(std::string))});
+    std::vector<Table::Row> rows{};
+    for (auto& entry : entries) {
+      rows.emplace_back(std::vector<Table::Row::cell_type>{entry.first, entry.second}, info);
+    }
+    Table::FitsWriter writer{m_folder + "/Index_File_posterior.fits", true};
+    writer.addData(Table::Table{rows});
+  }
+
+  void writeSamples(const std::string& name, const std::vector<Sample>& samples,
+                    const std::string& mass_column = "MASS") {
+    auto info = std::make_shared<Table::ColumnInfo>(std::vector<Table::ColumnInfo::info_type>{
+        Table::ColumnInfo::info_type("OBJECT_ID", typeid(std::int64_t)),
+        Table::ColumnInfo::info_type("SED_INDEX", typeid(std::int32_t)),
+        Table::ColumnInfo::info_type("Z", typeid(double)),
+        Table::ColumnInfo::info_type(mass_column, typeid(float), "solMass")});
+    std::vector<Table::Row> rows{};
+    for (auto& sample : samples) {
+      rows.emplace_back(std::vector<Table::Row::cell_type>{std::get<0>(sample), std::get<1>(sample),
+                                                           std::get<2>(sample), std::get<3>(sample)},
+                        info);
+    }
+    Table::FitsWriter writer{m_folder + "/" + name, true};
+    writer.addData(Table::Table{rows});
+  }
+};
+
+// Starts a test suite and name it.
+BOOST_AUTO_TEST_SUITE(PosteriorSampleIndex_test)
+
+BOOST_FIXTURE_TEST_CASE(mappedTable_test, PosteriorSampleIndex_Fixture) {
+  // WHEN
+  MappedFitsTable table{m_folder + "/Sample_File_1.fits"};
+  MappedFitsTable index{m_folder + "/Index_File_posterior.fits"};
+
+  // THEN
+  BOOST_CHECK_EQUAL(table.getRowNumber(), 5);
+  BOOST_CHECK_EQUAL(table.getColumns().size(), 4);
+  BOOST_CHECK_EQUAL(table.findColumn("UNKNOWN"), -1);
+  BOOST_CHECK_EQUAL(table.getColumns()[3].unit, "solMass");
+  BOOST_CHECK(!table.getColumns()[1].isFloatingPoint());
+  BOOST_CHECK(table.getColumns()[2].isFloatingPoint());
+  BOOST_CHECK_EQUAL(table.getInt64(3, table.getColumn("OBJECT_ID")), 2);
+  BOOST_CHECK_EQUAL(table.getInt64(4, table.getColumn("SED_INDEX")), 3);
+  BOOST_CHECK_EQUAL(table.getDouble(1, table.getColumn("Z")), 1.5);
+  BOOST_CHECK_EQUAL(table.getDouble(4, table.getColumn("MASS")), 8.5);
+  BOOST_CHECK_EQUAL(index.getString(2, index.getColumn("FILE_NAME")), "Sample_File_2.fits");
+  BOOST_CHECK_THROW(table.getColumn("UNKNOWN"), Elements::Exception);
+  BOOST_CHECK_THROW(MappedFitsTable(m_folder + "/Sample_File_1.fits", 0), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(samples_test, PosteriorSampleIndex_Fixture) {
+  // WHEN
+  PosteriorSampleIndex index{m_folder};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParameters().size(), 1);
+  BOOST_CHECK_EQUAL(index.getParameters()[0].name, "MASS");
+  BOOST_CHECK_EQUAL(index.getParameters()[0].unit, "solMass");
+  std::vector<std::int64_t> expected_ids{1, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(index.getSourceIds().begin(), index.getSourceIds().end(), expected_ids.begin(),
+                                expected_ids.end());
+
+  auto samples = index.getSamples(2);
+  BOOST_CHECK_EQUAL(samples.size(), 2);
+  BOOST_CHECK_EQUAL(samples.getValue(0, 0), 8.);
+  BOOST_CHECK_EQUAL(samples.getValue(1, 0), 8.5);
+  BOOST_CHECK_EQUAL(index.getSamples(3).getValue(0, 0), 12.);
+  BOOST_CHECK_EQUAL(index.getSamples(4).size(), 0);
+  BOOST_CHECK_EQUAL(index.getSamples(42).size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(redshift_test, PosteriorSampleIndex_Fixture) {
+  // WHEN
+  PosteriorSampleIndex index{m_folder, true};
+
+  // THEN
+  BOOST_CHECK_EQUAL(index.getParameters().size(), 2);
+  BOOST_CHECK_EQUAL(index.getParameters()[0].name, "MASS");
+  BOOST_CHECK_EQUAL(index.getParameters()[1].name, "Z");
+  auto samples = index.getSamples(2);
+  BOOST_CHECK_EQUAL(samples.getValue(1, 1), 0.2);
+  BOOST_CHECK_EQUAL(samples.getValue(0, 0), 8.);
+}
+
+BOOST_FIXTURE_TEST_CASE(columnNames_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  PosteriorSampleIndex::ColumnNames names{};
+  names.file_column = "FILE";
+
+  // THEN
+  BOOST_CHECK_THROW(PosteriorSampleIndex(m_folder, false, names), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(notConsecutive_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  writeSamples("Sample_File_2.fits", {Sample{3, 1, 3.0, 12.f}, Sample{1, 1, 3.0, 12.f}});
+
+  // THEN
+  BOOST_CHECK_THROW(PosteriorSampleIndex{m_folder}, Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(ranges_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  PosteriorSampleIndex index{m_folder, true, PosteriorSampleIndex::ColumnNames{}, 2};
+  std::size_t          last_done = 0;
+
+  // WHEN
+  auto ranges = index.computeRanges(2, [&last_done](std::size_t done, std::size_t) { last_done = done; });
+
+  // THEN
+  BOOST_CHECK_EQUAL(last_done, 3);
+  BOOST_CHECK_EQUAL(ranges[0].min, 8.);
+  BOOST_CHECK_EQUAL(ranges[0].max, 12.);
+  BOOST_CHECK_EQUAL(ranges[1].min, 0.1);
+  BOOST_CHECK_EQUAL(ranges[1].max, 3.0);
+}
+
+BOOST_FIXTURE_TEST_CASE(pdfs_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  PosteriorSampleIndex                             index{m_folder, true};
+  std::vector<PosteriorSampleIndex::Binning>       binnings{{8., 12., 2}, {0., 2., 2}};
+  std::vector<std::pair<std::string, std::string>> pdfs{{"Z", ""}, {"Z", "MASS"}};
+  std::string                                      output = m_folder + "/pp_pdf.fits";
+
+  // WHEN
+  index.computePdfs(binnings, pdfs, output);
+
+  // THEN
+  // The layout is the one read by PlotSpecZComparison.read_pp_pdf_catalog
+  auto table = Table::FitsReader{output, "PP_PDF"}.read();
+  BOOST_CHECK_EQUAL(table.size(), 3);
+  BOOST_CHECK_EQUAL(boost::get<std::int64_t>(table[1]["ID"]), 2);
+  auto z_pdf = boost::get<std::vector<double>>(table[0]["MC_Z"]);
+  BOOST_CHECK_EQUAL(z_pdf.size(), 2);
+  BOOST_CHECK_CLOSE(z_pdf[0], 1. / 3., 1e-8);
+  BOOST_CHECK_CLOSE(z_pdf[1], 2. / 3., 1e-8);
+  auto z_mass_pdf = boost::get<NdArray::NdArray<double>>(table[0]["MC_Z_MASS"]);
+  BOOST_CHECK_EQUAL(z_mass_pdf.shape().size(), 2);
+  BOOST_CHECK_EQUAL(z_mass_pdf.shape()[0], 2);
+  BOOST_CHECK_EQUAL(z_mass_pdf.shape()[1], 2);
+  // (Z bin, MASS bin)
+  BOOST_CHECK_SMALL(z_mass_pdf.at(0, 0), 1e-12);
+  BOOST_CHECK_CLOSE(z_mass_pdf.at(0, 1), 1. / 3., 1e-8);
+  BOOST_CHECK_CLOSE(z_mass_pdf.at(1, 0), 1. / 3., 1e-8);
+  BOOST_CHECK_CLOSE(z_mass_pdf.at(1, 1), 1. / 3., 1e-8);
+  // The sample out of the binning is dropped
+  auto last_pdf = boost::get<std::vector<double>>(table[2]["MC_Z"]);
+  BOOST_CHECK_EQUAL(last_pdf[0] + last_pdf[1], 0.);
+
+  auto z_bins = Table::FitsReader{output, "BINS_MC_PDF_Z"}.read();
+  BOOST_CHECK_EQUAL(z_bins.size(), 2);
+  BOOST_CHECK_CLOSE(boost::get<double>(z_bins[0]["BINS"]), 0.5, 1e-8);
+  BOOST_CHECK_CLOSE(boost::get<double>(z_bins[1]["BINS"]), 1.5, 1e-8);
+  auto mass_bins = Table::FitsReader{output, "BINS_MC_PDF_MASS"}.read();
+  BOOST_CHECK_EQUAL(mass_bins.getColumnInfo()->getDescription("BINS").unit, "solMass");
+  BOOST_CHECK_CLOSE(boost::get<double>(mass_bins[1]["BINS"]), 11., 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(invalidPdf_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  PosteriorSampleIndex                       index{m_folder, true};
+  std::vector<PosteriorSampleIndex::Binning> binnings{{8., 8., 2}, {0., 2., 2}};
+
+  // THEN
+  BOOST_CHECK_THROW(index.computePdfs(binnings, {{"AGE", ""}}, m_folder + "/pp_pdf.fits"), Elements::Exception);
+  BOOST_CHECK_THROW(index.computePdfs(binnings, {{"MASS", ""}}, m_folder + "/pp_pdf.fits"), Elements::Exception);
+  BOOST_CHECK_THROW(index.computePdfs({binnings[1]}, {{"Z", ""}}, m_folder + "/pp_pdf.fits"), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(separatorInName_test, PosteriorSampleIndex_Fixture) {
+  // GIVEN
+  writeSamples("Sample_File_1.fits", {Sample{1, 0, 0.5, 10.f}, Sample{2, 0, 0.1, 8.f}}, "STELLAR_MASS");
+  writeSamples("Sample_File_2.fits", {Sample{3, 1, 3.0, 12.f}}, "STELLAR_MASS");
+  PosteriorSampleIndex index{m_folder};
+
+  // THEN
+  // '_' separates the parameter names in the 2D PDF column names
+  BOOST_CHECK_THROW(index.computePdfs({{8., 12., 2}}, {{"STELLAR_MASS", ""}}, m_folder + "/pp_pdf.fits"),
+                    Elements::Exception);
+}
+
+// Ends the test suite
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+/*
+ * ProgressReporter_test.cpp
+ */
+#include "PhzUITools/ProgressReporter.h"
+#include "ElementsKernel/Temporary.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PhzUITools;
+
+struct ProgressReporter_Fixture {
+  std::vector<ProgressReporter::Status> m_updates{};
+
+  ProgressReporter::Listener listener() {
+    return [this](const ProgressReporter::Status& status) { m_updates.push_back(status); };
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(ProgressReporter_test)
+
+BOOST_FIXTURE_TEST_CASE(coalescing_test, ProgressReporter_Fixture) {
+  // GIVEN
+  ProgressReporter reporter{listener(), "models", "", std::chrono::hours(1)};
+
+  // WHEN
+  for (size_t step = 1; step <= 1000; ++step) {
+    reporter(step, 1000);
+  }
+
+  // THEN
+  BOOST_REQUIRE_EQUAL(m_updates.size(), 2);
+  BOOST_CHECK_EQUAL(m_updates.front().step, 1);
+  BOOST_CHECK(!m_updates.front().done);
+  BOOST_CHECK_EQUAL(m_updates.back().step, 1000);
+  BOOST_CHECK_EQUAL(m_updates.back().total, 1000);
+  BOOST_CHECK(m_updates.back().done);
+  BOOST_CHECK_EQUAL(m_updates.back().eta, 0.);
+  BOOST_CHECK_EQUAL(m_updates.back().unit, "models");
+}
+
+BOOST_FIXTURE_TEST_CASE(interval_test, ProgressReporter_Fixture) {
+  // GIVEN
+  ProgressReporter reporter{listener(), "models", "", std::chrono::milliseconds(0)};
+
+  // WHEN
+  for (size_t step = 1; step <= 5; ++step) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    reporter(step, 10);
+  }
+
+  // THEN
+  BOOST_REQUIRE_EQUAL(m_updates.size(), 5);
+  for (size_t index = 1; index < m_updates.size(); ++index) {
+    BOOST_CHECK_GT(m_updates[index].step, m_updates[index - 1].step);
+  }
+  BOOST_CHECK_GT(m_updates.back().rate, 0.);
+  BOOST_CHECK_GT(m_updates.back().eta, 0.);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test) {
+  // GIVEN
+  std::vector<size_t> steps{};
+  ProgressReporter    reporter{[&steps](const ProgressReporter::Status& status) { steps.push_back(status.step); },
+                            "sources", "", std::chrono::milliseconds(0)};
+
+  // WHEN
+  std::vector<std::thread> threads{};
+  for (size_t thread = 0; thread < 4; ++thread) {
+    threads.emplace_back([&reporter, thread]() {
+      for (size_t step = thread + 1; step <= 4000; step += 4) {
+        reporter(step, 4000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // THEN: the listener is never called concurrently and the steps never go back
+  BOOST_REQUIRE(!steps.empty());
+  BOOST_CHECK_EQUAL(steps.back(), 4000);
+  for (size_t index = 1; index < steps.size(); ++index) {
+    BOOST_CHECK_GE(steps[index], steps[index - 1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(describe_test) {
+  ProgressReporter::Status running{50, 100, 10., 5., 3723., false, "SEDs"};
+  BOOST_CHECK_EQUAL(ProgressReporter::describe(running), "5 SEDs/s, ETA 01:02:03");
+
+  ProgressReporter::Status done{100, 100, 12.34, 8.1, 0., true, "sources"};
+  BOOST_CHECK_EQUAL(ProgressReporter::describe(done), "8.1 sources/s, done in 12.3s");
+
+  ProgressReporter::Status unknown{0, 100, 0., 0., -1., false, "models"};
+  BOOST_CHECK_EQUAL(ProgressReporter::describe(unknown), "0 models/s");
+}
+
+BOOST_AUTO_TEST_CASE(progress_file_test) {
+  // GIVEN
+  Elements::TempDir top_dir{};
+  auto              file = (top_dir.path() / "progress.json").string();
+  ProgressReporter  reporter{nullptr, "\"quoted\" \\ units", file};
+
+  // WHEN
+  reporter(10, 10);
+
+  // THEN
+  std::ifstream     in(file);
+  std::stringstream content{};
+  content << in.rdbuf();
+  auto text = content.str();
+  BOOST_CHECK_EQUAL(text.find("{\"unit\": \"\\\"quoted\\\" \\\\ units\", \"step\": 10, \"total\": 10, \"fraction\": 1"),
+                    0);
+  BOOST_CHECK(text.find("\"state\": \"done\"}") != std::string::npos);
+  // Only the progress file is left, the temporary files have been renamed
+  auto files = std::distance(boost::filesystem::directory_iterator(top_dir.path()),
+                             boost::filesystem::directory_iterator());
+  BOOST_CHECK_EQUAL(files, 1);
+}
+
+BOOST_AUTO_TEST_CASE(terminal_state_test) {
+  // GIVEN
+  Elements::TempDir top_dir{};
+  auto              cancelled_file = (top_dir.path() / "cancelled.json").string();
+  auto              failed_file    = (top_dir.path() / "failed.json").string();
+  auto              done_file      = (top_dir.path() / "done.json").string();
+  ProgressReporter  cancelled{nullptr, "sources", cancelled_file, std::chrono::milliseconds(0)};
+  ProgressReporter  failed{nullptr, "sources", failed_file, std::chrono::milliseconds(0)};
+  ProgressReporter  done{nullptr, "sources", done_file, std::chrono::milliseconds(0)};
+
+  // WHEN
+  cancelled(3, 10);
+  cancelled.markCancelled();
+  cancelled(4, 10);
+  failed.markFailed();
+  done(10, 10);
+  done.markFailed();
+
+  // THEN
+  auto read = [](const std::string& file) {
+    std::ifstream     in(file);
+    std::stringstream content{};
+    content << in.rdbuf();
+    return content.str();
+  };
+  auto cancelled_text = read(cancelled_file);
+  BOOST_CHECK(cancelled_text.find("\"step\": 3, \"total\": 10") != std::string::npos);
+  BOOST_CHECK(cancelled_text.find("\"state\": \"cancelled\"}") != std::string::npos);
+  auto failed_text = read(failed_file);
+  BOOST_CHECK(failed_text.find("\"step\": 0, \"total\": 0") != std::string::npos);
+  BOOST_CHECK(failed_text.find("\"state\": \"failed\"}") != std::string::npos);
+  BOOST_CHECK(read(done_file).find("\"state\": \"done\"}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
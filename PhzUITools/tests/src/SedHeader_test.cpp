@@ -0,0 +1,45 @@
+/*
+ * SedHeader_test.cpp
+ */
+#include "PhzUITools/SedHeader.h"
+#include "ElementsKernel/Exception.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+using namespace Euclid::PhzUITools;
+
+BOOST_AUTO_TEST_SUITE(SedHeader_test)
+
+BOOST_AUTO_TEST_CASE(parse_test) {
+  // GIVEN
+  std::istringstream in{"# SedName\n"
+                        "#  ZKEY : last\n"
+                        "# PARAMETER : AGE = 1.5 * L [ Gyr ]\n"
+                        "# PARAMETER : BROKEN\n"
+                        "# ZKEY : again\n"
+                        "# Wave Flux\n"
+                        "\n"
+                        "1000.0 1.0E-3\n"
+                        "# AFTER : data\n"};
+
+  // WHEN
+  auto header = parseSedHeader(in);
+
+  // THEN
+  BOOST_CHECK_EQUAL(header.first_line_name, "SedName");
+  BOOST_REQUIRE_EQUAL(header.keyword_order.size(), 2);
+  BOOST_CHECK_EQUAL(header.keyword_order[0], "ZKEY");
+  BOOST_CHECK_EQUAL(header.keyword_order[1], "PARAMETER");
+  BOOST_REQUIRE_EQUAL(header.keywords.at("ZKEY").size(), 2);
+  BOOST_CHECK_EQUAL(header.keywords.at("ZKEY")[1], "again");
+  BOOST_CHECK_EQUAL(header.keywords.at("PARAMETER").size(), 2);
+  BOOST_CHECK_EQUAL(header.parameters.size(), 1);
+  BOOST_CHECK_EQUAL(header.parameters.at("AGE"), "Gyr");
+  BOOST_CHECK(header.keywords.find("AFTER") == header.keywords.end());
+}
+
+BOOST_AUTO_TEST_CASE(missing_file_test) {
+  BOOST_CHECK_THROW(parseSedHeader(std::string{"/nonexistent/sed.txt"}), Elements::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+/*
+ * SpecZComparisonEngine_test.cpp
+ */
+#include "PhzUITools/SpecZComparisonEngine.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::PhzUITools;
+
+struct SpecZComparisonEngine_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_specz_file = (m_top_dir.path() / "specz.txt").string();
+  std::string       m_phz_file   = (m_top_dir.path() / "phz.txt").string();
+  std::string       m_pe_file    = (m_top_dir.path() / "pe.txt").string();
+
+  SpecZComparisonEngine_Fixture() {
+    // The spec-z IDs are integers, the duplicated ID 3 is only used once
+    std::ofstream(m_specz_file) << "# Column: ID long\n"
+                                << "# Column: ZSPEC double\n"
+                                << "1 0.5\n2 1.0\n3 1.5\n3 9.0\n4 2.0\n";
+    // The photo-z IDs are strings, ID 9 has no spec-z
+    std::ofstream(m_phz_file) << "# Column: ID string\n"
+                              << "# Column: Z double\n"
+                              << "3 1.5\n1 0.65\n9 1.0\n2 1.0\n";
+    // Row by row with the photo-z catalog
+    std::ofstream(m_pe_file) << "# Column: PE double\n"
+                             << "1.5\n0.5\n7.0\n1.4\n";
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(SpecZComparisonEngine_test)
+
+BOOST_FIXTURE_TEST_CASE(join_test, SpecZComparisonEngine_Fixture) {
+  // GIVEN
+  SpecZComparisonEngine                            engine{"ID", "ZSPEC", "ID", "Z", 2, 2};
+  std::vector<std::pair<std::size_t, std::size_t>> progress{};
+
+  // WHEN
+  auto metrics = engine.compute(m_specz_file, m_phz_file, "", [&progress](std::size_t done, std::size_t total) {
+    progress.emplace_back(done, total);
+  });
+
+  // THEN: dz = 0, 0.1 and 0 for the IDs 3, 1 and 2
+  auto summary = metrics.getSummary();
+  BOOST_CHECK_EQUAL(summary.count, 3);
+  BOOST_CHECK_CLOSE(summary.mean, 0.1 / 3, 1e-8);
+  BOOST_REQUIRE_EQUAL(progress.size(), 2);
+  BOOST_CHECK_EQUAL(progress.back().first, 4);
+  BOOST_CHECK_EQUAL(progress.back().second, 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(point_estimate_catalog_test, SpecZComparisonEngine_Fixture) {
+  // GIVEN
+  SpecZComparisonEngine engine{"ID", "ZSPEC", "ID", "PE", 2, 3};
+
+  // WHEN
+  auto summary = engine.compute(m_specz_file, m_phz_file, m_pe_file).getSummary();
+
+  // THEN: dz = 0, 0 and 0.2 for the IDs 3, 1 and 2
+  BOOST_CHECK_EQUAL(summary.count, 3);
+  BOOST_CHECK_CLOSE(summary.mean, 0.2 / 3, 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(error_test, SpecZComparisonEngine_Fixture) {
+  // Missing column
+  BOOST_CHECK_THROW((SpecZComparisonEngine{"ID", "ZSPEC", "OBJECT_ID", "Z"}.compute(m_specz_file, m_phz_file)),
+                    Elements::Exception);
+
+  // No common ID
+  std::ofstream(m_phz_file) << "# Column: ID string\n"
+                            << "# Column: Z double\n"
+                            << "7 1.5\n8 0.65\n";
+  BOOST_CHECK_THROW((SpecZComparisonEngine{"ID", "ZSPEC", "ID", "Z"}.compute(m_specz_file, m_phz_file)),
+                    Elements::Exception);
+
+  // Cancelled
+  SpecZComparisonEngine engine{"ID", "ZSPEC", "ID", "Z"};
+  BOOST_CHECK_THROW(engine.compute(m_specz_file, m_phz_file, "", {}, []() { return true; }), Elements::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+/*
+ * SpecZComparisonMetrics_test.cpp
+ */
+#include "PhzUITools/SpecZComparisonMetrics.h"
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <cmath>
+
+using namespace Euclid::PhzUITools;
+
+BOOST_AUTO_TEST_SUITE(SpecZComparisonMetrics_test)
+
+BOOST_AUTO_TEST_CASE(summary_test) {
+  // GIVEN: dz = -0.3, -0.05, 0, 0.05, 0.1
+  SpecZComparisonMetrics metrics{0., 2., 2};
+  metrics.add(0., -0.3);
+  metrics.add(1., 0.9);
+  metrics.add(0.5, 0.5);
+  metrics.add(1., 1.1);
+  metrics.add(1.5, 1.75);
+  metrics.add(NAN, 1.);
+
+  // WHEN
+  auto summary = metrics.getSummary();
+
+  // THEN
+  BOOST_CHECK_EQUAL(summary.count, 5);
+  BOOST_CHECK_CLOSE(summary.mean, -0.04, 1e-8);
+  BOOST_CHECK_SMALL(summary.median, 1e-12);
+  BOOST_CHECK_CLOSE(summary.sigma, std::sqrt((0.26 * 0.26 + 0.01 * 0.01 + 0.04 * 0.04 + 0.09 * 0.09 + 0.14 * 0.14) / 5),
+                    1e-8);
+  BOOST_CHECK_CLOSE(summary.outliers_percent, 20., 1e-8);
+  BOOST_CHECK_CLOSE(summary.mean_no_outliers, 0.025, 1e-8);
+  BOOST_CHECK_CLOSE(summary.nmad, SpecZComparisonMetrics::NMAD_FACTOR * summary.mad, 1e-8);
+  BOOST_CHECK_GT(summary.mad, 0.);
+}
+
+BOOST_AUTO_TEST_CASE(box_test) {
+  // GIVEN
+  SpecZComparisonMetrics metrics{0., 2., 2};
+  metrics.add(0., -0.3);
+  metrics.add(0.5, 0.5);
+  metrics.add(1.5, 1.75);
+  metrics.add(2., 2.3);
+
+  // WHEN
+  auto boxes = metrics.getBoxStatistics();
+
+  // THEN
+  BOOST_CHECK_EQUAL(boxes.size(), 2);
+  BOOST_CHECK_EQUAL(boxes[0].bin_min, 0.);
+  BOOST_CHECK_EQUAL(boxes[0].bin_max, 1.);
+  BOOST_CHECK_EQUAL(boxes[0].count, 2);
+  BOOST_CHECK_CLOSE(boxes[0].median, -0.15, 1e-8);
+  BOOST_CHECK_CLOSE(boxes[0].outliers_percent, 50., 1e-8);
+  BOOST_CHECK_EQUAL(boxes[1].count, 2);
+  BOOST_CHECK_CLOSE(boxes[1].median, 0.1, 1e-8);
+  BOOST_CHECK_LE(boxes[1].lower_whisker, boxes[1].first_quartile);
+  BOOST_CHECK_GE(boxes[1].upper_whisker, boxes[1].third_quartile);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+/*
+ * TDigest_test.cpp
+ */
+#include "PhzUITools/TDigest.h"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>  // Gives access to the unit test framework.
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Euclid::PhzUITools;
+
+// Quantile with the numpy (linear) interpolation
+static double exactQuantile(std::vector<double> values, double q) {
+  std::sort(values.begin(), values.end());
+  double position = q * (values.size() - 1);
+  auto   index    = static_cast<std::size_t>(position);
+  if (index + 1 >= values.size()) {
+    return values.back();
+  }
+  return values[index] + (values[index + 1] - values[index]) * (position - index);
+}
+
+BOOST_AUTO_TEST_SUITE(TDigest_test)
+
+BOOST_AUTO_TEST_CASE(empty_test) {
+  TDigest digest{};
+  BOOST_CHECK(std::isnan(digest.quantile(0.5)));
+  BOOST_CHECK_EQUAL(digest.getCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(small_median_test) {
+  // Every value is its own centroid: the median is exact
+  TDigest odd{};
+  for (double value : {5., 1., 3.}) {
+    odd.add(value);
+  }
+  BOOST_CHECK_EQUAL(odd.quantile(0.5), 3.);
+  BOOST_CHECK_EQUAL(odd.quantile(0.), 1.);
+  BOOST_CHECK_EQUAL(odd.quantile(1.), 5.);
+
+  TDigest even{};
+  for (double value : {4., 1., 3., 2.}) {
+    even.add(value);
+  }
+  BOOST_CHECK_EQUAL(even.quantile(0.5), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(non_finite_test) {
+  TDigest digest{};
+  digest.add(1.);
+  digest.add(std::nan(""));
+  digest.add(INFINITY);
+  BOOST_CHECK_EQUAL(digest.getCount(), 1);
+  BOOST_CHECK_EQUAL(digest.quantile(0.5), 1.);
+}
+
+BOOST_AUTO_TEST_CASE(large_test) {
+  // GIVEN
+  std::mt19937               generator{1};
+  std::normal_distribution<> normal{0.1, 2.};
+  std::vector<double>        values{};
+  TDigest                    digest{};
+  TDigest                    first_half{};
+  TDigest                    second_half{};
+  for (int i = 0; i < 200000; ++i) {
+    values.push_back(normal(generator));
+    digest.add(values.back());
+    (i % 2 == 0 ? first_half : second_half).add(values.back());
+  }
+  first_half.merge(second_half);
+
+  // THEN
+  BOOST_CHECK_EQUAL(digest.getCount(), values.size());
+  for (double q : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+    double exact = exactQuantile(values, q);
+    BOOST_CHECK_SMALL(digest.quantile(q) - exact, 0.02);
+    BOOST_CHECK_SMALL(first_half.quantile(q) - exact, 0.02);
+    BOOST_CHECK_SMALL(digest.cdf(exact) - q, 0.002);
+  }
+  BOOST_CHECK_EQUAL(digest.getMin(), *std::min_element(values.begin(), values.end()));
+  BOOST_CHECK_EQUAL(digest.getMax(), *std::max_element(values.begin(), values.end()));
+
+  // The MAD of a normal distribution is 0.6745 sigma
+  BOOST_CHECK_CLOSE(digest.medianAbsoluteDeviation(0.1), 0.6745 * 2., 1.);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file SEDInterpolation/LruCache.h
+ * @date 10/19/26
+ */
+
+#ifndef _SEDINTERPOLATION_LRUCACHE_H
+#define _SEDINTERPOLATION_LRUCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+/**
+ * @class LruCache
+ *
+ * @brief Map keeping at most a given number of values, the least recently used
+ * value being dropped first.
+ *
+ * @details
+ * The values are held by shared pointers, so that a value dropped from the
+ * cache stays valid for the callers still using it. The cache is not thread
+ * safe.
+ */
+template <typename Key, typename Value>
+class LruCache {
+
+public:
+  explicit LruCache(std::size_t capacity) : m_capacity{capacity} {}
+
+  /**
+   * @brief Get the value of the key, or nullptr if it is not cached.
+   */
+  std::shared_ptr<const Value> get(const Key& key) {
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+      return nullptr;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return found->second->second;
+  }
+
+  /**
+   * @brief Add (or replace) the value of the key.
+   */
+  void put(const Key& key, std::shared_ptr<const Value> value) {
+    if (m_capacity == 0) {
+      return;
+    }
+    auto found = m_index.find(key);
+    if (found != m_index.end()) {
+      found->second->second = std::move(value);
+      m_entries.splice(m_entries.begin(), m_entries, found->second);
+      return;
+    }
+    m_entries.emplace_front(key, std::move(value));
+    m_index[key] = m_entries.begin();
+    if (m_entries.size() > m_capacity) {
+      m_index.erase(m_entries.back().first);
+      m_entries.pop_back();
+    }
+  }
+
+  std::size_t size() const {
+    return m_entries.size();
+  }
+
+  void clear() {
+    m_index.clear();
+    m_entries.clear();
+  }
+
+private:
+  typedef std::list<std::pair<Key, std::shared_ptr<const Value>>> EntryList;
+
+  std::size_t                                 m_capacity;
+  EntryList                                   m_entries{};
+  std::map<Key, typename EntryList::iterator> m_index{};
+};
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file SEDInterpolation/SedInterpolationEngine.h
+ * @date 10/19/26
+ */
+
+#ifndef _SEDINTERPOLATION_SEDINTERPOLATIONENGINE_H
+#define _SEDINTERPOLATION_SEDINTERPOLATIONENGINE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+/**
+ * @class SedInterpolationEngine
+ *
+ * @brief Write the SEDs interpolated between the successive SEDs of an
+ * ordered list into a directory.
+ *
+ * @details
+ * Each pair of successive SEDs is read and resampled once on its merged
+ * sampling (see SedPairInterpolator), then all the interpolants of all the
+ * pairs are computed and written by a pool of threads. The interpolated SEDs
+ * are named "<N-i>:<N+1>_<A>_+_<i+1>:<N+1>_<B>.sed" and the order.txt file of
+ * the output directory lists the SEDs in their order, the original ones
+ * included if they are copied.
+ */
+class SedInterpolationEngine {
+
+public:
+  /// Function called after each written SED with the number of written and total SEDs
+  typedef std::function<void(std::size_t done, std::size_t total)> ProgressListener;
+
+  /**
+   * @brief Constructor
+   *
+   * @param copy_seds
+   * If true the SEDs of the list are copied into the output directory
+   * @param interpolate_parameters
+   * If true the common physical parameters (PARAMETER keyword) of each pair
+   * of SEDs are interpolated too
+   * @param thread_number
+   * The number of threads, 0 meaning all the cores
+   */
+  SedInterpolationEngine(bool copy_seds = true, bool interpolate_parameters = true, std::size_t thread_number = 0);
+
+  /**
+   * @brief Compute and write the interpolated SEDs.
+   *
+   * @param sed_dir
+   * The directory the SED files are relative to
+   * @param seds
+   * The ordered list of the SED files, at least 2
+   * @param numbers
+   * The number of SEDs to interpolate between each pair of successive SEDs
+   * @param out_dir
+   * The output directory, created if needed and cleared if it exists
+   * @param progress
+   * Called after each written SED
+   *
+   * @return the number of interpolated SEDs written
+   * @throw Elements::Exception if the numbers do not match the SEDs or if a
+   * SED cannot be read or written
+   */
+  std::size_t run(const std::string& sed_dir, const std::vector<std::string>& seds,
+                  const std::vector<std::size_t>& numbers, const std::string& out_dir,
+                  ProgressListener progress = {}) const;
+
+  /**
+   * @brief Get the file names of the SEDs of the output directory in their
+   * order, as written in the order.txt file.
+   */
+  static std::vector<std::string> buildOrder(const std::vector<std::string>& seds,
+                                             const std::vector<std::size_t>& numbers, bool copy_seds);
+
+private:
+  bool        m_copy_seds;
+  bool        m_interpolate_parameters;
+  std::size_t m_thread_number;
+};
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file SEDInterpolation/SedPairInterpolator.h
+ * @date 10/19/26
+ */
+
+#ifndef _SEDINTERPOLATION_SEDPAIRINTERPOLATOR_H
+#define _SEDINTERPOLATION_SEDPAIRINTERPOLATOR_H
+
+#include "XYDataset/XYDataset.h"
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+/**
+ * @class SedPairInterpolator
+ *
+ * @brief Linear interpolation between two SEDs.
+ *
+ * @details
+ * The two SEDs are resampled once, at construction, on their merged sampling:
+ * the knots of the first SED below the common range, the densest of the two
+ * samplings over the common range and the knots of the last ending SED above
+ * it. Outside its own range a SED is zero. Each interpolant is then a weighted
+ * sum of the two resampled flux vectors.
+ *
+ * For N SEDs interpolated between A and B, the interpolant of index i (from 0)
+ * has the weights (N-i)/(N+1) for A and (i+1)/(N+1) for B.
+ *
+ * The interpolator is immutable and can be shared by several threads.
+ */
+class SedPairInterpolator {
+
+public:
+  SedPairInterpolator(const XYDataset::XYDataset& sed_1, const XYDataset::XYDataset& sed_2);
+
+  /**
+   * @brief Get the interpolant of index idx out of total.
+   */
+  XYDataset::XYDataset operator()(std::size_t idx, std::size_t total) const;
+
+  /// The merged sampling
+  const std::vector<double>& getWavelengths() const;
+
+  /// The flux of the interpolant of index idx out of total, on the merged sampling
+  std::vector<double> getFlux(std::size_t idx, std::size_t total) const;
+
+  /**
+   * @brief Build the name of an interpolant, like "2:3_A_+_1:3_B", from the
+   * names (or file names) of the two SEDs. No extension is appended.
+   */
+  static std::string buildName(const std::string& name_1, const std::string& name_2, std::size_t idx,
+                               std::size_t total);
+
+  /**
+   * @brief Strip the folders and the extension of a file name.
+   */
+  static std::string cleanName(const std::string& name);
+
+  /**
+   * @brief Interpolate the physical parameters common to the two SEDs.
+   *
+   * @details
+   * The parameters are given as "NAME=A*L+B[UNIT]" strings. Those with the
+   * same name and unit in both SEDs are interpolated with the weights of the
+   * interpolant, in the order of the first SED; the others are dropped.
+   */
+  static std::vector<std::string> interpolateParameters(const std::vector<std::string>& pp_1,
+                                                        const std::vector<std::string>& pp_2, std::size_t idx,
+                                                        std::size_t total);
+
+private:
+  std::vector<double> m_wavelengths{};
+  std::vector<double> m_flux_1{};
+  std::vector<double> m_flux_2{};
+};
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
+
+#endif
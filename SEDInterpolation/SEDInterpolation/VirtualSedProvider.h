@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file SEDInterpolation/VirtualSedProvider.h
+ * @date 10/19/26
+ */
+
+#ifndef _SEDINTERPOLATION_VIRTUALSEDPROVIDER_H
+#define _SEDINTERPOLATION_VIRTUALSEDPROVIDER_H
+
+#include "EmissionLines/EmissionLinesAdder.h"
+#include "SEDInterpolation/LruCache.h"
+#include "SEDInterpolation/SedPairInterpolator.h"
+#include "XYDataset/XYDatasetProvider.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+/**
+ * @class VirtualSedProvider
+ *
+ * @brief Provider serving, next to the SEDs of a base provider, SEDs derived
+ * from them which are computed on demand instead of being written to disk.
+ *
+ * @details
+ * Two kinds of derived SEDs can be registered:
+ *  - the SEDs of a group with emission lines added, served under a sibling
+ *    group (like the directories written by PhosphorosAddEmissionLines)
+ *  - the SEDs interpolated between successive SEDs of an ordered list, served
+ *    under a new group with the names used by InterpolateSED
+ *
+ * The derived datasets are computed at their first request and kept in a
+ * least recently used cache, as are the resampled SED pairs used by the
+ * interpolation, so that the cost of the base SEDs parsing is paid once per
+ * pair. The sources of the derived SEDs are resolved through the provider
+ * itself, so that they can be derived SEDs too (e.g. the emission lines of
+ * interpolated SEDs). The provider is thread safe as long as its base provider
+ * is only used through it.
+ */
+class VirtualSedProvider : public XYDataset::XYDatasetProvider {
+
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param base
+   * The provider of the SEDs from which the virtual ones are derived
+   * @param cache_size
+   * The maximum number of computed SEDs kept in memory
+   */
+  explicit VirtualSedProvider(std::shared_ptr<XYDataset::XYDatasetProvider> base, std::size_t cache_size = 1000);
+
+  /**
+   * @brief Serve all the SEDs of the base group (sub-groups included) with
+   * emission lines under the group named after it with the given suffix, e.g.
+   * "CWW/Ell" with "_el" gives "CWW/Ell_el".
+   *
+   * @return the names of the registered SEDs
+   * @throw Elements::Exception if a name is already used
+   */
+  std::vector<XYDataset::QualifiedName> addEmissionLines(const std::string& group, const std::string& suffix,
+                                                         std::shared_ptr<const EmissionLines::EmissionLinesAdder> adder);
+
+  /**
+   * @brief Serve in the given group the SEDs interpolated between the successive
+   * SEDs of the list.
+   *
+   * @param group
+   * The group of the interpolated SEDs
+   * @param seds
+   * The ordered list of the SEDs, at least 2
+   * @param numbers
+   * The number of SEDs to interpolate between each pair of successive SEDs
+   * @param copy_seds
+   * If true the SEDs of the list are also served in the group
+   * @param interpolate_parameters
+   * If true the common physical parameters of the SEDs (PARAMETER keyword) are
+   * interpolated too
+   *
+   * @return the names of the SEDs of the group in their order (the content of
+   * the order.txt file written by InterpolateSED)
+   * @throw Elements::Exception if the numbers do not match the SEDs or a name
+   * is already used
+   */
+  std::vector<XYDataset::QualifiedName> addInterpolation(const std::string&                           group,
+                                                         const std::vector<XYDataset::QualifiedName>& seds,
+                                                         const std::vector<std::size_t>&              numbers,
+                                                         bool copy_seds = true, bool interpolate_parameters = true);
+
+  std::vector<XYDataset::QualifiedName> listContents(const std::string& group) override;
+
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const XYDataset::QualifiedName& qualified_name) override;
+
+  std::string getParameter(const XYDataset::QualifiedName& qualified_name, const std::string& key_word) override;
+
+private:
+  struct VirtualSed {
+    enum class Kind { COPY, EMISSION_LINES, INTERPOLATION };
+    Kind                                                     kind;
+    std::string                                              source_1;
+    std::string                                              source_2;
+    std::size_t                                              idx;
+    std::size_t                                              total;
+    bool                                                     interpolate_parameters;
+    std::shared_ptr<const EmissionLines::EmissionLinesAdder> adder;
+  };
+
+  void registerSed(const std::string& name, VirtualSed sed);
+
+  std::shared_ptr<const XYDataset::XYDataset> computeDataset(const VirtualSed& sed);
+
+  std::shared_ptr<const SedPairInterpolator> getInterpolator(const std::string& name_1, const std::string& name_2);
+
+  std::unique_ptr<XYDataset::XYDataset> getSourceDataset(const std::string& name);
+
+  std::string getSourceParameter(const std::string& name, const std::string& key_word);
+
+  std::shared_ptr<XYDataset::XYDatasetProvider>                      m_base;
+  std::vector<std::string>                                           m_names{};
+  std::map<std::string, VirtualSed>                                  m_seds{};
+  LruCache<std::string, XYDataset::XYDataset>                        m_datasets;
+  LruCache<std::pair<std::string, std::string>, SedPairInterpolator> m_interpolators;
+  std::mutex                                                         m_mutex{};
+  std::mutex                                                         m_base_mutex{};
+};
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/SedInterpolationEngine.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/SedInterpolationEngine.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzUITools/ParallelFor.h"
+#include "PhzUITools/SedHeader.h"
+#include "SEDInterpolation/SedPairInterpolator.h"
+#include "XYDataset/AsciiParser.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SedInterpolationEngine");
+
+namespace {
+
+struct SedFile {
+  std::unique_ptr<XYDataset::XYDataset> dataset{};
+  std::vector<std::string>              parameters{};
+  std::string                           content{};
+};
+
+// The values of the "# PARAMETER : value" lines of a SED header, without duplicates
+std::vector<std::string> readParameters(const std::string& file_name) {
+  auto                     header = PhzUITools::parseSedHeader(file_name);
+  std::vector<std::string> parameters{};
+  auto                     values = header.keywords.find("PARAMETER");
+  if (values != header.keywords.end()) {
+    for (auto& value : values->second) {
+      if (std::find(parameters.begin(), parameters.end(), value) == parameters.end()) {
+        parameters.push_back(value);
+      }
+    }
+  }
+  return parameters;
+}
+
+SedFile readSed(const std::string& file_name, bool read_parameters, bool read_content) {
+  // Not a PhzUITools::CachedFileParser: each SED is read once per run, and its
+  // text is read again for the parameters and the copy
+  XYDataset::AsciiParser parser{};
+  SedFile                sed{};
+  try {
+    if (parser.isParsable(file_name)) {
+      sed.dataset = parser.getDataset(file_name);
+    }
+  } catch (const std::exception& e) {
+    logger.debug() << "Unable to parse " << file_name << " : " << e.what();
+  }
+  if (!sed.dataset || sed.dataset->size() == 0) {
+    throw Elements::Exception() << "Unable to read the SED " << file_name;
+  }
+  if (read_parameters) {
+    sed.parameters = readParameters(file_name);
+  }
+  if (read_content) {
+    std::ifstream      in{file_name, std::ios::binary};
+    std::ostringstream content{};
+    content << in.rdbuf();
+    sed.content = content.str();
+  }
+  return sed;
+}
+
+void writeSed(const std::string& file_name, const std::vector<double>& wavelengths, const std::vector<double>& flux,
+              const std::vector<std::string>& parameters) {
+  std::ofstream out{file_name};
+  if (parameters.empty()) {
+    out << "# Wave Flux\n";
+  }
+  for (auto& parameter : parameters) {
+    out << "# PARAMETER : " << parameter << '\n';
+  }
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (std::size_t i = 0; i < wavelengths.size(); ++i) {
+    out << wavelengths[i] << ' ' << flux[i] << '\n';
+  }
+  out.close();
+  if (!out) {
+    throw Elements::Exception() << "Unable to write the SED " << file_name;
+  }
+}
+
+std::string fileName(const std::string& sed) {
+  return sed.substr(sed.find_last_of('/') + 1);
+}
+
+}  // namespace
+
+SedInterpolationEngine::SedInterpolationEngine(bool copy_seds, bool interpolate_parameters, std::size_t thread_number)
+    : m_copy_seds{copy_seds}, m_interpolate_parameters{interpolate_parameters}, m_thread_number{thread_number} {}
+
+std::vector<std::string> SedInterpolationEngine::buildOrder(const std::vector<std::string>& seds,
+                                                            const std::vector<std::size_t>& numbers, bool copy_seds) {
+  std::vector<std::string> order{};
+  for (std::size_t index = 0; index < numbers.size() && index + 1 < seds.size(); ++index) {
+    if (copy_seds) {
+      order.push_back(fileName(seds[index]));
+    }
+    for (std::size_t idx = 0; idx < numbers[index]; ++idx) {
+      order.push_back(SedPairInterpolator::buildName(seds[index], seds[index + 1], idx, numbers[index]) + ".sed");
+    }
+  }
+  if (copy_seds && !seds.empty()) {
+    order.push_back(fileName(seds.back()));
+  }
+  return order;
+}
+
+std::size_t SedInterpolationEngine::run(const std::string& sed_dir, const std::vector<std::string>& seds,
+                                        const std::vector<std::size_t>& numbers, const std::string& out_dir,
+                                        ProgressListener progress) const {
+  if (seds.size() < 2) {
+    throw Elements::Exception() << "At least 2 SEDs must be provided";
+  }
+  if (numbers.size() != seds.size() - 1) {
+    throw Elements::Exception() << "The interpolation numbers must have one element less than the SEDs";
+  }
+
+  // Read each distinct SED once, before the output directory is cleared as it may contain some of them
+  std::vector<std::string> files{};
+  for (auto& sed : seds) {
+    boost::filesystem::path path{sed};
+    if (!path.is_absolute() || !boost::filesystem::exists(path)) {
+      path = boost::filesystem::path{sed_dir} / sed;
+    }
+    files.push_back(path.string());
+  }
+  std::vector<std::string> distinct_files = files;
+  std::sort(distinct_files.begin(), distinct_files.end());
+  distinct_files.erase(std::unique(distinct_files.begin(), distinct_files.end()), distinct_files.end());
+
+  std::vector<SedFile> sed_files(distinct_files.size());
+  PhzUITools::forEachIndex(distinct_files.size(), m_thread_number, [&](std::size_t index) {
+    sed_files[index] = readSed(distinct_files[index], m_interpolate_parameters, m_copy_seds);
+  });
+  auto getSedFile = [&](std::size_t sed_index) -> const SedFile& {
+    auto found = std::lower_bound(distinct_files.begin(), distinct_files.end(), files[sed_index]);
+    return sed_files[found - distinct_files.begin()];
+  };
+
+  // Resample each pair once
+  std::vector<std::unique_ptr<SedPairInterpolator>> interpolators(numbers.size());
+  PhzUITools::forEachIndex(numbers.size(), m_thread_number, [&](std::size_t index) {
+    if (numbers[index] > 0) {
+      logger.info() << "Interpolation between SED " << seds[index] << " and " << seds[index + 1];
+      interpolators[index].reset(
+          new SedPairInterpolator{*getSedFile(index).dataset, *getSedFile(index + 1).dataset});
+    }
+  });
+
+  if (boost::filesystem::exists(out_dir)) {
+    logger.info() << "Output directory " << out_dir << " exists, cleaning it";
+    boost::filesystem::remove_all(out_dir);
+  }
+  boost::filesystem::create_directories(out_dir);
+
+  if (m_copy_seds) {
+    logger.info() << "Copy original SEDs into the output folder";
+    for (std::size_t index = 0; index < seds.size(); ++index) {
+      std::ofstream out{(boost::filesystem::path{out_dir} / fileName(seds[index])).string(), std::ios::binary};
+      out << getSedFile(index).content;
+      if (!out) {
+        throw Elements::Exception() << "Unable to copy the SED " << seds[index];
+      }
+    }
+  }
+
+  // All the interpolants of all the pairs are computed in parallel
+  std::vector<std::pair<std::size_t, std::size_t>> tasks{};
+  for (std::size_t index = 0; index < numbers.size(); ++index) {
+    for (std::size_t idx = 0; idx < numbers[index]; ++idx) {
+      tasks.emplace_back(index, idx);
+    }
+  }
+  std::size_t done = 0;
+  std::mutex  progress_mutex{};
+  PhzUITools::forEachIndex(tasks.size(), m_thread_number, [&](std::size_t task) {
+    auto index = tasks[task].first;
+    auto idx   = tasks[task].second;
+    auto total = numbers[index];
+
+    std::vector<std::string> parameters{};
+    if (m_interpolate_parameters) {
+      parameters = SedPairInterpolator::interpolateParameters(getSedFile(index).parameters,
+                                                              getSedFile(index + 1).parameters, idx, total);
+    }
+    auto name = SedPairInterpolator::buildName(seds[index], seds[index + 1], idx, total) + ".sed";
+    writeSed((boost::filesystem::path{out_dir} / name).string(), interpolators[index]->getWavelengths(),
+             interpolators[index]->getFlux(idx, total), parameters);
+
+    std::lock_guard<std::mutex> lock{progress_mutex};
+    ++done;
+    if (progress) {
+      progress(done, tasks.size());
+    }
+  });
+
+  logger.info() << "Writing the order file";
+  std::ofstream order_file{(boost::filesystem::path{out_dir} / "order.txt").string()};
+  for (auto& name : buildOrder(seds, numbers, m_copy_seds)) {
+    order_file << name << '\n';
+  }
+  order_file.close();
+  if (!order_file) {
+    throw Elements::Exception() << "Unable to write the order file in " << out_dir;
+  }
+
+  logger.info() << "Wrote " << tasks.size() << " interpolated SED(s) into " << out_dir;
+  return tasks.size();
+}
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
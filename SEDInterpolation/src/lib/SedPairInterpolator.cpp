@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/SedPairInterpolator.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/SedPairInterpolator.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <iomanip>
+#include <sstream>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+static Elements::Logging logger = Elements::Logging::getLogger("SedPairInterpolator");
+
+namespace {
+
+struct Sampling {
+  std::vector<double> before{};
+  std::vector<double> common{};
+  std::vector<double> after{};
+};
+
+std::vector<double> select(const std::vector<double>& values, double min, double max) {
+  std::vector<double> result{};
+  std::copy_if(values.begin(), values.end(), std::back_inserter(result),
+               [min, max](double value) { return value >= min && value <= max; });
+  return result;
+}
+
+/*
+ * Keep the existing sampling for the non overlapping parts and the sampling
+ * with the highest number of knots for the overlapping part
+ */
+Sampling getSampling(const std::vector<double>& sample_1, const std::vector<double>& sample_2) {
+  double common_start = std::max(sample_1.front(), sample_2.front());
+  double common_end   = std::min(sample_1.back(), sample_2.back());
+
+  const auto& first  = sample_1.front() > sample_2.front() ? sample_2 : sample_1;
+  const auto& second = sample_1.front() > sample_2.front() ? sample_1 : sample_2;
+
+  Sampling sampling{};
+  auto     common_1 = select(first, common_start, common_end);
+  auto     common_2 = select(second, common_start, common_end);
+  sampling.common   = common_2.size() > common_1.size() ? std::move(common_2) : std::move(common_1);
+
+  std::copy_if(first.begin(), first.end(), std::back_inserter(sampling.before),
+               [common_start](double value) { return value < common_start; });
+  const auto& last = first.back() < second.back() ? second : first;
+  std::copy_if(last.begin(), last.end(), std::back_inserter(sampling.after),
+               [common_end](double value) { return value > common_end; });
+  return sampling;
+}
+
+/*
+ * Linear interpolation with the values clamped outside the range, like numpy.interp
+ */
+double interpolate(double x, const double* xp, const double* fp, std::size_t size) {
+  if (x <= xp[0]) {
+    return fp[0];
+  }
+  if (x >= xp[size - 1]) {
+    return fp[size - 1];
+  }
+  std::size_t upper = std::upper_bound(xp, xp + size, x) - xp;
+  std::size_t lower = upper - 1;
+  return fp[lower] + (fp[upper] - fp[lower]) * (x - xp[lower]) / (xp[upper] - xp[lower]);
+}
+
+/*
+ * The SED is kept as is on the parts of the sampling it defines and is zero
+ * on the parts defined by the other SED
+ */
+std::vector<double> resample(const std::vector<double>& x, const std::vector<double>& y, const Sampling& sampling) {
+  std::vector<double> values(sampling.before.size() + sampling.common.size() + sampling.after.size(), 0.);
+
+  std::size_t start = 0;
+  if (!sampling.before.empty() && x.front() == sampling.before.front()) {
+    start = sampling.before.size();
+    std::copy(y.begin(), y.begin() + start, values.begin());
+  }
+  std::size_t end = x.size();
+  if (!sampling.after.empty() && x.back() == sampling.after.back()) {
+    end = x.size() - sampling.after.size();
+    std::copy(y.begin() + end, y.end(), values.end() - sampling.after.size());
+  }
+
+  if (end > start) {
+    auto out = values.begin() + sampling.before.size();
+    for (double wavelength : sampling.common) {
+      *out++ = interpolate(wavelength, x.data() + start, y.data() + start, end - start);
+    }
+  }
+  return values;
+}
+
+std::pair<double, double> weights(std::size_t idx, std::size_t total) {
+  if (idx >= total) {
+    throw Elements::Exception() << "Interpolant index " << idx << " out of range for " << total << " interpolant(s)";
+  }
+  double norm = static_cast<double>(total) + 1.;
+  return {static_cast<double>(total - idx) / norm, static_cast<double>(idx + 1) / norm};
+}
+
+struct PhysicalParameter {
+  std::string name;
+  double      a;
+  double      b;
+  std::string unit;
+};
+
+/*
+ * Parse a "NAME=A*L+B[UNIT]" string
+ */
+PhysicalParameter parseParameter(const std::string& pp) {
+  auto equal = pp.find('=');
+  if (equal == std::string::npos) {
+    throw Elements::Exception() << "Missing '=' in the physical parameter " << pp;
+  }
+  PhysicalParameter result{boost::trim_copy(pp.substr(0, equal)), 0., 0., ""};
+
+  std::string              value = pp.substr(equal + 1);
+  std::vector<std::string> unit_bits{};
+  boost::split(unit_bits, value, boost::is_any_of("["));
+  if (unit_bits.size() == 2) {
+    result.unit = boost::trim_copy(unit_bits[1].substr(0, unit_bits[1].find(']')));
+    value       = unit_bits[0];
+  }
+
+  std::vector<std::string> num_bits{};
+  boost::split(num_bits, value, boost::is_any_of("+"));
+  for (auto& bit : num_bits) {
+    bool proportional = bit.find("*L") != std::string::npos;
+    boost::replace_all(bit, "*L", "");
+    std::size_t parsed = 0;
+    double      number = std::stod(bit, &parsed);
+    if (!boost::trim_copy(bit.substr(parsed)).empty()) {
+      throw Elements::Exception() << "Invalid term '" << bit << "' in the physical parameter " << pp;
+    }
+    (proportional ? result.a : result.b) = number;
+  }
+  return result;
+}
+
+/*
+ * Shortest representation reading back to the same value, like the python str
+ */
+std::string formatNumber(double value) {
+  std::string text{};
+  for (int precision = 1; precision <= 17; ++precision) {
+    std::ostringstream stream{};
+    stream << std::setprecision(precision) << value;
+    text = stream.str();
+    if (std::stod(text) == value) {
+      break;
+    }
+  }
+  if (text.find_first_of(".eEn") == std::string::npos) {
+    text += ".0";
+  }
+  return text;
+}
+
+}  // namespace
+
+SedPairInterpolator::SedPairInterpolator(const XYDataset::XYDataset& sed_1, const XYDataset::XYDataset& sed_2) {
+  if (sed_1.size() == 0 || sed_2.size() == 0) {
+    throw Elements::Exception() << "Cannot interpolate an empty SED";
+  }
+  std::vector<double> x_1{}, y_1{}, x_2{}, y_2{};
+  for (auto& pair : sed_1) {
+    x_1.push_back(pair.first);
+    y_1.push_back(pair.second);
+  }
+  for (auto& pair : sed_2) {
+    x_2.push_back(pair.first);
+    y_2.push_back(pair.second);
+  }
+
+  auto sampling = getSampling(x_1, x_2);
+  m_flux_1      = resample(x_1, y_1, sampling);
+  m_flux_2      = resample(x_2, y_2, sampling);
+
+  m_wavelengths = std::move(sampling.before);
+  m_wavelengths.insert(m_wavelengths.end(), sampling.common.begin(), sampling.common.end());
+  m_wavelengths.insert(m_wavelengths.end(), sampling.after.begin(), sampling.after.end());
+}
+
+const std::vector<double>& SedPairInterpolator::getWavelengths() const {
+  return m_wavelengths;
+}
+
+std::vector<double> SedPairInterpolator::getFlux(std::size_t idx, std::size_t total) const {
+  auto                frac = weights(idx, total);
+  std::vector<double> flux(m_flux_1.size());
+  for (std::size_t i = 0; i < flux.size(); ++i) {
+    flux[i] = frac.first * m_flux_1[i] + frac.second * m_flux_2[i];
+  }
+  return flux;
+}
+
+XYDataset::XYDataset SedPairInterpolator::operator()(std::size_t idx, std::size_t total) const {
+  return XYDataset::XYDataset::factory(m_wavelengths, getFlux(idx, total));
+}
+
+std::string SedPairInterpolator::cleanName(const std::string& name) {
+  std::string result = name.substr(name.find_last_of('/') + 1);
+  auto        dot    = result.find_last_of('.');
+  if (dot != std::string::npos) {
+    result = result.substr(0, dot);
+  }
+  return result;
+}
+
+std::string SedPairInterpolator::buildName(const std::string& name_1, const std::string& name_2, std::size_t idx,
+                                           std::size_t total) {
+  std::ostringstream name{};
+  name << (total - idx) << ":" << (total + 1) << "_" << cleanName(name_1) << "_+_" << (idx + 1) << ":" << (total + 1)
+       << "_" << cleanName(name_2);
+  return name.str();
+}
+
+std::vector<std::string> SedPairInterpolator::interpolateParameters(const std::vector<std::string>& pp_1,
+                                                                    const std::vector<std::string>& pp_2,
+                                                                    std::size_t idx, std::size_t total) {
+  auto parseAll = [](const std::vector<std::string>& pps) {
+    std::vector<PhysicalParameter> result{};
+    for (auto& pp : pps) {
+      try {
+        auto parsed = parseParameter(pp);
+        // Like for a dictionary, the last definition of a name wins
+        auto existing = std::find_if(result.begin(), result.end(),
+                                     [&parsed](const PhysicalParameter& other) { return other.name == parsed.name; });
+        if (existing != result.end()) {
+          *existing = parsed;
+        } else {
+          result.push_back(parsed);
+        }
+      } catch (const std::exception& e) {
+        logger.warn() << "Skipping the physical parameter " << pp << ": " << e.what();
+      }
+    }
+    return result;
+  };
+
+  auto frac     = weights(idx, total);
+  auto parsed_1 = parseAll(pp_1);
+  auto parsed_2 = parseAll(pp_2);
+
+  std::vector<std::string> result{};
+  for (auto& first : parsed_1) {
+    auto second = std::find_if(parsed_2.begin(), parsed_2.end(), [&first](const PhysicalParameter& other) {
+      return other.name == first.name && other.unit == first.unit;
+    });
+    if (second != parsed_2.end()) {
+      result.push_back(first.name + "=" + formatNumber(frac.first * first.a + frac.second * second->a) + "*L+" +
+                       formatNumber(frac.first * first.b + frac.second * second->b) + "[" + first.unit + "]");
+    }
+  }
+  return result;
+}
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/VirtualSedProvider.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/VirtualSedProvider.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+
+namespace Euclid {
+namespace SEDInterpolation {
+
+static Elements::Logging logger = Elements::Logging::getLogger("VirtualSedProvider");
+
+namespace {
+
+std::string normalizeGroup(std::string group) {
+  boost::trim_right_if(group, boost::is_any_of("/"));
+  return group;
+}
+
+bool belongsInGroup(const std::string& name, const std::string& group) {
+  return group.empty() || (name.size() > group.size() && name.compare(0, group.size(), group) == 0 &&
+                           name[group.size()] == '/');
+}
+
+std::unique_ptr<XYDataset::XYDataset> copyDataset(const XYDataset::XYDataset& dataset) {
+  std::vector<double> x{}, y{};
+  x.reserve(dataset.size());
+  y.reserve(dataset.size());
+  for (auto& pair : dataset) {
+    x.push_back(pair.first);
+    y.push_back(pair.second);
+  }
+  return std::unique_ptr<XYDataset::XYDataset>{new XYDataset::XYDataset{XYDataset::XYDataset::factory(x, y)}};
+}
+
+std::vector<std::string> splitParameters(const std::string& parameters) {
+  std::vector<std::string> result{};
+  boost::split(result, parameters, boost::is_any_of(";"));
+  for (auto& parameter : result) {
+    boost::trim(parameter);
+  }
+  result.erase(std::remove(result.begin(), result.end(), ""), result.end());
+  return result;
+}
+
+}  // namespace
+
+VirtualSedProvider::VirtualSedProvider(std::shared_ptr<XYDataset::XYDatasetProvider> base, std::size_t cache_size)
+    : m_base{std::move(base)}, m_datasets{cache_size}, m_interpolators{cache_size} {}
+
+void VirtualSedProvider::registerSed(const std::string& name, VirtualSed sed) {
+  auto existing = m_seds.find(name);
+  if (existing != m_seds.end()) {
+    auto& other = existing->second;
+    if (other.kind == sed.kind && other.source_1 == sed.source_1 && other.source_2 == sed.source_2 &&
+        other.idx == sed.idx && other.total == sed.total) {
+      // The same SED registered twice, e.g. a SED listed twice for the interpolation
+      return;
+    }
+    throw Elements::Exception() << "The virtual SED " << name << " is already defined";
+  }
+  m_seds.emplace(name, std::move(sed));
+  m_names.push_back(name);
+}
+
+std::vector<XYDataset::QualifiedName>
+VirtualSedProvider::addEmissionLines(const std::string& group, const std::string& suffix,
+                                     std::shared_ptr<const EmissionLines::EmissionLinesAdder> adder) {
+  auto base_group = normalizeGroup(group);
+  auto out_group  = base_group + suffix;
+  if (base_group.empty() || suffix.empty()) {
+    throw Elements::Exception() << "Both the group and the suffix are required to add emission lines";
+  }
+
+  // The group may itself be virtual
+  auto base_names = listContents(base_group);
+  if (!listContents(out_group).empty()) {
+    throw Elements::Exception() << "The group " << out_group << " already exists";
+  }
+
+  std::vector<XYDataset::QualifiedName> result{};
+  std::lock_guard<std::mutex>           lock(m_mutex);
+  for (auto& base_name : base_names) {
+    auto name = out_group + base_name.qualifiedName().substr(base_group.size());
+    registerSed(name, {VirtualSed::Kind::EMISSION_LINES, base_name.qualifiedName(), "", 0, 0, false, adder});
+    result.emplace_back(name);
+  }
+  logger.info() << "Registered " << result.size() << " SED(s) with emission lines in " << out_group;
+  return result;
+}
+
+std::vector<XYDataset::QualifiedName> VirtualSedProvider::addInterpolation(
+    const std::string& group, const std::vector<XYDataset::QualifiedName>& seds, const std::vector<std::size_t>& numbers,
+    bool copy_seds, bool interpolate_parameters) {
+  auto out_group = normalizeGroup(group);
+  if (out_group.empty()) {
+    throw Elements::Exception() << "A group is required for the interpolated SEDs";
+  }
+  if (seds.size() < 2) {
+    throw Elements::Exception() << "At least 2 SEDs must be provided";
+  }
+  if (numbers.size() != seds.size() - 1) {
+    throw Elements::Exception() << "The interpolation numbers must have one element less than the SEDs";
+  }
+  if (!listContents(out_group).empty()) {
+    throw Elements::Exception() << "The group " << out_group << " already exists";
+  }
+  for (auto& sed : seds) {
+    // A SED derived from itself could never be computed
+    if (belongsInGroup(sed.qualifiedName(), out_group)) {
+      throw Elements::Exception() << "The SED " << sed.qualifiedName() << " cannot be interpolated into its own group";
+    }
+  }
+
+  std::vector<XYDataset::QualifiedName> result{};
+  std::lock_guard<std::mutex>           lock(m_mutex);
+  auto copySed = [&](const XYDataset::QualifiedName& sed) {
+    auto name = out_group + "/" + sed.datasetName();
+    registerSed(name, {VirtualSed::Kind::COPY, sed.qualifiedName(), "", 0, 0, false, nullptr});
+    result.emplace_back(name);
+  };
+
+  for (std::size_t index = 0; index < numbers.size(); ++index) {
+    if (copy_seds) {
+      copySed(seds[index]);
+    }
+    for (std::size_t idx = 0; idx < numbers[index]; ++idx) {
+      auto name = out_group + "/" +
+                  SedPairInterpolator::buildName(seds[index].datasetName(), seds[index + 1].datasetName(), idx,
+                                                 numbers[index]);
+      registerSed(name, {VirtualSed::Kind::INTERPOLATION, seds[index].qualifiedName(), seds[index + 1].qualifiedName(),
+                         idx, numbers[index], interpolate_parameters, nullptr});
+      result.emplace_back(name);
+    }
+  }
+  if (copy_seds) {
+    copySed(seds.back());
+  }
+  logger.info() << "Registered " << result.size() << " interpolated SED(s) in " << out_group;
+  return result;
+}
+
+std::vector<XYDataset::QualifiedName> VirtualSedProvider::listContents(const std::string& group) {
+  auto                                  normalized = normalizeGroup(group);
+  std::vector<XYDataset::QualifiedName> result{};
+  {
+    std::lock_guard<std::mutex> lock(m_base_mutex);
+    result = m_base->listContents(group);
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& name : m_names) {
+    if (belongsInGroup(name, normalized)) {
+      result.emplace_back(name);
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<XYDataset::XYDataset> VirtualSedProvider::getDataset(const XYDataset::QualifiedName& qualified_name) {
+  auto       name = qualified_name.qualifiedName();
+  VirtualSed sed{};
+  bool       is_virtual = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        found = m_seds.find(name);
+    if (found != m_seds.end()) {
+      if (auto cached = m_datasets.get(name)) {
+        return copyDataset(*cached);
+      }
+      sed        = found->second;
+      is_virtual = true;
+    }
+  }
+  if (!is_virtual) {
+    std::lock_guard<std::mutex> lock(m_base_mutex);
+    return m_base->getDataset(qualified_name);
+  }
+
+  // Computed without holding the lock, so that other SEDs can be served meanwhile
+  auto dataset = computeDataset(sed);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_datasets.put(name, dataset);
+  }
+  return copyDataset(*dataset);
+}
+
+std::string VirtualSedProvider::getParameter(const XYDataset::QualifiedName& qualified_name,
+                                             const std::string&              key_word) {
+  auto       name = qualified_name.qualifiedName();
+  VirtualSed sed{};
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        found = m_seds.find(name);
+    if (found == m_seds.end()) {
+      std::lock_guard<std::mutex> base_lock(m_base_mutex);
+      return m_base->getParameter(qualified_name, key_word);
+    }
+    sed = found->second;
+  }
+
+  if (sed.kind != VirtualSed::Kind::INTERPOLATION) {
+    return getSourceParameter(sed.source_1, key_word);
+  }
+  if (key_word != "PARAMETER" || !sed.interpolate_parameters) {
+    return "";
+  }
+  auto parameters = SedPairInterpolator::interpolateParameters(
+      splitParameters(getSourceParameter(sed.source_1, key_word)),
+      splitParameters(getSourceParameter(sed.source_2, key_word)), sed.idx, sed.total);
+  return boost::join(parameters, ";");
+}
+
+std::shared_ptr<const XYDataset::XYDataset> VirtualSedProvider::computeDataset(const VirtualSed& sed) {
+  switch (sed.kind) {
+  case VirtualSed::Kind::COPY:
+    return getSourceDataset(sed.source_1);
+  case VirtualSed::Kind::EMISSION_LINES:
+    return std::make_shared<XYDataset::XYDataset>((*sed.adder)(*getSourceDataset(sed.source_1)));
+  case VirtualSed::Kind::INTERPOLATION:
+    return std::make_shared<XYDataset::XYDataset>((*getInterpolator(sed.source_1, sed.source_2))(sed.idx, sed.total));
+  }
+  throw Elements::Exception() << "Unknown kind of virtual SED";
+}
+
+std::shared_ptr<const SedPairInterpolator> VirtualSedProvider::getInterpolator(const std::string& name_1,
+                                                                               const std::string& name_2) {
+  auto key = std::make_pair(name_1, name_2);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto cached = m_interpolators.get(key)) {
+      return cached;
+    }
+  }
+  auto interpolator = std::make_shared<const SedPairInterpolator>(*getSourceDataset(name_1), *getSourceDataset(name_2));
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_interpolators.put(key, interpolator);
+  return interpolator;
+}
+
+std::unique_ptr<XYDataset::XYDataset> VirtualSedProvider::getSourceDataset(const std::string& name) {
+  // Resolved through this provider, so that a virtual SED can be derived from another one
+  auto dataset = getDataset(XYDataset::QualifiedName{name});
+  if (!dataset) {
+    throw Elements::Exception() << "Unknown SED " << name;
+  }
+  return dataset;
+}
+
+std::string VirtualSedProvider::getSourceParameter(const std::string& name, const std::string& key_word) {
+  return getParameter(XYDataset::QualifiedName{name}, key_word);
+}
+
+}  // namespace SEDInterpolation
+}  // namespace Euclid
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/InterpolateSED.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PhzUITools/ProgressReporter.h"
+#include "SEDInterpolation/SedInterpolationEngine.h"
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Euclid;
+using namespace Euclid::SEDInterpolation;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+static Elements::Logging logger = Elements::Logging::getLogger("InterpolateSED");
+
+static const std::string SED_DIR{"sed-dir"};
+static const std::string SEDS{"seds"};
+static const std::string NUMBERS{"numbers"};
+static const std::string OUT_DIR{"out-dir"};
+static const std::string COPY_SED{"copy-sed"};
+static const std::string INTERPOLATE_PP{"interpolate-pp"};
+static const std::string THREAD_NO{"thread-no"};
+static const std::string PROGRESS_FILE{"progress-file"};
+
+class InterpolateSED : public Elements::Program {
+
+public:
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"Interpolate SED options"};
+    options.add_options()(SED_DIR.c_str(), po::value<std::string>()->required(), "The directory containing the SEDs")(
+        SEDS.c_str(), po::value<std::string>()->required(),
+        "List of comma separated SEDs files (relative to sed-dir), at least 2 SED must be provided")(
+        NUMBERS.c_str(), po::value<std::string>()->required(),
+        "List of comma separated non-negative integer indicating the number of SED to be computed between each input "
+        "SEDs. The number of integer must be one less that the number of SED")(
+        OUT_DIR.c_str(), po::value<std::string>()->required(),
+        "Folder (relative to sed-dir) into which SEDs will be saved. If the folder exists it will be cleared.")(
+        COPY_SED.c_str(), po::value<std::string>()->default_value("True"),
+        "If true copy the original SEDs into the output folder (True /False Default: True)")(
+        INTERPOLATE_PP.c_str(), po::value<std::string>()->default_value("True"),
+        "If true interpolate also the (common) physical parameter(s) found in SEDs headers (True /False Default: "
+        "True)")(THREAD_NO.c_str(), po::value<int>()->default_value(0), "Number of threads (0 for all the cores)")(
+        PROGRESS_FILE.c_str(), po::value<std::string>()->default_value(""),
+        "(optional) JSON file into which the progress is written");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto sed_dir = args.at(SED_DIR).as<std::string>();
+    if (!fs::is_directory(sed_dir)) {
+      throw Elements::Exception() << "Unknown SED directory " << sed_dir;
+    }
+    auto out_dir = args.at(OUT_DIR).as<std::string>();
+    if (out_dir.empty()) {
+      throw Elements::Exception() << OUT_DIR << " must be provided";
+    }
+    out_dir = (fs::path{sed_dir} / out_dir).string();
+
+    std::vector<std::string> seds{};
+    boost::split(seds, args.at(SEDS).as<std::string>(), boost::is_any_of(","));
+    if (seds.size() < 2) {
+      throw Elements::Exception() << "At least 2 SEDs must be provided";
+    }
+    auto numbers = parseNumbers(args.at(NUMBERS).as<std::string>());
+    if (numbers.size() != seds.size() - 1) {
+      throw Elements::Exception() << NUMBERS << " must have one elements less than " << SEDS;
+    }
+
+    auto thread_no = args.at(THREAD_NO).as<int>();
+    if (thread_no < 0) {
+      throw Elements::Exception() << "Invalid " << THREAD_NO << " : " << thread_no;
+    }
+    SedInterpolationEngine engine{isTrue(args.at(COPY_SED).as<std::string>()),
+                                  isTrue(args.at(INTERPOLATE_PP).as<std::string>()),
+                                  static_cast<std::size_t>(thread_no)};
+    PhzUITools::ProgressReporter progress{
+        [](const PhzUITools::ProgressReporter::Status& status) {
+          logger.info() << "Written " << status.step << " / " << status.total << " SEDs, "
+                        << PhzUITools::ProgressReporter::describe(status);
+        },
+        "SEDs", args.at(PROGRESS_FILE).as<std::string>()};
+    try {
+      engine.run(sed_dir, seds, numbers, out_dir, progress);
+    } catch (...) {
+      progress.markFailed();
+      throw;
+    }
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  static bool isTrue(const std::string& value) {
+    return boost::algorithm::to_lower_copy(value) == "true";
+  }
+
+  static std::vector<std::size_t> parseNumbers(const std::string& numbers) {
+    std::vector<std::string> tokens{};
+    boost::split(tokens, numbers, boost::is_any_of(","));
+    std::vector<std::size_t> result{};
+    for (auto& token : tokens) {
+      int number = -1;
+      try {
+        number = std::stoi(token);
+      } catch (const std::exception&) {
+      }
+      if (number < 0) {
+        throw Elements::Exception() << "Invalid interpolation number " << token;
+      }
+      result.push_back(static_cast<std::size_t>(number));
+    }
+    return result;
+  }
+};
+
+MAIN_FOR(InterpolateSED)
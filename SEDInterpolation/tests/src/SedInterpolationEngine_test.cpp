@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/SedInterpolationEngine_test.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/SedInterpolationEngine.h"
+#include "ElementsKernel/Temporary.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace Euclid::SEDInterpolation;
+
+namespace {
+
+struct SedInterpolationEngine_Fixture {
+  Elements::TempDir m_top_dir{};
+  std::string       m_sed_dir = m_top_dir.path().string();
+  std::string       m_out_dir = (m_top_dir.path() / "Out").string();
+
+  SedInterpolationEngine_Fixture() {
+    boost::filesystem::create_directories(m_top_dir.path() / "Group");
+    writeFile("Group/A.sed", "# PARAMETER : AGE=0*L+1[GY]\n1000 1\n2000 1\n3000 1\n");
+    writeFile("Group/B.sed", "# PARAMETER : AGE=0*L+4[GY]\n1000 4\n2000 4\n3000 4\n");
+    writeFile("C.sed", "1000 7\n3000 7\n");
+  }
+
+  void writeFile(const std::string& name, const std::string& content) {
+    std::ofstream out{(m_top_dir.path() / name).string()};
+    out << content;
+  }
+
+  std::vector<std::string> readLines(const std::string& name) {
+    std::ifstream            in{(boost::filesystem::path{m_out_dir} / name).string()};
+    std::vector<std::string> lines{};
+    std::string              line;
+    while (std::getline(in, line)) {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+};
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(SedInterpolationEngine_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(build_order_test) {
+  auto order = SedInterpolationEngine::buildOrder({"G/A.sed", "B.sed", "C.sed"}, {2, 0}, true);
+  std::vector<std::string> expected{"A.sed", "2:3_A_+_1:3_B.sed", "1:3_A_+_2:3_B.sed", "B.sed", "C.sed"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+
+  auto no_copy = SedInterpolationEngine::buildOrder({"G/A.sed", "B.sed"}, {1}, false);
+  BOOST_REQUIRE_EQUAL(no_copy.size(), 1);
+  BOOST_CHECK_EQUAL(no_copy[0], "1:2_A_+_1:2_B.sed");
+}
+
+BOOST_FIXTURE_TEST_CASE(run_test, SedInterpolationEngine_Fixture) {
+  // Given
+  SedInterpolationEngine engine{true, true, 2};
+  std::size_t            calls = 0;
+
+  // When
+  auto written = engine.run(m_sed_dir, {"Group/A.sed", "Group/B.sed", "C.sed"}, {1, 3}, m_out_dir,
+                            [&calls](std::size_t, std::size_t) { ++calls; });
+
+  // Then
+  BOOST_CHECK_EQUAL(written, 4);
+  BOOST_CHECK_EQUAL(calls, 4);
+  auto order = readLines("order.txt");
+  BOOST_CHECK_EQUAL(order.size(), 7);
+  for (auto& name : order) {
+    BOOST_CHECK(boost::filesystem::exists(boost::filesystem::path{m_out_dir} / name));
+  }
+
+  auto interpolated = readLines("1:2_A_+_1:2_B.sed");
+  BOOST_REQUIRE_EQUAL(interpolated.size(), 4);
+  BOOST_CHECK_EQUAL(interpolated[0], "# PARAMETER : AGE=0.0*L+2.5[GY]");
+  BOOST_CHECK_EQUAL(interpolated[1], "1000 2.5");
+
+  // No common parameter between B and C
+  auto no_parameter = readLines("3:4_B_+_1:4_C.sed");
+  BOOST_REQUIRE(!no_parameter.empty());
+  BOOST_CHECK_EQUAL(no_parameter[0], "# Wave Flux");
+}
+
+BOOST_FIXTURE_TEST_CASE(clean_output_test, SedInterpolationEngine_Fixture) {
+  // Given
+  boost::filesystem::create_directories(m_out_dir);
+  writeFile("Out/previous.sed", "1000 1\n");
+  SedInterpolationEngine engine{false, false, 1};
+
+  // When
+  engine.run(m_sed_dir, {"Group/A.sed", "Group/B.sed"}, {1}, m_out_dir);
+
+  // Then
+  BOOST_CHECK(!boost::filesystem::exists(boost::filesystem::path{m_out_dir} / "previous.sed"));
+  BOOST_CHECK(!boost::filesystem::exists(boost::filesystem::path{m_out_dir} / "A.sed"));
+  BOOST_CHECK_EQUAL(readLines("order.txt").size(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(invalid_test, SedInterpolationEngine_Fixture) {
+  SedInterpolationEngine engine{};
+  BOOST_CHECK_THROW(engine.run(m_sed_dir, {"Group/A.sed"}, {}, m_out_dir), std::exception);
+  BOOST_CHECK_THROW(engine.run(m_sed_dir, {"Group/A.sed", "Group/B.sed"}, {1, 1}, m_out_dir), std::exception);
+  BOOST_CHECK_THROW(engine.run(m_sed_dir, {"Group/A.sed", "Missing.sed"}, {1}, m_out_dir), std::exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
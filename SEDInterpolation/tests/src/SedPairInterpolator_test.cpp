@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/SedPairInterpolator_test.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/SedPairInterpolator.h"
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid;
+using namespace Euclid::SEDInterpolation;
+
+namespace {
+
+std::vector<double> values(const XYDataset::XYDataset& dataset, bool wavelength) {
+  std::vector<double> result{};
+  for (auto& pair : dataset) {
+    result.push_back(wavelength ? pair.first : pair.second);
+  }
+  return result;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(SedPairInterpolator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(same_sampling_test) {
+  // Given
+  auto sed_1 = XYDataset::XYDataset::factory({1000., 2000., 3000.}, {1., 2., 3.});
+  auto sed_2 = XYDataset::XYDataset::factory({1000., 2000., 3000.}, {4., 5., 6.});
+
+  // When
+  SedPairInterpolator interpolator{sed_1, sed_2};
+  auto                first = interpolator(0, 2);
+  auto                last  = interpolator(1, 2);
+
+  // Then
+  std::vector<double> expected_wavelengths{1000., 2000., 3000.};
+  auto                wavelengths = values(first, true);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wavelengths.begin(), wavelengths.end(), expected_wavelengths.begin(),
+                                expected_wavelengths.end());
+  auto first_flux = values(first, false);
+  auto last_flux  = values(last, false);
+  for (std::size_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_CLOSE(first_flux[i], 2. / 3. * (i + 1) + 1. / 3. * (i + 4), 1e-10);
+    BOOST_CHECK_CLOSE(last_flux[i], 1. / 3. * (i + 1) + 2. / 3. * (i + 4), 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(merged_sampling_test) {
+  // Given: the second SED is denser over the common part and ends later
+  auto sed_1 = XYDataset::XYDataset::factory({1000., 2000., 3000.}, {2., 2., 2.});
+  auto sed_2 = XYDataset::XYDataset::factory({1500., 2000., 2500., 3000., 3500.}, {4., 4., 4., 4., 4.});
+
+  // When
+  SedPairInterpolator interpolator{sed_1, sed_2};
+  auto                flux = interpolator.getFlux(0, 1);
+
+  // Then
+  std::vector<double> expected_wavelengths{1000., 1500., 2000., 2500., 3000., 3500.};
+  auto&               wavelengths = interpolator.getWavelengths();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wavelengths.begin(), wavelengths.end(), expected_wavelengths.begin(),
+                                expected_wavelengths.end());
+  // Each SED is zero outside its own range
+  std::vector<double> expected_flux{1., 3., 3., 3., 3., 2.};
+  for (std::size_t i = 0; i < flux.size(); ++i) {
+    BOOST_CHECK_CLOSE(flux[i], expected_flux[i], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(get_sampling_test) {
+  // Given
+  auto sed_1 = XYDataset::XYDataset::factory({1., 2., 3., 5., 7., 9.1}, {1., 2., 3., 4., 5., 6.});
+  auto sed_2 = XYDataset::XYDataset::factory({3., 4., 5., 6., 7., 8., 9., 10., 11., 12., 13.},
+                                             {1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11.});
+
+  // When
+  SedPairInterpolator interpolator{sed_1, sed_2};
+
+  // Then
+  std::vector<double> expected{1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12., 13.};
+  auto&               wavelengths = interpolator.getWavelengths();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wavelengths.begin(), wavelengths.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(resample_test) {
+  // Given
+  auto sed_1 = XYDataset::XYDataset::factory({1., 2., 3., 5., 7., 9., 11.}, {10., 20., 30., 50., 70., 90., 110.});
+  auto sed_2 = XYDataset::XYDataset::factory({3., 5., 7., 9., 11., 12., 13., 14.},
+                                             {30., 50., 70., 90., 110., 120., 130., 140.});
+
+  // When
+  SedPairInterpolator interpolator{sed_1, sed_2};
+  auto                flux = interpolator.getFlux(0, 1);
+
+  // Then: each SED is kept on its own range and is zero elsewhere
+  std::vector<double> expected_wavelengths{1., 2., 3., 5., 7., 9., 11., 12., 13., 14.};
+  auto&               wavelengths = interpolator.getWavelengths();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wavelengths.begin(), wavelengths.end(), expected_wavelengths.begin(),
+                                expected_wavelengths.end());
+  std::vector<double> expected_flux{5., 10., 30., 50., 70., 90., 110., 60., 65., 70.};
+  BOOST_CHECK_EQUAL_COLLECTIONS(flux.begin(), flux.end(), expected_flux.begin(), expected_flux.end());
+}
+
+BOOST_AUTO_TEST_CASE(weights_test) {
+  // Given
+  std::vector<double> sampling{1., 2., 3., 4., 5., 6., 7., 8., 9., 10.};
+  std::vector<double> values_1{1., 2., 3., 4., 5., 6., 7., 8., 9., 10.};
+  std::vector<double> values_2{100., 90., 80., 70., 60., 50., 40., 30., 20., 10.};
+
+  // When
+  SedPairInterpolator interpolator{XYDataset::XYDataset::factory(sampling, values_1),
+                                   XYDataset::XYDataset::factory(sampling, values_2)};
+  auto                flux = interpolator.getFlux(0, 3);
+
+  // Then
+  for (std::size_t i = 0; i < sampling.size(); ++i) {
+    BOOST_CHECK_CLOSE(flux[i], 0.75 * values_1[i] + 0.25 * values_2[i], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_index_test) {
+  auto                sed = XYDataset::XYDataset::factory({1000., 2000.}, {1., 1.});
+  SedPairInterpolator interpolator{sed, sed};
+  BOOST_CHECK_THROW(interpolator(2, 2), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(build_name_test) {
+  BOOST_CHECK_EQUAL(SedPairInterpolator::buildName("path/A.sed", "B.sed", 0, 2), "2:3_A_+_1:3_B");
+  BOOST_CHECK_EQUAL(SedPairInterpolator::buildName("A", "B", 1, 2), "1:3_A_+_2:3_B");
+  BOOST_CHECK_EQUAL(SedPairInterpolator::cleanName("path//file.d1.d2"), "file.d1");
+  BOOST_CHECK_EQUAL(SedPairInterpolator::cleanName("file"), "file");
+}
+
+BOOST_AUTO_TEST_CASE(interpolate_parameters_test) {
+  // Given
+  std::vector<std::string> pp_1{"AGE=0*L+5[GY]", "MASS=2*L+0[M0]", "TEST=3*L+2[TT]", "MASS2 = 2 *L + 0 [ M0 ]"};
+  std::vector<std::string> pp_2{"AGE=0*L+7[GY]", "MASS=4*L+0[M0]", "TEST2=5*L+1[TT]", "MASS2=2*L+0[M_0]"};
+
+  // When
+  auto first  = SedPairInterpolator::interpolateParameters(pp_1, pp_2, 0, 3);
+  auto middle = SedPairInterpolator::interpolateParameters(pp_1, pp_2, 1, 3);
+  auto last   = SedPairInterpolator::interpolateParameters(pp_1, pp_2, 2, 3);
+
+  // Then
+  BOOST_REQUIRE_EQUAL(first.size(), 2);
+  BOOST_CHECK_EQUAL(first[0], "AGE=0.0*L+5.5[GY]");
+  BOOST_CHECK_EQUAL(first[1], "MASS=2.5*L+0.0[M0]");
+  BOOST_REQUIRE_EQUAL(middle.size(), 2);
+  BOOST_CHECK_EQUAL(middle[0], "AGE=0.0*L+6.0[GY]");
+  BOOST_CHECK_EQUAL(middle[1], "MASS=3.0*L+0.0[M0]");
+  BOOST_REQUIRE_EQUAL(last.size(), 2);
+  BOOST_CHECK_EQUAL(last[0], "AGE=0.0*L+6.5[GY]");
+  BOOST_CHECK_EQUAL(last[1], "MASS=3.5*L+0.0[M0]");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/VirtualSedProvider_test.cpp
+ * @date 10/19/26
+ */
+
+#include "SEDInterpolation/VirtualSedProvider.h"
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid;
+using namespace Euclid::SEDInterpolation;
+
+namespace {
+
+// Provider keeping its datasets in memory and counting the datasets read
+class MemoryProvider : public XYDataset::XYDatasetProvider {
+public:
+  std::vector<XYDataset::QualifiedName> listContents(const std::string& group) override {
+    std::vector<XYDataset::QualifiedName> result{};
+    for (auto& dataset : m_datasets) {
+      if (dataset.first.compare(0, group.size() + 1, group + "/") == 0) {
+        result.emplace_back(dataset.first);
+      }
+    }
+    return result;
+  }
+
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const XYDataset::QualifiedName& qualified_name) override {
+    auto found = m_datasets.find(qualified_name.qualifiedName());
+    if (found == m_datasets.end()) {
+      return nullptr;
+    }
+    ++m_read_count;
+    return std::unique_ptr<XYDataset::XYDataset>{
+        new XYDataset::XYDataset{XYDataset::XYDataset::factory(found->second.first, found->second.second)}};
+  }
+
+  std::string getParameter(const XYDataset::QualifiedName& qualified_name, const std::string& key_word) override {
+    auto found = m_parameters.find(qualified_name.qualifiedName() + ":" + key_word);
+    return found == m_parameters.end() ? "" : found->second;
+  }
+
+  std::map<std::string, std::pair<std::vector<double>, std::vector<double>>> m_datasets{};
+  std::map<std::string, std::string>                                          m_parameters{};
+  int                                                                         m_read_count = 0;
+};
+
+struct VirtualSedProvider_Fixture {
+  std::shared_ptr<MemoryProvider> base = std::make_shared<MemoryProvider>();
+
+  VirtualSedProvider_Fixture() {
+    base->m_datasets["SEDs/A"] = {{1000., 2000., 3000.}, {1., 1., 1.}};
+    base->m_datasets["SEDs/B"] = {{1000., 2000., 3000.}, {4., 4., 4.}};
+    base->m_datasets["SEDs/C"] = {{1000., 2000., 3000.}, {7., 7., 7.}};
+    base->m_parameters["SEDs/A:PARAMETER"] = "AGE=0*L+1[GY];MASS=1*L+0[M0];";
+    base->m_parameters["SEDs/B:PARAMETER"] = "AGE=0*L+4[GY];";
+  }
+};
+
+std::vector<double> flux(const XYDataset::XYDataset& dataset) {
+  std::vector<double> result{};
+  for (auto& pair : dataset) {
+    result.push_back(pair.second);
+  }
+  return result;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(VirtualSedProvider_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(interpolation_test, VirtualSedProvider_Fixture) {
+  // Given
+  VirtualSedProvider provider{base};
+
+  // When
+  auto order = provider.addInterpolation("SEDs/Interpolated", {XYDataset::QualifiedName{"SEDs/A"},
+                                                               XYDataset::QualifiedName{"SEDs/B"},
+                                                               XYDataset::QualifiedName{"SEDs/C"}},
+                                         {2, 1});
+
+  // Then
+  std::vector<std::string> expected{"SEDs/Interpolated/A", "SEDs/Interpolated/2:3_A_+_1:3_B",
+                                    "SEDs/Interpolated/1:3_A_+_2:3_B", "SEDs/Interpolated/B",
+                                    "SEDs/Interpolated/1:2_B_+_1:2_C", "SEDs/Interpolated/C"};
+  BOOST_REQUIRE_EQUAL(order.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_EQUAL(order[i].qualifiedName(), expected[i]);
+  }
+  BOOST_CHECK_EQUAL(provider.listContents("SEDs/Interpolated").size(), expected.size());
+  BOOST_CHECK_EQUAL(provider.listContents("SEDs").size(), expected.size() + 3);
+
+  auto dataset = provider.getDataset(XYDataset::QualifiedName{"SEDs/Interpolated/2:3_A_+_1:3_B"});
+  BOOST_REQUIRE(dataset);
+  for (double value : flux(*dataset)) {
+    BOOST_CHECK_CLOSE(value, 2., 1e-10);
+  }
+  auto copy = provider.getDataset(XYDataset::QualifiedName{"SEDs/Interpolated/B"});
+  BOOST_REQUIRE(copy);
+  BOOST_CHECK_CLOSE(flux(*copy)[0], 4., 1e-10);
+}
+
+BOOST_FIXTURE_TEST_CASE(cache_test, VirtualSedProvider_Fixture) {
+  // Given
+  VirtualSedProvider provider{base};
+  provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {3},
+                            false);
+
+  // When
+  for (auto& name : provider.listContents("Out")) {
+    provider.getDataset(name);
+    provider.getDataset(name);
+  }
+
+  // Then: the two SEDs of the pair are read once
+  BOOST_CHECK_EQUAL(base->m_read_count, 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(parameter_test, VirtualSedProvider_Fixture) {
+  // Given
+  VirtualSedProvider provider{base};
+  provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {1});
+
+  // Then
+  BOOST_CHECK_EQUAL(provider.getParameter(XYDataset::QualifiedName{"Out/1:2_A_+_1:2_B"}, "PARAMETER"),
+                    "AGE=0.0*L+2.5[GY]");
+  BOOST_CHECK_EQUAL(provider.getParameter(XYDataset::QualifiedName{"Out/A"}, "PARAMETER"),
+                    "AGE=0*L+1[GY];MASS=1*L+0[M0];");
+  BOOST_CHECK_EQUAL(provider.getParameter(XYDataset::QualifiedName{"SEDs/B"}, "PARAMETER"), "AGE=0*L+4[GY];");
+}
+
+BOOST_FIXTURE_TEST_CASE(emission_lines_test, VirtualSedProvider_Fixture) {
+  // Given
+  VirtualSedProvider provider{base};
+  auto               adder = std::make_shared<EmissionLines::EmissionLinesAdder>(
+      std::make_pair(1500., 2500.), 1., std::vector<EmissionLines::EmissionLine>{{"L", 2000., 1.}});
+
+  // When
+  auto names = provider.addEmissionLines("SEDs", "_el", adder);
+
+  // Then
+  BOOST_REQUIRE_EQUAL(names.size(), 3);
+  BOOST_CHECK_EQUAL(names[0].qualifiedName(), "SEDs_el/A");
+  auto dataset = provider.getDataset(names[0]);
+  BOOST_REQUIRE(dataset);
+  auto expected = (*adder)(*base->getDataset(XYDataset::QualifiedName{"SEDs/A"}));
+  BOOST_CHECK_EQUAL(dataset->size(), expected.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(chained_test, VirtualSedProvider_Fixture) {
+  // Given
+  VirtualSedProvider provider{base};
+  auto               adder = std::make_shared<EmissionLines::EmissionLinesAdder>(
+      std::make_pair(1500., 2500.), 1., std::vector<EmissionLines::EmissionLine>{{"L", 2000., 1.}});
+  provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {1});
+
+  // When
+  auto names = provider.addEmissionLines("Out", "_el", adder);
+
+  // Then
+  BOOST_REQUIRE_EQUAL(names.size(), 3);
+  BOOST_CHECK_EQUAL(names[1].qualifiedName(), "Out_el/1:2_A_+_1:2_B");
+  auto dataset = provider.getDataset(names[1]);
+  BOOST_REQUIRE(dataset);
+  auto interpolated = provider.getDataset(XYDataset::QualifiedName{"Out/1:2_A_+_1:2_B"});
+  auto expected     = (*adder)(*interpolated);
+  BOOST_REQUIRE_EQUAL(dataset->size(), expected.size());
+  auto value = dataset->begin();
+  for (auto& pair : expected) {
+    BOOST_CHECK_CLOSE(value->second, pair.second, 1e-10);
+    ++value;
+  }
+  BOOST_CHECK_EQUAL(provider.getParameter(names[1], "PARAMETER"), "AGE=0.0*L+2.5[GY]");
+}
+
+BOOST_FIXTURE_TEST_CASE(invalid_test, VirtualSedProvider_Fixture) {
+  VirtualSedProvider provider{base};
+  BOOST_CHECK_THROW(provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}}, {}), std::exception);
+  BOOST_CHECK_THROW(
+      provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {}),
+      std::exception);
+  // The group of the base SEDs cannot be shadowed
+  BOOST_CHECK_THROW(
+      provider.addInterpolation("SEDs", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {1}),
+      std::exception);
+  // A SED cannot be derived from itself
+  provider.addInterpolation("Out", {XYDataset::QualifiedName{"SEDs/A"}, XYDataset::QualifiedName{"SEDs/B"}}, {1});
+  BOOST_CHECK_THROW(
+      provider.addInterpolation("Out2", {XYDataset::QualifiedName{"Out2/A"}, XYDataset::QualifiedName{"Out/A"}}, {1}),
+      std::exception);
+  BOOST_CHECK(!provider.getDataset(XYDataset::QualifiedName{"SEDs/Unknown"}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()